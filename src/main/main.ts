@@ -1,9 +1,19 @@
 import { app, BrowserWindow, ipcMain, dialog, shell } from 'electron';
 import * as path from 'path';
 import * as fs from 'fs';
-import { IPCChannels, TypingEvent } from '../shared/types';
+import { IPCChannels, TypingEvent, TypingLiveState, HammyReaction, TraceRenderReport } from '../shared/types';
 import { KeyboardService, TypingMetadata } from './services/KeyboardService';
 import { dataManager } from './services/database/DataManager';
+import {
+  LIVE_STATE_FIELD_COUNT,
+  LIVE_STATE_SEQUENCE,
+  LIVE_STATE_ACTIVE,
+  LIVE_STATE_RATE,
+  LIVE_STATE_COMBO,
+  LIVE_STATE_LAST_KEY_AGE_MS,
+  LIVE_STATE_LAST_INTERVAL_MS,
+  NativeRhythmEvent
+} from './services/native/types';
 import { windowManager } from './windows/WindowManager';
 
 class ElectronApp {
@@ -11,6 +21,18 @@ class ElectronApp {
   private keyboardService: KeyboardService | null = null;
   private isDev = process.env.NODE_ENV === 'development';
 
+  // 위젯 실시간 상태 - 화면 갱신 주기로 네이티브 상태를 읽어 바뀐 경우에만 전달
+  private readonly LIVE_STATE_FRAME_MS = 16;
+  private liveStateBuffer = new Float64Array(LIVE_STATE_FIELD_COUNT);
+  private liveStateTimer: NodeJS.Timeout | null = null;
+  private lastLiveSequence = -1;
+  private lastLiveActive = false;
+
+  // 지연 추적 (HAMMY_TRACE=파일 경로, 1이면 사용자 데이터 폴더) - 위젯으로 보낸 추적 ID와 보낸 시각
+  private readonly TRACE_MAX_PENDING = 256;
+  private traceSentAt = new Map<number, number>();
+  private pendingLiveTrace: { traceId: number; since: number } | null = null;
+
   constructor() {
     this.initializeApp();
     this.initializeKeyboardService();
@@ -46,6 +68,7 @@ class ElectronApp {
 
     // 앱 종료 시 서비스 정리
     app.on('before-quit', async () => {
+      this.stopLiveStatePump();
       if (this.keyboardService) {
         this.keyboardService.destroy();
       }
@@ -81,6 +104,7 @@ class ElectronApp {
 
   private initializeKeyboardService(): void {
     this.keyboardService = new KeyboardService();
+    this.startTraceFromEnv();
     
     // 타이핑 이벤트 리스너 (send 사용 - 단방향)
     this.keyboardService.on('typing', (metadata: TypingMetadata) => {
@@ -89,7 +113,8 @@ class ElectronApp {
         keyCount: metadata.keyCount,
         interval: metadata.interval,
         isActive: metadata.isActive,
-        sessionId: metadata.sessionId
+        sessionId: metadata.sessionId,
+        traceId: metadata.traceId
       };
       
       console.log('Typing detected:', {
@@ -103,13 +128,41 @@ class ElectronApp {
         this.mainWindow.webContents.send(IPCChannels.TYPING_EVENT, typingEvent);
       }
       
-      // 위젯 창에도 타이핑 이벤트 전송
+      // 위젯 창은 실시간 상태를 읽을 수 없을 때만 키마다 전송 (시뮬레이션 모드)
       const widgetWindow = windowManager.getWidgetWindow();
-      if (widgetWindow && !widgetWindow.isDestroyed()) {
+      if (!this.liveStateTimer && widgetWindow && !widgetWindow.isDestroyed()) {
+        const sendStart = metadata.traceId ? this.keyboardService!.traceNow() : 0;
         widgetWindow.webContents.send(IPCChannels.TYPING_EVENT, typingEvent);
+        if (metadata.traceId) {
+          this.traceWidgetSend(metadata.traceId, sendStart);
+        }
+      } else if (this.liveStateTimer && metadata.traceId && !this.pendingLiveTrace) {
+        // 실시간 상태 경로: 다음 프레임의 상태에 (그 프레임의 첫) 추적 ID를 실어 보냄
+        this.pendingLiveTrace = { traceId: metadata.traceId, since: this.keyboardService!.traceNow() };
+      }
+    });
+
+    // 타이핑 리듬 이벤트 (몰아치기/멈춤/속도 변화 등 - 분에 몇 번 수준) → 위젯 반응
+    this.keyboardService.on('rhythm', (event: NativeRhythmEvent) => {
+      const widgetWindow = windowManager.getWidgetWindow();
+      if (widgetWindow && !widgetWindow.isDestroyed()) {
+        const reaction: HammyReaction = {
+          type: event.type,
+          timestamp: event.timestamp,
+          value: event.value
+        };
+        widgetWindow.webContents.send(IPCChannels.HAMMY_REACTION, reaction);
       }
     });
 
+    this.keyboardService.on('serviceStarted', () => {
+      this.startLiveStatePump();
+    });
+
+    this.keyboardService.on('serviceStopped', () => {
+      this.stopLiveStatePump();
+    });
+
     // 타이핑 세션 종료 이벤트 (send 사용)
     this.keyboardService.on('typingEnd', (metadata: TypingMetadata) => {
       const typingEvent: TypingEvent = {
@@ -152,6 +205,116 @@ class ElectronApp {
     });
   }
 
+  /**
+   * 위젯용 실시간 상태 전달 시작 (네이티브 리스너가 동작 중일 때만)
+   * 읽기 비용과 전달 횟수가 화면 갱신 주기로 고정되어 입력 속도와 무관함
+   */
+  private startLiveStatePump(): void {
+    if (this.liveStateTimer || !this.keyboardService?.hasLiveState()) {
+      return;
+    }
+
+    this.lastLiveSequence = -1;
+    this.lastLiveActive = false;
+    this.liveStateTimer = setInterval(() => this.publishLiveState(), this.LIVE_STATE_FRAME_MS);
+  }
+
+  private stopLiveStatePump(): void {
+    if (this.liveStateTimer) {
+      clearInterval(this.liveStateTimer);
+      this.liveStateTimer = null;
+    }
+  }
+
+  private publishLiveState(): void {
+    const widgetWindow = windowManager.getWidgetWindow();
+    if (!widgetWindow || widgetWindow.isDestroyed() || !widgetWindow.isVisible()) {
+      this.pendingLiveTrace = null;
+      return;
+    }
+
+    const state = this.liveStateBuffer;
+    if (!this.keyboardService?.readLiveState(state)) {
+      return;
+    }
+
+    // 새 키 입력이 없고 입력 중/유휴 전환도 없으면 보내지 않음
+    const active = state[LIVE_STATE_ACTIVE] !== 0;
+    if (state[LIVE_STATE_SEQUENCE] === this.lastLiveSequence && active === this.lastLiveActive) {
+      return;
+    }
+    this.lastLiveSequence = state[LIVE_STATE_SEQUENCE];
+    this.lastLiveActive = active;
+
+    const liveState: TypingLiveState = {
+      active,
+      rate: state[LIVE_STATE_RATE],
+      combo: state[LIVE_STATE_COMBO],
+      lastKeyAgeMs: state[LIVE_STATE_LAST_KEY_AGE_MS],
+      lastIntervalMs: state[LIVE_STATE_LAST_INTERVAL_MS]
+    };
+
+    const trace = this.pendingLiveTrace;
+    if (!trace) {
+      widgetWindow.webContents.send(IPCChannels.TYPING_LIVE_STATE, liveState);
+      return;
+    }
+
+    this.pendingLiveTrace = null;
+    liveState.traceId = trace.traceId;
+    const sendStart = this.keyboardService!.traceNow();
+    this.keyboardService!.traceSpan(trace.traceId, 'live-state wait', trace.since, sendStart, { track: 'live-state pump' });
+    widgetWindow.webContents.send(IPCChannels.TYPING_LIVE_STATE, liveState);
+    this.traceWidgetSend(trace.traceId, sendStart);
+  }
+
+  /**
+   * 환경 변수로 지연 추적 켜기 (HAMMY_TRACE=경로, 1이면 사용자 데이터 폴더의 typing-trace-<시각>.json)
+   */
+  private startTraceFromEnv(): void {
+    const target = process.env.HAMMY_TRACE;
+    if (!target || !this.keyboardService) {
+      return;
+    }
+
+    const tracePath = target === '1'
+      ? path.join(app.getPath('userData'), `typing-trace-${Date.now()}.json`)
+      : path.resolve(target);
+    this.keyboardService.startTrace(tracePath);
+  }
+
+  /**
+   * 위젯으로 보낸 IPC 구간 기록 - 위젯이 그린 뒤 보고하면 전달/렌더 구간을 이어 붙임
+   */
+  private traceWidgetSend(traceId: number, sendStart: number): void {
+    const sentAt = this.keyboardService!.traceNow();
+    this.keyboardService!.traceSpan(traceId, 'ipc send', sendStart, sentAt);
+
+    // 위젯이 보고하지 않은 항목 (창이 숨겨짐 등)이 쌓이지 않도록 가장 오래된 것부터 버림
+    if (this.traceSentAt.size >= this.TRACE_MAX_PENDING) {
+      const oldest = this.traceSentAt.keys().next().value;
+      if (oldest !== undefined) {
+        this.traceSentAt.delete(oldest);
+      }
+    }
+    this.traceSentAt.set(traceId, sentAt);
+  }
+
+  private handleTraceRendered(report: TraceRenderReport): void {
+    const sentAt = this.traceSentAt.get(report?.traceId);
+    if (sentAt === undefined || !this.keyboardService ||
+        typeof report.receivedAt !== 'number' || typeof report.renderedAt !== 'number') {
+      return;
+    }
+    this.traceSentAt.delete(report.traceId);
+
+    // 프로세스마다 시각을 따로 재므로 순서가 뒤집힌 만큼은 0으로 맞춤
+    const receivedAt = Math.max(sentAt, report.receivedAt);
+    const renderedAt = Math.max(receivedAt, report.renderedAt);
+    this.keyboardService.traceSpan(report.traceId, 'ipc delivery', sentAt, receivedAt, { track: 'widget ipc' });
+    this.keyboardService.traceSpan(report.traceId, 'render', receivedAt, renderedAt, { track: 'widget renderer', end: true });
+  }
+
   private setupIPC(): void {
     // Test IPC communication
     ipcMain.handle(IPCChannels.PING, async () => {
@@ -198,6 +361,11 @@ class ElectronApp {
       // TODO: Implement dashboard window closing
     });
 
+    // 지연 추적: 위젯이 추적 ID가 붙은 상태를 그린 뒤 보내는 보고
+    ipcMain.on(IPCChannels.TRACE_RENDERED, (_, report: TraceRenderReport) => {
+      this.handleTraceRendered(report);
+    });
+
     // Handle typing events (will be implemented in future tasks)
     ipcMain.on(IPCChannels.TYPING_EVENT, (_, event) => {
       console.log('Typing event received:', event);
@@ -1,5 +1,5 @@
 import { contextBridge, ipcRenderer } from 'electron';
-import { IPCChannels, TypingEvent } from '../shared/types';
+import { IPCChannels, TypingEvent, TypingLiveState, TraceRenderReport } from '../shared/types';
 
 // Expose safe Node.js APIs
 contextBridge.exposeInMainWorld('nodeAPI', {
@@ -48,6 +48,15 @@ contextBridge.exposeInMainWorld('electronAPI', {
     ipcRenderer.on(IPCChannels.TYPING_SESSION_END, (_, event) => callback(event));
   },
 
+  // 실시간 타이핑 상태 (네이티브 리스너가 동작 중일 때 키 이벤트 대신 위젯에 전달)
+  onTypingLiveState: (callback: (state: TypingLiveState) => void) => {
+    ipcRenderer.on(IPCChannels.TYPING_LIVE_STATE, (_, state) => callback(state));
+  },
+
+  // 지연 추적: 추적 ID가 붙은 상태를 그린 뒤 보고 (추적 중일 때만 호출됨)
+  reportTraceRendered: (report: TraceRenderReport) =>
+    ipcRenderer.send(IPCChannels.TRACE_RENDERED, report),
+
   // Listen for Hammy reactions
   onHammyReaction: (callback: (reaction: any) => void) => {
     ipcRenderer.on(IPCChannels.HAMMY_REACTION, (_, reaction) => callback(reaction));
@@ -1,6 +1,7 @@
 import { EventEmitter } from 'events';
+import { performance } from 'perf_hooks';
 import { NativeKeyboardListener } from './native';
-import { NativeKeyEvent } from './native/types';
+import { IntervalStatsSnapshot, NativeRhythmEvent, TraceSpanOptions, TraceSummary } from './native/types';
 import { dataManager } from './database/DataManager';
 
 export interface TypingMetadata {
@@ -9,6 +10,8 @@ export interface TypingMetadata {
     interval: number;
     isActive: boolean;
     sessionId: string;
+    appId?: number;     // 네이티브 세션 레코드만 (getAppTable().names 색인, 0 = 알 수 없음)
+    traceId?: number;   // 지연 추적 중인 네이티브 레코드만 (traceSpan으로 구간을 이어 붙임)
 }
 
 export class KeyboardService extends EventEmitter {
@@ -21,6 +24,9 @@ export class KeyboardService extends EventEmitter {
     private readonly TYPING_TIMEOUT = 2000; // 2초 후 타이핑 세션 종료
     private simulationInterval: NodeJS.Timeout | null = null;
     private isSimulationMode: boolean = false;
+    private rhythmSubscription: number | null = null;
+    private traceFlushTimer: NodeJS.Timeout | null = null;
+    private readonly TRACE_FLUSH_INTERVAL = 250; // 스레드별 추적 버퍼가 넘치기 전에 파일로 씀
 
     constructor() {
         super();
@@ -32,16 +38,28 @@ export class KeyboardService extends EventEmitter {
         return `session_${Date.now()}_${Math.random().toString(36).substring(2, 11)}`;
     }
 
-    private handleNativeKeyEvent(event: NativeKeyEvent): void {
-        // 키를 누를 때만 처리 (키를 뗄 때는 무시)
-        if (!event.isKeyDown) return;
-
-        // 특수 키는 무시 (프라이버시 보호)
-        if (event.isSpecialKey) return;
-
-        this.handleKeyPress(event.timestamp);
+    /**
+     * 네이티브 세션 단계에서 전달된 레코드 처리
+     * 세션/간격 계산과 유휴 타임아웃 감지는 네이티브에서 수행됨
+     */
+    private handleNativeTypingRecord(metadata: TypingMetadata): void {
+        this.sessionId = metadata.sessionId;
+
+        if (metadata.isActive) {
+            this.keyCount = metadata.keyCount;
+            this.lastKeyTime = metadata.timestamp;
+            this.dispatchTyping(metadata, true);
+        } else {
+            // 종료된 세션의 간격 통계 (다음 세션 레코드가 처리되기 전에 동기적으로 조회)
+            this.dispatchSessionEnd(metadata, this.nativeListener.getSessionStats());
+            this.keyCount = 0;
+            this.lastKeyTime = 0;
+        }
     }
 
+    /**
+     * 시뮬레이션 모드용 키 입력 처리 (네이티브 세션 단계를 거치지 않음)
+     */
     private handleKeyPress(timestamp?: number): void {
         const currentTime = timestamp || Date.now();
         const interval = this.lastKeyTime > 0 ? currentTime - this.lastKeyTime : 0;
@@ -63,13 +81,7 @@ export class KeyboardService extends EventEmitter {
             sessionId: this.sessionId
         };
 
-        // 데이터베이스에 타이핑 이벤트 저장
-        dataManager.handleTypingEvent(metadata).catch(error => {
-            console.error('Failed to save typing event to database:', error);
-        });
-
-        // 타이핑 이벤트 발생
-        this.emit('typing', metadata);
+        this.dispatchTyping(metadata);
 
         // 타이핑 세션 종료 타이머 설정
         this.typingTimeout = setTimeout(() => {
@@ -86,12 +98,7 @@ export class KeyboardService extends EventEmitter {
             sessionId: this.sessionId
         };
 
-        // 데이터베이스에 세션 종료 저장
-        dataManager.handleSessionEnd(endMetadata).catch(error => {
-            console.error('Failed to save session end to database:', error);
-        });
-
-        this.emit('typingEnd', endMetadata);
+        this.dispatchSessionEnd(endMetadata);
 
         // 새로운 세션 시작 준비
         this.keyCount = 0;
@@ -99,6 +106,29 @@ export class KeyboardService extends EventEmitter {
         this.sessionId = this.generateSessionId();
     }
 
+    private dispatchTyping(metadata: TypingMetadata, fromNative: boolean = false): void {
+        // 데이터베이스에 타이핑 이벤트 저장 (네이티브 레코드는 저널을 거쳐 일괄 반영)
+        dataManager.handleTypingEvent(metadata, fromNative).catch(error => {
+            console.error('Failed to save typing event to database:', error);
+        });
+
+        // 타이핑 이벤트 발생 (추적 중이면 리스너 실행 전체를 한 구간으로 기록)
+        const emitStart = metadata.traceId ? this.traceNow() : 0;
+        this.emit('typing', metadata);
+        if (metadata.traceId) {
+            this.traceSpan(metadata.traceId, 'emit typing', emitStart);
+        }
+    }
+
+    private dispatchSessionEnd(metadata: TypingMetadata, intervalStats?: IntervalStatsSnapshot): void {
+        // 데이터베이스에 세션 종료 저장
+        dataManager.handleSessionEnd(metadata, intervalStats).catch(error => {
+            console.error('Failed to save session end to database:', error);
+        });
+
+        this.emit('typingEnd', metadata);
+    }
+
     public startListening(): void {
         if (this.isListening) return;
 
@@ -126,15 +156,20 @@ export class KeyboardService extends EventEmitter {
                 return;
             }
 
-            // 네이티브 키보드 리스너 시작
-            const success = this.nativeListener.startListening((event: NativeKeyEvent) => {
-                this.handleNativeKeyEvent(event);
-            });
+            // 네이티브 키보드 리스너 시작 (세션 추적은 네이티브에서 수행)
+            const success = this.nativeListener.startTypingSessions(
+                (metadata: TypingMetadata) => {
+                    this.handleNativeTypingRecord(metadata);
+                },
+                { idleTimeoutMs: this.TYPING_TIMEOUT }
+            );
 
             if (!success) {
                 throw new Error('Failed to start native keyboard listener');
             }
 
+            this.startRhythmEvents();
+
             this.isListening = true;
             console.log('Native keyboard service started successfully');
             this.emit('serviceStarted');
@@ -159,7 +194,8 @@ export class KeyboardService extends EventEmitter {
             if (this.isSimulationMode) {
                 this.stopSimulationMode();
             } else {
-                // 네이티브 리스너 중지
+                // 네이티브 리스너 중지 (리듬 구독은 같은 후킹을 공유하므로 먼저 해제)
+                this.stopRhythmEvents();
                 this.nativeListener.stopListening();
             }
 
@@ -172,6 +208,32 @@ export class KeyboardService extends EventEmitter {
         }
     }
 
+    /**
+     * 네이티브 리듬 구독 시작 - 몰아치기/멈춤/속도 변화 같은 의미 이벤트만 'rhythm'으로 전달
+     * 실패해도 타이핑 추적에는 영향이 없으므로 경고만 남김
+     */
+    private startRhythmEvents(): void {
+        try {
+            this.rhythmSubscription = this.nativeListener.subscribe(
+                'rhythm',
+                (event: NativeRhythmEvent) => {
+                    this.emit('rhythm', event);
+                },
+                { idleTimeoutMs: this.TYPING_TIMEOUT }
+            );
+        } catch (error) {
+            console.warn('Failed to start native rhythm events:', error);
+            this.rhythmSubscription = null;
+        }
+    }
+
+    private stopRhythmEvents(): void {
+        if (this.rhythmSubscription !== null) {
+            this.nativeListener.unsubscribe(this.rhythmSubscription);
+            this.rhythmSubscription = null;
+        }
+    }
+
     public isActive(): boolean {
         return this.isListening && (this.isSimulationMode || this.nativeListener.isListening());
     }
@@ -184,6 +246,85 @@ export class KeyboardService extends EventEmitter {
         return this.keyCount;
     }
 
+    /**
+     * 네이티브 실시간 상태를 쓸 수 있는지 (시뮬레이션 모드에서는 키 이벤트로만 전달)
+     */
+    public hasLiveState(): boolean {
+        return this.isListening && !this.isSimulationMode;
+    }
+
+    /**
+     * 실시간 타이핑 상태를 호출자 버퍼에 채움 (LIVE_STATE_* 인덱스)
+     * 네이티브 상태를 쓸 수 없으면 false
+     */
+    public readLiveState(buffer: Float64Array): boolean {
+        if (!this.hasLiveState()) {
+            return false;
+        }
+        try {
+            this.nativeListener.readSnapshot(buffer);
+            return true;
+        } catch (error) {
+            return false;
+        }
+    }
+
+    /**
+     * 지연 추적 시작 - 키 입력 → 후킹 → 링 → JS 호출 → 'typing' → IPC → 위젯 렌더 구간을 path에 기록
+     * (Chrome trace-event JSON - chrome://tracing, ui.perfetto.dev에서 열림)
+     */
+    public startTrace(path: string): boolean {
+        try {
+            if (!this.nativeListener.startTrace(path)) {
+                return false;
+            }
+        } catch (error) {
+            console.warn('Failed to start latency trace:', error);
+            return false;
+        }
+
+        this.traceFlushTimer = setInterval(() => {
+            this.nativeListener.flushTrace();
+        }, this.TRACE_FLUSH_INTERVAL);
+        console.log('Latency trace started:', path);
+        return true;
+    }
+
+    public stopTrace(): TraceSummary | null {
+        if (!this.traceFlushTimer) {
+            return null;
+        }
+        clearInterval(this.traceFlushTimer);
+        this.traceFlushTimer = null;
+
+        const summary = this.nativeListener.stopTrace();
+        if (summary) {
+            console.log(`Latency trace written: ${summary.path} (${summary.events} spans, ${summary.dropped} dropped)`);
+        }
+        return summary;
+    }
+
+    public isTracing(): boolean {
+        return this.traceFlushTimer !== null;
+    }
+
+    /**
+     * 추적 구간 시각 (epoch ms, 소수점 이하 포함 - 렌더러의 performance 시각과 같은 축)
+     */
+    public traceNow(): number {
+        return performance.timeOrigin + performance.now();
+    }
+
+    /**
+     * 추적 ID가 붙은 키 입력의 JS 쪽 구간 기록 (endMs 생략 시 지금까지)
+     */
+    public traceSpan(traceId: number, name: string, startMs: number, endMs?: number, options?: TraceSpanOptions): void {
+        if (!this.traceFlushTimer) {
+            return;
+        }
+        this.nativeListener.traceSpan(traceId, name, startMs, endMs ?? this.traceNow(), options);
+    }
+
     public checkPermissions() {
         return this.nativeListener.checkPermissions();
     }
@@ -228,6 +369,7 @@ export class KeyboardService extends EventEmitter {
     }
 
     public destroy(): void {
+        this.stopTrace();
         this.stopListening();
         this.stopSimulationMode();
         this.removeAllListeners();
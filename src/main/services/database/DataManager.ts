@@ -3,7 +3,13 @@ import { TypingSession } from './models/TypingSession';
 import { TypingEvent } from './models/TypingEvent';
 import { DailyStats } from './models/DailyStats';
 import { AppSettings } from './models/AppSettings';
+import { eventJournal } from './EventJournal';
+import { statsRollup } from './StatsRollup';
+import { statsSnapshot } from './StatsSnapshot';
+import { timeIndex } from './TimeIndex';
+import { typingArchive } from './TypingArchive';
 import { TypingMetadata } from '../KeyboardService';
+import { IntervalStatsSnapshot } from '../native/types';
 
 /**
  * 데이터 관리자 - 키보드 서비스와 데이터베이스 간의 중간 계층
@@ -12,10 +18,13 @@ export class DataManager {
     private currentSessionId: string | null = null;
     private sessionStartTime: number = 0;
     private sessionKeyCount: number = 0;
-    private sessionIntervals: number[] = [];
+    // 간격은 합계/개수만 유지 (분위수는 네이티브 고정 메모리 통계에서 제공)
+    private sessionIntervalSum: number = 0;
+    private sessionIntervalCount: number = 0;
+    private initializing: Promise<void>;
 
     constructor() {
-        this.initialize();
+        this.initializing = this.initialize();
     }
 
     /**
@@ -23,11 +32,41 @@ export class DataManager {
      */
     private async initialize(): Promise<void> {
         try {
+            // 빠른 시작 스냅샷 - DB를 열기 전에 지난 누적을 읽어 오늘 통계를 바로 제공
+            statsSnapshot.load();
+
             await databaseService.initialize();
-            console.log('DataManager initialized successfully');
             
-            // 앱 시작 시 오늘 통계 업데이트
-            await this.updateTodayStats();
+            // 타이핑 이벤트 저널 (네이티브 모듈이 없으면 이벤트마다 직접 INSERT)
+            if (eventJournal.open()) {
+                eventJournal.startCompactor();
+            }
+
+            // 시간 버킷 색인의 지난 기록 채우기 (증분이 처음 반영되기 전이어야 이후 행을 두 번 세지 않음)
+            await timeIndex.load().catch(error => {
+                console.error('Failed to load time bucket index:', error);
+            });
+
+            // 일별/시간별 통계 증분 반영 (세션마다 SQL로 다시 계산하지 않음)
+            statsRollup.start();
+
+            // 스냅샷 누적을 DB 값으로 보정 (백그라운드) 후 주기적으로 저장
+            if (statsSnapshot.isAvailable()) {
+                statsSnapshot.start();
+                statsSnapshot.reconcile().catch(error => {
+                    console.error('Failed to reconcile stats snapshot:', error);
+                });
+            }
+
+            // 지난 날짜의 이벤트를 압축 아카이브로 옮김 (남은 저널 세그먼트가 반영된 뒤)
+            if (typingArchive.open()) {
+                eventJournal.compact()
+                    .then(() => typingArchive.archiveClosedDays())
+                    .catch(error => {
+                        console.error('Failed to archive typing events:', error);
+                    });
+            }
+            console.log('DataManager initialized successfully');
         } catch (error) {
             console.error('Failed to initialize DataManager:', error);
             throw error;
@@ -36,14 +75,35 @@ export class DataManager {
 
     /**
      * 타이핑 이벤트 처리 (KeyboardService에서 호출)
+     * fromNative가 true이고 저널이 열려 있으면 이벤트는 이미 네이티브 저널에 기록되었으므로
+     * 세션 시작/종료만 DB에 쓰고 이벤트 행은 압축기가 일괄 반영
      */
-    public async handleTypingEvent(metadata: TypingMetadata): Promise<void> {
+    public async handleTypingEvent(metadata: TypingMetadata, fromNative: boolean = false): Promise<void> {
+        const journaled = fromNative && eventJournal.isOpen();
+
         try {
             // 새로운 세션 시작
             if (metadata.sessionId !== this.currentSessionId) {
                 await this.startNewSession(metadata);
             }
 
+            // 세션 정보 업데이트
+            this.sessionKeyCount = metadata.keyCount;
+            if (metadata.interval > 0) {
+                this.sessionIntervalSum += metadata.interval;
+                this.sessionIntervalCount++;
+            }
+
+            // 네이티브 레코드는 네이티브 쪽에서 이미 통계 증분에 반영됨
+            if (!fromNative) {
+                statsRollup.add(metadata);
+                timeIndex.add(metadata);
+            }
+
+            if (journaled) {
+                return;
+            }
+
             // 타이핑 이벤트 저장
             await TypingEvent.create({
                 session_id: metadata.sessionId,
@@ -53,12 +113,6 @@ export class DataManager {
                 is_active: metadata.isActive
             });
 
-            // 세션 정보 업데이트
-            this.sessionKeyCount = metadata.keyCount;
-            if (metadata.interval > 0) {
-                this.sessionIntervals.push(metadata.interval);
-            }
-
             // 진행 중인 세션 업데이트
             await this.updateCurrentSession(metadata);
 
@@ -70,8 +124,9 @@ export class DataManager {
 
     /**
      * 타이핑 세션 종료 처리
+     * intervalStats가 있으면 (네이티브 세션 추적) 평균과 분위수를 함께 기록
      */
-    public async handleSessionEnd(metadata: TypingMetadata): Promise<void> {
+    public async handleSessionEnd(metadata: TypingMetadata, intervalStats?: IntervalStatsSnapshot): Promise<void> {
         if (!this.currentSessionId || this.currentSessionId !== metadata.sessionId) {
             return;
         }
@@ -79,9 +134,9 @@ export class DataManager {
         try {
             const endTime = metadata.timestamp;
             const duration = endTime - this.sessionStartTime;
-            const averageInterval = this.sessionIntervals.length > 0
-                ? this.sessionIntervals.reduce((sum, interval) => sum + interval, 0) / this.sessionIntervals.length
-                : 0;
+            const averageInterval = intervalStats && intervalStats.count > 0
+                ? intervalStats.mean
+                : this.getAverageInterval();
 
             // 세션 종료 처리
             await TypingSession.endSession(
@@ -89,16 +144,14 @@ export class DataManager {
                 endTime,
                 this.sessionKeyCount,
                 duration,
-                averageInterval
+                averageInterval,
+                intervalStats && intervalStats.count > 0 ? intervalStats : undefined
             );
 
             console.log(`Session ended: ${metadata.sessionId}, Duration: ${duration}ms, Keys: ${this.sessionKeyCount}`);
 
             // 세션 정보 초기화
             this.resetSessionData();
-
-            // 오늘 통계 업데이트
-            await this.updateTodayStats();
         } catch (error) {
             console.error('Failed to handle session end:', error);
         }
@@ -126,7 +179,8 @@ export class DataManager {
         this.currentSessionId = metadata.sessionId;
         this.sessionStartTime = metadata.timestamp;
         this.sessionKeyCount = 0;
-        this.sessionIntervals = [];
+        this.sessionIntervalSum = 0;
+        this.sessionIntervalCount = 0;
 
         console.log(`New session started: ${metadata.sessionId}`);
     }
@@ -137,9 +191,7 @@ export class DataManager {
     private async updateCurrentSession(metadata: TypingMetadata): Promise<void> {
         if (!this.currentSessionId) return;
 
-        const averageInterval = this.sessionIntervals.length > 0
-            ? this.sessionIntervals.reduce((sum, interval) => sum + interval, 0) / this.sessionIntervals.length
-            : 0;
+        const averageInterval = this.getAverageInterval();
 
         await TypingSession.updateKeyCount(
             this.currentSessionId,
@@ -156,9 +208,7 @@ export class DataManager {
 
         const endTime = Date.now();
         const duration = endTime - this.sessionStartTime;
-        const averageInterval = this.sessionIntervals.length > 0
-            ? this.sessionIntervals.reduce((sum, interval) => sum + interval, 0) / this.sessionIntervals.length
-            : 0;
+        const averageInterval = this.getAverageInterval();
 
         await TypingSession.endSession(
             this.currentSessionId,
@@ -178,18 +228,17 @@ export class DataManager {
         this.currentSessionId = null;
         this.sessionStartTime = 0;
         this.sessionKeyCount = 0;
-        this.sessionIntervals = [];
+        this.sessionIntervalSum = 0;
+        this.sessionIntervalCount = 0;
     }
 
     /**
-     * 오늘 통계 업데이트
+     * 현재 세션 평균 간격
      */
-    private async updateTodayStats(): Promise<void> {
-        try {
-            await DailyStats.updateTodayStats();
-        } catch (error) {
-            console.error('Failed to update today stats:', error);
-        }
+    private getAverageInterval(): number {
+        return this.sessionIntervalCount > 0
+            ? this.sessionIntervalSum / this.sessionIntervalCount
+            : 0;
     }
 
     /**
@@ -197,20 +246,47 @@ export class DataManager {
      */
     public async getStats(period: 'today' | 'week' | 'month' = 'today'): Promise<any> {
         try {
-            const today = new Date().toISOString().split('T')[0];
+            // DB가 준비되어 보정될 때까지 오늘 통계는 스냅샷에서 이어받은 네이티브 누적으로 바로 응답
+            if (period === 'today' && statsSnapshot.isServing()) {
+                return statsSnapshot.getTodayStats();
+            }
+
+            // 초기화(시간 버킷 색인 채우기 포함)가 끝나기 전에 증분을 반영하지 않음
+            await this.initializing.catch(() => undefined);
+
+            const today = DailyStats.localDate();
+            const weekStart = new Date();
+            weekStart.setDate(weekStart.getDate() - 6);
+            const now = new Date();
+
+            // 시간 버킷 색인 - 구간 합 O(log n), SQLite를 거치지 않음
+            if (timeIndex.isReady()) {
+                switch (period) {
+                    case 'today':
+                        return timeIndex.getDailyStats(today);
+                    case 'week':
+                        return await timeIndex.getPeriodStats(DailyStats.localDate(weekStart.getTime()), 7);
+                    case 'month':
+                        return await timeIndex.getMonthlyStats(now.getFullYear(), now.getMonth() + 1);
+                    default:
+                        return null;
+                }
+            }
+
+            // 쌓인 증분을 먼저 반영 (갱신된 날짜/시간 행 수만큼의 upsert)
+            await statsRollup.flush().catch(error => {
+                console.error('Failed to flush stats rollup:', error);
+            });
 
             switch (period) {
                 case 'today':
                     return await DailyStats.findByDate(today);
                 
                 case 'week':
-                    const weekStart = new Date();
-                    weekStart.setDate(weekStart.getDate() - 6);
                     const weekStartStr = weekStart.toISOString().split('T')[0];
                     return await DailyStats.getWeeklyStats(weekStartStr);
                 
                 case 'month':
-                    const now = new Date();
                     return await DailyStats.getMonthlyStats(now.getFullYear(), now.getMonth() + 1);
                 
                 default:
@@ -269,12 +345,15 @@ export class DataManager {
     public async cleanupOldData(): Promise<void> {
         try {
             const retentionDays = await AppSettings.getNumber('data_retention_days', 365);
+
+            // 보존 기간이 지난 이벤트도 이력으로 남도록 삭제 전에 아카이브로 옮김
+            const archivedEvents = await typingArchive.archiveClosedDays();
             
             const deletedSessions = await TypingSession.deleteOldSessions(retentionDays);
             const deletedEvents = await TypingEvent.deleteOldEvents(retentionDays);
             const deletedStats = await DailyStats.deleteOldStats(retentionDays);
 
-            console.log(`Data cleanup completed: ${deletedSessions} sessions, ${deletedEvents} events, ${deletedStats} stats deleted`);
+            console.log(`Data cleanup completed: ${archivedEvents} events archived, ${deletedSessions} sessions, ${deletedEvents} events, ${deletedStats} stats deleted`);
         } catch (error) {
             console.error('Failed to cleanup old data:', error);
         }
@@ -337,6 +416,18 @@ export class DataManager {
                 await this.forceEndCurrentSession();
             }
 
+            // 남은 통계 증분 반영
+            await statsRollup.close();
+
+            // 반영이 끝난 누적을 스냅샷으로 저장 (다음 시작 시 바로 제공)
+            statsSnapshot.close();
+
+            // 저널을 닫고 남은 이벤트 반영
+            await eventJournal.close();
+
+            // 실행 중인 보관이 끝난 뒤 아카이브 닫기
+            await typingArchive.close();
+
             // 데이터베이스 연결 종료
             await databaseService.close();
             console.log('DataManager shutdown completed');
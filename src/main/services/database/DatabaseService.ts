@@ -13,6 +13,8 @@ export class DatabaseService {
     private db: sqlite3.Database | null = null;
     private dbPath: string;
     private isInitialized: boolean = false;
+    // 이전 트랜잭션이 끝난 뒤 다음 트랜잭션을 시작하도록 잇는 대기열 (연결 하나를 공유하므로 겹치면 안 됨)
+    private transactionQueue: Promise<void> = Promise.resolve();
 
     constructor(config: DatabaseConfig = {}) {
         // 데이터베이스 파일 경로 설정 (사용자 데이터 디렉토리)
@@ -70,6 +72,9 @@ export class DatabaseService {
         // 스키마 생성
         await this.createTables();
         
+        // 기존 데이터베이스 스키마 보강
+        await this.migrateSchema();
+        
         // 인덱스 생성
         await this.createIndexes();
         
@@ -91,6 +96,9 @@ export class DatabaseService {
                 total_keys INTEGER DEFAULT 0,
                 duration INTEGER DEFAULT 0,
                 average_interval REAL DEFAULT 0,
+                interval_p50 REAL,
+                interval_p90 REAL,
+                interval_p99 REAL,
                 created_at INTEGER DEFAULT (strftime('%s', 'now'))
             )`,
 
@@ -165,6 +173,31 @@ export class DatabaseService {
         console.log('Database tables created successfully');
     }
 
+    /**
+     * 스키마 마이그레이션 (이전 버전에서 생성된 테이블에 누락된 컬럼 추가)
+     */
+    private async migrateSchema(): Promise<void> {
+        const migrations: Array<[string, string, string]> = [
+            ['typing_sessions', 'interval_p50', 'REAL'],
+            ['typing_sessions', 'interval_p90', 'REAL'],
+            ['typing_sessions', 'interval_p99', 'REAL'],
+            // 통계 증분 집계의 간격 적률 (ms 합/제곱합 - 더하기만으로 병합 가능)
+            ['daily_stats', 'interval_count', 'INTEGER DEFAULT 0'],
+            ['daily_stats', 'interval_sum', 'REAL DEFAULT 0'],
+            ['daily_stats', 'interval_sum_sq', 'REAL DEFAULT 0'],
+            ['hourly_stats', 'interval_count', 'INTEGER DEFAULT 0'],
+            ['hourly_stats', 'interval_sum', 'REAL DEFAULT 0'],
+            ['hourly_stats', 'interval_sum_sq', 'REAL DEFAULT 0']
+        ];
+
+        for (const [table, column, type] of migrations) {
+            const columns = await this.all(`PRAGMA table_info(${table})`);
+            if (!columns.some((info: { name: string }) => info.name === column)) {
+                await this.run(`ALTER TABLE ${table} ADD COLUMN ${column} ${type}`);
+            }
+        }
+    }
+
     /**
      * 인덱스 생성
      */
@@ -285,8 +318,17 @@ export class DatabaseService {
 
     /**
      * 트랜잭션 실행
+     * 연결 하나를 공유하므로 호출 순서대로 하나씩 실행 (겹치면 두 번째 BEGIN이 실패하고
+     * 그 ROLLBACK이 앞 트랜잭션까지 되돌림) - operations 안에서 transaction을 다시 부르면 안 됨
      */
-    public async transaction(operations: () => Promise<void>): Promise<void> {
+    public transaction(operations: () => Promise<void>): Promise<void> {
+        const result = this.transactionQueue.then(() => this.runTransaction(operations));
+        // 실패한 트랜잭션이 뒤 트랜잭션을 막지 않도록 대기열에는 완료만 남김
+        this.transactionQueue = result.catch(() => undefined);
+        return result;
+    }
+
+    private async runTransaction(operations: () => Promise<void>): Promise<void> {
         await this.run('BEGIN TRANSACTION');
         
         try {
@@ -0,0 +1,206 @@
+import * as path from 'path';
+import { databaseService } from './DatabaseService';
+import { AppSettings } from './models/AppSettings';
+import { nativeKeyboardListener } from '../native';
+import { JournalRecords } from '../native/types';
+
+// 봉인 세그먼트를 DB로 옮기는 주기
+const COMPACT_INTERVAL_MS = 60 * 1000;
+
+// 다중 행 INSERT 한 번에 넣는 행 수 (SQLite 바인딩 변수 제한 999 이하 유지)
+const INSERT_CHUNK_ROWS = 150;
+
+// 압축 진행 상태 (app_settings) - DB 반영과 같은 트랜잭션에 기록하므로 세그먼트 삭제 전에 종료되어도
+// 다음 실행이 같은 세그먼트를 typing_events에 다시 넣지 않고 삭제만 함
+const COMPACT_STATE_KEY = 'journal_compact_state';
+
+// 반영했지만 삭제를 확인하지 못한 세그먼트
+// 저널 디렉터리가 비면 세그먼트 ID를 1부터 다시 쓰므로 첫 레코드 시각과 레코드 수로 함께 식별
+interface CompactedSegment {
+    segmentId: number;
+    firstTimestamp: number;
+    count: number;
+}
+
+/**
+ * 타이핑 이벤트 저널 - 네이티브 메모리 매핑 저널과 압축기
+ * 키 입력마다 typing_events에 INSERT하는 대신 네이티브 저널에 기록하고,
+ * 봉인된 세그먼트를 주기적으로 한 트랜잭션에 모아 typing_events에 반영
+ */
+export class EventJournal {
+    private journalOpen: boolean = false;
+    private compactTimer: NodeJS.Timeout | null = null;
+    private compacting: Promise<void> | null = null;
+
+    /**
+     * 저널 열기 (네이티브 모듈이 없으면 false - 기존 SQLite 경로 사용)
+     */
+    public open(directory: string = path.join(path.dirname(databaseService.getDatabasePath()), 'journal')): boolean {
+        try {
+            this.journalOpen = nativeKeyboardListener.openJournal(directory);
+        } catch (error) {
+            console.warn('Event journal unavailable, falling back to direct inserts:', error);
+            this.journalOpen = false;
+        }
+
+        if (this.journalOpen) {
+            console.log(`Event journal opened: ${directory}`);
+        }
+        return this.journalOpen;
+    }
+
+    public isOpen(): boolean {
+        return this.journalOpen;
+    }
+
+    /**
+     * 압축기 시작 (이전 실행에서 남은 세그먼트도 바로 반영)
+     */
+    public startCompactor(intervalMs: number = COMPACT_INTERVAL_MS): void {
+        if (this.compactTimer || !this.journalOpen) return;
+
+        this.compact().catch(error => {
+            console.error('Failed to compact event journal:', error);
+        });
+
+        this.compactTimer = setInterval(() => {
+            this.compact().catch(error => {
+                console.error('Failed to compact event journal:', error);
+            });
+        }, intervalMs);
+    }
+
+    /**
+     * [start, end) 시각 범위의 저널 레코드 조회 (아직 DB에 반영되지 않은 레코드 포함)
+     */
+    public range(start: number, end: number): JournalRecords | null {
+        if (!this.journalOpen) return null;
+        return nativeKeyboardListener.journalRange(start, end);
+    }
+
+    /**
+     * 봉인된 세그먼트를 typing_events에 반영하고 삭제
+     * 세그먼트 하나당 트랜잭션 하나 - 반영에 실패한 세그먼트는 남겨 두고 다음 주기에 다시 시도
+     */
+    public compact(): Promise<void> {
+        if (!this.compacting) {
+            this.compacting = this.compactSealedSegments().then(
+                () => {
+                    this.compacting = null;
+                },
+                error => {
+                    this.compacting = null;
+                    throw error;
+                }
+            );
+        }
+        return this.compacting;
+    }
+
+    private async compactSealedSegments(): Promise<void> {
+        const sealed = nativeKeyboardListener.journalSealedSegments();
+        if (sealed.length === 0) return;
+
+        // 지난 실행에서 반영만 하고 삭제하지 못한 세그먼트 (디스크에서 사라진 항목은 다음 기록 때 정리)
+        const saved = await AppSettings.getJSON<CompactedSegment[]>(COMPACT_STATE_KEY, []);
+        let compacted = (saved || []).filter(entry => sealed.indexOf(entry.segmentId) !== -1);
+
+        for (const segmentId of sealed) {
+            const records = nativeKeyboardListener.journalReadSegment(segmentId);
+
+            if (!records) {
+                console.warn(`Discarding unreadable journal segment ${segmentId}`);
+                nativeKeyboardListener.journalReleaseSegment(segmentId);
+                continue;
+            }
+
+            if (records.count > 0) {
+                const segment: CompactedSegment = { segmentId, firstTimestamp: records.timestamps[0], count: records.count };
+                const applied = compacted.some(entry =>
+                    entry.segmentId === segment.segmentId &&
+                    entry.firstTimestamp === segment.firstTimestamp &&
+                    entry.count === segment.count
+                );
+
+                if (applied) {
+                    nativeKeyboardListener.journalReleaseSegment(segmentId);
+                    console.log(`Journal segment ${segmentId} was already compacted, released`);
+                    continue;
+                }
+
+                const next = [...compacted, segment];
+                await databaseService.transaction(async () => {
+                    await this.insertRecords(records);
+                    await AppSettings.set(COMPACT_STATE_KEY, next, 'json', '타이핑 이벤트 저널 압축 진행 상태');
+                });
+                compacted = next;
+            }
+
+            nativeKeyboardListener.journalReleaseSegment(segmentId);
+            console.log(`Journal segment ${segmentId} compacted: ${records.count} events`);
+        }
+    }
+
+    private async insertRecords(records: JournalRecords): Promise<void> {
+        const sessionIds: string[] = new Array(records.count);
+        const sessionStarts = new Map<string, number>();
+
+        for (let i = 0; i < records.count; i++) {
+            // 네이티브 CreateSessionId(keyboard-native.cc)와 같은 형식
+            const sessionId = `session_${records.sessionStarts[i]}_${records.sessionSeqs[i]}`;
+            sessionIds[i] = sessionId;
+            if (!sessionStarts.has(sessionId)) {
+                sessionStarts.set(sessionId, records.sessionStarts[i]);
+            }
+        }
+
+        // 비정상 종료로 세션 행이 만들어지지 못한 경우에도 외래 키를 만족하도록 보충
+        for (const [sessionId, startTime] of sessionStarts) {
+            await databaseService.run(
+                'INSERT OR IGNORE INTO typing_sessions (session_id, start_time) VALUES (?, ?)',
+                [sessionId, startTime]
+            );
+        }
+
+        for (let offset = 0; offset < records.count; offset += INSERT_CHUNK_ROWS) {
+            const end = Math.min(offset + INSERT_CHUNK_ROWS, records.count);
+            const placeholders: string[] = [];
+            const params: any[] = [];
+
+            for (let i = offset; i < end; i++) {
+                placeholders.push('(?, ?, ?, ?, 1)');
+                params.push(sessionIds[i], records.timestamps[i], records.keyCounts[i], records.intervals[i]);
+            }
+
+            await databaseService.run(
+                `INSERT INTO typing_events (session_id, timestamp, key_count, interval_ms, is_active)
+                 VALUES ${placeholders.join(', ')}`,
+                params
+            );
+        }
+    }
+
+    /**
+     * 압축기 중지 후 저널을 닫고 남은 레코드를 모두 반영
+     */
+    public async close(): Promise<void> {
+        if (this.compactTimer) {
+            clearInterval(this.compactTimer);
+            this.compactTimer = null;
+        }
+
+        if (!this.journalOpen) return;
+
+        nativeKeyboardListener.closeJournal();
+        this.journalOpen = false;
+
+        // 실행 중인 압축이 끝난 뒤 방금 봉인된 세그먼트까지 반영
+        if (this.compacting) {
+            await this.compacting;
+        }
+        await this.compact();
+    }
+}
+
+// 싱글톤 인스턴스
+export const eventJournal = new EventJournal();
@@ -0,0 +1,267 @@
+import { databaseService } from './DatabaseService';
+import { DailyStats } from './models/DailyStats';
+import { nativeKeyboardListener } from '../native';
+import { RollupRow, RunningStats } from '../native/types';
+import { TypingMetadata } from '../KeyboardService';
+
+// 증분을 daily_stats/hourly_stats에 반영하는 주기
+const ROLLUP_FLUSH_INTERVAL_MS = 30 * 1000;
+
+/**
+ * 일별/시간별 통계 증분 집계
+ * 세션이 끝날 때마다 그날의 세션/이벤트를 SQL로 다시 계산하는 대신,
+ * 키 입력마다 O(1)로 더한 증분(네이티브 StatsRollup 또는 JS 경로)을 주기적으로 더하기 upsert로 반영
+ * 반영 비용은 갱신된 날짜/시간 행 수에만 비례하고 쌓인 이력이나 그날의 이벤트 수와 무관
+ */
+export class StatsRollup {
+    private nativeAvailable: boolean = false;
+    private flushTimer: NodeJS.Timeout | null = null;
+    private flushing: Promise<void> | null = null;
+
+    // 아직 DB에 반영되지 않은 증분 (date#hour → 행, 반영에 실패하면 다음 주기에 다시 시도)
+    private pending = new Map<string, RollupRow>();
+
+    /**
+     * 주기적 반영 시작 (네이티브 모듈이 없으면 JS 경로 증분만 반영)
+     */
+    public start(intervalMs: number = ROLLUP_FLUSH_INTERVAL_MS): void {
+        if (this.flushTimer) return;
+
+        try {
+            this.mergeNative();
+            this.nativeAvailable = true;
+        } catch (error) {
+            console.warn('Native stats rollup unavailable, using JS accumulation only:', error);
+            this.nativeAvailable = false;
+        }
+
+        this.flushTimer = setInterval(() => {
+            this.flush().catch(error => {
+                console.error('Failed to flush stats rollup:', error);
+            });
+        }, intervalMs);
+    }
+
+    /**
+     * 네이티브 세션 단계를 거치지 않은 타이핑 이벤트 반영 (시뮬레이션 모드 등)
+     * 네이티브 레코드는 네이티브 쪽에서 이미 집계되므로 넘기지 않아야 함
+     */
+    public add(metadata: TypingMetadata): void {
+        const date = new Date(metadata.timestamp);
+        const row = this.emptyRow(DailyStats.localDate(metadata.timestamp), -1);
+        row.keys = 1;
+        if (metadata.keyCount <= 1) {
+            row.sessions = 1;
+        } else {
+            row.activeMs = metadata.interval;
+            row.intervalCount = 1;
+            row.intervalSum = metadata.interval;
+            row.intervalSumSq = metadata.interval * metadata.interval;
+        }
+
+        this.merge(row);
+        this.merge({ ...row, hour: date.getHours() });
+    }
+
+    /**
+     * 쌓인 증분을 한 트랜잭션으로 반영 (실행 중인 반영이 있으면 끝난 뒤 이어서 실행)
+     */
+    public async flush(): Promise<void> {
+        while (this.flushing) {
+            await this.flushing.catch(() => undefined);
+        }
+
+        this.flushing = this.writePending();
+        try {
+            await this.flushing;
+        } finally {
+            this.flushing = null;
+        }
+    }
+
+    /**
+     * 네이티브 누적 통계(빠른 시작 스냅샷에서 이어받은 값)를 DB 값으로 보정
+     * 증분 반영과 같은 순서로 실행해 takeRollups와 DB 조회 사이에 다른 반영이 끼어들지 않게 함
+     * 날짜가 바뀌어 보정하지 못했으면 false (다음 날짜의 누적은 처음부터 세므로 보정이 필요 없음)
+     */
+    public async reconcileNative(): Promise<boolean> {
+        if (!this.nativeAvailable) return false;
+
+        while (this.flushing) {
+            await this.flushing.catch(() => undefined);
+        }
+
+        let reconciled = false;
+        this.flushing = this.writePending().then(async () => {
+            reconciled = await this.reconcileRunning();
+        });
+        try {
+            await this.flushing;
+        } finally {
+            this.flushing = null;
+        }
+        return reconciled;
+    }
+
+    /**
+     * 주기적 반영 중지 후 남은 증분 반영
+     */
+    public async close(): Promise<void> {
+        if (this.flushTimer) {
+            clearInterval(this.flushTimer);
+            this.flushTimer = null;
+        }
+        await this.flush();
+    }
+
+    private async writePending(): Promise<void> {
+        if (this.nativeAvailable) {
+            this.mergeNative();
+        }
+        if (this.pending.size === 0) return;
+
+        const rows = Array.from(this.pending.values());
+        this.pending.clear();
+
+        try {
+            await databaseService.transaction(async () => {
+                const dates = new Set<string>();
+                for (const row of rows) {
+                    if (row.hour < 0) {
+                        await this.upsertDaily(row);
+                        dates.add(row.date);
+                    } else {
+                        await this.upsertHourly(row);
+                    }
+                }
+
+                // 평균 속도와 가장 활발한 시간은 누적값에서 다시 계산 (날짜당 시간별 행 최대 24개)
+                for (const date of dates) {
+                    await databaseService.run(
+                        `UPDATE daily_stats
+                         SET average_speed = CASE WHEN total_duration > 0
+                                 THEN ROUND(total_keys * 60000.0 / total_duration, 2) ELSE 0 END,
+                             peak_hour = COALESCE((SELECT hour FROM hourly_stats
+                                                   WHERE hourly_stats.date = daily_stats.date
+                                                   ORDER BY key_count DESC, hour ASC LIMIT 1), peak_hour),
+                             updated_at = strftime('%s', 'now')
+                         WHERE date = ?`,
+                        [date]
+                    );
+                }
+            });
+        } catch (error) {
+            for (const row of rows) {
+                this.merge(row);
+            }
+            throw error;
+        }
+    }
+
+    private upsertDaily(row: RollupRow): Promise<unknown> {
+        return databaseService.run(
+            `INSERT INTO daily_stats (date, total_keys, total_sessions, total_duration,
+                                      interval_count, interval_sum, interval_sum_sq)
+             VALUES (?, ?, ?, ?, ?, ?, ?)
+             ON CONFLICT(date) DO UPDATE SET
+                 total_keys = total_keys + excluded.total_keys,
+                 total_sessions = total_sessions + excluded.total_sessions,
+                 total_duration = total_duration + excluded.total_duration,
+                 interval_count = interval_count + excluded.interval_count,
+                 interval_sum = interval_sum + excluded.interval_sum,
+                 interval_sum_sq = interval_sum_sq + excluded.interval_sum_sq`,
+            [row.date, row.keys, row.sessions, row.activeMs, row.intervalCount, row.intervalSum, row.intervalSumSq]
+        );
+    }
+
+    private upsertHourly(row: RollupRow): Promise<unknown> {
+        return databaseService.run(
+            `INSERT INTO hourly_stats (date, hour, key_count, session_count, duration,
+                                       interval_count, interval_sum, interval_sum_sq)
+             VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+             ON CONFLICT(date, hour) DO UPDATE SET
+                 key_count = key_count + excluded.key_count,
+                 session_count = session_count + excluded.session_count,
+                 duration = duration + excluded.duration,
+                 interval_count = interval_count + excluded.interval_count,
+                 interval_sum = interval_sum + excluded.interval_sum,
+                 interval_sum_sq = interval_sum_sq + excluded.interval_sum_sq,
+                 updated_at = strftime('%s', 'now')`,
+            [row.date, row.hour, row.keys, row.sessions, row.activeMs, row.intervalCount, row.intervalSum, row.intervalSumSq]
+        );
+    }
+
+    private async reconcileRunning(): Promise<boolean> {
+        const running = nativeKeyboardListener.getRunningStats();
+        if (!running.date) return false;
+
+        const daily = await DailyStats.findByDate(running.date);
+        const hourly: Array<{ hour: number; key_count: number }> = await databaseService.all(
+            'SELECT hour, key_count FROM hourly_stats WHERE date = ?',
+            [running.date]
+        );
+        const streaks = await DailyStats.getStreaks(running.date);
+
+        const hourKeys = new Array<number>(24).fill(0);
+        for (const row of hourly) {
+            hourKeys[row.hour] = row.key_count;
+        }
+
+        const stored: RunningStats = {
+            date: running.date,
+            keys: daily?.total_keys ?? 0,
+            sessions: daily?.total_sessions ?? 0,
+            activeMs: daily?.total_duration ?? 0,
+            intervalCount: daily?.interval_count ?? 0,
+            intervalSum: daily?.interval_sum ?? 0,
+            intervalSumSq: daily?.interval_sum_sq ?? 0,
+            hourKeys,
+            streakDays: streaks.current,
+            bestStreakDays: streaks.best,
+            session: null
+        };
+        return nativeKeyboardListener.reconcileStats(stored);
+    }
+
+    private mergeNative(): void {
+        const rollups = nativeKeyboardListener.takeRollups();
+        for (const row of rollups.daily) {
+            this.merge(row);
+        }
+        for (const row of rollups.hourly) {
+            this.merge(row);
+        }
+    }
+
+    private merge(row: RollupRow): void {
+        const key = `${row.date}#${row.hour}`;
+        const existing = this.pending.get(key);
+        if (!existing) {
+            this.pending.set(key, { ...row });
+            return;
+        }
+
+        existing.keys += row.keys;
+        existing.sessions += row.sessions;
+        existing.activeMs += row.activeMs;
+        existing.intervalCount += row.intervalCount;
+        existing.intervalSum += row.intervalSum;
+        existing.intervalSumSq += row.intervalSumSq;
+    }
+
+    private emptyRow(date: string, hour: number): RollupRow {
+        return {
+            date,
+            hour,
+            keys: 0,
+            sessions: 0,
+            activeMs: 0,
+            intervalCount: 0,
+            intervalSum: 0,
+            intervalSumSq: 0
+        };
+    }
+}
+
+// 싱글톤 인스턴스
+export const statsRollup = new StatsRollup();
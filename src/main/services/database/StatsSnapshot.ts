@@ -0,0 +1,138 @@
+import * as path from 'path';
+import { databaseService } from './DatabaseService';
+import { DailyStats, DailyStatsData } from './models/DailyStats';
+import { statsRollup } from './StatsRollup';
+import { nativeKeyboardListener } from '../native';
+import { RunningStats } from '../native/types';
+
+// 스냅샷 저장 주기 (종료 시에도 저장)
+const SNAPSHOT_SAVE_INTERVAL_MS = 60 * 1000;
+
+/**
+ * 빠른 시작용 누적 통계 스냅샷
+ * 네이티브 누적(오늘 카운터, 연속 입력 일수, 마지막 세션)을 작은 버전/체크섬 파일로 주기적으로 저장하고,
+ * 시작할 때 DB를 열기 전에 읽어 오늘 통계를 바로 제공 - 첫 통계까지의 시간이 DB 크기와 무관
+ * DB가 준비되면 통계 증분을 반영한 뒤 DB 값으로 보정하고 이후에는 DB에서 조회
+ */
+export class StatsSnapshot {
+    private available: boolean = false;
+    private loaded: boolean = false;
+    private reconciled: boolean = false;
+    private saveTimer: NodeJS.Timeout | null = null;
+
+    /**
+     * 스냅샷 읽기 (네이티브 모듈이 없거나 스냅샷이 없거나 손상되었으면 null - DB에서 조회)
+     */
+    public load(file: string = path.join(path.dirname(databaseService.getDatabasePath()), 'stats.snapshot')): RunningStats | null {
+        let snapshot: RunningStats | null = null;
+        try {
+            snapshot = nativeKeyboardListener.loadStatsSnapshot(file);
+            this.available = true;
+        } catch (error) {
+            console.warn('Stats snapshot unavailable:', error);
+            this.available = false;
+        }
+
+        this.loaded = snapshot !== null;
+        if (snapshot) {
+            console.log(`Stats snapshot loaded: ${snapshot.date}, ${snapshot.keys} keys (saved ${new Date(snapshot.savedAt ?? 0).toISOString()})`);
+        }
+        return snapshot;
+    }
+
+    public isAvailable(): boolean {
+        return this.available;
+    }
+
+    /**
+     * 주기적 저장 시작
+     */
+    public start(intervalMs: number = SNAPSHOT_SAVE_INTERVAL_MS): void {
+        if (this.saveTimer || !this.available) return;
+
+        this.saveTimer = setInterval(() => {
+            this.save();
+        }, intervalMs);
+    }
+
+    /**
+     * DB 값으로 보정 (통계 증분 반영 후) - 이후 오늘 통계는 DB에서 조회
+     */
+    public async reconcile(): Promise<void> {
+        try {
+            if (await statsRollup.reconcileNative()) {
+                console.log('Stats snapshot reconciled with database');
+            }
+        } finally {
+            // 보정에 실패해도 이후에는 DB에서 조회 (스냅샷은 다음 저장 때 현재 누적으로 덮어씀)
+            this.reconciled = true;
+        }
+        this.save();
+    }
+
+    /**
+     * 스냅샷으로 오늘 통계를 제공하는 중인지 (스냅샷을 읽었고 DB 보정 전)
+     */
+    public isServing(): boolean {
+        return this.loaded && !this.reconciled;
+    }
+
+    /**
+     * 네이티브 누적으로 만든 오늘 통계 (daily_stats 행과 같은 형태, 오늘 입력이 없으면 null)
+     */
+    public getTodayStats(date: string = DailyStats.localDate()): DailyStatsData | null {
+        const running = nativeKeyboardListener.getRunningStats();
+        if (running.date !== date || running.keys === 0) {
+            return null;
+        }
+
+        let peakHour = 0;
+        for (let hour = 1; hour < 24; hour++) {
+            if (running.hourKeys[hour] > running.hourKeys[peakHour]) {
+                peakHour = hour;
+            }
+        }
+
+        return {
+            date,
+            total_keys: running.keys,
+            total_sessions: running.sessions,
+            total_duration: Math.round(running.activeMs),
+            average_speed: running.activeMs > 0
+                ? Math.round(running.keys * 60000 / running.activeMs * 100) / 100
+                : 0,
+            peak_hour: peakHour,
+            interval_count: running.intervalCount,
+            interval_sum: running.intervalSum,
+            interval_sum_sq: running.intervalSumSq
+        };
+    }
+
+    /**
+     * 현재 누적을 스냅샷 파일에 저장
+     */
+    public save(): boolean {
+        if (!this.available) return false;
+
+        try {
+            return nativeKeyboardListener.saveStatsSnapshot();
+        } catch (error) {
+            console.error('Failed to save stats snapshot:', error);
+            return false;
+        }
+    }
+
+    /**
+     * 주기적 저장 중지 후 마지막으로 저장 (통계 증분을 반영한 뒤 호출)
+     */
+    public close(): void {
+        if (this.saveTimer) {
+            clearInterval(this.saveTimer);
+            this.saveTimer = null;
+        }
+        this.save();
+    }
+}
+
+// 싱글톤 인스턴스
+export const statsSnapshot = new StatsSnapshot();
@@ -0,0 +1,203 @@
+import { databaseService } from './DatabaseService';
+import { DailyStats, DailyStatsData, PeriodRhythm } from './models/DailyStats';
+import { nativeKeyboardListener } from '../native';
+import { TimeRangeSums } from '../native/types';
+import { TypingMetadata } from '../KeyboardService';
+
+/**
+ * 기간 통계 (getWeeklyStats/getMonthlyStats와 같은 형태)
+ */
+export interface PeriodStats {
+    totalKeys: number;
+    totalSessions: number;
+    totalDuration: number;
+    averageSpeed: number;
+    dailyStats: DailyStatsData[];
+    rhythm: PeriodRhythm | null;
+}
+
+/**
+ * 시간 버킷 색인 - 네이티브 분 단위 Fenwick 트리로 기간 통계 조회
+ * 네이티브 타이핑 레코드는 네이티브 쪽에서 바로 더해지고, 지난 기록은 시작할 때 hourly_stats에서 한 번 채움
+ * 조회는 구간마다 O(log n)이라 대시보드 갱신 비용이 쌓인 이력과 무관하고 SQLite를 거치지 않음
+ */
+export class TimeIndex {
+    private ready: boolean = false;
+
+    /**
+     * 지난 기록을 DB에서 채움 (통계 증분이 처음 반영되기 전에 한 번 - 이후 행은 색인에 이미 더해져 있음)
+     * 네이티브 모듈이 없으면 false (SQL로 조회)
+     */
+    public async load(): Promise<boolean> {
+        if (this.ready) return true;
+
+        try {
+            nativeKeyboardListener.timeIndexInfo();
+        } catch (error) {
+            console.warn('Time bucket index unavailable, using SQL aggregation:', error);
+            return false;
+        }
+
+        // 시간별 행은 로컬 시간의 시작, 시간별 행이 없는 (증분 집계 이전의) 날짜는 로컬 자정에 둠
+        const rows: Array<{ date: string; hour: number; keys: number; duration: number; sessions: number }> =
+            await databaseService.all(
+                `SELECT date, hour, key_count AS keys, duration, session_count AS sessions FROM hourly_stats
+                 UNION ALL
+                 SELECT date, 0 AS hour, total_keys AS keys, total_duration AS duration, total_sessions AS sessions
+                 FROM daily_stats
+                 WHERE NOT EXISTS (SELECT 1 FROM hourly_stats WHERE hourly_stats.date = daily_stats.date)`
+            );
+
+        const count = rows.length;
+        const buckets = {
+            count,
+            starts: new Float64Array(count),
+            keys: new Float64Array(count),
+            activeMs: new Float64Array(count),
+            sessions: new Float64Array(count)
+        };
+        rows.forEach((row, i) => {
+            buckets.starts[i] = this.localTime(row.date, row.hour);
+            buckets.keys[i] = row.keys || 0;
+            buckets.activeMs[i] = row.duration || 0;
+            buckets.sessions[i] = row.sessions || 0;
+        });
+        nativeKeyboardListener.timeIndexAdd(buckets);
+
+        this.ready = true;
+        const info = nativeKeyboardListener.timeIndexInfo();
+        console.log(`Time bucket index loaded: ${count} rows, ${info.days} days, ${info.bytes} bytes`);
+        return true;
+    }
+
+    public isReady(): boolean {
+        return this.ready;
+    }
+
+    /**
+     * 네이티브 세션 단계를 거치지 않은 타이핑 이벤트 반영 (시뮬레이션 모드 등)
+     */
+    public add(metadata: TypingMetadata): void {
+        if (!this.ready) return;
+
+        nativeKeyboardListener.timeIndexAdd({
+            count: 1,
+            starts: Float64Array.of(metadata.timestamp),
+            keys: Float64Array.of(1),
+            activeMs: Float64Array.of(metadata.keyCount > 1 ? metadata.interval : 0),
+            sessions: Float64Array.of(metadata.keyCount <= 1 ? 1 : 0)
+        });
+    }
+
+    /**
+     * 연속한 [bounds[i], bounds[i + 1]) 구간 합
+     */
+    public query(bounds: number[]): TimeRangeSums {
+        return nativeKeyboardListener.timeIndexQuery(bounds);
+    }
+
+    /**
+     * 하루 통계 (daily_stats 행과 같은 형태, 입력이 없으면 null)
+     */
+    public getDailyStats(date: string): DailyStatsData | null {
+        return this.getDays(date, 1)[0] ?? null;
+    }
+
+    /**
+     * startDate부터 days일의 기간 통계 (간격 분석은 작업 스레드에서 함께 진행)
+     */
+    public async getPeriodStats(startDate: string, days: number): Promise<PeriodStats> {
+        const rhythm = DailyStats.getPeriodRhythm(startDate, days);
+        const dailyStats = this.getDays(startDate, days);
+
+        const totalKeys = dailyStats.reduce((sum, day) => sum + day.total_keys, 0);
+        const totalSessions = dailyStats.reduce((sum, day) => sum + day.total_sessions, 0);
+        const totalDuration = dailyStats.reduce((sum, day) => sum + day.total_duration, 0);
+        const averageSpeed = dailyStats.length > 0
+            ? dailyStats.reduce((sum, day) => sum + day.average_speed, 0) / dailyStats.length
+            : 0;
+
+        return {
+            totalKeys,
+            totalSessions,
+            totalDuration,
+            averageSpeed: Math.round(averageSpeed * 100) / 100,
+            dailyStats,
+            rhythm: await rhythm
+        };
+    }
+
+    /**
+     * 월간 통계 (getMonthlyStats와 같은 형태)
+     */
+    public async getMonthlyStats(year: number, month: number): Promise<PeriodStats & { peakDay: string }> {
+        const startDate = `${year}-${month.toString().padStart(2, '0')}-01`;
+        const stats = await this.getPeriodStats(startDate, new Date(year, month, 0).getDate());
+
+        // 가장 활발했던 날 찾기
+        const peakDay = stats.dailyStats.reduce((maxDay, current) =>
+            current.total_keys > maxDay.total_keys ? current : maxDay,
+            { total_keys: 0, date: startDate }
+        ).date;
+
+        return { ...stats, peakDay };
+    }
+
+    /**
+     * startDate부터 days일 중 입력이 있는 날의 통계 - 시간 구간(날짜당 24개)을 한 번에 조회
+     * 일광 절약 시간 전환일에 없는 시간은 빈 구간이 됨
+     */
+    private getDays(startDate: string, days: number): DailyStatsData[] {
+        const bounds: number[] = [];
+        for (let day = 0; day < days; day++) {
+            for (let hour = 0; hour < 24; hour++) {
+                bounds.push(this.localTime(startDate, hour, day));
+            }
+        }
+        bounds.push(this.localTime(startDate, 0, days));
+        const sums = this.query(bounds);
+
+        const dailyStats: DailyStatsData[] = [];
+        for (let day = 0; day < days; day++) {
+            let keys = 0;
+            let sessions = 0;
+            let activeMs = 0;
+            let peakHour = 0;
+            for (let hour = 0; hour < 24; hour++) {
+                const i = day * 24 + hour;
+                keys += sums.keys[i];
+                sessions += sums.sessions[i];
+                activeMs += sums.activeMs[i];
+                if (sums.keys[i] > sums.keys[day * 24 + peakHour]) {
+                    peakHour = hour;
+                }
+            }
+            if (keys > 0) {
+                dailyStats.push(this.toDailyStats(DailyStats.localDate(bounds[day * 24]), keys, sessions, activeMs, peakHour));
+            }
+        }
+        return dailyStats;
+    }
+
+    private toDailyStats(date: string, keys: number, sessions: number, activeMs: number, peakHour: number): DailyStatsData {
+        return {
+            date,
+            total_keys: keys,
+            total_sessions: sessions,
+            total_duration: Math.round(activeMs),
+            average_speed: activeMs > 0 ? Math.round(keys * 60000 / activeMs * 100) / 100 : 0,
+            peak_hour: peakHour
+        };
+    }
+
+    /**
+     * 로컬 날짜(YYYY-MM-DD) + 시간/일 오프셋의 epoch ms
+     */
+    private localTime(date: string, hour: number, dayOffset: number = 0): number {
+        const [year, month, day] = date.split('-').map(Number);
+        return new Date(year, month - 1, day + dayOffset, hour).getTime();
+    }
+}
+
+// 싱글톤 인스턴스
+export const timeIndex = new TimeIndex();
@@ -0,0 +1,66 @@
+import { databaseService } from './DatabaseService';
+import { typingArchive } from './TypingArchive';
+import { nativeKeyboardListener } from '../native';
+import { AnalyticsOptions, AnalyticsResult } from '../native/types';
+
+/**
+ * 기간별 타이핑 간격 분석
+ * 아카이브로 옮겨진 지난 날짜는 네이티브 작업 스레드가 직접 읽고, typing_events에 남은 행만
+ * 배열로 넘겨 함께 분석 (합/분산, 분위수, 몰아치기/멈춤, 구간별 히스토그램 모두 네이티브 커널)
+ */
+export class TypingAnalytics {
+    /**
+     * [start, end) 범위의 이벤트 분석 (네이티브 모듈이 없으면 null)
+     */
+    public async analyzeRange(start: number, end: number, options?: AnalyticsOptions): Promise<AnalyticsResult | null> {
+        try {
+            const rows = await databaseService.all(
+                `SELECT timestamp, interval_ms FROM typing_events
+                 WHERE timestamp >= ? AND timestamp < ?
+                 ORDER BY timestamp ASC`,
+                [start, end]
+            );
+
+            const timestamps = new Float64Array(rows.length);
+            const intervals = new Float64Array(rows.length);
+            for (let i = 0; i < rows.length; i++) {
+                timestamps[i] = rows[i].timestamp;
+                intervals[i] = rows[i].interval_ms;
+            }
+
+            return await nativeKeyboardListener.analyze(
+                {
+                    intervals,
+                    timestamps,
+                    archive: typingArchive.isOpen() ? { start, end } : undefined
+                },
+                options
+            );
+        } catch (error) {
+            console.warn('Native typing analytics unavailable:', error);
+            return null;
+        }
+    }
+
+    /**
+     * 로컬 날짜별 분석 (히스토그램 구간 = 하루, 시작 날짜 자정 기준)
+     * 서머타임 전환일에는 구간 경계가 로컬 자정과 최대 1시간 어긋날 수 있음
+     */
+    public analyzeDays(startDate: string, days: number, options?: AnalyticsOptions): Promise<AnalyticsResult | null> {
+        const start = new Date(`${startDate}T00:00:00`);
+        const end = new Date(start);
+        end.setDate(end.getDate() + days);
+
+        return this.analyzeRange(start.getTime(), end.getTime(), {
+            ...options,
+            histogram: {
+                origin: start.getTime(),
+                width: 24 * 60 * 60 * 1000,
+                buckets: days
+            }
+        });
+    }
+}
+
+// 싱글톤 인스턴스
+export const typingAnalytics = new TypingAnalytics();
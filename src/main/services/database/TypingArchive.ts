@@ -0,0 +1,232 @@
+import * as path from 'path';
+import { databaseService } from './DatabaseService';
+import { AppSettings } from './models/AppSettings';
+import { TypingEventData } from './models/TypingEvent';
+import { nativeKeyboardListener } from '../native';
+import { JournalRecords } from '../native/types';
+
+// 보관 진행 상태 (app_settings) - 아카이브 추가와 typing_events 삭제 사이에 종료되어도 중복/유실 없이 이어감
+const ARCHIVE_STATE_KEY = 'archive_state';
+
+interface ArchiveState {
+    records: number;           // 삭제까지 끝난 시점의 아카이브 레코드 수
+    pendingMaxId?: number;     // 추가했거나 추가하려던 행 범위 (id <= pendingMaxId, timestamp < pendingEnd)
+    pendingEnd?: number;
+}
+
+// 네이티브 세션 ID 형식 (session_<sessionStart>_<sessionSeq>)
+const SESSION_ID_PATTERN = /^session_(\d+)_(\w+)$/;
+
+/**
+ * 타이핑 이벤트 아카이브 - 지난 날짜의 typing_events 행을 네이티브 압축 열 블록 파일로 옮김
+ * 키 입력당 한 행씩 쌓이는 테이블 대신 블록당 최소/최대 인덱스가 있는 추가 전용 파일에 보관하므로
+ * 보존 기간 정리로 이력을 잃지 않고, 범위 조회는 겹치는 블록만 풀어 읽음
+ */
+export class TypingArchive {
+    private archiveOpen: boolean = false;
+    private archiving: Promise<number> | null = null;
+
+    /**
+     * 아카이브 열기 (네이티브 모듈이 없으면 false - 이벤트는 typing_events에 남음)
+     */
+    public open(filePath: string = path.join(path.dirname(databaseService.getDatabasePath()), 'typing-archive.tha')): boolean {
+        try {
+            this.archiveOpen = nativeKeyboardListener.openArchive(filePath);
+        } catch (error) {
+            console.warn('Typing archive unavailable, keeping events in SQLite:', error);
+            this.archiveOpen = false;
+        }
+
+        if (this.archiveOpen) {
+            const info = nativeKeyboardListener.archiveInfo();
+            console.log(`Typing archive opened: ${filePath} (${info.records} events, ${info.bytes} bytes)`);
+        }
+        return this.archiveOpen;
+    }
+
+    public isOpen(): boolean {
+        return this.archiveOpen;
+    }
+
+    /**
+     * 오늘 이전(로컬 자정 기준)의 이벤트를 하루 단위로 아카이브에 옮기고 옮긴 행 수 반환
+     * 실행 중인 보관이 있으면 그 결과를 기다림
+     */
+    public archiveClosedDays(): Promise<number> {
+        if (!this.archiveOpen) return Promise.resolve(0);
+
+        if (!this.archiving) {
+            this.archiving = this.archivePending().then(
+                count => {
+                    this.archiving = null;
+                    return count;
+                },
+                error => {
+                    this.archiving = null;
+                    throw error;
+                }
+            );
+        }
+        return this.archiving;
+    }
+
+    /**
+     * [start, end) 범위의 보관된 이벤트 조회 (typing_events 행 형태, id 없음)
+     */
+    public findEvents(start: number, end: number): TypingEventData[] {
+        if (!this.archiveOpen) return [];
+
+        const events: TypingEventData[] = [];
+        for (const records of nativeKeyboardListener.archiveRange(start, end)) {
+            for (let i = 0; i < records.count; i++) {
+                events.push({
+                    // 네이티브 CreateSessionId(keyboard-native.cc)와 같은 형식
+                    session_id: `session_${records.sessionStarts[i]}_${records.sessionSeqs[i]}`,
+                    timestamp: records.timestamps[i],
+                    key_count: records.keyCounts[i],
+                    interval_ms: records.intervals[i],
+                    is_active: true
+                });
+            }
+        }
+        return events;
+    }
+
+    /**
+     * 아카이브 닫기 (실행 중인 보관이 끝난 뒤)
+     */
+    public async close(): Promise<void> {
+        if (!this.archiveOpen) return;
+
+        if (this.archiving) {
+            await this.archiving.catch(() => undefined);
+        }
+        nativeKeyboardListener.closeArchive();
+        this.archiveOpen = false;
+    }
+
+    private async archivePending(): Promise<number> {
+        const state = await this.recover();
+
+        const cutoff = new Date();
+        cutoff.setHours(0, 0, 0, 0);
+
+        let archived = 0;
+        for (;;) {
+            const first = await databaseService.get(
+                'SELECT MIN(timestamp) as timestamp FROM typing_events WHERE timestamp < ?',
+                [cutoff.getTime()]
+            );
+            if (!first || first.timestamp === null) break;
+
+            // 가장 오래된 행이 속한 날의 다음 로컬 자정까지 (하루치가 블록 하나 - 큰 블록일수록 압축률이 좋음)
+            const dayEnd = new Date(first.timestamp);
+            dayEnd.setHours(24, 0, 0, 0);
+            const end = Math.min(dayEnd.getTime(), cutoff.getTime());
+
+            archived += await this.archiveDay(state, end);
+        }
+
+        if (archived > 0) {
+            const info = nativeKeyboardListener.archiveInfo();
+            console.log(`Typing archive updated: ${archived} events moved (${info.records} archived, ${info.bytes} bytes)`);
+        }
+        return archived;
+    }
+
+    private async archiveDay(state: ArchiveState, end: number): Promise<number> {
+        const rows = await databaseService.all(
+            `SELECT id, session_id, timestamp, key_count, interval_ms FROM typing_events
+             WHERE timestamp < ? ORDER BY timestamp ASC, id ASC`,
+            [end]
+        );
+        if (rows.length === 0) return 0;
+
+        let maxId = 0;
+        for (const row of rows) {
+            if (row.id > maxId) maxId = row.id;
+        }
+
+        // 추가 전에 대상 범위를 남겨 두고, 삭제와 완료 표시는 한 트랜잭션으로
+        state.pendingMaxId = maxId;
+        state.pendingEnd = end;
+        await AppSettings.set(ARCHIVE_STATE_KEY, state, 'json', '타이핑 이벤트 아카이브 진행 상태');
+
+        nativeKeyboardListener.archiveAppend(this.toRecords(rows));
+        await this.commitPending(state);
+
+        return rows.length;
+    }
+
+    /**
+     * 이전 실행이 추가 후 삭제 전에 끝났으면 삭제만 마저 수행
+     * (아카이브 레코드 수가 완료 시점보다 많으면 추가까지는 끝난 것)
+     */
+    private async recover(): Promise<ArchiveState> {
+        const saved = await AppSettings.getJSON<ArchiveState>(ARCHIVE_STATE_KEY, null);
+        const state: ArchiveState = saved ?? { records: nativeKeyboardListener.archiveInfo().records };
+
+        if (state.pendingMaxId !== undefined && state.pendingEnd !== undefined) {
+            if (nativeKeyboardListener.archiveInfo().records > state.records) {
+                await this.commitPending(state);
+            } else {
+                delete state.pendingMaxId;
+                delete state.pendingEnd;
+            }
+        }
+        return state;
+    }
+
+    private async commitPending(state: ArchiveState): Promise<void> {
+        const maxId = state.pendingMaxId;
+        const end = state.pendingEnd;
+
+        delete state.pendingMaxId;
+        delete state.pendingEnd;
+        state.records = nativeKeyboardListener.archiveInfo().records;
+
+        await databaseService.transaction(async () => {
+            await databaseService.run('DELETE FROM typing_events WHERE id <= ? AND timestamp < ?', [maxId, end]);
+            await AppSettings.set(ARCHIVE_STATE_KEY, state, 'json', '타이핑 이벤트 아카이브 진행 상태');
+        });
+    }
+
+    /**
+     * typing_events 행을 저널 레코드 형태로 변환
+     * 네이티브 세션 ID가 아닌 경우(시뮬레이션 등 session_<시각>_<임의 문자열>) 일련번호는 0으로 보관
+     */
+    private toRecords(rows: any[]): JournalRecords {
+        const count = rows.length;
+        const records: JournalRecords = {
+            count,
+            timestamps: new Float64Array(count),
+            sessionStarts: new Float64Array(count),
+            sessionSeqs: new Uint32Array(count),
+            keyCounts: new Uint32Array(count),
+            intervals: new Float64Array(count)
+        };
+
+        let lastSessionId = '';
+        let sessionStart = 0;
+        let sessionSeq = 0;
+        for (let i = 0; i < count; i++) {
+            const row = rows[i];
+            if (row.session_id !== lastSessionId) {
+                lastSessionId = row.session_id;
+                const match = SESSION_ID_PATTERN.exec(row.session_id);
+                sessionStart = match ? Number(match[1]) : row.timestamp;
+                sessionSeq = match && /^\d+$/.test(match[2]) ? Number(match[2]) >>> 0 : 0;
+            }
+
+            records.timestamps[i] = row.timestamp;
+            records.sessionStarts[i] = sessionStart;
+            records.sessionSeqs[i] = sessionSeq;
+            records.keyCounts[i] = row.key_count;
+            records.intervals[i] = row.interval_ms;
+        }
+        return records;
+    }
+}
+
+// 싱글톤 인스턴스
+export const typingArchive = new TypingArchive();
@@ -1,6 +1,7 @@
 import { databaseService } from '../DatabaseService';
 import { TypingSession } from './TypingSession';
 import { TypingEvent } from './TypingEvent';
+import { typingAnalytics } from '../TypingAnalytics';
 
 export interface DailyStatsData {
     id?: number;
@@ -10,10 +11,28 @@ export interface DailyStatsData {
     total_duration: number; // milliseconds
     average_speed: number; // keys per minute
     peak_hour: number; // 0-23
+    interval_count?: number; // 키 입력 간격 적률 (증분 집계)
+    interval_sum?: number; // ms
+    interval_sum_sq?: number; // ms²
     created_at?: number;
     updated_at?: number;
 }
 
+// 기간 내 키 입력 간격 분석 (네이티브 분석 커널 - 모듈이 없으면 null)
+export interface PeriodRhythm {
+    events: number;
+    meanInterval: number; // ms
+    stdDevInterval: number;
+    medianInterval: number;
+    p90Interval: number;
+    p99Interval: number;
+    burstRuns: number; // 빠른 타이핑 구간 수 (간격 < 100ms 연속)
+    longestBurst: number; // 가장 긴 빠른 타이핑 구간의 키 수
+    pauseCount: number; // 긴 휴식 수 (간격 > 2000ms)
+    pauseDuration: number; // ms
+    dailyKeys: number[]; // 시작 날짜부터 하루 단위 키 입력 수
+}
+
 export class DailyStats {
     /**
      * 일별 통계 생성 또는 업데이트
@@ -134,11 +153,14 @@ export class DailyStats {
         totalDuration: number;
         averageSpeed: number;
         dailyStats: DailyStatsData[];
+        rhythm: PeriodRhythm | null;
     }> {
         // 시작 날짜부터 7일간의 통계
         const endDate = new Date(new Date(startDate).getTime() + 6 * 24 * 60 * 60 * 1000)
             .toISOString().split('T')[0];
         
+        // 이벤트 단위 분석은 작업 스레드에서 일별 행 조회와 함께 진행
+        const rhythm = this.getPeriodRhythm(startDate, 7);
         const dailyStats = await this.findByDateRange(startDate, endDate);
         
         const totalKeys = dailyStats.reduce((sum, day) => sum + day.total_keys, 0);
@@ -153,7 +175,8 @@ export class DailyStats {
             totalSessions,
             totalDuration,
             averageSpeed: Math.round(averageSpeed * 100) / 100,
-            dailyStats
+            dailyStats,
+            rhythm: await rhythm
         };
     }
 
@@ -167,10 +190,12 @@ export class DailyStats {
         averageSpeed: number;
         dailyStats: DailyStatsData[];
         peakDay: string;
+        rhythm: PeriodRhythm | null;
     }> {
         const startDate = `${year}-${month.toString().padStart(2, '0')}-01`;
         const endDate = new Date(year, month, 0).toISOString().split('T')[0]; // 해당 월의 마지막 날
         
+        const rhythm = this.getPeriodRhythm(startDate, new Date(year, month, 0).getDate());
         const dailyStats = await this.findByDateRange(startDate, endDate);
         
         const totalKeys = dailyStats.reduce((sum, day) => sum + day.total_keys, 0);
@@ -192,7 +217,34 @@ export class DailyStats {
             totalDuration,
             averageSpeed: Math.round(averageSpeed * 100) / 100,
             dailyStats,
-            peakDay
+            peakDay,
+            rhythm: await rhythm
+        };
+    }
+
+    /**
+     * 기간 내 이벤트 단위 간격 분석 (보관된 이벤트 포함)
+     * 일별 행은 기간당 최대 31개라 JS에서 더하고, 이벤트 수에 비례하는 계산만 네이티브 작업 스레드로
+     */
+    static async getPeriodRhythm(startDate: string, days: number): Promise<PeriodRhythm | null> {
+        const result = await typingAnalytics.analyzeDays(startDate, days, { percentiles: [50, 90, 99] });
+        if (!result) {
+            return null;
+        }
+
+        const round = (value: number) => Math.round(value * 100) / 100;
+        return {
+            events: result.events,
+            meanInterval: round(result.mean),
+            stdDevInterval: round(result.stdDev),
+            medianInterval: round(result.percentiles[0]),
+            p90Interval: round(result.percentiles[1]),
+            p99Interval: round(result.percentiles[2]),
+            burstRuns: result.bursts.runs,
+            longestBurst: result.bursts.longest,
+            pauseCount: result.pauses.count,
+            pauseDuration: round(result.pauses.totalMs),
+            dailyKeys: result.histogram ? Array.from(result.histogram.counts) : []
         };
     }
 
@@ -240,8 +292,48 @@ export class DailyStats {
      * 오늘 통계 실시간 업데이트
      */
     static async updateTodayStats(): Promise<DailyStatsData> {
-        const today = new Date().toISOString().split('T')[0];
-        return await this.calculateAndUpdateStats(today);
+        return await this.calculateAndUpdateStats(this.localDate());
+    }
+
+    /**
+     * endDate까지 하루도 빠짐없이 입력한 날 수와 가장 긴 연속 입력 일수
+     * 입력이 있는 날짜 행만 읽으므로 비용은 이벤트 수가 아닌 날짜 수에 비례
+     */
+    static async getStreaks(endDate: string): Promise<{ current: number; best: number }> {
+        const rows: Array<{ date: string }> = await databaseService.all(
+            'SELECT date FROM daily_stats WHERE total_keys > 0 AND date <= ? ORDER BY date ASC',
+            [endDate]
+        );
+
+        let run = 0;
+        let best = 0;
+        let previous = '';
+        for (const row of rows) {
+            run = previous && this.nextDate(previous) === row.date ? run + 1 : 1;
+            best = Math.max(best, run);
+            previous = row.date;
+        }
+
+        return { current: previous === endDate ? run : 0, best };
+    }
+
+    /**
+     * 다음 로컬 날짜 (YYYY-MM-DD)
+     */
+    static nextDate(date: string): string {
+        const [year, month, day] = date.split('-').map(Number);
+        // 일광 절약 시간 전환과 무관하도록 정오 기준
+        return this.localDate(new Date(year, month - 1, day + 1, 12).getTime());
+    }
+
+    /**
+     * 로컬 날짜 문자열 (YYYY-MM-DD) - 일별 통계 행의 날짜 기준
+     */
+    static localDate(time: number = Date.now()): string {
+        const date = new Date(time);
+        const month = (date.getMonth() + 1).toString().padStart(2, '0');
+        const day = date.getDate().toString().padStart(2, '0');
+        return `${date.getFullYear()}-${month}-${day}`;
     }
 
     /**
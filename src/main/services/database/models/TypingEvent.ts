@@ -1,4 +1,5 @@
 import { databaseService } from '../DatabaseService';
+import { typingArchive } from '../TypingArchive';
 
 export interface TypingEventData {
     id?: number;
@@ -46,7 +47,7 @@ export class TypingEvent {
     }
 
     /**
-     * 날짜 범위로 타이핑 이벤트 조회
+     * 날짜 범위로 타이핑 이벤트 조회 (아카이브로 옮겨진 지난 날짜의 이벤트 포함)
      */
     static async findByDateRange(startDate: number, endDate: number): Promise<TypingEventData[]> {
         const rows = await databaseService.all(
@@ -56,10 +57,16 @@ export class TypingEvent {
             [startDate, endDate]
         );
 
-        return rows.map(row => ({
+        const events: TypingEventData[] = rows.map(row => ({
             ...row,
             is_active: Boolean(row.is_active)
         }));
+
+        const archived = typingArchive.findEvents(startDate, endDate + 1);
+        if (archived.length === 0) {
+            return events;
+        }
+        return archived.concat(events).sort((a, b) => a.timestamp - b.timestamp);
     }
 
     /**
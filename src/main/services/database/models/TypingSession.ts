@@ -8,6 +8,9 @@ export interface TypingSessionData {
     total_keys: number;
     duration: number;
     average_interval: number;
+    interval_p50?: number | null;
+    interval_p90?: number | null;
+    interval_p99?: number | null;
     created_at?: number;
 }
 
@@ -57,13 +60,31 @@ export class TypingSession {
 
     /**
      * 세션 종료 처리
+     * percentiles는 네이티브 간격 통계가 있을 때만 기록 (없으면 NULL 유지)
      */
-    static async endSession(sessionId: string, endTime: number, totalKeys: number, duration: number, averageInterval: number): Promise<void> {
+    static async endSession(
+        sessionId: string,
+        endTime: number,
+        totalKeys: number,
+        duration: number,
+        averageInterval: number,
+        percentiles?: { p50: number; p90: number; p99: number }
+    ): Promise<void> {
         await databaseService.run(
             `UPDATE typing_sessions 
-             SET end_time = ?, total_keys = ?, duration = ?, average_interval = ?
+             SET end_time = ?, total_keys = ?, duration = ?, average_interval = ?,
+                 interval_p50 = ?, interval_p90 = ?, interval_p99 = ?
              WHERE session_id = ?`,
-            [endTime, totalKeys, duration, averageInterval, sessionId]
+            [
+                endTime,
+                totalKeys,
+                duration,
+                averageInterval,
+                percentiles ? percentiles.p50 : null,
+                percentiles ? percentiles.p90 : null,
+                percentiles ? percentiles.p99 : null,
+                sessionId
+            ]
         );
     }
 
@@ -0,0 +1,210 @@
+// 포커스 앱 귀속 통합 테스트 (Linux X11 백엔드)
+// Xvfb에 WM_CLASS가 다른 창 두 개를 띄우고 루트의 _NET_ACTIVE_WINDOW를 바꿔 가며 XTest로 키를 입력해
+// 키 이벤트의 appId와 getAppTable()/getAppStats() 귀속을 확인
+// Xvfb, libX11/libXtst로 빌드할 C++ 컴파일러, 빌드된 애드온(npm run build) 중 하나라도 없으면 건너뜀
+
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import * as readline from 'readline';
+import { Readable } from 'stream';
+import { spawn, spawnSync, ChildProcess } from 'child_process';
+import { describe, it, expect, beforeAll, afterAll } from '@jest/globals';
+import { NativeKeyboardListener } from '../index';
+import { NativeKeyEvent, AppStats } from '../types';
+
+// index.ts의 loadNativeModule이 읽는 경로
+const ADDON_PATH = path.join(process.cwd(), 'dist', 'main', 'build', 'Release', 'keyboard_native.node');
+const HELPER_SOURCE = path.join(__dirname, 'fixtures', 'x11-app-windows.cc');
+
+const ALPHA_CLASS = 'TypsterAlpha';
+const BETA_CLASS = 'TypsterBeta';
+const ALPHA_KEYS = 12;
+const BETA_KEYS = 7;
+
+// 앱마다 세션 하나가 되도록 - 도우미의 키 간격(20ms)보다 길고 앱 전환 대기보다 짧게
+const IDLE_TIMEOUT_MS = 300;
+const APP_SWITCH_PAUSE_MS = 2 * IDLE_TIMEOUT_MS;
+
+function hasCommand(command: string): boolean {
+  return spawnSync('sh', ['-c', `command -v ${command}`], { stdio: 'ignore' }).status === 0;
+}
+
+// 도우미 빌드 (헤더/라이브러리가 없으면 null - 테스트를 건너뜀)
+function buildHelper(): string | null {
+  if (process.platform !== 'linux' || !fs.existsSync(ADDON_PATH) || !hasCommand('Xvfb') || !hasCommand('c++')) {
+    return null;
+  }
+
+  const binary = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'typster-x11-')), 'x11-app-windows');
+  const result = spawnSync('c++', ['-O1', HELPER_SOURCE, '-o', binary, '-lXtst', '-lX11'], { stdio: 'ignore' });
+  return result.status === 0 ? binary : null;
+}
+
+function delay(ms: number): Promise<void> {
+  return new Promise(resolve => setTimeout(resolve, ms));
+}
+
+// 조건이 참이 될 때까지 이벤트 루프를 돌리며 대기 (콜백/레코드 링 비우기가 JS 스레드에서 일어나므로)
+async function waitFor(condition: () => boolean, description: string, timeoutMs = 5000): Promise<void> {
+  const deadline = Date.now() + timeoutMs;
+  while (!condition()) {
+    if (Date.now() > deadline) {
+      throw new Error(`Timed out waiting for ${description}`);
+    }
+    await delay(20);
+  }
+}
+
+// Xvfb 시작 - 빈 디스플레이 번호를 -displayfd로 받음
+function startXvfb(): Promise<{ server: ChildProcess; display: string }> {
+  return new Promise((resolve, reject) => {
+    const server = spawn('Xvfb', ['-displayfd', '3', '-nolisten', 'tcp', '-screen', '0', '640x480x24'], {
+      stdio: ['ignore', 'ignore', 'ignore', 'pipe'],
+    });
+    let output = '';
+    (server.stdio[3] as Readable).on('data', (chunk: Buffer) => {
+      output += chunk.toString();
+      if (output.includes('\n')) {
+        resolve({ server, display: `:${output.trim()}` });
+      }
+    });
+    server.on('error', reject);
+    server.on('exit', code => reject(new Error(`Xvfb exited with code ${code}`)));
+  });
+}
+
+// 도우미 프로세스 - 명령 한 줄을 보내고 응답 한 줄을 받음
+class X11Helper {
+  private process: ChildProcess;
+  private pending: Array<(line: string) => void> = [];
+
+  constructor(binary: string, display: string) {
+    this.process = spawn(binary, [], {
+      env: { ...process.env, DISPLAY: display },
+      stdio: ['pipe', 'pipe', 'inherit'],
+    });
+    readline.createInterface({ input: this.process.stdout! }).on('line', line => {
+      const resolve = this.pending.shift();
+      if (resolve) {
+        resolve(line);
+      }
+    });
+  }
+
+  request(command: string): Promise<string> {
+    return new Promise(resolve => {
+      this.pending.push(resolve);
+      this.process.stdin!.write(`${command}\n`);
+    });
+  }
+
+  async createWindow(className: string): Promise<number> {
+    const reply = await this.request(`create ${className}`);
+    expect(reply).toMatch(/^window \d+$/);
+    return Number(reply.split(' ')[1]);
+  }
+
+  async activate(window: number): Promise<void> {
+    expect(await this.request(`activate ${window}`)).toBe('ok');
+  }
+
+  async type(count: number): Promise<void> {
+    expect(await this.request(`type ${count}`)).toBe('ok');
+  }
+
+  close(): void {
+    this.process.stdin!.end('quit\n');
+  }
+}
+
+const helperBinary = buildHelper();
+const describeX11 = helperBinary ? describe : describe.skip;
+
+describeX11('active app attribution on X11', () => {
+  const listener = new NativeKeyboardListener();
+  const events: NativeKeyEvent[] = [];
+  let xvfb: ChildProcess;
+  let helper: X11Helper;
+
+  const activeAppName = (): string => {
+    const table = listener.getAppTable();
+    return table.names[table.activeAppId];
+  };
+
+  const statsFor = (appId: number): AppStats | undefined =>
+    listener.getAppStats().find(stats => stats.appId === appId);
+
+  beforeAll(async () => {
+    const started = await startXvfb();
+    xvfb = started.server;
+    xvfb.removeAllListeners('exit');
+
+    // 포커스 추적 연결은 리스닝 시작 때 DISPLAY로 열림
+    process.env.DISPLAY = started.display;
+    helper = new X11Helper(helperBinary!, started.display);
+  }, 15000);
+
+  afterAll(() => {
+    if (listener.isListening()) {
+      listener.stopListening();
+    }
+    helper?.close();
+    xvfb?.kill();
+  });
+
+  it('stamps key events and per-app stats with the focused window class', async () => {
+    expect(listener.startListening(event => events.push(event))).toBe(true);
+    listener.setIdleTimeout(IDLE_TIMEOUT_MS);
+    listener.getAppStats(true);
+
+    const alphaWindow = await helper.createWindow(ALPHA_CLASS);
+    const betaWindow = await helper.createWindow(BETA_CLASS);
+
+    // 캡처 스레드가 PropertyNotify를 처리해 앱 ID를 바꾼 뒤에 입력
+    await helper.activate(alphaWindow);
+    await waitFor(() => activeAppName() === ALPHA_CLASS, `${ALPHA_CLASS} to become active`);
+    const alphaId = listener.getAppTable().activeAppId;
+    await helper.type(ALPHA_KEYS);
+    await waitFor(() => statsFor(alphaId)?.keys === ALPHA_KEYS, `${ALPHA_KEYS} keys for ${ALPHA_CLASS}`);
+
+    await delay(APP_SWITCH_PAUSE_MS);
+    await helper.activate(betaWindow);
+    await waitFor(() => activeAppName() === BETA_CLASS, `${BETA_CLASS} to become active`);
+    const betaId = listener.getAppTable().activeAppId;
+    await helper.type(BETA_KEYS);
+    await waitFor(() => statsFor(betaId)?.keys === BETA_KEYS, `${BETA_KEYS} keys for ${BETA_CLASS}`);
+
+    // ID 표 - 클래스마다 다른 ID, 0은 알 수 없음
+    const table = listener.getAppTable();
+    expect(table.names[0]).toBe('');
+    expect(alphaId).not.toBe(0);
+    expect(betaId).not.toBe(alphaId);
+    expect(table.names[alphaId]).toBe(ALPHA_CLASS);
+    expect(table.names[betaId]).toBe(BETA_CLASS);
+
+    // 앱별 누적 - 전환 전 대기로 앱마다 세션 하나, 입력한 키는 모두 해당 앱에만
+    const alphaStats = statsFor(alphaId)!;
+    const betaStats = statsFor(betaId)!;
+    expect(alphaStats.sessions).toBe(1);
+    expect(betaStats.sessions).toBe(1);
+    expect(alphaStats.activeMs).toBeGreaterThan(0);
+    expect(betaStats.activeMs).toBeGreaterThan(0);
+    expect(statsFor(0)).toBeUndefined();
+
+    // 키 이벤트 - 누름마다 그때 활성 앱의 ID
+    const presses = events.filter(event => event.isKeyDown);
+    expect(presses.map(event => event.appId)).toEqual([
+      ...Array(ALPHA_KEYS).fill(alphaId),
+      ...Array(BETA_KEYS).fill(betaId),
+    ]);
+
+    // 활성 창이 없어지면 알 수 없음으로 돌아감
+    await helper.activate(0);
+    await waitFor(() => listener.getAppTable().activeAppId === 0, 'active app to reset');
+
+    // reset이면 읽은 뒤 비움
+    expect(listener.getAppStats(true)).toHaveLength(2);
+    expect(listener.getAppStats()).toHaveLength(0);
+  }, 30000);
+});
@@ -0,0 +1,88 @@
+// 포커스 앱 귀속 테스트용 X 클라이언트 (app-attribution.test.ts가 Xvfb에서 빌드해 실행)
+// 창 관리자 없이 EWMH 창 관리자 흉내 - 창을 만들고 루트의 _NET_ACTIVE_WINDOW를 직접 바꾸고 XTest로 키 입력
+// stdin 한 줄에 명령 하나, 처리가 끝나면 stdout에 한 줄로 응답
+//   create <class>  → window <id>   (WM_CLASS가 <class>인 창을 띄움)
+//   activate <id>   → ok            (0이면 활성 창 없음)
+//   type <count>    → ok            (키 하나를 count번 누르고 뗌, 키 사이 간격 KEY_INTERVAL_US)
+//   quit
+
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XTest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// 키 사이 간격 - 세션 유휴 타임아웃보다 충분히 짧게
+#define KEY_INTERVAL_US 20000
+
+static Window CreateAppWindow(Display* display, const char* className) {
+    Window window = XCreateSimpleWindow(display, DefaultRootWindow(display), 0, 0, 64, 64, 0, 0, 0);
+
+    XClassHint hint;
+    hint.res_name = const_cast<char*>(className);
+    hint.res_class = const_cast<char*>(className);
+    XSetClassHint(display, window, &hint);
+
+    XMapWindow(display, window);
+    XSync(display, False);
+    return window;
+}
+
+static void SetActiveWindow(Display* display, Window window) {
+    Atom netActiveWindow = XInternAtom(display, "_NET_ACTIVE_WINDOW", False);
+    unsigned long value = window;
+    XChangeProperty(display, DefaultRootWindow(display), netActiveWindow, XA_WINDOW, 32,
+                    PropModeReplace, reinterpret_cast<unsigned char*>(&value), 1);
+    XSync(display, False);
+}
+
+static void TypeKeys(Display* display, unsigned long count) {
+    KeyCode keyCode = XKeysymToKeycode(display, XK_a);
+    for (unsigned long i = 0; i < count; i++) {
+        XTestFakeKeyEvent(display, keyCode, True, CurrentTime);
+        XTestFakeKeyEvent(display, keyCode, False, CurrentTime);
+        XSync(display, False);
+        usleep(KEY_INTERVAL_US);
+    }
+}
+
+int main() {
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        fprintf(stderr, "cannot open display\n");
+        return 1;
+    }
+
+    int eventBase, errorBase, major, minor;
+    if (!XTestQueryExtension(display, &eventBase, &errorBase, &major, &minor)) {
+        fprintf(stderr, "XTEST extension not available\n");
+        return 1;
+    }
+
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    char line[256];
+    char argument[200];
+    while (fgets(line, sizeof(line), stdin)) {
+        if (sscanf(line, "create %199s", argument) == 1) {
+            printf("window %lu\n", CreateAppWindow(display, argument));
+        } else if (sscanf(line, "activate %199s", argument) == 1) {
+            SetActiveWindow(display, strtoul(argument, nullptr, 10));
+            printf("ok\n");
+        } else if (sscanf(line, "type %199s", argument) == 1) {
+            TypeKeys(display, strtoul(argument, nullptr, 10));
+            printf("ok\n");
+        } else if (strncmp(line, "quit", 4) == 0) {
+            break;
+        } else {
+            printf("error unknown command\n");
+        }
+    }
+
+    XCloseDisplay(display);
+    return 0;
+}
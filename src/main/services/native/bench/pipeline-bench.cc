@@ -0,0 +1,672 @@
+// 캡처 경로 벤치마크/스트레스 도구 (Electron, Node 없이 단독 실행)
+//
+// 생산자 스레드마다 KeyboardListenerBase 리스너 하나와 CaptureDispatcher 하나를 두고, 플랫폼 리스너와 같은
+// 캡처 단계(CaptureChain)를 거쳐 애드온과 같은 후킹 경로 코드 (capture-dispatch.cc - 실시간 상태 → 구독별 필터 →
+// 세션 → 레코드 링 → 리듬 → 링 → 과부하 정책)를 그대로 호출
+// 리스너는 플랫폼 백엔드처럼 싱크 타입을 템플릿 인자로 받음 (싱크 = 파이프라인 - 콜백 시간을 재고 디스패처로 넘김)
+// 시작할 때 캡처 단계 호출 비용 (std::function + 가상 호출 방식과 합성 체인)을 따로 측정해 함께 출력
+// 소비자 스레드는 JS 스레드 역할 - 링과 레코드 링을 비우고, 유휴 확인/실시간 상태 읽기/필터 교체를 동시에 수행
+// (sanitizer 변형으로 빌드하면 스레드 사이 경합과 수명 문제를 Electron 없이 재현)
+//
+// 사용법: pipeline_bench [--producers N] [--events N] [--rate N] [--subscriptions N]
+//                        [--policy drop-newest|drop-oldest|block|coalesce] [--ring-limit N]
+//                        [--batch-size N] [--consumer-stall-us N] [--idle-timeout-ms N]
+// 빌드: node-gyp configure -- -Dpipeline_bench=1 && make -C build pipeline_bench
+//       (sanitizer 변형: pipeline_bench_tsan, pipeline_bench_asan - 변수를 주지 않으면 애드온만 빌드)
+// 소비 항목 수가 링에 넣은 항목 수와 맞지 않거나, 합쳐진 이벤트가 요약 항목으로 모두 전달되지 않거나,
+// 순서가 뒤바뀌면 종료 코드 1
+
+#include "capture-dispatch.h"
+#include "capture-pipeline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// 할당 횟수 - 스레드별로 세어 생산자(후킹) 스레드 몫만 따로 집계
+// (교체한 new/delete는 인라인하지 않음 - 인라인되면 GCC가 malloc/free 짝을 new/delete 불일치로 오판)
+static thread_local uint64_t t_allocations = 0;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    t_allocations++;
+    void* ptr = malloc(size > 0 ? size : 1);
+    if (!ptr) {
+        fprintf(stderr, "pipeline_bench: out of memory\n");
+        abort();
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) void* operator new(size_t size, std::align_val_t alignment) {
+    t_allocations++;
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, static_cast<size_t>(alignment), size > 0 ? size : 1) != 0) {
+        fprintf(stderr, "pipeline_bench: out of memory\n");
+        abort();
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+// 생성하는 X 키 코드 (문자 키)
+static const uint32_t kBenchKeyCodes[] = {
+    24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+    38, 39, 40, 41, 42, 43, 44, 45, 46,
+    52, 53, 54, 55, 56, 57, 58
+};
+static const size_t kBenchKeyCodeCount = sizeof(kBenchKeyCodes) / sizeof(kBenchKeyCodes[0]);
+
+// 16번째 키마다 특수 키 (Shift) - 필터/세션 단계의 분기를 함께 거치도록
+#define BENCH_SPECIAL_KEY_EVERY 16
+#define BENCH_SPECIAL_KEY_CODE 50
+
+// 소비자의 유휴 확인/실시간 상태 읽기 주기 (유휴 타이머와 화면 갱신 주기 흉내)
+#define BENCH_CHECK_INTERVAL_NS 1000000ull
+// 이 횟수의 확인마다 이벤트 필터 교체 (JS에서 setEventFilter 호출 흉내)
+#define BENCH_FILTER_SWAP_CHECKS 50
+
+// 배치 구독의 기본 깨우기 임계값 (바인딩의 DEFAULT_BATCH_MAX_SIZE와 같음)
+#define BENCH_DEFAULT_BATCH_SIZE 256
+
+static const char* const kPolicyNames[] = { "drop-newest", "drop-oldest", "block", "coalesce" };
+
+struct BenchOptions {
+    uint32_t producers;         // 생산자 스레드 수 (각자 리스너 하나와 구독들을 가짐)
+    uint64_t events;            // 생산자당 이벤트 수 (누름/뗌 각각 1)
+    double rate;                // 생산자당 초당 이벤트 수 (0 = 최대 속도)
+    uint32_t subscriptions;     // 리스너당 구독 수 (events → batched → sessions → rhythm 순으로 반복)
+    OverloadPolicy policy;      // drop-newest, drop-oldest, block, coalesce
+    uint32_t ringLimit;         // 링 최대 깊이 (1 ~ KEY_EVENT_RING_CAPACITY)
+    uint32_t batchSize;         // 배치 구독의 깨우기 임계값 (batchWakeThreshold)
+    uint32_t consumerStallUs;   // 소비자가 한 번 비운 뒤 쉬는 시간 (느린 JS 스레드 흉내)
+    uint32_t idleTimeoutMs;     // 세션 유휴 타임아웃
+};
+
+// 캡처 단계 호출 비용 측정 횟수
+#define BENCH_DISPATCH_ITERATIONS 20000000ull
+
+// 구독 하나 - 바인딩의 KeyboardSubscription처럼 후킹 쪽 상태(CaptureSubscription)에 소비자 쪽 집계를 덧붙임
+// 깨우기는 세기만 함 (소비자는 깨우기를 기다리지 않고 계속 링을 확인)
+struct BenchSubscription : CaptureSubscription {
+    explicit BenchSubscription(bool keepRecords)
+        : CaptureSubscription(keepRecords, Wake), wakeRequests(0), popped(0), summaries(0), summarizedEvents(0),
+          records(0), sessionEnds(0), rhythmEvents(0), lastTimestamp(0), orderViolations(0) {}
+
+    static void Wake(CaptureSubscription* sub) {
+        static_cast<BenchSubscription*>(sub)->wakeRequests++;
+    }
+
+    uint64_t wakeRequests;      // 후킹 스레드 전용 - 소비자를 깨웠을 횟수
+
+    // 소비자 스레드 전용
+    uint64_t popped;
+    uint64_t summaries;         // 합치기 정책의 요약 항목 수
+    uint64_t summarizedEvents;  // 요약 항목에 합쳐져 있던 이벤트 수
+    uint64_t records;           // 레코드 링에서 꺼낸 타이핑 레코드 수
+    uint64_t sessionEnds;
+    uint64_t rhythmEvents;
+    uint64_t lastTimestamp;
+    uint64_t orderViolations;
+};
+
+// 정해진 수의 키 이벤트를 정해진 속도로 싱크에 전달하는 리스너 (플랫폼 후킹 스레드 역할)
+// 이벤트는 XRecord/evdev 리스너와 같은 캡처 단계를 거침 (특수 키 표시 → 싱크)
+template <typename Sink>
+class BenchListener : public KeyboardListenerBase {
+public:
+    BenchListener(Sink& sink, uint32_t seed, const BenchOptions& options, const std::atomic<bool>* startGate)
+        : m_sink(sink), m_seed(seed), m_events(options.events), m_rate(options.rate), m_startGate(startGate),
+          m_shouldStop(false), m_allocations(0) {}
+
+    virtual ~BenchListener() {
+        StopListening();
+    }
+
+    bool StartListening() override {
+        if (m_isListening) {
+            return false;
+        }
+        m_shouldStop.store(false);
+        m_isListening = true;
+        m_thread = std::thread(&BenchListener::ThreadFunc, this);
+        return true;
+    }
+
+    bool StopListening() override {
+        if (!m_isListening) {
+            return false;
+        }
+        m_shouldStop.store(true);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_isListening = false;
+        return true;
+    }
+
+    PermissionInfo CheckPermissions() override {
+        PermissionInfo info;
+        info.hasPermission = true;
+        info.requiresElevation = false;
+        info.permissionMessage = "";
+        return info;
+    }
+
+    bool IsListening() const override {
+        return m_isListening;
+    }
+
+    // 끝날 때까지 기다림 (StopListening과 달리 남은 이벤트를 모두 전달)
+    void Join() {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    // 콜백 안에서 일어난 할당 수 (Join 후)
+    uint64_t GetAllocations() const { return m_allocations; }
+
+private:
+    typedef CaptureChain<SpecialKeyStage<kXSpecialKeys>, SinkStage<Sink>> CaptureStages;
+
+    Sink& m_sink;
+    uint32_t m_seed;
+    uint64_t m_events;
+    double m_rate;
+    const std::atomic<bool>* m_startGate;
+    std::atomic<bool> m_shouldStop;
+    uint64_t m_allocations;
+    std::thread m_thread;
+
+    void ThreadFunc() {
+        // 모든 생산자가 준비될 때까지 대기 (스레드 생성 시간을 측정에서 제외)
+        while (!m_startGate->load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t allocationsBefore = t_allocations;
+
+        for (uint64_t i = 0; i < m_events && !m_shouldStop.load(std::memory_order_relaxed); i++) {
+            if (m_rate > 0) {
+                const auto target = start + std::chrono::nanoseconds(static_cast<int64_t>(i * 1e9 / m_rate));
+                if (target > std::chrono::steady_clock::now()) {
+                    std::this_thread::sleep_until(target);
+                }
+            }
+
+            const uint64_t key = i / 2;
+            KeyEvent event;
+            event.keyCode = key % BENCH_SPECIAL_KEY_EVERY == BENCH_SPECIAL_KEY_EVERY - 1
+                                ? BENCH_SPECIAL_KEY_CODE
+                                : kBenchKeyCodes[(key * 7 + m_seed) % kBenchKeyCodeCount];
+            event.isKeyDown = (i & 1) == 0;
+            event.isSpecialKey = false;
+            event.timestamp = EventClock::NowNs();
+            event.appId = 0;
+            CaptureStages::Run(event, m_sink);
+        }
+
+        m_allocations = t_allocations - allocationsBefore;
+    }
+};
+
+// 생산자 하나의 후킹 경로 전체 (리스너, 디스패처, 구독들, 소비자 스레드) - 리스너의 싱크
+struct BenchPipeline {
+    std::unique_ptr<BenchListener<BenchPipeline>> listener;
+    CaptureDispatcher dispatcher{ kXModifierKeys };
+    std::vector<std::unique_ptr<BenchSubscription>> subscriptions;
+    LatencyHistogram callbackDuration;   // 리스너 콜백 전체 (구독 전부 포함)
+    std::atomic<bool> producerDone;
+    std::thread consumer;
+
+    // 소비자 스레드 전용
+    uint64_t idleChecks;
+    uint64_t snapshotReads;
+    uint64_t filterSwaps;
+
+    // 캡처 단계의 끝 (SinkStage, 생산자 스레드) - 바인딩에서 s_dispatcher가 받는 자리
+    void Deliver(const KeyEvent& event) {
+        const uint64_t hookStartNs = EventClock::NowNs();
+        dispatcher.Deliver(event);
+        callbackDuration.Record(EventClock::NowNs() - hookStartNs);
+    }
+};
+
+// 캡처 단계 호출 비용 비교용 싱크 (최적화로 지워지지 않도록 결과를 누적)
+static uint64_t s_dispatchSink = 0;
+
+__attribute__((noinline)) static void DispatchSink(const KeyEvent& event) {
+    s_dispatchSink += event.keyCode + (event.isSpecialKey ? 1 : 0);
+}
+
+// 이전 방식 - 가상 함수로 특수 키 판별, std::function 콜백으로 전달
+class VirtualDispatchListener {
+public:
+    virtual ~VirtualDispatchListener() = default;
+    virtual bool IsSpecialKey(uint32_t keyCode) = 0;
+
+    void Handle(KeyEvent& event) {
+        event.isSpecialKey = IsSpecialKey(event.keyCode);
+        m_callback(event);
+    }
+
+    std::function<void(const KeyEvent&)> m_callback;
+};
+
+class VirtualDispatchListenerX : public VirtualDispatchListener {
+public:
+    bool IsSpecialKey(uint32_t keyCode) override { return kXSpecialKeys.Test(keyCode); }
+};
+
+// 합성 체인 방식의 싱크 단계
+struct DispatchSinkStage {
+    template <typename Context>
+    static CAPTURE_INLINE bool Process(KeyEvent& event, Context&) {
+        DispatchSink(event);
+        return true;
+    }
+};
+
+// 싱크 호출까지의 이벤트당 비용 (ns) - 같은 키 순서를 두 방식으로 전달
+static void MeasureCaptureDispatch(double* virtualNs, double* chainNs) {
+    typedef CaptureChain<SpecialKeyStage<kXSpecialKeys>, DispatchSinkStage> ChainStages;
+
+    // 구체 타입이 보이면 컴파일러가 가상 호출을 없앨 수 있으므로 volatile 포인터로 감춤
+    std::unique_ptr<VirtualDispatchListener> owner(new VirtualDispatchListenerX());
+    VirtualDispatchListener* volatile hidden = owner.get();
+    VirtualDispatchListener* listener = hidden;
+    listener->m_callback = [](const KeyEvent& event) { DispatchSink(event); };
+
+    KeyEvent event;
+    event.timestamp = 0;
+    event.isKeyDown = true;
+    event.appId = 0;
+    int dummy = 0;
+
+    const auto virtualStart = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < BENCH_DISPATCH_ITERATIONS; i++) {
+        event.keyCode = i % BENCH_SPECIAL_KEY_EVERY == 0 ? BENCH_SPECIAL_KEY_CODE : kBenchKeyCodes[i % kBenchKeyCodeCount];
+        listener->Handle(event);
+    }
+    const auto chainStart = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < BENCH_DISPATCH_ITERATIONS; i++) {
+        event.keyCode = i % BENCH_SPECIAL_KEY_EVERY == 0 ? BENCH_SPECIAL_KEY_CODE : kBenchKeyCodes[i % kBenchKeyCodeCount];
+        ChainStages::Run(event, dummy);
+    }
+    const auto chainEnd = std::chrono::steady_clock::now();
+
+    *virtualNs = std::chrono::duration<double, std::nano>(chainStart - virtualStart).count() / BENCH_DISPATCH_ITERATIONS;
+    *chainNs = std::chrono::duration<double, std::nano>(chainEnd - chainStart).count() / BENCH_DISPATCH_ITERATIONS;
+}
+
+// 링에서 꺼낸 항목 처리 (소비자 스레드)
+static void ConsumeEntry(BenchSubscription* sub, const QueuedEvent& entry, uint64_t wakeNs) {
+    sub->popped++;
+
+    // 요약 항목 (세션 종료만 합쳐진 요약도 coalescedStartNs는 설정됨)
+    if (entry.coalescedStartNs != 0) {
+        sub->summaries++;
+        sub->summarizedEvents += entry.coalescedCount;
+    }
+
+    if (entry.session.type == SESSION_RECORD_END) {
+        sub->sessionEnds++;
+        return;
+    }
+    if (entry.rhythm.type != RHYTHM_EVENT_NONE) {
+        sub->rhythmEvents++;
+    }
+
+    sub->metrics.delivered.fetch_add(1, std::memory_order_relaxed);
+    sub->metrics.deliveryLatency.Record(wakeNs > entry.enqueuedNs ? wakeNs - entry.enqueuedNs : 0);
+
+    // 생산자 하나의 키 이벤트는 시각 순으로 나와야 함 (리듬 항목은 지난 간격 시각을 가질 수 있어 제외)
+    if (entry.rhythm.type == RHYTHM_EVENT_NONE) {
+        if (entry.event.timestamp < sub->lastTimestamp) {
+            sub->orderViolations++;
+        }
+        sub->lastTimestamp = entry.event.timestamp;
+    }
+}
+
+// 소비자 스레드 - JS 스레드 역할 (링 비우기, 유휴 타이머, 실시간 상태 읽기, 필터 교체)
+static void ConsumerThreadFunc(BenchPipeline* pipeline, const BenchOptions* options) {
+    uint64_t lastCheckNs = EventClock::NowNs();
+    double snapshot[LIVE_STATE_FIELD_COUNT];
+    bool maskActive = false;
+
+    for (;;) {
+        // 생산자 종료를 먼저 확인 - 그 뒤의 한 바퀴에서 빈 링이면 남은 항목이 없음
+        const bool producerDone = pipeline->producerDone.load(std::memory_order_acquire);
+        const uint64_t wakeNs = EventClock::NowNs();
+        bool any = false;
+
+        for (size_t i = 0; i < pipeline->subscriptions.size(); i++) {
+            BenchSubscription* sub = pipeline->subscriptions[i].get();
+            QueuedEvent entry;
+            bool woke = false;
+            while (CaptureDispatcher::PopEvent(sub, &entry)) {
+                ConsumeEntry(sub, entry, wakeNs);
+                woke = true;
+            }
+            if (sub->recordRing) {
+                SessionRecord record;
+                while (sub->recordRing->TryPop(&record)) {
+                    sub->records++;
+                    woke = true;
+                }
+            }
+            if (woke) {
+                sub->metrics.wakeups.fetch_add(1, std::memory_order_relaxed);
+                any = true;
+            }
+        }
+
+        const uint64_t now = EventClock::NowNs();
+        if (now - lastCheckNs >= BENCH_CHECK_INTERVAL_NS) {
+            lastCheckNs = now;
+            pipeline->idleChecks++;
+            for (size_t i = 0; i < pipeline->subscriptions.size(); i++) {
+                BenchSubscription* sub = pipeline->subscriptions[i].get();
+                SessionRecord ended;
+                RhythmEvent events[RHYTHM_MAX_EVENTS];
+                uint64_t deadline = 0;
+                sub->sessionizer.CheckIdle(now, &ended, &deadline);
+                sub->rhythmDetector.CheckIdle(now, events, &deadline);
+            }
+            pipeline->dispatcher.GetLiveState().Read(now, snapshot);
+            pipeline->snapshotReads++;
+
+            // 후킹 스레드가 필터를 읽는 중에 설정 교체 (이전 설정은 Reclaim 전까지 유지되어야 함)
+            if (pipeline->idleChecks % BENCH_FILTER_SWAP_CHECKS == 0) {
+                EventFilterConfig config = EventFilter::DefaultConfig();
+                maskActive = !maskActive;
+                if (maskActive) {
+                    config.customMask.Set(kBenchKeyCodes[0]);
+                }
+                pipeline->subscriptions[0]->eventFilter.Configure(config);
+                pipeline->filterSwaps++;
+            }
+        }
+
+        if (!any) {
+            if (producerDone) {
+                break;
+            }
+            std::this_thread::yield();
+        } else if (options->consumerStallUs > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(options->consumerStallUs));
+        }
+    }
+}
+
+static void PrintUsage() {
+    fprintf(stderr,
+            "usage: pipeline_bench [--producers N] [--events N] [--rate N] [--subscriptions N]\n"
+            "                      [--policy drop-newest|drop-oldest|block|coalesce] [--ring-limit N]\n"
+            "                      [--batch-size N] [--consumer-stall-us N] [--idle-timeout-ms N]\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions* options) {
+    options->producers = 4;
+    options->events = 1000000;
+    options->rate = 0;
+    options->subscriptions = 4;
+    options->policy = OVERLOAD_DROP_NEWEST;
+    options->ringLimit = KEY_EVENT_RING_CAPACITY;
+    options->batchSize = BENCH_DEFAULT_BATCH_SIZE;
+    options->consumerStallUs = 0;
+    options->idleTimeoutMs = DEFAULT_SESSION_IDLE_TIMEOUT_MS;
+
+    for (int i = 1; i < argc; i++) {
+        const char* name = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "pipeline_bench: missing value for %s\n", name);
+            return false;
+        }
+        const char* value = argv[++i];
+        char* end = nullptr;
+        const double number = strtod(value, &end);
+        const bool isNumber = end != value && *end == '\0' && number >= 0;
+
+        if (strcmp(name, "--policy") == 0) {
+            size_t policy = 0;
+            while (policy < sizeof(kPolicyNames) / sizeof(kPolicyNames[0]) && strcmp(value, kPolicyNames[policy]) != 0) {
+                policy++;
+            }
+            if (policy == sizeof(kPolicyNames) / sizeof(kPolicyNames[0])) {
+                fprintf(stderr, "pipeline_bench: policy must be drop-newest, drop-oldest, block or coalesce\n");
+                return false;
+            }
+            options->policy = static_cast<OverloadPolicy>(policy);
+        } else if (!isNumber) {
+            fprintf(stderr, "pipeline_bench: %s expects a non-negative number\n", name);
+            return false;
+        } else if (strcmp(name, "--producers") == 0 && number >= 1) {
+            options->producers = static_cast<uint32_t>(number);
+        } else if (strcmp(name, "--events") == 0 && number >= 1) {
+            options->events = static_cast<uint64_t>(number);
+        } else if (strcmp(name, "--rate") == 0) {
+            options->rate = number;
+        } else if (strcmp(name, "--subscriptions") == 0 && number >= 1 && number <= KEYBOARD_MAX_SUBSCRIPTIONS) {
+            options->subscriptions = static_cast<uint32_t>(number);
+        } else if (strcmp(name, "--ring-limit") == 0 && number >= 1 && number <= KEY_EVENT_RING_CAPACITY) {
+            options->ringLimit = static_cast<uint32_t>(number);
+        } else if (strcmp(name, "--batch-size") == 0 && number >= 1 && number <= KEY_EVENT_RING_CAPACITY) {
+            options->batchSize = static_cast<uint32_t>(number);
+        } else if (strcmp(name, "--consumer-stall-us") == 0) {
+            options->consumerStallUs = static_cast<uint32_t>(number);
+        } else if (strcmp(name, "--idle-timeout-ms") == 0 && number >= 1) {
+            options->idleTimeoutMs = static_cast<uint32_t>(number);
+        } else {
+            fprintf(stderr, "pipeline_bench: unknown option or value out of range: %s %s\n", name, value);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void PrintHistogram(const char* label, const LatencyHistogram& histogram, double scale, const char* unit) {
+    printf("%-22s p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f %s\n", label,
+           histogram.GetPercentile(0.5) / scale, histogram.GetPercentile(0.9) / scale,
+           histogram.GetPercentile(0.99) / scale, histogram.GetPercentile(0.999) / scale,
+           histogram.GetMax() / scale, unit);
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // 캡처 단계 호출 비용 (생산자 스레드를 띄우기 전, 단일 스레드)
+    double virtualDispatchNs = 0, chainDispatchNs = 0;
+    MeasureCaptureDispatch(&virtualDispatchNs, &chainDispatchNs);
+
+    static const DeliveryMode kModes[] = { DELIVERY_EVENTS, DELIVERY_BATCHED, DELIVERY_SESSIONS, DELIVERY_RHYTHM };
+    std::atomic<bool> startGate(false);
+    std::vector<std::unique_ptr<BenchPipeline>> pipelines;
+
+    // 구성 (측정 구간 밖에서 모든 할당을 끝냄)
+    for (uint32_t p = 0; p < options.producers; p++) {
+        std::unique_ptr<BenchPipeline> pipeline(new BenchPipeline());
+        pipeline->producerDone.store(false);
+        pipeline->idleChecks = 0;
+        pipeline->snapshotReads = 0;
+        pipeline->filterSwaps = 0;
+        for (uint32_t s = 0; s < options.subscriptions; s++) {
+            // 첫 구독이 바인딩의 기본 구독처럼 저널/통계용 레코드 링을 둠
+            std::unique_ptr<BenchSubscription> sub(new BenchSubscription(s == 0));
+            sub->deliveryMode = kModes[s % (sizeof(kModes) / sizeof(kModes[0]))];
+            sub->eventRing.SetLimit(options.ringLimit);
+            sub->overloadPolicy.store(options.policy);
+            if (sub->deliveryMode == DELIVERY_BATCHED) {
+                sub->batchWakeThreshold.store(options.batchSize);
+            }
+            sub->sessionizer.SetIdleTimeout(options.idleTimeoutMs);
+            pipeline->dispatcher.Attach(sub.get());
+            pipeline->subscriptions.push_back(std::move(sub));
+        }
+        pipeline->listener.reset(new BenchListener<BenchPipeline>(*pipeline, p, options, &startGate));
+        pipelines.push_back(std::move(pipeline));
+    }
+
+    for (size_t p = 0; p < pipelines.size(); p++) {
+        BenchPipeline* pipeline = pipelines[p].get();
+        pipeline->consumer = std::thread(ConsumerThreadFunc, pipeline, &options);
+        pipeline->listener->StartListening();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    startGate.store(true, std::memory_order_release);
+
+    for (size_t p = 0; p < pipelines.size(); p++) {
+        pipelines[p]->listener->Join();
+    }
+    const auto producersDone = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < pipelines.size(); p++) {
+        pipelines[p]->producerDone.store(true, std::memory_order_release);
+    }
+    for (size_t p = 0; p < pipelines.size(); p++) {
+        pipelines[p]->consumer.join();
+        pipelines[p]->listener->StopListening();
+        for (size_t s = 0; s < pipelines[p]->subscriptions.size(); s++) {
+            pipelines[p]->dispatcher.Detach(pipelines[p]->subscriptions[s].get());
+            pipelines[p]->subscriptions[s]->eventFilter.Reclaim();
+        }
+    }
+    const auto consumersDone = std::chrono::steady_clock::now();
+
+    // 합산
+    LatencyHistogram callbackDuration;
+    LatencyHistogram dispatchDuration;
+    LatencyHistogram deliveryLatency;
+    uint64_t hookCalls = 0, filtered = 0, enqueued = 0, dropped = 0, evicted = 0, delivered = 0;
+    uint64_t blocked = 0, blockTimeouts = 0, coalesced = 0, summaries = 0, records = 0, recordsDropped = 0;
+    uint64_t wakeRequests = 0, wakeups = 0, maxDepth = 0, sessionEnds = 0, rhythmEvents = 0;
+    uint64_t hookAllocations = 0, idleChecks = 0, filterSwaps = 0;
+    uint64_t mismatched = 0, orderViolations = 0;
+
+    for (size_t p = 0; p < pipelines.size(); p++) {
+        BenchPipeline* pipeline = pipelines[p].get();
+        callbackDuration.Merge(pipeline->callbackDuration);
+        hookAllocations += pipeline->listener->GetAllocations();
+        idleChecks += pipeline->idleChecks;
+        filterSwaps += pipeline->filterSwaps;
+        for (size_t s = 0; s < pipeline->subscriptions.size(); s++) {
+            BenchSubscription* sub = pipeline->subscriptions[s].get();
+            const PipelineMetrics& metrics = sub->metrics;
+            dispatchDuration.Merge(metrics.hookDuration);
+            deliveryLatency.Merge(metrics.deliveryLatency);
+            hookCalls += metrics.hookCalls.load();
+            filtered += metrics.filtered.load();
+            enqueued += metrics.enqueued.load();
+            dropped += metrics.dropped.load();
+            evicted += metrics.evicted.load();
+            delivered += metrics.delivered.load();
+            blocked += metrics.blocked.load();
+            blockTimeouts += metrics.blockTimeouts.load();
+            coalesced += metrics.coalesced.load();
+            recordsDropped += metrics.recordsDropped.load();
+            summaries += sub->summaries;
+            records += sub->records;
+            wakeups += metrics.wakeups.load();
+            if (metrics.maxQueueDepth.load() > maxDepth) {
+                maxDepth = metrics.maxQueueDepth.load();
+            }
+            wakeRequests += sub->wakeRequests;
+            sessionEnds += sub->sessionEnds;
+            rhythmEvents += sub->rhythmEvents;
+            orderViolations += sub->orderViolations;
+
+            // 링에 들어간 항목은 꺼내졌거나 밀려났어야 함
+            // (링이 비었을 때 소비자가 직접 가져간 요약 항목은 링을 거치지 않으므로 그만큼 더 꺼낼 수 있음)
+            const uint64_t ringOut = sub->popped + metrics.evicted.load();
+            if (ringOut < metrics.enqueued.load() || ringOut > metrics.enqueued.load() + sub->summaries) {
+                fprintf(stderr, "pipeline_bench: producer %zu subscription %zu enqueued %llu but popped %llu + evicted %llu "
+                        "(%llu summaries)\n",
+                        p, s, static_cast<unsigned long long>(metrics.enqueued.load()),
+                        static_cast<unsigned long long>(sub->popped),
+                        static_cast<unsigned long long>(metrics.evicted.load()),
+                        static_cast<unsigned long long>(sub->summaries));
+                mismatched++;
+            }
+            // 합쳐진 이벤트는 모두 요약 항목으로 전달되어야 함
+            if (sub->summarizedEvents != metrics.coalesced.load()) {
+                fprintf(stderr, "pipeline_bench: producer %zu subscription %zu coalesced %llu but summaries carried %llu\n",
+                        p, s, static_cast<unsigned long long>(metrics.coalesced.load()),
+                        static_cast<unsigned long long>(sub->summarizedEvents));
+                mismatched++;
+            }
+        }
+    }
+
+    const double produceSec = std::chrono::duration<double>(producersDone - start).count();
+    const double totalSec = std::chrono::duration<double>(consumersDone - start).count();
+    const uint64_t produced = options.events * options.producers;
+
+    printf("pipeline_bench: producers %u, subscriptions %u/producer, events %llu/producer, rate %s, "
+           "policy %s, ring limit %u, consumer stall %u us\n",
+           options.producers, options.subscriptions, static_cast<unsigned long long>(options.events),
+           options.rate > 0 ? "paced" : "max", kPolicyNames[options.policy],
+           options.ringLimit, options.consumerStallUs);
+    if (options.rate > 0) {
+        printf("%-22s %.0f events/s per producer\n", "target rate", options.rate);
+    }
+    printf("%-22s %.3f s (drained after %.3f s)\n", "elapsed", produceSec, totalSec);
+    printf("%-22s %.3f M events/s\n", "throughput", produceSec > 0 ? produced / produceSec / 1e6 : 0.0);
+    printf("%-22s %llu dispatched, %llu filtered, %llu enqueued, %llu dropped, %llu evicted\n", "subscriptions",
+           static_cast<unsigned long long>(hookCalls), static_cast<unsigned long long>(filtered),
+           static_cast<unsigned long long>(enqueued), static_cast<unsigned long long>(dropped),
+           static_cast<unsigned long long>(evicted));
+    printf("%-22s %llu blocked (%llu timed out), %llu coalesced into %llu summaries\n", "overload",
+           static_cast<unsigned long long>(blocked), static_cast<unsigned long long>(blockTimeouts),
+           static_cast<unsigned long long>(coalesced), static_cast<unsigned long long>(summaries));
+    printf("%-22s %llu drained, %llu dropped\n", "typing records",
+           static_cast<unsigned long long>(records), static_cast<unsigned long long>(recordsDropped));
+    printf("%-22s %llu delivered, %llu session ends, %llu rhythm events\n", "consumers",
+           static_cast<unsigned long long>(delivered), static_cast<unsigned long long>(sessionEnds),
+           static_cast<unsigned long long>(rhythmEvents));
+    printf("%-22s %llu (%.4f per event), %llu drain rounds with data\n", "wake requests",
+           static_cast<unsigned long long>(wakeRequests), hookCalls > 0 ? static_cast<double>(wakeRequests) / hookCalls : 0.0,
+           static_cast<unsigned long long>(wakeups));
+    printf("%-22s %llu\n", "max queue depth", static_cast<unsigned long long>(maxDepth));
+    printf("%-22s %.2f virtual + std::function, %.2f composed chain (ns/event, classify → sink)\n",
+           "capture dispatch", virtualDispatchNs, chainDispatchNs);
+    PrintHistogram("hook callback (ns)", callbackDuration, 1.0, "");
+    PrintHistogram("per dispatch (ns)", dispatchDuration, 1.0, "");
+    PrintHistogram("delivery (us)", deliveryLatency, 1000.0, "");
+    printf("%-22s %llu (%.4f per event)\n", "hook allocations",
+           static_cast<unsigned long long>(hookAllocations), produced > 0 ? static_cast<double>(hookAllocations) / produced : 0.0);
+    printf("%-22s %llu idle checks, %llu filter swaps\n", "concurrent readers",
+           static_cast<unsigned long long>(idleChecks), static_cast<unsigned long long>(filterSwaps));
+
+    if (mismatched > 0 || orderViolations > 0) {
+        fprintf(stderr, "pipeline_bench: FAILED (%llu ring accounting mismatches, %llu out-of-order events)\n",
+                static_cast<unsigned long long>(mismatched), static_cast<unsigned long long>(orderViolations));
+        return 1;
+    }
+    return 0;
+}
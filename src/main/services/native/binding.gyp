@@ -1,10 +1,46 @@
 {
+  "variables": {
+    "pipeline_bench%": 0,
+    "pipeline_bench_sources": [
+      "bench/pipeline-bench.cc",
+      "common/event-clock.cc",
+      "common/event-filter.cc",
+      "common/key-state.cc",
+      "common/sessionizer.cc",
+      "common/pipeline-metrics.cc",
+      "common/live-state.cc",
+      "common/rhythm-detector.cc",
+      "common/trace-recorder.cc",
+      "common/capture-dispatch.cc"
+    ],
+    "pipeline_bench_include_dirs": [
+      "common/"
+    ]
+  },
   "targets": [
     {
       "target_name": "keyboard_native",
       "sources": [
         "bindings/keyboard-native.cc",
-        "common/keyboard-base.cc"
+        "common/event-clock.cc",
+        "common/event-filter.cc",
+        "common/key-state.cc",
+        "common/app-registry.cc",
+        "common/keyboard-trace.cc",
+        "common/keyboard-replay.cc",
+        "common/sessionizer.cc",
+        "common/interval-stats.cc",
+        "common/pipeline-metrics.cc",
+        "common/event-journal.cc",
+        "common/stats-rollup.cc",
+        "common/stats-snapshot.cc",
+        "common/time-bucket-index.cc",
+        "common/event-archive.cc",
+        "common/analytics-kernels.cc",
+        "common/live-state.cc",
+        "common/rhythm-detector.cc",
+        "common/trace-recorder.cc",
+        "common/capture-dispatch.cc"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
@@ -19,6 +55,13 @@
       "cflags_cc!": [ "-fno-exceptions" ],
       "defines": [ "NAPI_DISABLE_CPP_EXCEPTIONS" ],
       "conditions": [
+        [
+          "target_arch=='x64' or target_arch=='ia32'",
+          {
+            "dependencies": [ "analytics_avx2" ],
+            "defines": [ "ANALYTICS_HAVE_AVX2" ]
+          }
+        ],
         [
           "OS=='mac'",
           {
@@ -63,6 +106,8 @@
           {
             "sources": [
               "platform/linux/keyboard-linux.cc",
+              "platform/linux/keyboard-evdev.cc",
+              "platform/linux/active-window-linux.cc",
               "platform/linux/permissions-linux.cc"
             ],
             "libraries": [
@@ -80,6 +125,66 @@
           }
         ]
       ]
+    },
+    {
+      "target_name": "analytics_avx2",
+      "type": "static_library",
+      "sources": [
+        "common/analytics-kernels-avx2.cc"
+      ],
+      "include_dirs": [
+        "common/"
+      ],
+      "cflags": [ "-mavx2" ],
+      "xcode_settings": {
+        "OTHER_CFLAGS": [ "-mavx2" ]
+      },
+      "msvs_settings": {
+        "VCCLCompilerTool": {
+          "EnableEnhancedInstructionSet": "5"
+        }
+      }
     }
+  ],
+  "conditions": [
+    [
+      "OS!='win' and pipeline_bench==1",
+      {
+        "targets": [
+          {
+            "target_name": "pipeline_bench",
+            "type": "executable",
+            "sources": [ "<@(pipeline_bench_sources)" ],
+            "include_dirs": [ "<@(pipeline_bench_include_dirs)" ],
+            "cflags": [ "-g" ],
+            "ldflags": [ "-pthread" ]
+          },
+          {
+            "target_name": "pipeline_bench_tsan",
+            "type": "executable",
+            "sources": [ "<@(pipeline_bench_sources)" ],
+            "include_dirs": [ "<@(pipeline_bench_include_dirs)" ],
+            "cflags": [ "-g", "-O1", "-fno-omit-frame-pointer", "-fsanitize=thread" ],
+            "ldflags": [ "-pthread", "-fsanitize=thread" ],
+            "xcode_settings": {
+              "OTHER_CFLAGS": [ "-g", "-O1", "-fno-omit-frame-pointer", "-fsanitize=thread" ],
+              "OTHER_LDFLAGS": [ "-fsanitize=thread" ]
+            }
+          },
+          {
+            "target_name": "pipeline_bench_asan",
+            "type": "executable",
+            "sources": [ "<@(pipeline_bench_sources)" ],
+            "include_dirs": [ "<@(pipeline_bench_include_dirs)" ],
+            "cflags": [ "-g", "-O1", "-fno-omit-frame-pointer", "-fsanitize=address,undefined" ],
+            "ldflags": [ "-pthread", "-fsanitize=address,undefined" ],
+            "xcode_settings": {
+              "OTHER_CFLAGS": [ "-g", "-O1", "-fno-omit-frame-pointer", "-fsanitize=address,undefined" ],
+              "OTHER_LDFLAGS": [ "-fsanitize=address,undefined" ]
+            }
+          }
+        ]
+      }
+    ]
   ]
 }
\ No newline at end of file
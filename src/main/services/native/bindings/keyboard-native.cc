@@ -1,42 +1,162 @@
 #include "keyboard-native.h"
 #include "../common/keyboard-base.h"
+#include "../common/keyboard-replay.h"
 
 #ifdef __APPLE__
 #include "../platform/macos/keyboard-macos.h"
+#elif __linux__
+#include "../platform/linux/keyboard-linux.h"
+#include "../platform/linux/keyboard-evdev.h"
 #endif
 
 #include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
 
-// 정적 멤버 초기화
+// 정적 멤버 초기화 (프로세스 공유 - OS 후킹과 구독 슬롯)
 std::unique_ptr<KeyboardListenerBase> KeyboardNativeBinding::s_listener = nullptr;
-napi_threadsafe_function KeyboardNativeBinding::s_callback = nullptr;
-napi_env KeyboardNativeBinding::s_env = nullptr;
+std::mutex KeyboardNativeBinding::s_listenerMutex;
+size_t KeyboardNativeBinding::s_attachedCount = 0;
+#if defined(__APPLE__)
+CaptureDispatcher KeyboardNativeBinding::s_dispatcher(kMacModifierKeys);
+#elif defined(_WIN32)
+CaptureDispatcher KeyboardNativeBinding::s_dispatcher(kWindowsModifierKeys);
+#else
+CaptureDispatcher KeyboardNativeBinding::s_dispatcher(kXModifierKeys);   // XRecord/evdev/재생 백엔드 공용 (X 키 코드)
+#endif
+
+KeyboardSubscription::KeyboardSubscription(uint32_t subscriptionId, KeyboardAddonInstance* owner)
+    : CaptureSubscription(subscriptionId == KEYBOARD_PRIMARY_SUBSCRIPTION_ID, KeyboardNativeBinding::WakeJS),
+      id(subscriptionId),
+      instance(owner),
+      callback(nullptr),
+      generation(0),
+      attached(false),
+      closing(false),
+      openHandles(0),
+      lastReportedSessionEnd(0),
+      idleTimerInitialized(false),
+      idleTimerArmed(false),
+      lastReportedPause(0),
+      lastReportedRateLow(0),
+      batchConfig{ DEFAULT_BATCH_MAX_SIZE, DEFAULT_BATCH_MAX_LATENCY_MS },
+      batchTimestampsRef(nullptr),
+      batchKeyCodesRef(nullptr),
+      batchFlagsRef(nullptr),
+      batchAppIdsRef(nullptr),
+      batchBufferSize(0),
+      flushTimerInitialized(false),
+      flushTimerArmed(false),
+      flushDue(false),
+      wakeNs(0) {
+}
+
+// 과부하 정책 이름 (OverloadPolicy 순서)
+static const char* const kOverloadPolicyNames[] = { "drop-newest", "drop-oldest", "block", "coalesce" };
+
+// 리듬 이벤트 이름 (RhythmEventType 순서)
+static const char* const kRhythmEventNames[] = { "none", "burst", "pause", "rate-high", "rate-low", "streak" };
+
+// 세션 ID 문자열 생성 (session_<시작 epoch ms>_<일련번호>)
+// EventJournal.ts/TypingArchive.ts가 레코드 열에서 같은 형식으로 만들어 저장하므로 형식을 바꾸면 함께 바꿀 것
+static napi_value CreateSessionId(napi_env env, uint64_t sessionStart, uint32_t sessionSeq) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "session_%llu_%u", static_cast<unsigned long long>(sessionStart), sessionSeq);
+    napi_value sessionId;
+    napi_create_string_utf8(env, buffer, NAPI_AUTO_LENGTH, &sessionId);
+    return sessionId;
+}
 
-// 플랫폼별 리스너 생성
-KeyboardListenerBase* CreatePlatformListener() {
+// 플랫폼별 리스너 생성 (키 이벤트는 sink로 전달)
+template <typename Sink>
+static KeyboardListenerBase* CreatePlatformListener(Sink& sink) {
 #ifdef __APPLE__
-    return new KeyboardListenerMacOS();
+    return new KeyboardListenerMacOS<Sink>(sink);
 #elif _WIN32
     // Windows 구현 (나중에 추가)
     return nullptr;
 #elif __linux__
-    // Linux 구현 (나중에 추가)
-    return nullptr;
+    // X 서버가 없으면 (Wayland, 헤드리스) evdev 장치를 직접 읽음
+    const char* display = getenv("DISPLAY");
+    if (!display || !*display) {
+        return new KeyboardListenerEvdev<Sink>(sink);
+    }
+    return new KeyboardListenerLinux<Sink>(sink);
 #else
     return nullptr;
 #endif
 }
 
-// Node.js 모듈 초기화
+// Node.js 모듈 초기화 (환경마다 한 번 - 메인 스레드와 각 worker_thread가 각자의 인스턴스를 가짐)
 napi_value KeyboardNativeBinding::Init(napi_env env, napi_value exports) {
-    s_env = env;
+    KeyboardAddonInstance* instance = new KeyboardAddonInstance();
+    instance->env = env;
+    instance->primary = new KeyboardSubscription(KEYBOARD_PRIMARY_SUBSCRIPTION_ID, instance);
+    instance->subscriptions.push_back(instance->primary);
+    instance->nextSubscriptionId = KEYBOARD_PRIMARY_SUBSCRIPTION_ID + 1;
+    
+    if (napi_set_instance_data(env, instance, FinalizeInstance, nullptr) != napi_ok) {
+        delete instance->primary;
+        delete instance;
+        napi_throw_error(env, nullptr, "Failed to set instance data");
+        return nullptr;
+    }
     
     // API 함수들을 exports 객체에 추가
     napi_property_descriptor desc[] = {
         DECLARE_NAPI_METHOD("startListening", StartListening),
+        DECLARE_NAPI_METHOD("startListeningBatched", StartListeningBatched),
+        DECLARE_NAPI_METHOD("startTypingSessions", StartTypingSessions),
+        DECLARE_NAPI_METHOD("subscribe", Subscribe),
+        DECLARE_NAPI_METHOD("unsubscribe", Unsubscribe),
+        DECLARE_NAPI_METHOD("setIdleTimeout", SetIdleTimeout),
+        DECLARE_NAPI_METHOD("setEventFilter", SetEventFilter),
+        DECLARE_NAPI_METHOD("setOverloadPolicy", SetOverloadPolicy),
+        DECLARE_NAPI_METHOD("setRhythmOptions", SetRhythmOptions),
+        DECLARE_NAPI_METHOD("getSessionStats", GetSessionStats),
+        DECLARE_NAPI_METHOD("resetSessionStats", ResetSessionStats),
         DECLARE_NAPI_METHOD("stopListening", StopListening),
         DECLARE_NAPI_METHOD("checkPermissions", CheckPermissions),
         DECLARE_NAPI_METHOD("isListening", IsListening),
+        DECLARE_NAPI_METHOD("setListenerBackend", SetListenerBackend),
+        DECLARE_NAPI_METHOD("getMetrics", GetMetrics),
+        DECLARE_NAPI_METHOD("resetMetrics", ResetMetrics),
+        DECLARE_NAPI_METHOD("getClockAnchor", GetClockAnchor),
+        DECLARE_NAPI_METHOD("openJournal", OpenJournal),
+        DECLARE_NAPI_METHOD("closeJournal", CloseJournal),
+        DECLARE_NAPI_METHOD("journalRange", JournalRange),
+        DECLARE_NAPI_METHOD("journalSealedSegments", JournalSealedSegments),
+        DECLARE_NAPI_METHOD("journalReadSegment", JournalReadSegment),
+        DECLARE_NAPI_METHOD("journalReleaseSegment", JournalReleaseSegment),
+        DECLARE_NAPI_METHOD("takeRollups", TakeRollups),
+        DECLARE_NAPI_METHOD("loadStatsSnapshot", LoadStatsSnapshot),
+        DECLARE_NAPI_METHOD("saveStatsSnapshot", SaveStatsSnapshot),
+        DECLARE_NAPI_METHOD("getRunningStats", GetRunningStats),
+        DECLARE_NAPI_METHOD("reconcileStats", ReconcileStats),
+        DECLARE_NAPI_METHOD("timeIndexAdd", TimeIndexAdd),
+        DECLARE_NAPI_METHOD("timeIndexQuery", TimeIndexQuery),
+        DECLARE_NAPI_METHOD("timeIndexInfo", TimeIndexInfo),
+        DECLARE_NAPI_METHOD("getAppTable", GetAppTable),
+        DECLARE_NAPI_METHOD("getAppStats", GetAppStats),
+        DECLARE_NAPI_METHOD("openArchive", OpenArchive),
+        DECLARE_NAPI_METHOD("closeArchive", CloseArchive),
+        DECLARE_NAPI_METHOD("archiveAppend", ArchiveAppend),
+        DECLARE_NAPI_METHOD("archiveScan", ArchiveScan),
+        DECLARE_NAPI_METHOD("archiveInfo", ArchiveInfo),
+        DECLARE_NAPI_METHOD("analyze", Analyze),
+        DECLARE_NAPI_METHOD("getAnalyticsKernel", GetAnalyticsKernel),
+        DECLARE_NAPI_METHOD("readSnapshot", ReadSnapshot),
+        DECLARE_NAPI_METHOD("setLiveStateOptions", SetLiveStateOptions),
+        DECLARE_NAPI_METHOD("getKeyState", GetKeyState),
+        DECLARE_NAPI_METHOD("startTrace", StartTrace),
+        DECLARE_NAPI_METHOD("stopTrace", StopTrace),
+        DECLARE_NAPI_METHOD("flushTrace", FlushTrace),
+        DECLARE_NAPI_METHOD("traceSpan", RecordTraceSpan),
     };
     
     napi_status status = napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc);
@@ -48,7 +168,65 @@ napi_value KeyboardNativeBinding::Init(napi_env env, napi_value exports) {
     return exports;
 }
 
-// 키보드 리스닝 시작
+// 환경 종료 - 이 환경의 구독을 모두 OS 후킹에서 떼어내고 해제
+// (다른 환경의 구독이 남아 있으면 OS 후킹은 계속 실행됨)
+void KeyboardNativeBinding::FinalizeInstance(napi_env env, void* data, void* hint) {
+    KeyboardAddonInstance* instance = static_cast<KeyboardAddonInstance*>(data);
+    
+    const std::vector<KeyboardSubscription*> subscriptions = instance->subscriptions;
+    for (KeyboardSubscription* sub : subscriptions) {
+        if (!sub->closing) {
+            StopSubscription(sub);
+            CloseSubscription(env, sub);
+        }
+    }
+    
+    // 아직 핸들이 닫히지 않은 구독은 환경 없이 삭제를 기다림
+    for (KeyboardSubscription* sub : instance->subscriptions) {
+        sub->instance = nullptr;
+    }
+    delete instance;
+}
+
+// 현재 환경의 인스턴스 데이터
+KeyboardAddonInstance* KeyboardNativeBinding::GetInstance(napi_env env) {
+    void* data = nullptr;
+    napi_get_instance_data(env, &data);
+    return static_cast<KeyboardAddonInstance*>(data);
+}
+
+// args[index]의 구독 ID로 구독 찾기 (생략하면 기본 구독, 없는 ID면 예외 후 nullptr)
+KeyboardSubscription* KeyboardNativeBinding::ResolveSubscription(napi_env env, napi_value* args, size_t argc, size_t index) {
+    KeyboardAddonInstance* instance = GetInstance(env);
+    if (!instance) {
+        napi_throw_error(env, nullptr, "Keyboard module is not initialized");
+        return nullptr;
+    }
+    if (argc <= index) {
+        return instance->primary;
+    }
+    
+    napi_valuetype valuetype;
+    napi_typeof(env, args[index], &valuetype);
+    if (valuetype == napi_undefined || valuetype == napi_null) {
+        return instance->primary;
+    }
+    
+    uint32_t id = 0;
+    if (valuetype != napi_number || napi_get_value_uint32(env, args[index], &id) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected subscription id to be a number");
+        return nullptr;
+    }
+    for (KeyboardSubscription* sub : instance->subscriptions) {
+        if (sub->id == id && !sub->closing) {
+            return sub;
+        }
+    }
+    napi_throw_range_error(env, nullptr, "Unknown subscription id");
+    return nullptr;
+}
+
+// 키보드 리스닝 시작 (이벤트당 객체 하나씩 전달)
 napi_value KeyboardNativeBinding::StartListening(napi_env env, napi_callback_info info) {
     size_t argc = 1;
     napi_value args[1];
@@ -70,137 +248,2868 @@ napi_value KeyboardNativeBinding::StartListening(napi_env env, napi_callback_inf
     }
     
     // 이미 리스닝 중인지 확인
-    if (s_listener && s_listener->IsListening()) {
+    KeyboardSubscription* sub = GetInstance(env)->primary;
+    if (sub->callback) {
         napi_value result;
         napi_get_boolean(env, false, &result);
         return result;
     }
     
-    // 플랫폼 리스너 생성
-    if (!s_listener) {
-        s_listener.reset(CreatePlatformListener());
-        if (!s_listener) {
-            napi_throw_error(env, nullptr, "Unsupported platform");
+    return StartSubscription(env, sub, DELIVERY_EVENTS, args[0], nullptr);
+}
+
+// 배치 키보드 리스닝 시작
+// callback(timestamps: Float64Array, keyCodes: Uint32Array, flags: Uint8Array, count: number)
+// 배열은 전달 사이에 재사용되므로 콜백 밖에서 보관하려면 복사해야 함
+napi_value KeyboardNativeBinding::StartListeningBatched(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_status status;
+    
+    // 인자 파싱 (콜백 함수, 옵션)
+    status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected callback function");
+        return nullptr;
+    }
+    
+    // 콜백 함수 타입 확인
+    napi_valuetype valuetype;
+    status = napi_typeof(env, args[0], &valuetype);
+    if (status != napi_ok || valuetype != napi_function) {
+        napi_throw_error(env, nullptr, "Expected callback to be a function");
+        return nullptr;
+    }
+    
+    // 이미 리스닝 중인지 확인
+    KeyboardSubscription* sub = GetInstance(env)->primary;
+    if (sub->callback) {
+        napi_value result;
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    return StartSubscription(env, sub, DELIVERY_BATCHED, args[0], argc >= 2 ? args[1] : nullptr);
+}
+
+// 타이핑 세션 추적 시작
+// callback(metadata: { timestamp, keyCount, interval, isActive, sessionId })
+// 세션에 포함되는 키 입력마다 isActive=true, 유휴 타임아웃으로 세션이 끝나면 isActive=false 레코드 전달
+napi_value KeyboardNativeBinding::StartTypingSessions(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_status status;
+    
+    // 인자 파싱 (콜백 함수, 옵션)
+    status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected callback function");
+        return nullptr;
+    }
+    
+    // 콜백 함수 타입 확인
+    napi_valuetype valuetype;
+    status = napi_typeof(env, args[0], &valuetype);
+    if (status != napi_ok || valuetype != napi_function) {
+        napi_throw_error(env, nullptr, "Expected callback to be a function");
+        return nullptr;
+    }
+    
+    // 이미 리스닝 중인지 확인
+    KeyboardSubscription* sub = GetInstance(env)->primary;
+    if (sub->callback) {
+        napi_value result;
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    return StartSubscription(env, sub, DELIVERY_SESSIONS, args[0], argc >= 2 ? args[1] : nullptr);
+}
+
+// 추가 구독 - subscribe(mode, callback, options?) → 구독 ID
+// mode: 'events' | 'batched' | 'sessions' (콜백 형태는 각각 startListening/startListeningBatched/startTypingSessions와 같음)
+//       'rhythm' - callback({ type, timestamp, value, sessionId? }) 의미 이벤트만 (키마다 깨우지 않음)
+// options: 배치/세션/리듬 옵션 + { filter?: 이벤트 필터 옵션, overload?: 과부하 정책 옵션 }
+// 같은 OS 후킹을 공유하며, 필터/배치/세션/과부하 상태는 구독마다 따로 가짐
+napi_value KeyboardNativeBinding::Subscribe(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_status status;
+    
+    status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        napi_throw_error(env, nullptr, "Expected delivery mode and callback function");
+        return nullptr;
+    }
+    
+    char modeName[16];
+    size_t modeLength = 0;
+    DeliveryMode mode;
+    if (napi_get_value_string_utf8(env, args[0], modeName, sizeof(modeName), &modeLength) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected delivery mode to be a string");
+        return nullptr;
+    }
+    if (strcmp(modeName, "events") == 0) {
+        mode = DELIVERY_EVENTS;
+    } else if (strcmp(modeName, "batched") == 0) {
+        mode = DELIVERY_BATCHED;
+    } else if (strcmp(modeName, "sessions") == 0) {
+        mode = DELIVERY_SESSIONS;
+    } else if (strcmp(modeName, "rhythm") == 0) {
+        mode = DELIVERY_RHYTHM;
+    } else {
+        napi_throw_range_error(env, nullptr, "mode must be 'events', 'batched', 'sessions' or 'rhythm'");
+        return nullptr;
+    }
+    
+    napi_valuetype valuetype;
+    status = napi_typeof(env, args[1], &valuetype);
+    if (status != napi_ok || valuetype != napi_function) {
+        napi_throw_error(env, nullptr, "Expected callback to be a function");
+        return nullptr;
+    }
+    
+    napi_value options = nullptr;
+    napi_value filterOptions = nullptr;
+    napi_value overloadOptions = nullptr;
+    if (argc >= 3) {
+        napi_typeof(env, args[2], &valuetype);
+        if (valuetype == napi_object) {
+            options = args[2];
+            bool hasProperty = false;
+            napi_has_named_property(env, options, "filter", &hasProperty);
+            if (hasProperty) {
+                napi_get_named_property(env, options, "filter", &filterOptions);
+            }
+            napi_has_named_property(env, options, "overload", &hasProperty);
+            if (hasProperty) {
+                napi_get_named_property(env, options, "overload", &overloadOptions);
+            }
+        } else if (valuetype != napi_undefined && valuetype != napi_null) {
+            napi_throw_type_error(env, nullptr, "Expected options to be an object");
             return nullptr;
         }
     }
     
-    // Thread-safe 함수 생성
-    napi_value async_resource_name;
-    status = napi_create_string_utf8(env, "KeyboardCallback", NAPI_AUTO_LENGTH, &async_resource_name);
-    if (status != napi_ok) {
-        napi_throw_error(env, nullptr, "Failed to create async resource name");
+    KeyboardAddonInstance* instance = GetInstance(env);
+    KeyboardSubscription* sub = new KeyboardSubscription(instance->nextSubscriptionId++, instance);
+    instance->subscriptions.push_back(sub);
+    
+    if (!ApplyEventFilterOptions(env, sub, filterOptions) ||
+        !ApplyOverloadOptions(env, sub, overloadOptions)) {
+        CloseSubscription(env, sub);
         return nullptr;
     }
     
-    status = napi_create_threadsafe_function(
-        env,
-        args[0],                    // JavaScript 콜백 함수
-        nullptr,                    // async_resource
-        async_resource_name,        // async_resource_name
-        0,                          // max_queue_size (무제한)
-        1,                          // initial_thread_count
-        nullptr,                    // thread_finalize_data
-        nullptr,                    // thread_finalize_cb
-        nullptr,                    // context
-        CallJS,                     // call_js_cb
-        &s_callback                 // result
-    );
+    napi_value started = StartSubscription(env, sub, mode, args[1], options);
+    bool success = false;
+    if (started) {
+        napi_get_value_bool(env, started, &success);
+    }
+    if (!success) {
+        CloseSubscription(env, sub);
+        if (started) {
+            napi_throw_error(env, nullptr, "Failed to start keyboard listener");
+        }
+        return nullptr;
+    }
     
-    if (status != napi_ok) {
-        napi_throw_error(env, nullptr, "Failed to create threadsafe function");
+    napi_value result;
+    napi_create_uint32(env, sub->id, &result);
+    return result;
+}
+
+// 구독 해제 - unsubscribe(id) (기본 구독 ID면 stopListening과 같음)
+napi_value KeyboardNativeBinding::Unsubscribe(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected subscription id");
+        return nullptr;
+    }
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 0);
+    if (!sub) {
         return nullptr;
     }
     
-    // 키보드 리스닝 시작
-    bool success = s_listener->StartListening(KeyEventCallback);
+    bool success = StopSubscription(sub);
+    if (sub != GetInstance(env)->primary) {
+        CloseSubscription(env, sub);
+    }
     
     napi_value result;
     napi_get_boolean(env, success, &result);
     return result;
 }
 
-// 키보드 리스닝 중지
-napi_value KeyboardNativeBinding::StopListening(napi_env env, napi_callback_info info) {
-    bool success = true;
+// 세션 유휴 타임아웃 변경 (밀리초) - setIdleTimeout(timeoutMs, subscriptionId?)
+napi_value KeyboardNativeBinding::SetIdleTimeout(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    uint32_t idleTimeoutMs = 0;
     
-    if (s_listener) {
-        success = s_listener->StopListening();
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1 ||
+        napi_get_value_uint32(env, args[0], &idleTimeoutMs) != napi_ok || idleTimeoutMs == 0) {
+        napi_throw_range_error(env, nullptr, "Expected idle timeout to be a positive integer");
+        return nullptr;
     }
     
-    // Thread-safe 함수 정리
-    if (s_callback) {
-        napi_release_threadsafe_function(s_callback, napi_tsfn_release);
-        s_callback = nullptr;
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 1);
+    if (!sub) {
+        return nullptr;
+    }
+    
+    sub->sessionizer.SetIdleTimeout(idleTimeoutMs);
+    
+    // 예약된 유휴 확인 시각이 바뀌므로 즉시 다시 확인하도록 함
+    if (sub->deliveryMode == DELIVERY_SESSIONS) {
+        StopIdleTimer(sub);
+        WakeJS(sub);
     }
     
     napi_value result;
-    napi_get_boolean(env, success, &result);
+    napi_get_undefined(env, &result);
     return result;
 }
 
-// 권한 확인
-napi_value KeyboardNativeBinding::CheckPermissions(napi_env env, napi_callback_info info) {
-    if (!s_listener) {
-        s_listener.reset(CreatePlatformListener());
-        if (!s_listener) {
-            napi_throw_error(env, nullptr, "Unsupported platform");
-            return nullptr;
+// 이벤트 필터 설정 - setEventFilter({ keyUp, special, customMask }, subscriptionId?) → 적용된 설정
+// 지정하지 않은 항목은 현재 값 유지, 리스닝 중에도 바로 교체됨
+// customMask는 걸러낼 키 코드 배열 (빈 배열이면 해제)
+napi_value KeyboardNativeBinding::SetEventFilter(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 1);
+    if (!sub || !ApplyEventFilterOptions(env, sub, argc >= 1 ? args[0] : nullptr)) {
+        return nullptr;
+    }
+    
+    return CreateEventFilterObject(env, sub->eventFilter.GetConfig());
+}
+
+// 링 과부하 정책 설정 (리스닝 중에도 변경 가능)
+// setOverloadPolicy({ policy?, blockTimeoutMs?, maxQueueDepth? }, subscriptionId?) → 적용된 설정
+napi_value KeyboardNativeBinding::SetOverloadPolicy(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 1);
+    if (!sub || !ApplyOverloadOptions(env, sub, argc >= 1 ? args[0] : nullptr)) {
+        return nullptr;
+    }
+    
+    return CreateOverloadPolicyObject(env, sub);
+}
+
+// 리듬 판정 기준 설정 - setRhythmOptions({ burstGapMs, burstMinKeys, pauseMs, rateHighKps, rateLowKps,
+//                                         rateWindowMs, streakMs }, subscriptionId?) → 적용된 설정
+// 지정하지 않은 항목은 현재 값 유지, 리스닝 중에도 다음 키 입력부터 반영
+napi_value KeyboardNativeBinding::SetRhythmOptions(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 1);
+    if (!sub || !ApplyRhythmOptions(env, sub, argc >= 1 ? args[0] : nullptr)) {
+        return nullptr;
+    }
+    
+    // 판정 시각이 바뀌므로 예약된 유휴 확인을 다시 계산
+    if (sub->deliveryMode == DELIVERY_RHYTHM && sub->attached) {
+        StopIdleTimer(sub);
+        WakeJS(sub);
+    }
+    
+    return CreateRhythmConfigObject(env, sub->rhythmDetector.GetConfig());
+}
+
+// 이벤트 필터 옵션 적용 ({ keyUp, special, customMask }, 생략하거나 null이면 그대로)
+bool KeyboardNativeBinding::ApplyEventFilterOptions(napi_env env, KeyboardSubscription* sub, napi_value options) {
+    if (options) {
+        napi_valuetype valuetype;
+        napi_typeof(env, options, &valuetype);
+        if (valuetype == napi_undefined || valuetype == napi_null) {
+            options = nullptr;
+        } else if (valuetype != napi_object) {
+            napi_throw_type_error(env, nullptr, "Expected filter options to be an object");
+            return false;
         }
     }
     
-    PermissionInfo permInfo = s_listener->CheckPermissions();
-    return CreatePermissionObject(env, permInfo);
+    EventFilterConfig config = sub->eventFilter.GetConfig();
+    double keyUp = config.keyUp ? 1 : 0;
+    double special = config.special ? 1 : 0;
+    double repeats = config.repeats ? 1 : 0;
+    if (!ReadNumberOption(env, options, "keyUp", &keyUp) ||
+        !ReadNumberOption(env, options, "special", &special) ||
+        !ReadNumberOption(env, options, "repeats", &repeats) ||
+        !ReadKeyCodeSetOption(env, options, "customMask", &config.customMask)) {
+        return false;
+    }
+    config.keyUp = keyUp != 0;
+    config.special = special != 0;
+    config.repeats = repeats != 0;
+    
+    sub->eventFilter.Configure(config);
+    if (!sub->attached) {
+        sub->eventFilter.Reclaim();
+    }
+    return true;
 }
 
-// 리스닝 상태 확인
-napi_value KeyboardNativeBinding::IsListening(napi_env env, napi_callback_info info) {
-    bool isListening = s_listener && s_listener->IsListening();
+// 과부하 정책 옵션 적용 ({ policy, blockTimeoutMs, maxQueueDepth }, 생략하거나 null이면 그대로)
+bool KeyboardNativeBinding::ApplyOverloadOptions(napi_env env, KeyboardSubscription* sub, napi_value options) {
+    if (options) {
+        napi_valuetype valuetype;
+        napi_typeof(env, options, &valuetype);
+        if (valuetype == napi_undefined || valuetype == napi_null) {
+            options = nullptr;
+        } else if (valuetype != napi_object) {
+            napi_throw_type_error(env, nullptr, "Expected overload options to be an object");
+            return false;
+        }
+    }
+    
+    int policy = sub->overloadPolicy.load(std::memory_order_relaxed);
+    std::string policyName = kOverloadPolicyNames[policy];
+    double blockTimeoutMs = sub->blockTimeoutMs.load(std::memory_order_relaxed);
+    double maxQueueDepth = static_cast<double>(sub->eventRing.GetLimit());
+    if (!ReadStringOption(env, options, "policy", &policyName) ||
+        !ReadNumberOption(env, options, "blockTimeoutMs", &blockTimeoutMs) ||
+        !ReadNumberOption(env, options, "maxQueueDepth", &maxQueueDepth)) {
+        return false;
+    }
+    
+    policy = -1;
+    for (int i = 0; i < static_cast<int>(sizeof(kOverloadPolicyNames) / sizeof(kOverloadPolicyNames[0])); i++) {
+        if (policyName == kOverloadPolicyNames[i]) {
+            policy = i;
+        }
+    }
+    if (policy < 0) {
+        napi_throw_range_error(env, nullptr, "policy must be 'drop-newest', 'drop-oldest', 'block' or 'coalesce'");
+        return false;
+    }
+    if (blockTimeoutMs > MAX_OVERLOAD_BLOCK_TIMEOUT_MS) {
+        napi_throw_range_error(env, nullptr, "blockTimeoutMs must not exceed 1000");
+        return false;
+    }
+    if (maxQueueDepth < 1 || maxQueueDepth > KEY_EVENT_RING_CAPACITY || maxQueueDepth != floor(maxQueueDepth)) {
+        napi_throw_range_error(env, nullptr, "maxQueueDepth must be an integer between 1 and 4096");
+        return false;
+    }
+    
+    sub->blockTimeoutMs.store(static_cast<uint32_t>(blockTimeoutMs), std::memory_order_relaxed);
+    sub->eventRing.SetLimit(static_cast<size_t>(maxQueueDepth));
+    sub->overloadPolicy.store(policy, std::memory_order_relaxed);
+    
+    // 대기 중인 후킹 스레드는 바뀐 정책으로 다시 판단하도록 깨움
+    if (sub->producerBlocked.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(sub->blockMutex);
+        sub->blockCondition.notify_one();
+    }
+    return true;
+}
+
+// 세션 옵션 적용 ({ idleTimeoutMs?: number })
+bool KeyboardNativeBinding::ApplyIdleTimeoutOption(napi_env env, KeyboardSubscription* sub, napi_value options) {
+    napi_valuetype valuetype;
+    napi_status status = napi_typeof(env, options, &valuetype);
+    if (status == napi_ok && valuetype == napi_object) {
+        bool hasProperty = false;
+        napi_has_named_property(env, options, "idleTimeoutMs", &hasProperty);
+        if (hasProperty) {
+            napi_value value;
+            uint32_t idleTimeoutMs = 0;
+            napi_get_named_property(env, options, "idleTimeoutMs", &value);
+            if (napi_get_value_uint32(env, value, &idleTimeoutMs) != napi_ok || idleTimeoutMs == 0) {
+                napi_throw_range_error(env, nullptr, "idleTimeoutMs must be a positive integer");
+                return false;
+            }
+            sub->sessionizer.SetIdleTimeout(idleTimeoutMs);
+        }
+    } else if (status == napi_ok && valuetype != napi_undefined && valuetype != napi_null) {
+        napi_throw_type_error(env, nullptr, "Expected options to be an object");
+        return false;
+    }
+    return true;
+}
+
+// 리듬 옵션 적용 (생략하거나 null이면 그대로, 옵션 객체의 다른 속성은 무시)
+bool KeyboardNativeBinding::ApplyRhythmOptions(napi_env env, KeyboardSubscription* sub, napi_value options) {
+    if (options) {
+        napi_valuetype valuetype;
+        napi_typeof(env, options, &valuetype);
+        if (valuetype == napi_undefined || valuetype == napi_null) {
+            options = nullptr;
+        } else if (valuetype != napi_object) {
+            napi_throw_type_error(env, nullptr, "Expected rhythm options to be an object");
+            return false;
+        }
+    }
+    
+    RhythmConfig config = sub->rhythmDetector.GetConfig();
+    double burstGapMs = config.burstGapMs;
+    double burstMinKeys = config.burstMinKeys;
+    double pauseMs = config.pauseMs;
+    double rateWindowMs = config.rateWindowMs;
+    double streakMs = config.streakMs;
+    if (!ReadNumberOption(env, options, "burstGapMs", &burstGapMs) ||
+        !ReadNumberOption(env, options, "burstMinKeys", &burstMinKeys) ||
+        !ReadNumberOption(env, options, "pauseMs", &pauseMs) ||
+        !ReadNumberOption(env, options, "rateHighKps", &config.rateHighKps) ||
+        !ReadNumberOption(env, options, "rateLowKps", &config.rateLowKps) ||
+        !ReadNumberOption(env, options, "rateWindowMs", &rateWindowMs) ||
+        !ReadNumberOption(env, options, "streakMs", &streakMs)) {
+        return false;
+    }
+    
+    if (burstMinKeys < 2 || burstMinKeys > UINT32_MAX || burstMinKeys != floor(burstMinKeys)) {
+        napi_throw_range_error(env, nullptr, "burstMinKeys must be an integer of at least 2");
+        return false;
+    }
+    if (burstGapMs < 1 || pauseMs < 1 || rateWindowMs < 1 ||
+        burstGapMs > UINT32_MAX || pauseMs > UINT32_MAX || rateWindowMs > UINT32_MAX || streakMs > UINT32_MAX) {
+        napi_throw_range_error(env, nullptr, "burstGapMs, pauseMs and rateWindowMs must be positive durations");
+        return false;
+    }
+    if (!(config.rateLowKps > 0) || !(config.rateLowKps < config.rateHighKps)) {
+        napi_throw_range_error(env, nullptr, "rateLowKps must be positive and below rateHighKps");
+        return false;
+    }
+    
+    config.burstGapMs = static_cast<uint32_t>(burstGapMs);
+    config.burstMinKeys = static_cast<uint32_t>(burstMinKeys);
+    config.pauseMs = static_cast<uint32_t>(pauseMs);
+    config.rateWindowMs = static_cast<uint32_t>(rateWindowMs);
+    config.streakMs = static_cast<uint32_t>(streakMs);
+    sub->rhythmDetector.Configure(config);
+    return true;
+}
+
+// 현재 세션의 키 입력 간격 통계 조회 - getSessionStats(subscriptionId?)
+// 세션 종료 레코드를 받은 콜백 안에서 호출하면 종료된 세션의 통계를 얻음
+// (다음 세션의 첫 키가 처리될 때 자동으로 초기화됨)
+napi_value KeyboardNativeBinding::GetSessionStats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 0);
+    if (!sub) {
+        return nullptr;
+    }
+    return CreateIntervalStatsObject(env, sub->sessionStats);
+}
+
+// 세션 통계 초기화 - resetSessionStats(subscriptionId?)
+napi_value KeyboardNativeBinding::ResetSessionStats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 0);
+    if (!sub) {
+        return nullptr;
+    }
+    sub->sessionStats.Reset();
     
     napi_value result;
-    napi_get_boolean(env, isListening, &result);
+    napi_get_undefined(env, &result);
     return result;
 }
 
-// 키 이벤트 콜백 (네이티브 → JavaScript)
-void KeyboardNativeBinding::KeyEventCallback(const KeyEvent& event) {
-    if (s_callback) {
-        // Thread-safe 함수 호출
-        napi_call_threadsafe_function(s_callback, (void*)&event, napi_tsfn_blocking);
+// libuv 타이머 초기화 (구독마다 최초 1회, 구독을 해제할 때 닫음)
+bool KeyboardNativeBinding::InitTimer(napi_env env, KeyboardSubscription* sub, uv_timer_t* timer, bool* initialized) {
+    if (*initialized) {
+        return true;
+    }
+    
+    uv_loop_t* loop = nullptr;
+    napi_status status = napi_get_uv_event_loop(env, &loop);
+    if (status != napi_ok || !loop || uv_timer_init(loop, timer) != 0) {
+        return false;
     }
+    
+    // 타이머 때문에 이벤트 루프가 종료되지 않는 일이 없도록 함
+    uv_unref(reinterpret_cast<uv_handle_t*>(timer));
+    timer->data = sub;
+    sub->openHandles++;
+    *initialized = true;
+    return true;
 }
 
-// JavaScript 콜백 호출
-void KeyboardNativeBinding::CallJS(napi_env env, napi_value js_callback, void* context, void* data) {
-    if (env && js_callback) {
-        KeyEvent* event = static_cast<KeyEvent*>(data);
+// 구독 리스닝 시작 (전달 방식별 준비, Thread-safe 함수 생성, OS 후킹 연결)
+napi_value KeyboardNativeBinding::StartSubscription(napi_env env, KeyboardSubscription* sub, DeliveryMode mode,
+                                                    napi_value callback, napi_value options) {
+    napi_status status;
+    size_t wakeThreshold = 0;
+    
+    if (mode == DELIVERY_BATCHED) {
+        // 배치 옵션 파싱
+        BatchConfig config = { DEFAULT_BATCH_MAX_SIZE, DEFAULT_BATCH_MAX_LATENCY_MS };
+        if (options && !ParseBatchConfig(env, options, &config)) {
+            return nullptr;
+        }
         
-        // KeyEvent 객체 생성
-        napi_value eventObj = CreateKeyEventObject(env, *event);
+        // 재사용할 배치 버퍼 준비
+        if (!EnsureBatchBuffers(env, sub, config.maxBatchSize)) {
+            napi_throw_error(env, nullptr, "Failed to allocate batch buffers");
+            return nullptr;
+        }
         
-        // JavaScript 콜백 함수 호출
-        napi_value global;
-        napi_get_global(env, &global);
+        // 플러시 타이머 초기화 (최초 1회)
+        if (!InitTimer(env, sub, &sub->flushTimer, &sub->flushTimerInitialized)) {
+            napi_throw_error(env, nullptr, "Failed to initialize flush timer");
+            return nullptr;
+        }
         
-        napi_value result;
-        napi_call_function(env, global, js_callback, 1, &eventObj, &result);
+        sub->batchConfig = config;
+        sub->flushDue = false;
+        wakeThreshold = config.maxBatchSize;
+    } else if (mode == DELIVERY_SESSIONS || mode == DELIVERY_RHYTHM) {
+        if (options && !ApplyIdleTimeoutOption(env, sub, options)) {
+            return nullptr;
+        }
+        if (mode == DELIVERY_RHYTHM && !ApplyRhythmOptions(env, sub, options)) {
+            return nullptr;
+        }
+        
+        // 유휴 타이머 초기화 (최초 1회)
+        if (!InitTimer(env, sub, &sub->idleTimer, &sub->idleTimerInitialized)) {
+            napi_throw_error(env, nullptr, "Failed to initialize idle timer");
+            return nullptr;
+        }
     }
-}
-
-// KeyEvent 객체 생성
-napi_value KeyboardNativeBinding::CreateKeyEventObject(napi_env env, const KeyEvent& event) {
-    napi_value obj;
-    napi_create_object(env, &obj);
     
-    // timestamp
-    napi_value timestamp;
-    napi_create_bigint_uint64(env, event.timestamp, &timestamp);
-    napi_set_named_property(env, obj, "timestamp", timestamp);
+    sub->deliveryMode = mode;
+    sub->batchWakeThreshold.store(wakeThreshold, std::memory_order_relaxed);
     
-    // keyCode
-    napi_value keyCode;
-    napi_create_uint32(env, event.keyCode, &keyCode);
-    napi_set_named_property(env, obj, "keyCode", keyCode);
+    // Thread-safe 함수 생성
+    napi_value async_resource_name;
+    status = napi_create_string_utf8(env, "KeyboardCallback", NAPI_AUTO_LENGTH, &async_resource_name);
+    if (status != napi_ok) {
+        napi_throw_error(env, nullptr, "Failed to create async resource name");
+        return nullptr;
+    }
+    
+    DeliveryToken* token = new DeliveryToken{ sub, ++sub->generation };
+    status = napi_create_threadsafe_function(
+        env,
+        callback,                   // JavaScript 콜백 함수
+        nullptr,                    // async_resource
+        async_resource_name,        // async_resource_name
+        1,                          // max_queue_size (깨우기 신호 1개면 충분)
+        1,                          // initial_thread_count
+        token,                      // thread_finalize_data
+        FinalizeDelivery,           // thread_finalize_cb
+        token,                      // context (구독과 리스닝 세대)
+        CallJS,                     // call_js_cb
+        &sub->callback              // result
+    );
+    
+    if (status != napi_ok) {
+        delete token;
+        sub->callback = nullptr;
+        napi_throw_error(env, nullptr, "Failed to create threadsafe function");
+        return nullptr;
+    }
+    sub->openHandles++;
+    
+    // 이전 리스닝에서 전달되지 못한 이벤트가 남아 있으면 생산자가 깨우지 않으므로 직접 예약
+    sub->releaseProducer.store(false, std::memory_order_relaxed);
+    if (CaptureDispatcher::PendingCount(sub) > 0) {
+        WakeJS(sub);
+    }
+    
+    // OS 후킹에 연결 (첫 구독이면 플랫폼 리스너 시작)
+    bool success = AttachSubscription(env, sub);
+    if (!success) {
+        napi_release_threadsafe_function(sub->callback, napi_tsfn_release);
+        sub->callback = nullptr;
+        
+        bool isPending = false;
+        napi_is_exception_pending(env, &isPending);
+        if (isPending) {
+            return nullptr;
+        }
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, success, &result);
+    return result;
+}
+
+// 구독 리스닝 중지 (구독 상태는 유지되어 다시 시작할 수 있음)
+bool KeyboardNativeBinding::StopSubscription(KeyboardSubscription* sub) {
+    // OS 후킹에서 떼어냄 (기다리던 후킹 스레드를 풀어주고, 마지막 구독이면 리스너 중지)
+    bool success = DetachSubscription(sub);
+    
+    // 후킹 스레드가 더 이상 이 구독을 보지 않으므로 교체된 필터 설정 해제
+    sub->eventFilter.Reclaim();
+    
+    // 모아둔 이벤트를 마지막으로 전달하도록 예약 (해제 전 대기 중인 호출은 실행됨)
+    StopFlushTimer(sub);
+    StopIdleTimer(sub);
+    sub->flushDue = true;
+    WakeJS(sub);
+    
+    // Thread-safe 함수 정리
+    if (sub->callback) {
+        napi_release_threadsafe_function(sub->callback, napi_tsfn_release);
+        sub->callback = nullptr;
+    }
+    return success;
+}
+
+// 구독 해제 - 중지된 구독의 타이머/버퍼를 정리하고, Thread-safe 함수와 타이머가 모두 닫히면 삭제
+void KeyboardNativeBinding::CloseSubscription(napi_env env, KeyboardSubscription* sub) {
+    sub->closing = true;
+    
+    if (sub->batchTimestampsRef) {
+        napi_delete_reference(env, sub->batchTimestampsRef);
+        napi_delete_reference(env, sub->batchKeyCodesRef);
+        napi_delete_reference(env, sub->batchFlagsRef);
+        napi_delete_reference(env, sub->batchAppIdsRef);
+        sub->batchTimestampsRef = nullptr;
+        sub->batchKeyCodesRef = nullptr;
+        sub->batchFlagsRef = nullptr;
+        sub->batchAppIdsRef = nullptr;
+    }
+    
+    if (sub->flushTimerInitialized) {
+        sub->flushTimerInitialized = false;
+        uv_close(reinterpret_cast<uv_handle_t*>(&sub->flushTimer), OnTimerClosed);
+    }
+    if (sub->idleTimerInitialized) {
+        sub->idleTimerInitialized = false;
+        uv_close(reinterpret_cast<uv_handle_t*>(&sub->idleTimer), OnTimerClosed);
+    }
+    
+    if (sub->openHandles == 0) {
+        DeleteSubscription(sub);
+    }
+}
+
+// 닫힌 핸들 반영 - 해제 중인 구독의 마지막 핸들이면 삭제
+void KeyboardNativeBinding::ReleaseSubscriptionHandle(KeyboardSubscription* sub) {
+    sub->openHandles--;
+    if (sub->closing && sub->openHandles == 0) {
+        DeleteSubscription(sub);
+    }
+}
+
+// 구독 삭제 (환경이 남아 있으면 목록에서도 제거)
+void KeyboardNativeBinding::DeleteSubscription(KeyboardSubscription* sub) {
+    if (sub->instance) {
+        std::vector<KeyboardSubscription*>& subscriptions = sub->instance->subscriptions;
+        for (size_t i = 0; i < subscriptions.size(); i++) {
+            if (subscriptions[i] == sub) {
+                subscriptions.erase(subscriptions.begin() + i);
+                break;
+            }
+        }
+    }
+    delete sub;
+}
+
+// 타이머 닫힘 (uv_close 콜백)
+void KeyboardNativeBinding::OnTimerClosed(uv_handle_t* handle) {
+    ReleaseSubscriptionHandle(static_cast<KeyboardSubscription*>(handle->data));
+}
+
+// Thread-safe 함수 해제 완료 (남은 호출이 모두 끝난 뒤 JS 스레드에서 호출)
+void KeyboardNativeBinding::FinalizeDelivery(napi_env env, void* data, void* hint) {
+    DeliveryToken* token = static_cast<DeliveryToken*>(data);
+    KeyboardSubscription* sub = token->subscription;
+    
+    // 환경 종료로 Node가 먼저 닫은 경우 - 함수가 해제되기 전에 후킹 스레드에서 떼어냄
+    if (sub->callback && token->generation == sub->generation) {
+        DetachSubscription(sub);
+        sub->callback = nullptr;
+    }
+    delete token;
+    ReleaseSubscriptionHandle(sub);
+}
+
+// 구독을 OS 후킹에 연결 - 빈 슬롯에 게시하고, 첫 구독이면 플랫폼 리스너 시작
+bool KeyboardNativeBinding::AttachSubscription(napi_env env, KeyboardSubscription* sub) {
+    std::lock_guard<std::mutex> lock(s_listenerMutex);
+    
+    // 플랫폼 리스너 생성
+    if (!s_listener) {
+        s_listener.reset(CreatePlatformListener(s_dispatcher));
+        if (!s_listener) {
+            napi_throw_error(env, nullptr, "Unsupported platform");
+            return false;
+        }
+    }
+    
+    if (!s_dispatcher.Attach(sub)) {
+        napi_throw_error(env, nullptr, "Too many keyboard subscriptions");
+        return false;
+    }
+    sub->attached = true;
+    s_attachedCount++;
+    
+    // 키보드 리스닝 시작 (이미 다른 구독을 위해 실행 중이면 그대로 공유)
+    // 중지된 동안 놓친 뗌이 반복으로 보이지 않도록 키 상태를 비우고 시작 (후킹 스레드 없음)
+    if (!s_listener->IsListening()) {
+        s_dispatcher.GetKeyState().Reset();
+    }
+    if (!s_listener->IsListening() && !s_listener->StartListening()) {
+        // 후킹이 시작되지 않았으므로 슬롯을 비우는 즉시 반환됨
+        s_dispatcher.Detach(sub);
+        sub->attached = false;
+        s_attachedCount--;
+        return false;
+    }
+    return true;
+}
+
+// 구독을 OS 후킹에서 떼어냄 - 반환 후에는 후킹 스레드가 이 구독에 접근하지 않음
+// 마지막 구독이면 플랫폼 리스너 중지
+bool KeyboardNativeBinding::DetachSubscription(KeyboardSubscription* sub) {
+    if (!sub->attached) {
+        return true;
+    }
+    
+    // 링 자리를 기다리는 후킹 스레드가 있으면 먼저 풀어줌 (후킹 종료 대기와 교착 방지)
+    CaptureDispatcher::ReleaseBlockedProducer(sub);
+    
+    std::lock_guard<std::mutex> lock(s_listenerMutex);
+    s_dispatcher.Detach(sub);
+    sub->attached = false;
+    s_attachedCount--;
+    
+    if (s_attachedCount == 0 && s_listener) {
+        return s_listener->StopListening();
+    }
+    return true;
+}
+
+// 키보드 리스닝 중지 (기본 구독)
+napi_value KeyboardNativeBinding::StopListening(napi_env env, napi_callback_info info) {
+    bool success = StopSubscription(GetInstance(env)->primary);
+    
+    napi_value result;
+    napi_get_boolean(env, success, &result);
+    return result;
+}
+
+// 권한 확인
+napi_value KeyboardNativeBinding::CheckPermissions(napi_env env, napi_callback_info info) {
+    std::lock_guard<std::mutex> lock(s_listenerMutex);
+    if (!s_listener) {
+        s_listener.reset(CreatePlatformListener(s_dispatcher));
+        if (!s_listener) {
+            napi_throw_error(env, nullptr, "Unsupported platform");
+            return nullptr;
+        }
+    }
+    
+    PermissionInfo permInfo = s_listener->CheckPermissions();
+    return CreatePermissionObject(env, permInfo);
+}
+
+// 리스닝 상태 확인 (기본 구독)
+napi_value KeyboardNativeBinding::IsListening(napi_env env, napi_callback_info info) {
+    bool isListening = false;
+    {
+        std::lock_guard<std::mutex> lock(s_listenerMutex);
+        isListening = GetInstance(env)->primary->attached && s_listener && s_listener->IsListening();
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, isListening, &result);
+    return result;
+}
+
+// 리스너 백엔드 선택 (어느 환경의 구독도 리스닝 중이 아닐 때만 가능)
+// setListenerBackend('default' | 'xrecord' | 'evdev', options?)
+// evdev 옵션: { devices?: string[] } - 지정하면 해당 경로만 읽음 (FIFO/파일 대체 장치 가능)
+napi_value KeyboardNativeBinding::SetListenerBackend(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_status status;
+    
+    status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected backend name");
+        return nullptr;
+    }
+    
+    char name[32];
+    size_t nameLength = 0;
+    status = napi_get_value_string_utf8(env, args[0], name, sizeof(name), &nameLength);
+    if (status != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected backend name to be a string");
+        return nullptr;
+    }
+    
+    napi_value options = nullptr;
+    if (argc >= 2) {
+        napi_valuetype valuetype;
+        napi_typeof(env, args[1], &valuetype);
+        if (valuetype == napi_object) {
+            options = args[1];
+        }
+    }
+    
+    // 녹화 모드 - 선택한 백엔드를 녹화 싱크에 묶어 출력을 트레이스 파일로 기록한 뒤 s_dispatcher로 넘김
+    std::string recordTo;
+    if (!ReadStringOption(env, options, "recordTo", &recordTo)) {
+        return nullptr;
+    }
+    
+    bool backpressure = false;
+    KeyboardListenerBase* listener = nullptr;
+    if (recordTo.empty()) {
+        listener = CreateListenerBackend(env, name, options, s_dispatcher, &backpressure);
+    } else {
+        std::unique_ptr<KeyboardListenerRecorder> recorder(new KeyboardListenerRecorder(recordTo, s_dispatcher));
+        KeyboardListenerBase* inner = CreateListenerBackend(env, name, options, recorder->GetSink(), &backpressure);
+        if (inner) {
+            recorder->SetInner(inner);
+            listener = recorder.release();
+        }
+    }
+    if (!listener) {
+        bool isPending = false;
+        napi_is_exception_pending(env, &isPending);
+        if (!isPending) {
+            napi_throw_error(env, nullptr, "Unknown or unsupported listener backend");
+        }
+        return nullptr;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(s_listenerMutex);
+        if (s_attachedCount > 0 || (s_listener && s_listener->IsListening())) {
+            delete listener;
+            napi_throw_error(env, nullptr, "Cannot change backend while listening");
+            return nullptr;
+        }
+        s_listener.reset(listener);
+        s_dispatcher.SetSourceBackpressure(backpressure);
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+// 캡처 경로 지표 조회 - getMetrics(subscriptionId?)
+// 카운터는 시작(또는 resetMetrics) 이후 누적값, 지연 시간은 나노초 단위
+napi_value KeyboardNativeBinding::GetMetrics(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 0);
+    if (!sub) {
+        return nullptr;
+    }
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    struct {
+        const char* name;
+        uint64_t value;
+    } counters[] = {
+        { "eventsSeen", sub->metrics.hookCalls.load(std::memory_order_relaxed) },
+        { "eventsFiltered", sub->metrics.filtered.load(std::memory_order_relaxed) },
+        { "eventsEnqueued", sub->metrics.enqueued.load(std::memory_order_relaxed) },
+        { "eventsDelivered", sub->metrics.delivered.load(std::memory_order_relaxed) },
+        { "eventsDropped", sub->metrics.dropped.load(std::memory_order_relaxed) },
+        { "eventsEvicted", sub->metrics.evicted.load(std::memory_order_relaxed) },
+        { "eventsCoalesced", sub->metrics.coalesced.load(std::memory_order_relaxed) },
+        { "producerBlocks", sub->metrics.blocked.load(std::memory_order_relaxed) },
+        { "producerBlockTimeouts", sub->metrics.blockTimeouts.load(std::memory_order_relaxed) },
+        { "queueDepth", sub->eventRing.Size() },
+        { "maxQueueDepth", sub->metrics.maxQueueDepth.load(std::memory_order_relaxed) },
+        { "queueLimit", sub->eventRing.GetLimit() },
+        { "queueCapacity", KeyEventRing::GetCapacity() },
+        { "recordsDropped", sub->metrics.recordsDropped.load(std::memory_order_relaxed) },
+        { "wakeups", sub->metrics.wakeups.load(std::memory_order_relaxed) },
+    };
+    
+    for (size_t i = 0; i < sizeof(counters) / sizeof(counters[0]); i++) {
+        napi_value value;
+        napi_create_double(env, static_cast<double>(counters[i].value), &value);
+        napi_set_named_property(env, obj, counters[i].name, value);
+    }
+    
+    napi_set_named_property(env, obj, "hookDurationNs", CreateLatencyObject(env, sub->metrics.hookDuration));
+    napi_set_named_property(env, obj, "deliveryLatencyNs", CreateLatencyObject(env, sub->metrics.deliveryLatency));
+    
+    return obj;
+}
+
+// 캡처 경로 지표 초기화 - resetMetrics(subscriptionId?)
+napi_value KeyboardNativeBinding::ResetMetrics(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    KeyboardSubscription* sub = ResolveSubscription(env, args, argc, 0);
+    if (!sub) {
+        return nullptr;
+    }
+    sub->metrics.Reset();
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+// 시계 기준점 조회 - { monotonicNs, wallMs } (같은 순간의 단조 시계와 epoch ms)
+// 네이티브 타임스탬프는 모두 이 기준점으로 변환되어 전달됨
+napi_value KeyboardNativeBinding::GetClockAnchor(napi_env env, napi_callback_info info) {
+    const uint64_t monotonicNs = EventClock::RefreshWallOffset();
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value value;
+    napi_create_double(env, static_cast<double>(monotonicNs), &value);
+    napi_set_named_property(env, obj, "monotonicNs", value);
+    napi_create_double(env, EventClock::ToWallMs(monotonicNs), &value);
+    napi_set_named_property(env, obj, "wallMs", value);
+    
+    return obj;
+}
+
+// 이벤트 저널 열기
+// openJournal(directory: string, options?: { segmentRecords?: number })
+napi_value KeyboardNativeBinding::OpenJournal(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_status status;
+    
+    status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected journal directory");
+        return nullptr;
+    }
+    
+    size_t pathLength = 0;
+    status = napi_get_value_string_utf8(env, args[0], nullptr, 0, &pathLength);
+    if (status != napi_ok || pathLength == 0) {
+        napi_throw_type_error(env, nullptr, "Expected journal directory to be a non-empty string");
+        return nullptr;
+    }
+    std::vector<char> directory(pathLength + 1);
+    napi_get_value_string_utf8(env, args[0], directory.data(), directory.size(), &pathLength);
+    
+    uint32_t segmentRecords = EVENT_JOURNAL_DEFAULT_CAPACITY;
+    if (argc >= 2) {
+        napi_valuetype valuetype;
+        napi_typeof(env, args[1], &valuetype);
+        if (valuetype == napi_object) {
+            bool hasProperty = false;
+            napi_has_named_property(env, args[1], "segmentRecords", &hasProperty);
+            if (hasProperty) {
+                napi_value value;
+                napi_get_named_property(env, args[1], "segmentRecords", &value);
+                if (napi_get_value_uint32(env, value, &segmentRecords) != napi_ok || segmentRecords == 0) {
+                    napi_throw_range_error(env, nullptr, "segmentRecords must be a positive integer");
+                    return nullptr;
+                }
+            }
+        }
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, GetInstance(env)->journal.Open(directory.data(), segmentRecords), &result);
+    return result;
+}
+
+// 이벤트 저널 닫기 (활성 세그먼트 봉인)
+napi_value KeyboardNativeBinding::CloseJournal(napi_env env, napi_callback_info info) {
+    GetInstance(env)->journal.Close();
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+// [start, end) 시각 범위의 저널 레코드 조회
+napi_value KeyboardNativeBinding::JournalRange(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    double start = 0;
+    double end = 0;
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2 ||
+        napi_get_value_double(env, args[0], &start) != napi_ok ||
+        napi_get_value_double(env, args[1], &end) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected start and end timestamps");
+        return nullptr;
+    }
+    
+    std::vector<JournalRecord> records;
+    if (end > start && end > 0) {
+        GetInstance(env)->journal.ReadRange(start > 0 ? static_cast<uint64_t>(start) : 0, static_cast<uint64_t>(end), &records);
+    }
+    return CreateJournalRecordsObject(env, records);
+}
+
+// 압축 대기 중인 봉인 세그먼트 ID 목록
+napi_value KeyboardNativeBinding::JournalSealedSegments(napi_env env, napi_callback_info info) {
+    std::vector<uint64_t> ids;
+    GetInstance(env)->journal.ListSealedSegments(&ids);
+    
+    napi_value result;
+    napi_create_array_with_length(env, ids.size(), &result);
+    for (size_t i = 0; i < ids.size(); i++) {
+        napi_value id;
+        napi_create_double(env, static_cast<double>(ids[i]), &id);
+        napi_set_element(env, result, static_cast<uint32_t>(i), id);
+    }
+    return result;
+}
+
+// 세그먼트 하나의 레코드 조회 (없거나 손상되었으면 null)
+napi_value KeyboardNativeBinding::JournalReadSegment(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    int64_t segmentId = 0;
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1 ||
+        napi_get_value_int64(env, args[0], &segmentId) != napi_ok || segmentId <= 0) {
+        napi_throw_type_error(env, nullptr, "Expected segment id");
+        return nullptr;
+    }
+    
+    std::vector<JournalRecord> records;
+    if (!GetInstance(env)->journal.ReadSegment(static_cast<uint64_t>(segmentId), &records)) {
+        napi_value result;
+        napi_get_null(env, &result);
+        return result;
+    }
+    return CreateJournalRecordsObject(env, records);
+}
+
+// DB 반영이 끝난 봉인 세그먼트 삭제
+napi_value KeyboardNativeBinding::JournalReleaseSegment(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    int64_t segmentId = 0;
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1 ||
+        napi_get_value_int64(env, args[0], &segmentId) != napi_ok || segmentId <= 0) {
+        napi_throw_type_error(env, nullptr, "Expected segment id");
+        return nullptr;
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, GetInstance(env)->journal.ReleaseSegment(static_cast<uint64_t>(segmentId)), &result);
+    return result;
+}
+
+// 일별/시간별 통계 증분 꺼내기 - { daily: RollupRow[], hourly: RollupRow[] }
+// 마지막 호출 이후 더해진 값만 담기므로 DB에는 기존 행에 더하는 upsert로 반영해야 함
+napi_value KeyboardNativeBinding::TakeRollups(napi_env env, napi_callback_info info) {
+    std::vector<RollupBucket> daily;
+    std::vector<RollupBucket> hourly;
+    GetInstance(env)->rollup.Take(&daily, &hourly);
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    napi_set_named_property(env, obj, "daily", CreateRollupArray(env, daily));
+    napi_set_named_property(env, obj, "hourly", CreateRollupArray(env, hourly));
+    return obj;
+}
+
+// 누적 통계 스냅샷 읽기 - 유효하면 누적을 스냅샷 값으로 시작하고 내용 반환 (없거나 손상되면 null)
+// 경로는 기억해 두고 이후 saveStatsSnapshot이 같은 파일에 저장
+// loadStatsSnapshot(path: string)
+napi_value KeyboardNativeBinding::LoadStatsSnapshot(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    size_t pathLength = 0;
+    if (status != napi_ok || argc < 1 ||
+        napi_get_value_string_utf8(env, args[0], nullptr, 0, &pathLength) != napi_ok || pathLength == 0) {
+        napi_throw_type_error(env, nullptr, "Expected snapshot path to be a non-empty string");
+        return nullptr;
+    }
+    std::vector<char> path(pathLength + 1);
+    napi_get_value_string_utf8(env, args[0], path.data(), path.size(), &pathLength);
+    
+    KeyboardAddonInstance* instance = GetInstance(env);
+    instance->statsSnapshotPath.assign(path.data(), pathLength);
+    
+    RollupRunning running;
+    uint64_t savedAt = 0;
+    napi_value result;
+    if (!StatsSnapshot::Load(path.data(), &running, &savedAt)) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    // 이미 집계가 시작되었으면 (리스닝 후 다시 읽은 경우) 현재 누적을 유지
+    instance->rollup.SeedRunning(running);
+    
+    result = CreateRunningStatsObject(env, running);
+    napi_value value;
+    napi_create_double(env, static_cast<double>(savedAt), &value);
+    napi_set_named_property(env, result, "savedAt", value);
+    return result;
+}
+
+// 현재 누적 통계를 스냅샷 파일에 저장 (경로가 지정되지 않았거나 쓰기에 실패하면 false)
+napi_value KeyboardNativeBinding::SaveStatsSnapshot(napi_env env, napi_callback_info info) {
+    KeyboardAddonInstance* instance = GetInstance(env);
+    
+    bool saved = false;
+    if (!instance->statsSnapshotPath.empty()) {
+        const uint64_t savedAt = EventClock::ToWallMsFloor(EventClock::NowNs());
+        saved = StatsSnapshot::Save(instance->statsSnapshotPath.c_str(), instance->rollup.GetRunning(), savedAt);
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, saved, &result);
+    return result;
+}
+
+// 현재 누적 통계 (스냅샷에 저장되는 값과 같음)
+napi_value KeyboardNativeBinding::GetRunningStats(napi_env env, napi_callback_info info) {
+    return CreateRunningStatsObject(env, GetInstance(env)->rollup.GetRunning());
+}
+
+// DB 값으로 누적 보정 - stored는 마지막 takeRollups까지 반영된 날짜 행과 연속 입력 일수
+// (getRunningStats와 같은 형태, session/savedAt은 무시) - 날짜가 맞지 않아 반영하지 않았으면 false
+// reconcileStats(stored: RunningStats)
+napi_value KeyboardNativeBinding::ReconcileStats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    RollupRunning stored;
+    if (status != napi_ok || argc < 1 || !ReadRunningStatsObject(env, args[0], &stored)) {
+        napi_throw_type_error(env, nullptr, "Expected stored stats { date, keys, sessions, activeMs, ..., hourKeys }");
+        return nullptr;
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, GetInstance(env)->rollup.Reconcile(stored), &result);
+    return result;
+}
+
+// 시간 버킷 색인에 더하기 - 지난 기록(DB의 시간별 행)이나 네이티브 세션 단계를 거치지 않은 이벤트용
+// 네이티브 타이핑 레코드는 이미 더해지므로 넘기지 않아야 함 - 더한 버킷 수 반환
+// timeIndexAdd({ count, starts: Float64Array (epoch ms), keys, activeMs, sessions: Float64Array })
+napi_value KeyboardNativeBinding::TimeIndexAdd(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    uint32_t count = 0;
+    napi_value countValue;
+    if (status != napi_ok || argc < 1 ||
+        napi_get_named_property(env, args[0], "count", &countValue) != napi_ok ||
+        napi_get_value_uint32(env, countValue, &count) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected buckets.count");
+        return nullptr;
+    }
+    
+    static const char* const names[4] = { "starts", "keys", "activeMs", "sessions" };
+    const double* columns[4];
+    for (int i = 0; i < 4; i++) {
+        napi_value array;
+        bool isTypedArray = false;
+        napi_typedarray_type type;
+        size_t length = 0;
+        void* data = nullptr;
+        if (napi_get_named_property(env, args[0], names[i], &array) != napi_ok ||
+            napi_is_typedarray(env, array, &isTypedArray) != napi_ok || !isTypedArray ||
+            napi_get_typedarray_info(env, array, &type, &length, &data, nullptr, nullptr) != napi_ok ||
+            type != napi_float64_array || length < count) {
+            std::string message = std::string("buckets.") + names[i] + " must be a Float64Array of at least count elements";
+            napi_throw_type_error(env, nullptr, message.c_str());
+            return nullptr;
+        }
+        columns[i] = static_cast<const double*>(data);
+    }
+    
+    TimeBucketIndex& index = GetInstance(env)->timeIndex;
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!(columns[0][i] > 0) || !(columns[1][i] >= 0) || !(columns[2][i] >= 0) || !(columns[3][i] >= 0)) {
+            continue;
+        }
+        TimeBucketValue bucket;
+        bucket.keys = static_cast<uint64_t>(columns[1][i]);
+        bucket.activeUs = static_cast<uint64_t>(columns[2][i] * 1000.0 + 0.5);
+        bucket.sessions = static_cast<uint64_t>(columns[3][i]);
+        index.Add(columns[0][i], bucket);
+        added++;
+    }
+    
+    napi_value result;
+    napi_create_uint32(env, added, &result);
+    return result;
+}
+
+// 시간 버킷 색인 구간 합 - 경계 n개로 연속한 [bounds[i], bounds[i + 1]) 구간 n - 1개를 한 번에 조회
+// (분 단위로 내림, 구간마다 O(log n)) - { keys, activeMs, sessions: Float64Array }
+// timeIndexQuery(bounds: number[] | Float64Array)
+napi_value KeyboardNativeBinding::TimeIndexQuery(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    std::vector<double> bounds;
+    bool isArray = false;
+    bool isTypedArray = false;
+    if (status == napi_ok && argc >= 1) {
+        napi_is_array(env, args[0], &isArray);
+        napi_is_typedarray(env, args[0], &isTypedArray);
+    }
+    
+    if (isTypedArray) {
+        napi_typedarray_type type;
+        size_t length = 0;
+        void* data = nullptr;
+        napi_get_typedarray_info(env, args[0], &type, &length, &data, nullptr, nullptr);
+        if (type == napi_float64_array) {
+            bounds.assign(static_cast<const double*>(data), static_cast<const double*>(data) + length);
+        }
+    } else if (isArray) {
+        uint32_t length = 0;
+        napi_get_array_length(env, args[0], &length);
+        bounds.resize(length);
+        for (uint32_t i = 0; i < length; i++) {
+            napi_value element;
+            if (napi_get_element(env, args[0], i, &element) != napi_ok ||
+                napi_get_value_double(env, element, &bounds[i]) != napi_ok) {
+                bounds.clear();
+                break;
+            }
+        }
+    }
+    if (bounds.size() < 2) {
+        napi_throw_type_error(env, nullptr, "Expected bounds to be an array (or Float64Array) of at least 2 epoch ms values");
+        return nullptr;
+    }
+    
+    const TimeBucketIndex& index = GetInstance(env)->timeIndex;
+    const size_t ranges = bounds.size() - 1;
+    double* columns[3];
+    napi_value arrays[3];
+    for (int i = 0; i < 3; i++) {
+        void* data = nullptr;
+        napi_value buffer;
+        napi_create_arraybuffer(env, ranges * sizeof(double), &data, &buffer);
+        napi_create_typedarray(env, napi_float64_array, ranges, buffer, 0, &arrays[i]);
+        columns[i] = static_cast<double*>(data);
+    }
+    
+    for (size_t i = 0; i < ranges; i++) {
+        const TimeBucketValue sum = index.Query(bounds[i], bounds[i + 1]);
+        columns[0][i] = static_cast<double>(sum.keys);
+        columns[1][i] = sum.activeUs / 1000.0;
+        columns[2][i] = static_cast<double>(sum.sessions);
+    }
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    napi_set_named_property(env, obj, "keys", arrays[0]);
+    napi_set_named_property(env, obj, "activeMs", arrays[1]);
+    napi_set_named_property(env, obj, "sessions", arrays[2]);
+    return obj;
+}
+
+// 시간 버킷 색인 요약 - { days, minuteHours, bytes }
+napi_value KeyboardNativeBinding::TimeIndexInfo(napi_env env, napi_callback_info info) {
+    const TimeBucketIndex& index = GetInstance(env)->timeIndex;
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    struct {
+        const char* name;
+        double value;
+    } fields[] = {
+        { "days", static_cast<double>(index.DayCount()) },
+        { "minuteHours", static_cast<double>(index.MinuteHourCount()) },
+        { "bytes", static_cast<double>(index.MemoryBytes()) },
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        napi_value value;
+        napi_create_double(env, fields[i].value, &value);
+        napi_set_named_property(env, obj, fields[i].name, value);
+    }
+    return obj;
+}
+
+// 앱 ID → 이름 표 - { names: string[] (names[id], [0] = ''), activeAppId }
+// 키 이벤트/타이핑 레코드의 appId는 이 표로 이름을 찾음 (ID는 프로세스가 끝날 때까지 유지)
+napi_value KeyboardNativeBinding::GetAppTable(napi_env env, napi_callback_info info) {
+    std::vector<std::string> names;
+    AppRegistry::Shared().CopyNames(&names);
+    
+    napi_value array;
+    napi_create_array_with_length(env, names.size() + 1, &array);
+    napi_value name;
+    napi_create_string_utf8(env, "", 0, &name);
+    napi_set_element(env, array, APP_ID_UNKNOWN, name);
+    for (size_t i = 0; i < names.size(); i++) {
+        napi_create_string_utf8(env, names[i].data(), names[i].size(), &name);
+        napi_set_element(env, array, static_cast<uint32_t>(i + 1), name);
+    }
+    
+    napi_value obj;
+    napi_value activeAppId;
+    napi_create_object(env, &obj);
+    napi_create_uint32(env, AppRegistry::Shared().GetActive(), &activeAppId);
+    napi_set_named_property(env, obj, "names", array);
+    napi_set_named_property(env, obj, "activeAppId", activeAppId);
+    return obj;
+}
+
+// 앱별 누적 - [{ appId, keys, activeMs, sessions }] (입력이 있는 앱만, reset이면 읽은 뒤 비움)
+// getAppStats(reset?: boolean)
+napi_value KeyboardNativeBinding::GetAppStats(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    bool reset = false;
+    if (argc >= 1) {
+        napi_valuetype type;
+        napi_typeof(env, args[0], &type);
+        if (type == napi_boolean) {
+            napi_get_value_bool(env, args[0], &reset);
+        } else if (type != napi_undefined) {
+            napi_throw_type_error(env, nullptr, "Expected reset to be a boolean");
+            return nullptr;
+        }
+    }
+    
+    std::vector<TimeBucketValue>& appStats = GetInstance(env)->appStats;
+    
+    napi_value array;
+    napi_create_array(env, &array);
+    uint32_t count = 0;
+    for (size_t appId = 0; appId < appStats.size(); appId++) {
+        const TimeBucketValue& stats = appStats[appId];
+        if (stats.IsEmpty()) {
+            continue;
+        }
+        
+        napi_value obj;
+        napi_create_object(env, &obj);
+        
+        struct {
+            const char* name;
+            double value;
+        } fields[] = {
+            { "appId", static_cast<double>(appId) },
+            { "keys", static_cast<double>(stats.keys) },
+            { "activeMs", stats.activeUs / 1000.0 },
+            { "sessions", static_cast<double>(stats.sessions) },
+        };
+        for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+            napi_value value;
+            napi_create_double(env, fields[i].value, &value);
+            napi_set_named_property(env, obj, fields[i].name, value);
+        }
+        napi_set_element(env, array, count++, obj);
+    }
+    
+    if (reset) {
+        appStats.assign(appStats.size(), TimeBucketValue{0, 0, 0});
+    }
+    return array;
+}
+
+// 이벤트 아카이브 열기 (없으면 생성)
+// openArchive(path: string)
+napi_value KeyboardNativeBinding::OpenArchive(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    size_t pathLength = 0;
+    if (status != napi_ok || argc < 1 ||
+        napi_get_value_string_utf8(env, args[0], nullptr, 0, &pathLength) != napi_ok || pathLength == 0) {
+        napi_throw_type_error(env, nullptr, "Expected archive path to be a non-empty string");
+        return nullptr;
+    }
+    std::vector<char> path(pathLength + 1);
+    napi_get_value_string_utf8(env, args[0], path.data(), path.size(), &pathLength);
+    
+    napi_value result;
+    napi_get_boolean(env, GetInstance(env)->archive.Open(path.data()), &result);
+    return result;
+}
+
+// 이벤트 아카이브 닫기
+napi_value KeyboardNativeBinding::CloseArchive(napi_env env, napi_callback_info info) {
+    GetInstance(env)->archive.Close();
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+// 레코드 추가 (journalRange와 같은 배열 구조체 형태) - 기록한 블록 수 반환
+// 시각 순으로 정렬된 하루치 같은 큰 묶음으로 넘겨야 압축률이 좋음
+napi_value KeyboardNativeBinding::ArchiveAppend(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected records");
+        return nullptr;
+    }
+    
+    KeyboardAddonInstance* instance = GetInstance(env);
+    if (!instance->archive.IsOpen()) {
+        napi_throw_error(env, nullptr, "Event archive is not open");
+        return nullptr;
+    }
+    
+    std::vector<JournalRecord> records;
+    if (!ReadJournalRecordsObject(env, args[0], &records)) {
+        return nullptr;
+    }
+    
+    const int blocks = instance->archive.Append(records.data(), records.size());
+    if (blocks < 0) {
+        napi_throw_error(env, nullptr, "Failed to write event archive");
+        return nullptr;
+    }
+    
+    napi_value result;
+    napi_create_int32(env, blocks, &result);
+    return result;
+}
+
+// [start, end) 범위와 겹치는 다음 블록 하나 조회 - { records, cursor }
+// 다음 호출에 cursor를 넘겨 이어서 읽고, 더 읽을 블록이 없으면 cursor는 -1
+// archiveScan(start: number, end: number, cursor?: number)
+napi_value KeyboardNativeBinding::ArchiveScan(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    double start = 0;
+    double end = 0;
+    int64_t cursorValue = 0;
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2 ||
+        napi_get_value_double(env, args[0], &start) != napi_ok ||
+        napi_get_value_double(env, args[1], &end) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected start and end timestamps");
+        return nullptr;
+    }
+    if (argc >= 3) {
+        napi_valuetype valuetype;
+        napi_typeof(env, args[2], &valuetype);
+        if (valuetype != napi_undefined &&
+            (napi_get_value_int64(env, args[2], &cursorValue) != napi_ok || cursorValue < 0)) {
+            napi_throw_type_error(env, nullptr, "cursor must be a non-negative integer");
+            return nullptr;
+        }
+    }
+    
+    std::vector<JournalRecord> records;
+    size_t cursor = static_cast<size_t>(cursorValue);
+    bool more = false;
+    if (end > start && end > 0) {
+        more = GetInstance(env)->archive.Scan(start > 0 ? static_cast<uint64_t>(start) : 0,
+                                              static_cast<uint64_t>(end), &cursor, &records);
+    }
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    napi_set_named_property(env, obj, "records", CreateJournalRecordsObject(env, records));
+    
+    napi_value cursorResult;
+    napi_create_double(env, more ? static_cast<double>(cursor) : -1, &cursorResult);
+    napi_set_named_property(env, obj, "cursor", cursorResult);
+    return obj;
+}
+
+// 아카이브 요약 - { open, blocks, records, bytes, minTimestamp, maxTimestamp }
+napi_value KeyboardNativeBinding::ArchiveInfo(napi_env env, napi_callback_info info) {
+    const EventArchive& archive = GetInstance(env)->archive;
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value value;
+    napi_get_boolean(env, archive.IsOpen(), &value);
+    napi_set_named_property(env, obj, "open", value);
+    napi_create_double(env, static_cast<double>(archive.GetBlockCount()), &value);
+    napi_set_named_property(env, obj, "blocks", value);
+    napi_create_double(env, static_cast<double>(archive.GetRecordCount()), &value);
+    napi_set_named_property(env, obj, "records", value);
+    napi_create_double(env, static_cast<double>(archive.GetByteSize()), &value);
+    napi_set_named_property(env, obj, "bytes", value);
+    napi_create_double(env, static_cast<double>(archive.GetMinTimestamp()), &value);
+    napi_set_named_property(env, obj, "minTimestamp", value);
+    napi_create_double(env, static_cast<double>(archive.GetMaxTimestamp()), &value);
+    napi_set_named_property(env, obj, "maxTimestamp", value);
+    
+    return obj;
+}
+
+// 간격 분석 - 합/평균/분산, 분위수, 몰아치기/멈춤 구간, 시간 구간별 히스토그램
+// analyze(input: { intervals?, timestamps?, archive?: { start, end } }, options?) → Promise
+// 계산은 작업 스레드에서 수행하므로 큰 범위도 JS 스레드를 막지 않음
+napi_value KeyboardNativeBinding::Analyze(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    napi_valuetype valuetype = napi_undefined;
+    if (status != napi_ok || argc < 1 || napi_typeof(env, args[0], &valuetype) != napi_ok || valuetype != napi_object) {
+        napi_throw_type_error(env, nullptr, "Expected analytics input object");
+        return nullptr;
+    }
+    
+    std::unique_ptr<AnalyticsWork> work(new AnalyticsWork());
+    work->useArchive = false;
+    work->archiveStart = 0;
+    work->archiveEnd = 0;
+    work->kernel = AnalyticsKernels::Detect();
+    work->burstMs = 100;
+    work->pauseMs = 2000;
+    work->histogram = false;
+    work->histogramOrigin = 0;
+    work->histogramWidth = 0;
+    work->histogramBuckets = 0;
+    work->failed = false;
+    work->events = 0;
+    work->elapsedNs = 0;
+    memset(&work->moments, 0, sizeof(work->moments));
+    memset(&work->segments, 0, sizeof(work->segments));
+    work->percentiles.push_back(50);
+    work->percentiles.push_back(90);
+    work->percentiles.push_back(99);
+    
+    if (!ParseAnalyticsInput(env, args[0], work.get()) ||
+        !ParseAnalyticsOptions(env, argc >= 2 ? args[1] : nullptr, work.get())) {
+        return nullptr;
+    }
+    if (work->histogram && work->timestamps.size() != work->intervals.size()) {
+        napi_throw_type_error(env, nullptr, "histogram requires timestamps for every interval");
+        return nullptr;
+    }
+    
+    napi_value promise;
+    napi_value resourceName;
+    napi_create_string_utf8(env, "KeyboardAnalytics", NAPI_AUTO_LENGTH, &resourceName);
+    if (napi_create_promise(env, &work->deferred, &promise) != napi_ok ||
+        napi_create_async_work(env, nullptr, resourceName, ExecuteAnalytics, CompleteAnalytics,
+                               work.get(), &work->work) != napi_ok) {
+        napi_throw_error(env, nullptr, "Failed to create analytics work");
+        return nullptr;
+    }
+    if (napi_queue_async_work(env, work->work) != napi_ok) {
+        napi_delete_async_work(env, work->work);
+        napi_throw_error(env, nullptr, "Failed to queue analytics work");
+        return nullptr;
+    }
+    
+    work.release();
+    return promise;
+}
+
+// 이 CPU에서 analyze가 기본으로 쓰는 커널 이름
+napi_value KeyboardNativeBinding::GetAnalyticsKernel(napi_env env, napi_callback_info info) {
+    napi_value result;
+    napi_create_string_utf8(env, AnalyticsKernels::Name(AnalyticsKernels::Detect()), NAPI_AUTO_LENGTH, &result);
+    return result;
+}
+
+// 실시간 타이핑 상태 읽기 - readSnapshot(buffer: Float64Array) → 입력 중 여부
+// 호출자 버퍼(LIVE_STATE_FIELD_COUNT 칸 이상)에 LiveStateField 순서로 채움
+// 화면 갱신 주기로 호출하도록 JS 객체를 만들지 않음 (반환값도 캐시된 불리언)
+napi_value KeyboardNativeBinding::ReadSnapshot(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    bool isTypedArray = false;
+    napi_typedarray_type type;
+    size_t length = 0;
+    void* data = nullptr;
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1 ||
+        napi_is_typedarray(env, args[0], &isTypedArray) != napi_ok || !isTypedArray ||
+        napi_get_typedarray_info(env, args[0], &type, &length, &data, nullptr, nullptr) != napi_ok ||
+        type != napi_float64_array) {
+        napi_throw_type_error(env, nullptr, "Expected a Float64Array");
+        return nullptr;
+    }
+    if (length < LIVE_STATE_FIELD_COUNT) {
+        napi_throw_range_error(env, nullptr, "Snapshot buffer is too small");
+        return nullptr;
+    }
+
+    double* out = static_cast<double*>(data);
+    s_dispatcher.GetLiveState().Read(EventClock::NowNs(), out);
+
+    napi_value result;
+    napi_get_boolean(env, out[LIVE_STATE_ACTIVE] != 0, &result);
+    return result;
+}
+
+// 실시간 상태 판정 기준 변경 - setLiveStateOptions({ activeMs, comboGapMs, rateWindowMs }) → 적용된 설정
+// 프로세스 공유 (OS 후킹이 하나) - 지정하지 않은 항목은 현재 값 유지
+napi_value KeyboardNativeBinding::SetLiveStateOptions(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    napi_value options = argc >= 1 ? args[0] : nullptr;
+
+    double activeMs = 0;
+    double comboGapMs = 0;
+    double rateWindowMs = 0;
+    if (!ReadNumberOption(env, options, "activeMs", &activeMs) ||
+        !ReadNumberOption(env, options, "comboGapMs", &comboGapMs) ||
+        !ReadNumberOption(env, options, "rateWindowMs", &rateWindowMs)) {
+        return nullptr;
+    }
+    if (activeMs > UINT32_MAX || comboGapMs > UINT32_MAX || rateWindowMs > UINT32_MAX) {
+        napi_throw_range_error(env, nullptr, "Live state options are out of range");
+        return nullptr;
+    }
+    s_dispatcher.GetLiveState().Configure(static_cast<uint32_t>(activeMs), static_cast<uint32_t>(comboGapMs),
+                          static_cast<uint32_t>(rateWindowMs));
+
+    napi_value obj;
+    napi_create_object(env, &obj);
+
+    napi_value value;
+    napi_create_uint32(env, s_dispatcher.GetLiveState().GetActiveMs(), &value);
+    napi_set_named_property(env, obj, "activeMs", value);
+    napi_create_uint32(env, s_dispatcher.GetLiveState().GetComboGapMs(), &value);
+    napi_set_named_property(env, obj, "comboGapMs", value);
+    napi_create_uint32(env, s_dispatcher.GetLiveState().GetRateWindowMs(), &value);
+    napi_set_named_property(env, obj, "rateWindowMs", value);
+
+    return obj;
+}
+
+// 현재 키 상태 - { modifiers, keysDown } (프로세스 공유, 어느 키가 눌렸는지는 노출하지 않음)
+napi_value KeyboardNativeBinding::GetKeyState(napi_env env, napi_callback_info info) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value value;
+    napi_create_uint32(env, s_dispatcher.GetKeyState().Modifiers(), &value);
+    napi_set_named_property(env, obj, "modifiers", value);
+    napi_create_uint32(env, s_dispatcher.GetKeyState().DownCount(), &value);
+    napi_set_named_property(env, obj, "keysDown", value);
+    
+    return obj;
+}
+
+// 지연 추적 시작 - startTrace(path: string): boolean
+// 키 입력마다 추적 ID를 붙이고 후킹/링 대기/JS 호출 구간을 Chrome trace-event JSON 파일로 기록
+napi_value KeyboardNativeBinding::StartTrace(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        napi_throw_error(env, nullptr, "Expected trace file path");
+        return nullptr;
+    }
+    
+    size_t pathLength = 0;
+    status = napi_get_value_string_utf8(env, args[0], nullptr, 0, &pathLength);
+    if (status != napi_ok || pathLength == 0) {
+        napi_throw_type_error(env, nullptr, "Expected trace file path to be a non-empty string");
+        return nullptr;
+    }
+    std::vector<char> path(pathLength + 1);
+    napi_get_value_string_utf8(env, args[0], path.data(), path.size(), &pathLength);
+    
+    std::string error;
+    const bool started = TraceRecorder::Shared().Start(path.data(), &error);
+    if (!started) {
+        std::cerr << "Failed to start trace: " << error << std::endl;
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, started, &result);
+    return result;
+}
+
+// 지연 추적 중지 - stopTrace(): { path, events, dropped } | null (추적 중이 아니었으면 null)
+napi_value KeyboardNativeBinding::StopTrace(napi_env env, napi_callback_info info) {
+    TraceSummary summary;
+    if (!TraceRecorder::Shared().Stop(&summary)) {
+        napi_value result;
+        napi_get_null(env, &result);
+        return result;
+    }
+    return CreateTraceSummaryObject(env, summary);
+}
+
+// 쌓인 구간을 파일에 씀 - flushTrace(): { path, events, dropped } | null
+// 스레드별 버퍼는 고정 크기이므로 추적 중에는 JS가 주기적으로 호출
+napi_value KeyboardNativeBinding::FlushTrace(napi_env env, napi_callback_info info) {
+    TraceRecorder& recorder = TraceRecorder::Shared();
+    if (!recorder.IsEnabled()) {
+        napi_value result;
+        napi_get_null(env, &result);
+        return result;
+    }
+    
+    TraceSummary summary;
+    recorder.Flush(&summary);
+    return CreateTraceSummaryObject(env, summary);
+}
+
+// JS 쪽 구간 기록 - traceSpan(traceId, name, startMs, endMs, options?: { track?: string, end?: boolean })
+// 시각은 epoch 밀리초 (Date.now()/performance.timeOrigin 기준) - 네이티브 구간과 같은 단조 시계 축으로 변환
+// traceId가 0이 아니면 흐름 단계로 이어 붙이고, end면 그 키 입력의 흐름을 닫음
+napi_value KeyboardNativeBinding::RecordTraceSpan(napi_env env, napi_callback_info info) {
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    
+    TraceRecorder& recorder = TraceRecorder::Shared();
+    if (!recorder.IsEnabled()) {
+        return undefined;
+    }
+    
+    size_t argc = 5;
+    napi_value args[5];
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 4) {
+        napi_throw_error(env, nullptr, "Expected traceId, name, startMs and endMs");
+        return nullptr;
+    }
+    
+    double traceId = 0;
+    double startMs = 0;
+    double endMs = 0;
+    if (napi_get_value_double(env, args[0], &traceId) != napi_ok ||
+        napi_get_value_double(env, args[2], &startMs) != napi_ok ||
+        napi_get_value_double(env, args[3], &endMs) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected traceId, startMs and endMs to be numbers");
+        return nullptr;
+    }
+    if (!(traceId >= 0) || !(startMs > 0) || !(endMs >= startMs)) {
+        napi_throw_range_error(env, nullptr, "Expected traceId >= 0 and 0 < startMs <= endMs");
+        return nullptr;
+    }
+    
+    char name[128];
+    size_t nameLength = 0;
+    if (napi_get_value_string_utf8(env, args[1], name, sizeof(name), &nameLength) != napi_ok || nameLength == 0) {
+        napi_throw_type_error(env, nullptr, "Expected span name to be a non-empty string");
+        return nullptr;
+    }
+    
+    std::string track;
+    bool end = false;
+    if (argc >= 5) {
+        napi_valuetype valuetype;
+        napi_typeof(env, args[4], &valuetype);
+        if (valuetype == napi_object) {
+            if (!ReadStringOption(env, args[4], "track", &track)) {
+                return nullptr;
+            }
+            bool hasProperty = false;
+            napi_has_named_property(env, args[4], "end", &hasProperty);
+            if (hasProperty) {
+                napi_value value;
+                napi_get_named_property(env, args[4], "end", &value);
+                napi_get_value_bool(env, value, &end);
+            }
+        }
+    }
+    
+    const uint64_t id = static_cast<uint64_t>(traceId);
+    recorder.NameCurrentThread("js main");
+    recorder.Record(recorder.Intern(name, nameLength), recorder.Intern(track.data(), track.size()),
+                    EventClock::FromWallNs(static_cast<int64_t>(startMs * 1e6)),
+                    EventClock::FromWallNs(static_cast<int64_t>(endMs * 1e6)), id,
+                    id == 0 ? TRACE_FLOW_NONE : (end ? TRACE_FLOW_END : TRACE_FLOW_STEP));
+    return undefined;
+}
+
+// 분석 입력 읽기 - 배열은 작업 스레드가 읽는 동안 JS에서 바뀌지 않도록 복사
+bool KeyboardNativeBinding::ParseAnalyticsInput(napi_env env, napi_value input, AnalyticsWork* work) {
+    static const char* const names[2] = { "timestamps", "intervals" };
+    std::vector<double>* targets[2] = { &work->timestamps, &work->intervals };
+    bool present[2] = { false, false };
+    const double* arrays[2] = { nullptr, nullptr };
+    size_t lengths[2] = { 0, 0 };
+    
+    for (int i = 0; i < 2; i++) {
+        bool hasProperty = false;
+        napi_has_named_property(env, input, names[i], &hasProperty);
+        if (!hasProperty) {
+            continue;
+        }
+        
+        napi_value array;
+        napi_valuetype valuetype;
+        napi_get_named_property(env, input, names[i], &array);
+        napi_typeof(env, array, &valuetype);
+        if (valuetype == napi_undefined) {
+            continue;
+        }
+        
+        bool isTypedArray = false;
+        napi_typedarray_type type;
+        void* data = nullptr;
+        if (napi_is_typedarray(env, array, &isTypedArray) != napi_ok || !isTypedArray ||
+            napi_get_typedarray_info(env, array, &type, &lengths[i], &data, nullptr, nullptr) != napi_ok ||
+            type != napi_float64_array) {
+            std::string message = std::string(names[i]) + " must be a Float64Array";
+            napi_throw_type_error(env, nullptr, message.c_str());
+            return false;
+        }
+        present[i] = true;
+        arrays[i] = static_cast<const double*>(data);
+    }
+    
+    if (present[0] && present[1] && lengths[0] != lengths[1]) {
+        napi_throw_range_error(env, nullptr, "timestamps and intervals must have the same length");
+        return false;
+    }
+    
+    bool hasArchive = false;
+    napi_has_named_property(env, input, "archive", &hasArchive);
+    if (hasArchive) {
+        napi_value range;
+        napi_valuetype valuetype;
+        napi_get_named_property(env, input, "archive", &range);
+        napi_typeof(env, range, &valuetype);
+        if (valuetype == napi_object) {
+            double start = 0;
+            double end = 0;
+            if (!ReadNumberOption(env, range, "start", &start) || !ReadNumberOption(env, range, "end", &end)) {
+                return false;
+            }
+            
+            const EventArchive& archive = GetInstance(env)->archive;
+            if (!archive.IsOpen()) {
+                napi_throw_error(env, nullptr, "Event archive is not open");
+                return false;
+            }
+            if (end > start) {
+                archive.Snapshot(&work->archive);
+                work->useArchive = true;
+                work->archiveStart = static_cast<uint64_t>(start);
+                work->archiveEnd = static_cast<uint64_t>(end);
+            }
+        } else if (valuetype != napi_undefined) {
+            napi_throw_type_error(env, nullptr, "archive must be an object { start, end }");
+            return false;
+        }
+    }
+    
+    // 배열은 아카이브 레코드 뒤에 붙이므로 작업 스레드에서 합침 - 여기서는 복사만
+    for (int i = 0; i < 2; i++) {
+        if (present[i]) {
+            targets[i]->assign(arrays[i], arrays[i] + lengths[i]);
+        }
+    }
+    if (!present[1]) {
+        work->timestamps.clear();
+    }
+    return true;
+}
+
+// 분석 옵션 읽기
+// { percentiles?: number[] (0-100), burstMs?, pauseMs?, histogram?: { origin, width, buckets }, kernel? }
+bool KeyboardNativeBinding::ParseAnalyticsOptions(napi_env env, napi_value options, AnalyticsWork* work) {
+    if (!options) {
+        return true;
+    }
+    napi_valuetype valuetype;
+    napi_typeof(env, options, &valuetype);
+    if (valuetype == napi_undefined || valuetype == napi_null) {
+        return true;
+    }
+    if (valuetype != napi_object) {
+        napi_throw_type_error(env, nullptr, "Expected analytics options object");
+        return false;
+    }
+    
+    if (!ReadNumberOption(env, options, "burstMs", &work->burstMs) ||
+        !ReadNumberOption(env, options, "pauseMs", &work->pauseMs)) {
+        return false;
+    }
+    
+    std::string kernelName;
+    if (!ReadStringOption(env, options, "kernel", &kernelName)) {
+        return false;
+    }
+    if (!kernelName.empty() && !AnalyticsKernels::Parse(kernelName.c_str(), &work->kernel)) {
+        napi_throw_type_error(env, nullptr, "kernel must be one of 'auto', 'scalar', 'sse2', 'neon', 'avx2'");
+        return false;
+    }
+    
+    bool hasProperty = false;
+    napi_has_named_property(env, options, "percentiles", &hasProperty);
+    if (hasProperty) {
+        napi_value array;
+        bool isArray = false;
+        uint32_t length = 0;
+        napi_get_named_property(env, options, "percentiles", &array);
+        if (napi_is_array(env, array, &isArray) != napi_ok || !isArray) {
+            napi_throw_type_error(env, nullptr, "percentiles must be an array of numbers");
+            return false;
+        }
+        napi_get_array_length(env, array, &length);
+        work->percentiles.clear();
+        for (uint32_t i = 0; i < length; i++) {
+            napi_value element;
+            double percentile = 0;
+            napi_get_element(env, array, i, &element);
+            if (napi_get_value_double(env, element, &percentile) != napi_ok || !(percentile >= 0 && percentile <= 100)) {
+                napi_throw_range_error(env, nullptr, "percentiles must be numbers between 0 and 100");
+                return false;
+            }
+            work->percentiles.push_back(percentile);
+        }
+    }
+    
+    napi_has_named_property(env, options, "histogram", &hasProperty);
+    if (hasProperty) {
+        napi_value histogram;
+        napi_get_named_property(env, options, "histogram", &histogram);
+        napi_typeof(env, histogram, &valuetype);
+        if (valuetype == napi_object) {
+            double buckets = 0;
+            if (!ReadNumberOption(env, histogram, "origin", &work->histogramOrigin) ||
+                !ReadNumberOption(env, histogram, "width", &work->histogramWidth) ||
+                !ReadNumberOption(env, histogram, "buckets", &buckets)) {
+                return false;
+            }
+            if (!(work->histogramWidth > 0) || buckets < 1 || buckets > 1000000) {
+                napi_throw_range_error(env, nullptr, "histogram requires width > 0 and 1-1000000 buckets");
+                return false;
+            }
+            work->histogram = true;
+            work->histogramBuckets = static_cast<uint32_t>(buckets);
+        } else if (valuetype != napi_undefined) {
+            napi_throw_type_error(env, nullptr, "histogram must be an object { origin, width, buckets }");
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// 작업 스레드 - 아카이브 범위를 풀어 입력 앞에 붙이고 커널 실행 (N-API 호출 금지)
+void KeyboardNativeBinding::ExecuteAnalytics(napi_env env, void* data) {
+    AnalyticsWork* work = static_cast<AnalyticsWork*>(data);
+    const uint64_t startNs = EventClock::NowNs();
+    
+    if (work->useArchive) {
+        if (!work->archive.Open()) {
+            work->failed = true;
+            work->error = "Failed to read event archive";
+            return;
+        }
+        
+        std::vector<JournalRecord> records;
+        std::vector<double> timestamps;
+        std::vector<double> intervals;
+        size_t cursor = 0;
+        while (work->archive.Scan(work->archiveStart, work->archiveEnd, &cursor, &records)) {
+            for (const JournalRecord& record : records) {
+                timestamps.push_back(static_cast<double>(record.timestamp));
+                intervals.push_back(static_cast<double>(record.interval) / 1000.0);
+            }
+            records.clear();
+        }
+        work->archive.Close();
+        
+        timestamps.insert(timestamps.end(), work->timestamps.begin(), work->timestamps.end());
+        intervals.insert(intervals.end(), work->intervals.begin(), work->intervals.end());
+        work->timestamps.swap(timestamps);
+        work->intervals.swap(intervals);
+    }
+    
+    const size_t count = work->intervals.size();
+    work->events = count;
+    
+    AnalyticsKernels::Segments(work->kernel, work->intervals.data(), count, work->burstMs, work->pauseMs, &work->segments);
+    
+    if (work->histogram) {
+        work->histogramCounts.assign(work->histogramBuckets, 0.0);
+        work->histogramSums.assign(work->histogramBuckets, 0.0);
+        AnalyticsKernels::Histogram(work->kernel, work->timestamps.data(), work->intervals.data(), count,
+                                    work->histogramOrigin, work->histogramWidth, work->histogramBuckets,
+                                    work->histogramCounts.data(), work->histogramSums.data());
+    }
+    
+    // 통계와 분위수는 세션 첫 키(간격 0)를 뺀 값으로 - 입력 사본을 그대로 재사용
+    const size_t positive = AnalyticsKernels::CompactPositive(work->intervals.data(), count, work->intervals.data());
+    AnalyticsKernels::Moments(work->kernel, work->intervals.data(), positive, &work->moments);
+    work->percentileValues.resize(work->percentiles.size());
+    AnalyticsKernels::Percentiles(work->kernel, work->intervals.data(), positive,
+                                  work->percentiles.data(), work->percentiles.size(), work->percentileValues.data());
+    
+    work->elapsedNs = EventClock::NowNs() - startNs;
+}
+
+// JS 스레드 - Promise 처리 후 작업 해제
+void KeyboardNativeBinding::CompleteAnalytics(napi_env env, napi_status status, void* data) {
+    AnalyticsWork* work = static_cast<AnalyticsWork*>(data);
+    
+    if (status != napi_ok || work->failed) {
+        napi_value message;
+        napi_value error;
+        napi_create_string_utf8(env, work->failed ? work->error.c_str() : "Analytics work cancelled",
+                                NAPI_AUTO_LENGTH, &message);
+        napi_create_error(env, nullptr, message, &error);
+        napi_reject_deferred(env, work->deferred, error);
+    } else {
+        napi_resolve_deferred(env, work->deferred, CreateAnalyticsObject(env, *work));
+    }
+    
+    napi_delete_async_work(env, work->work);
+    delete work;
+}
+
+// 옵션 객체에서 숫자 값 읽기 (없으면 value 유지, 타입이 다르면 예외 후 false)
+// 불리언도 허용 (true = 1, false = 0)
+bool KeyboardNativeBinding::ReadNumberOption(napi_env env, napi_value options, const char* name, double* value) {
+    bool hasProperty = false;
+    if (!options || napi_has_named_property(env, options, name, &hasProperty) != napi_ok || !hasProperty) {
+        return true;
+    }
+    
+    napi_value property;
+    napi_valuetype valuetype;
+    napi_get_named_property(env, options, name, &property);
+    napi_typeof(env, property, &valuetype);
+    
+    if (valuetype == napi_undefined) {
+        return true;
+    }
+    if (valuetype == napi_boolean) {
+        bool flag = false;
+        napi_get_value_bool(env, property, &flag);
+        *value = flag ? 1 : 0;
+        return true;
+    }
+    if (valuetype != napi_number || napi_get_value_double(env, property, value) != napi_ok || *value < 0) {
+        std::string message = std::string(name) + " must be a non-negative number";
+        napi_throw_type_error(env, nullptr, message.c_str());
+        return false;
+    }
+    return true;
+}
+
+// 옵션 객체에서 문자열 값 읽기 (없으면 value 유지, 타입이 다르면 예외 후 false)
+bool KeyboardNativeBinding::ReadStringOption(napi_env env, napi_value options, const char* name, std::string* value) {
+    bool hasProperty = false;
+    if (!options || napi_has_named_property(env, options, name, &hasProperty) != napi_ok || !hasProperty) {
+        return true;
+    }
+    
+    napi_value property;
+    napi_valuetype valuetype;
+    napi_get_named_property(env, options, name, &property);
+    napi_typeof(env, property, &valuetype);
+    
+    if (valuetype == napi_undefined) {
+        return true;
+    }
+    
+    size_t length = 0;
+    if (valuetype != napi_string || napi_get_value_string_utf8(env, property, nullptr, 0, &length) != napi_ok) {
+        std::string message = std::string(name) + " must be a string";
+        napi_throw_type_error(env, nullptr, message.c_str());
+        return false;
+    }
+    
+    std::vector<char> buffer(length + 1);
+    napi_get_value_string_utf8(env, property, buffer.data(), buffer.size(), &length);
+    value->assign(buffer.data(), length);
+    return true;
+}
+
+// 옵션 객체에서 키 코드 배열을 읽어 집합으로 변환 (없으면 value 유지, 형식이 다르면 예외 후 false)
+bool KeyboardNativeBinding::ReadKeyCodeSetOption(napi_env env, napi_value options, const char* name, KeyCodeSet* value) {
+    bool hasProperty = false;
+    if (!options || napi_has_named_property(env, options, name, &hasProperty) != napi_ok || !hasProperty) {
+        return true;
+    }
+    
+    napi_value property;
+    napi_valuetype valuetype;
+    napi_get_named_property(env, options, name, &property);
+    napi_typeof(env, property, &valuetype);
+    
+    if (valuetype == napi_undefined) {
+        return true;
+    }
+    
+    const std::string message = std::string(name) + " must be an array of key codes (0-255)";
+    bool isArray = false;
+    uint32_t length = 0;
+    if (napi_is_array(env, property, &isArray) != napi_ok || !isArray ||
+        napi_get_array_length(env, property, &length) != napi_ok) {
+        napi_throw_type_error(env, nullptr, message.c_str());
+        return false;
+    }
+    
+    KeyCodeSet keyCodes;
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        uint32_t keyCode = 0;
+        if (napi_get_element(env, property, i, &element) != napi_ok ||
+            napi_get_value_uint32(env, element, &keyCode) != napi_ok ||
+            keyCode >= KeyCodeSet::kMaxKeyCodes) {
+            napi_throw_range_error(env, nullptr, message.c_str());
+            return false;
+        }
+        keyCodes.Set(keyCode);
+    }
+    
+    *value = keyCodes;
+    return true;
+}
+
+// 리스너 백엔드 생성
+template <typename Sink>
+KeyboardListenerBase* KeyboardNativeBinding::CreateListenerBackend(napi_env env, const char* name, napi_value options,
+                                                                   Sink& sink, bool* backpressure) {
+    *backpressure = false;
+    if (strcmp(name, "default") == 0) {
+        return CreatePlatformListener(sink);
+    }
+    
+    // 트레이스 재생 / 합성 타이핑 (플랫폼 공통)
+    if (strcmp(name, "replay") == 0 || strcmp(name, "synthetic") == 0) {
+        ReplayOptions replayOptions = DefaultReplayOptions();
+        double loop = 0;
+        double rebase = 1;
+        if (!ReadNumberOption(env, options, "speed", &replayOptions.speed) ||
+            !ReadNumberOption(env, options, "loop", &loop) ||
+            !ReadNumberOption(env, options, "rebaseTimestamps", &rebase)) {
+            return nullptr;
+        }
+        replayOptions.loop = loop != 0;
+        replayOptions.rebaseTimestamps = rebase != 0;
+        // 최대 속도 재생은 링이 차도 버리지 않고 기다림 (전달 결과가 스케줄링에 좌우되지 않도록)
+        *backpressure = replayOptions.speed == 0;
+        
+        if (strcmp(name, "replay") == 0) {
+            std::string trace;
+            if (!ReadStringOption(env, options, "trace", &trace)) {
+                return nullptr;
+            }
+            if (trace.empty()) {
+                napi_throw_type_error(env, nullptr, "Replay backend requires a trace path");
+                return nullptr;
+            }
+            if (replayOptions.loop && replayOptions.rebaseTimestamps && IsAcceleratedReplay(replayOptions)) {
+                napi_throw_range_error(env, nullptr, "Accelerated replay cannot loop (timestamps would run ahead of wall time)");
+                return nullptr;
+            }
+            return new KeyboardListenerReplay<Sink>(sink, trace, replayOptions);
+        }
+        
+        SyntheticTypingModel model = DefaultSyntheticTypingModel();
+        double keyCount = 0;
+        double seed = static_cast<double>(model.seed);
+        double appCount = 0;
+        if (!ReadNumberOption(env, options, "keyCount", &keyCount) ||
+            !ReadNumberOption(env, options, "seed", &seed) ||
+            !ReadNumberOption(env, options, "intervalMedianMs", &model.intervalMedianMs) ||
+            !ReadNumberOption(env, options, "intervalSigma", &model.intervalSigma) ||
+            !ReadNumberOption(env, options, "burstMeanKeys", &model.burstMeanKeys) ||
+            !ReadNumberOption(env, options, "pauseMeanMs", &model.pauseMeanMs) ||
+            !ReadNumberOption(env, options, "holdMs", &model.holdMs) ||
+            !ReadNumberOption(env, options, "appCount", &appCount)) {
+            return nullptr;
+        }
+        model.appCount = appCount > 0 ? static_cast<uint32_t>(appCount) : 0;
+        model.keyCount = keyCount > 0 ? static_cast<uint64_t>(keyCount) : 0;
+        model.seed = static_cast<uint64_t>(seed);
+        if (model.keyCount == 0 && IsAcceleratedReplay(replayOptions)) {
+            napi_throw_range_error(env, nullptr, "Accelerated synthetic typing requires keyCount (timestamps would run ahead of wall time)");
+            return nullptr;
+        }
+        return new KeyboardListenerReplay<Sink>(sink, model, replayOptions);
+    }
+    
+#ifdef __linux__
+    if (strcmp(name, "xrecord") == 0) {
+        return new KeyboardListenerLinux<Sink>(sink);
+    }
+    
+    if (strcmp(name, "evdev") == 0) {
+        // 장치 경로 목록 (없으면 /dev/input 자동 탐색)
+        bool hasDevices = false;
+        if (options) {
+            napi_has_named_property(env, options, "devices", &hasDevices);
+        }
+        if (!hasDevices) {
+            return new KeyboardListenerEvdev<Sink>(sink);
+        }
+        
+        napi_value devices;
+        bool isArray = false;
+        napi_get_named_property(env, options, "devices", &devices);
+        napi_is_array(env, devices, &isArray);
+        if (!isArray) {
+            napi_throw_type_error(env, nullptr, "Expected devices to be an array of paths");
+            return nullptr;
+        }
+        
+        uint32_t length = 0;
+        napi_get_array_length(env, devices, &length);
+        std::vector<std::string> paths;
+        for (uint32_t i = 0; i < length; i++) {
+            napi_value element;
+            size_t pathLength = 0;
+            napi_get_element(env, devices, i, &element);
+            if (napi_get_value_string_utf8(env, element, nullptr, 0, &pathLength) != napi_ok || pathLength == 0) {
+                napi_throw_type_error(env, nullptr, "Expected devices to be an array of paths");
+                return nullptr;
+            }
+            // 장치 표의 경로 칸에 들어가지 않으면 거부 (잘린 경로로 다른 장치를 열지 않도록)
+            if (pathLength >= EVDEV_PATH_MAX) {
+                napi_throw_type_error(env, nullptr, "Device path is too long");
+                return nullptr;
+            }
+            std::vector<char> path(pathLength + 1);
+            napi_get_value_string_utf8(env, element, path.data(), path.size(), &pathLength);
+            paths.push_back(std::string(path.data(), pathLength));
+        }
+        return new KeyboardListenerEvdev<Sink>(sink, paths);
+    }
+#endif
+    
+    return nullptr;
+}
+
+// 링에서 꺼낸 항목을 지표와 세션 통계에 반영 (JS 스레드)
+void KeyboardNativeBinding::AccountDequeued(KeyboardSubscription* sub, const QueuedEvent& entry) {
+    // 세션 종료 항목은 키 이벤트가 아님
+    if (entry.session.type != SESSION_RECORD_END) {
+        sub->metrics.delivered.fetch_add(1, std::memory_order_relaxed);
+        sub->metrics.deliveryLatency.Record(sub->wakeNs > entry.enqueuedNs ? sub->wakeNs - entry.enqueuedNs : 0);
+    }
+    // 링 대기는 지표와 같은 기준 (후킹 진입 → 이번 깨우기 시작)
+    if (entry.traceId != 0) {
+        TraceRecorder& recorder = TraceRecorder::Shared();
+        recorder.NameCurrentThread("js main");
+        recorder.Record(TRACE_NAME_RING_WAIT, TRACE_NAME_NONE, entry.enqueuedNs, sub->wakeNs, entry.traceId,
+                        TRACE_FLOW_NONE);
+    }
+    AccountSessionRecord(sub, entry.session);
+}
+
+// 링에서 꺼낸 세션 레코드를 구독의 세션 통계에 반영 (JS 스레드)
+// 저널/통계 집계는 과부하 정책과 상관없이 레코드 링에서 (DrainSessionRecords)
+void KeyboardNativeBinding::AccountSessionRecord(KeyboardSubscription* sub, const SessionRecord& record) {
+    if (record.type != SESSION_RECORD_TYPING) {
+        return;
+    }
+    
+    // 새 세션의 첫 키 - 이전 세션 통계 초기화
+    if (record.keyCount == 1) {
+        sub->sessionStats.Reset();
+        return;
+    }
+    
+    sub->sessionStats.Add(record.interval);
+}
+
+// 레코드 링을 비워 저널과 통계에 반영 (JS 스레드, 깨어날 때마다 이벤트 링보다 먼저)
+// 합쳐지거나 버려진 이벤트 링 항목과 상관없이 키마다 한 번씩 셈
+// (기본 구독만 레코드 링이 있으므로 추가 구독이 같은 키 입력을 다시 세지 않음)
+void KeyboardNativeBinding::DrainSessionRecords(KeyboardSubscription* sub) {
+    KeyboardAddonInstance* instance = sub->instance;
+    if (!sub->recordRing || !instance) {
+        return;
+    }
+    
+    SessionRecord record;
+    while (sub->recordRing->TryPop(&record)) {
+        // 저널이 열려 있으면 타이핑 이벤트를 기록 (SQLite 대신 메모리 매핑 세그먼트에 복사)
+        if (instance->journal.IsOpen()) {
+            instance->journal.Append(record);
+        }
+        
+        // 일별/시간별 통계 증분과 시간 버킷 색인 갱신 (레코드당 O(1) / O(log n))
+        const double wallMs = EventClock::ToWallMs(record.timestamp);
+        instance->rollup.Add(record, wallMs);
+        
+        TimeBucketValue bucket;
+        bucket.keys = 1;
+        bucket.activeUs = record.keyCount > 1 ? record.interval / 1000 : 0;
+        bucket.sessions = record.keyCount <= 1 ? 1 : 0;
+        instance->timeIndex.Add(wallMs, bucket);
+        
+        // 앱별 누적 (새 앱이 처음 나타날 때만 늘어남)
+        if (record.appId >= instance->appStats.size()) {
+            instance->appStats.resize(record.appId + 1, TimeBucketValue{0, 0, 0});
+        }
+        instance->appStats[record.appId].Add(bucket);
+    }
+}
+
+// JS 스레드 깨우기 요청
+// (구독의 CaptureSubscription::wake - 후킹 스레드에서도 호출)
+void KeyboardNativeBinding::WakeJS(CaptureSubscription* captureSub) {
+    KeyboardSubscription* sub = static_cast<KeyboardSubscription*>(captureSub);
+    if (sub->callback) {
+        // 큐가 가득 찬 경우(napi_queue_full)는 이미 깨우기가 예약된 상태이므로 무시
+        napi_call_threadsafe_function(sub->callback, nullptr, napi_tsfn_nonblocking);
+    }
+}
+
+// JavaScript 콜백 호출 - 링에 쌓인 이벤트를 모두 전달
+void KeyboardNativeBinding::CallJS(napi_env env, napi_value js_callback, void* context, void* data) {
+    if (!env || !js_callback) {
+        return;
+    }
+
+    // 중지 직후 다시 시작한 경우 이전 함수의 마지막 호출은 무시
+    // (남은 이벤트는 새 리스닝이 시작하면서 전달)
+    DeliveryToken* token = static_cast<DeliveryToken*>(context);
+    KeyboardSubscription* sub = token->subscription;
+    if (token->generation != sub->generation) {
+        return;
+    }
+
+    // 깨어날 때마다 벽시계 기준점 갱신 (절전/NTP 보정이 다음 변환부터 반영됨)
+    sub->wakeNs = EventClock::RefreshWallOffset();
+    sub->metrics.wakeups.fetch_add(1, std::memory_order_relaxed);
+    DrainSessionRecords(sub);
+
+    if (sub->deliveryMode == DELIVERY_BATCHED) {
+        DeliverBatches(env, js_callback, sub);
+        return;
+    }
+    if (sub->deliveryMode == DELIVERY_SESSIONS) {
+        DeliverSessionRecords(env, js_callback, sub);
+        return;
+    }
+    if (sub->deliveryMode == DELIVERY_RHYTHM) {
+        DeliverRhythmEvents(env, js_callback, sub);
+        return;
+    }
+
+    napi_value global;
+    napi_get_global(env, &global);
+
+    // 한 번의 깨우기에서 최대 링 크기만큼 처리 (메인 스레드 독점 방지)
+    QueuedEvent entry;
+    size_t delivered = 0;
+    while (delivered < KEY_EVENT_RING_CAPACITY && CaptureDispatcher::PopEvent(sub, &entry)) {
+        delivered++;
+        AccountDequeued(sub, entry);
+
+        // 세션 종료 항목은 키 이벤트가 아님
+        if (entry.session.type == SESSION_RECORD_END) {
+            continue;
+        }
+
+        // KeyEvent 객체 생성 (요약 항목은 마지막 이벤트에 합쳐진 개수와 첫 이벤트 시각을 덧붙임)
+        napi_value eventObj = CreateKeyEventObject(env, entry.event, entry.keyState);
+        if (entry.coalescedCount > 0) {
+            napi_value coalescedCount, coalescedStart;
+            napi_create_uint32(env, entry.coalescedCount, &coalescedCount);
+            napi_create_double(env, EventClock::ToWallMs(entry.coalescedStartNs), &coalescedStart);
+            napi_set_named_property(env, eventObj, "coalescedCount", coalescedCount);
+            napi_set_named_property(env, eventObj, "coalescedStart", coalescedStart);
+        }
+
+        if (entry.traceId != 0) {
+            napi_value traceId;
+            napi_create_double(env, static_cast<double>(entry.traceId), &traceId);
+            napi_set_named_property(env, eventObj, "traceId", traceId);
+        }
+
+        // JavaScript 콜백 함수 호출
+        const uint64_t callStartNs = entry.traceId != 0 ? EventClock::NowNs() : 0;
+        napi_value result;
+        napi_status status = napi_call_function(env, global, js_callback, 1, &eventObj, &result);
+        if (entry.traceId != 0) {
+            TraceRecorder::Shared().Record(TRACE_NAME_JS_DISPATCH, TRACE_NAME_NONE, callStartNs, EventClock::NowNs(),
+                                           entry.traceId, TRACE_FLOW_STEP);
+        }
+        if (status != napi_ok) {
+            // 콜백에서 예외 발생 - 남은 이벤트는 다음 깨우기에서 처리
+            break;
+        }
+    }
+
+    // 아직 남은 이벤트가 있으면 생산자는 다시 깨우지 않으므로 직접 예약
+    if (CaptureDispatcher::PendingCount(sub) > 0) {
+        WakeJS(sub);
+    }
+}
+
+// 배치 옵션 파싱 ({ maxBatchSize?: number, maxLatencyMs?: number })
+bool KeyboardNativeBinding::ParseBatchConfig(napi_env env, napi_value options, BatchConfig* config) {
+    napi_valuetype valuetype;
+    napi_typeof(env, options, &valuetype);
+    if (valuetype == napi_undefined || valuetype == napi_null) {
+        return true;
+    }
+    if (valuetype != napi_object) {
+        napi_throw_type_error(env, nullptr, "Expected options to be an object");
+        return false;
+    }
+    
+    bool hasProperty = false;
+    napi_value value;
+    
+    // maxBatchSize
+    napi_has_named_property(env, options, "maxBatchSize", &hasProperty);
+    if (hasProperty) {
+        uint32_t maxBatchSize = 0;
+        napi_get_named_property(env, options, "maxBatchSize", &value);
+        if (napi_get_value_uint32(env, value, &maxBatchSize) != napi_ok || maxBatchSize == 0) {
+            napi_throw_range_error(env, nullptr, "maxBatchSize must be a positive integer");
+            return false;
+        }
+        // 링 크기를 넘는 배치는 조기 전달 조건을 만족할 수 없으므로 제한
+        config->maxBatchSize = maxBatchSize < KEY_EVENT_RING_CAPACITY ? maxBatchSize : KEY_EVENT_RING_CAPACITY;
+    }
+    
+    // maxLatencyMs
+    napi_has_named_property(env, options, "maxLatencyMs", &hasProperty);
+    if (hasProperty) {
+        uint32_t maxLatencyMs = 0;
+        napi_get_named_property(env, options, "maxLatencyMs", &value);
+        if (napi_get_value_uint32(env, value, &maxLatencyMs) != napi_ok) {
+            napi_throw_range_error(env, nullptr, "maxLatencyMs must be a non-negative integer");
+            return false;
+        }
+        config->maxLatencyMs = maxLatencyMs;
+    }
+    
+    return true;
+}
+
+// 배치 버퍼 확보 (크기가 같으면 기존 버퍼 재사용)
+bool KeyboardNativeBinding::EnsureBatchBuffers(napi_env env, KeyboardSubscription* sub, size_t size) {
+    if (sub->batchTimestampsRef && sub->batchBufferSize == size) {
+        return true;
+    }
+    
+    napi_value timestampsBuffer, keyCodesBuffer, flagsBuffer, appIdsBuffer;
+    napi_value timestamps, keyCodes, flags, appIds;
+    void* data;
+    
+    if (napi_create_arraybuffer(env, size * sizeof(double), &data, &timestampsBuffer) != napi_ok ||
+        napi_create_arraybuffer(env, size * sizeof(uint32_t), &data, &keyCodesBuffer) != napi_ok ||
+        napi_create_arraybuffer(env, size * sizeof(uint8_t), &data, &flagsBuffer) != napi_ok ||
+        napi_create_arraybuffer(env, size * sizeof(uint16_t), &data, &appIdsBuffer) != napi_ok) {
+        return false;
+    }
+    
+    if (napi_create_typedarray(env, napi_float64_array, size, timestampsBuffer, 0, &timestamps) != napi_ok ||
+        napi_create_typedarray(env, napi_uint32_array, size, keyCodesBuffer, 0, &keyCodes) != napi_ok ||
+        napi_create_typedarray(env, napi_uint8_array, size, flagsBuffer, 0, &flags) != napi_ok ||
+        napi_create_typedarray(env, napi_uint16_array, size, appIdsBuffer, 0, &appIds) != napi_ok) {
+        return false;
+    }
+    
+    // 이전 버퍼 해제
+    if (sub->batchTimestampsRef) {
+        napi_delete_reference(env, sub->batchTimestampsRef);
+        napi_delete_reference(env, sub->batchKeyCodesRef);
+        napi_delete_reference(env, sub->batchFlagsRef);
+        napi_delete_reference(env, sub->batchAppIdsRef);
+    }
+    
+    napi_create_reference(env, timestamps, 1, &sub->batchTimestampsRef);
+    napi_create_reference(env, keyCodes, 1, &sub->batchKeyCodesRef);
+    napi_create_reference(env, flags, 1, &sub->batchFlagsRef);
+    napi_create_reference(env, appIds, 1, &sub->batchAppIdsRef);
+    sub->batchBufferSize = size;
+    
+    return true;
+}
+
+// 배치 전달 - 배치 크기에 도달했거나 시간 예산이 지났을 때만 JS 호출
+void KeyboardNativeBinding::DeliverBatches(napi_env env, napi_value js_callback, KeyboardSubscription* sub) {
+    // 링 최대 깊이가 배치 크기보다 작으면 가득 찬 링을 가득 찬 배치로 취급
+    const size_t limit = sub->eventRing.GetLimit();
+    const size_t maxBatchSize = sub->batchConfig.maxBatchSize < limit ? sub->batchConfig.maxBatchSize : limit;
+    const bool flushAll = sub->flushDue || sub->batchConfig.maxLatencyMs == 0;
+    
+    // 아직 배치가 차지 않았으면 시간 예산만큼 더 모음
+    if (!flushAll && CaptureDispatcher::PendingCount(sub) < maxBatchSize) {
+        if (CaptureDispatcher::PendingCount(sub) > 0) {
+            ArmFlushTimer(sub);
+        }
+        return;
+    }
+    
+    sub->flushDue = false;
+    StopFlushTimer(sub);
+    
+    // 한 번의 깨우기에서 최대 링 크기만큼 처리 (메인 스레드 독점 방지)
+    size_t delivered = 0;
+    while (delivered < KEY_EVENT_RING_CAPACITY) {
+        if (!flushAll && CaptureDispatcher::PendingCount(sub) < maxBatchSize) {
+            break;
+        }
+        
+        size_t count = CaptureDispatcher::PendingCount(sub);
+        if (count == 0) {
+            break;
+        }
+        if (count > maxBatchSize) {
+            count = maxBatchSize;
+        }
+        
+        delivered += count;
+        if (!CallBatchJS(env, js_callback, sub, count)) {
+            break;
+        }
+    }
+    
+    // 남은 이벤트 처리 예약 (가득 찬 배치는 즉시, 나머지는 시간 예산 후)
+    const size_t remaining = CaptureDispatcher::PendingCount(sub);
+    if (remaining >= maxBatchSize || (flushAll && remaining > 0)) {
+        if (flushAll) {
+            sub->flushDue = true;
+        }
+        WakeJS(sub);
+    } else if (remaining > 0) {
+        ArmFlushTimer(sub);
+    }
+}
+
+// 링에서 count개를 꺼내 재사용 버퍼에 채우고 JS 콜백 호출
+bool KeyboardNativeBinding::CallBatchJS(napi_env env, napi_value js_callback, KeyboardSubscription* sub, size_t count) {
+    // (timestamps, keyCodes, flags, count, appIds) - appIds는 기존 콜백과 호환되도록 마지막
+    napi_value argv[5];
+    void* timestampsData = nullptr;
+    void* keyCodesData = nullptr;
+    void* flagsData = nullptr;
+    void* appIdsData = nullptr;
+    
+    // 버퍼 포인터는 매 배치마다 다시 조회 (JS에서 버퍼가 분리된 경우 대비)
+    napi_get_reference_value(env, sub->batchTimestampsRef, &argv[0]);
+    napi_get_reference_value(env, sub->batchKeyCodesRef, &argv[1]);
+    napi_get_reference_value(env, sub->batchFlagsRef, &argv[2]);
+    napi_get_reference_value(env, sub->batchAppIdsRef, &argv[4]);
+    napi_get_typedarray_info(env, argv[0], nullptr, nullptr, &timestampsData, nullptr, nullptr);
+    napi_get_typedarray_info(env, argv[1], nullptr, nullptr, &keyCodesData, nullptr, nullptr);
+    napi_get_typedarray_info(env, argv[2], nullptr, nullptr, &flagsData, nullptr, nullptr);
+    napi_get_typedarray_info(env, argv[4], nullptr, nullptr, &appIdsData, nullptr, nullptr);
+    if (!timestampsData || !keyCodesData || !flagsData || !appIdsData) {
+        return false;
+    }
+    
+    double* timestamps = static_cast<double*>(timestampsData);
+    uint32_t* keyCodes = static_cast<uint32_t*>(keyCodesData);
+    uint8_t* flags = static_cast<uint8_t*>(flagsData);
+    uint16_t* appIds = static_cast<uint16_t*>(appIdsData);
+    
+    // 구조체 배열 → 배열 구조체 변환
+    // 배치는 콜백 한 번이므로 JS 호출 구간은 배치의 마지막 추적 ID에 연결
+    QueuedEvent entry;
+    size_t filled = 0;
+    uint64_t traceId = 0;
+    while (filled < count && CaptureDispatcher::PopEvent(sub, &entry)) {
+        AccountDequeued(sub, entry);
+        
+        // 세션 종료 항목은 키 이벤트가 아님
+        if (entry.session.type == SESSION_RECORD_END) {
+            continue;
+        }
+        if (entry.traceId != 0) {
+            traceId = entry.traceId;
+        }
+        timestamps[filled] = EventClock::ToWallMs(entry.event.timestamp);
+        if (entry.coalescedCount > 0) {
+            keyCodes[filled] = entry.coalescedCount;
+            flags[filled] = KEY_EVENT_FLAG_COALESCED;
+        } else {
+            keyCodes[filled] = entry.event.keyCode;
+            flags[filled] = (entry.event.isKeyDown ? KEY_EVENT_FLAG_KEY_DOWN : 0) |
+                            (entry.event.isSpecialKey ? KEY_EVENT_FLAG_SPECIAL : 0) |
+                            (entry.keyState.transition == KEY_TRANSITION_REPEAT ? KEY_EVENT_FLAG_REPEAT : 0) |
+                            static_cast<uint8_t>(entry.keyState.modifiers << KEY_EVENT_FLAG_MODIFIER_SHIFT);
+        }
+        appIds[filled] = entry.event.appId;
+        filled++;
+    }
+    
+    napi_create_uint32(env, static_cast<uint32_t>(filled), &argv[3]);
+    
+    napi_value global;
+    napi_get_global(env, &global);
+    
+    const uint64_t callStartNs = traceId != 0 ? EventClock::NowNs() : 0;
+    napi_value result;
+    const bool ok = napi_call_function(env, global, js_callback, 5, argv, &result) == napi_ok;
+    if (traceId != 0) {
+        TraceRecorder::Shared().Record(TRACE_NAME_JS_DISPATCH, TRACE_NAME_NONE, callStartNs, EventClock::NowNs(),
+                                       traceId, TRACE_FLOW_STEP);
+    }
+    return ok;
+}
+
+// 플러시 타이머 예약 (이미 예약되어 있으면 유지 - 첫 이벤트 기준 시간 예산)
+void KeyboardNativeBinding::ArmFlushTimer(KeyboardSubscription* sub) {
+    if (!sub->flushTimerInitialized || sub->flushTimerArmed) {
+        return;
+    }
+    sub->flushTimerArmed = true;
+    uv_timer_start(&sub->flushTimer, OnFlushTimer, sub->batchConfig.maxLatencyMs, 0);
+}
+
+// 플러시 타이머 취소
+void KeyboardNativeBinding::StopFlushTimer(KeyboardSubscription* sub) {
+    if (!sub->flushTimerInitialized || !sub->flushTimerArmed) {
+        return;
+    }
+    sub->flushTimerArmed = false;
+    uv_timer_stop(&sub->flushTimer);
+}
+
+// 시간 예산 만료 - JS 스레드에서 실행되지만 콜백 스코프 밖이므로 Thread-safe 함수로 전달 요청
+void KeyboardNativeBinding::OnFlushTimer(uv_timer_t* handle) {
+    KeyboardSubscription* sub = static_cast<KeyboardSubscription*>(handle->data);
+    sub->flushTimerArmed = false;
+    sub->flushDue = true;
+    WakeJS(sub);
+}
+
+// 세션 레코드 전달 - 링을 비운 뒤 유휴 여부를 확인하고 필요하면 유휴 타이머를 한 번만 예약
+void KeyboardNativeBinding::DeliverSessionRecords(napi_env env, napi_value js_callback, KeyboardSubscription* sub) {
+    StopIdleTimer(sub);
+    
+    // 한 번의 깨우기에서 최대 링 크기만큼 처리 (메인 스레드 독점 방지)
+    QueuedEvent entry;
+    size_t delivered = 0;
+    bool ok = true;
+    while (ok && delivered < KEY_EVENT_RING_CAPACITY && CaptureDispatcher::PopEvent(sub, &entry)) {
+        delivered++;
+        AccountDequeued(sub, entry);
+        
+        switch (entry.session.type) {
+            case SESSION_RECORD_TYPING:
+                ok = CallSessionJS(env, js_callback, entry.session, entry.coalescedCount, entry.traceId);
+                break;
+                
+            case SESSION_RECORD_END:
+                // 유휴 타이머가 이미 보고한 세션은 건너뜀
+                if (entry.session.sessionSeq > sub->lastReportedSessionEnd) {
+                    sub->lastReportedSessionEnd = entry.session.sessionSeq;
+                    ok = CallSessionJS(env, js_callback, entry.session, entry.coalescedCount, 0);
+                }
+                break;
+                
+            default:
+                break; // 세션에 포함되지 않는 이벤트
+        }
+    }
+    
+    // 남은 항목이 있으면 다음 깨우기에서 처리 (유휴 확인도 그때 수행)
+    if (CaptureDispatcher::PendingCount(sub) > 0) {
+        WakeJS(sub);
+        return;
+    }
+    
+    // 현재 세션의 유휴 여부 확인
+    SessionRecord ended;
+    uint64_t deadline = 0;
+    const uint64_t now = EventClock::NowNs();
+    if (sub->sessionizer.CheckIdle(now, &ended, &deadline)) {
+        if (ended.sessionSeq > sub->lastReportedSessionEnd) {
+            sub->lastReportedSessionEnd = ended.sessionSeq;
+            CallSessionJS(env, js_callback, ended, 0, 0);
+        }
+    } else if (deadline > 0 && sub->attached) {
+        // 유휴 판정 시각에 다시 확인 (키 입력마다 타이머를 다시 설정하지 않음)
+        // (ns → ms 올림 - 판정 시각 전에 깨어나 타이머를 다시 거는 일이 없도록)
+        ArmIdleTimer(sub, deadline > now ? (deadline - now + 999999) / 1000000 : 0);
+    }
+}
+
+// TypingMetadata 객체를 만들어 JS 콜백 호출
+// 요약 항목이면 합쳐진 키 이벤트 수를 coalescedCount로 덧붙임 (keyCount는 세션 단계가 센 정확한 값)
+// 추적 중인 키 입력이면 traceId를 덧붙이고 JS 호출 구간을 기록 (emit('typing')이 이 안에서 실행됨)
+bool KeyboardNativeBinding::CallSessionJS(napi_env env, napi_value js_callback, const SessionRecord& record,
+                                          uint32_t coalescedCount, uint64_t traceId) {
+    napi_value metadata = CreateTypingMetadataObject(env, record);
+    if (coalescedCount > 0) {
+        napi_value value;
+        napi_create_uint32(env, coalescedCount, &value);
+        napi_set_named_property(env, metadata, "coalescedCount", value);
+    }
+    if (traceId != 0) {
+        napi_value value;
+        napi_create_double(env, static_cast<double>(traceId), &value);
+        napi_set_named_property(env, metadata, "traceId", value);
+    }
+    
+    napi_value global;
+    napi_get_global(env, &global);
+    
+    const uint64_t callStartNs = traceId != 0 ? EventClock::NowNs() : 0;
+    napi_value result;
+    const bool ok = napi_call_function(env, global, js_callback, 1, &metadata, &result) == napi_ok;
+    if (traceId != 0) {
+        TraceRecorder::Shared().Record(TRACE_NAME_JS_DISPATCH, TRACE_NAME_NONE, callStartNs, EventClock::NowNs(),
+                                       traceId, TRACE_FLOW_STEP);
+    }
+    return ok;
+}
+
+// 리듬 이벤트 전달 - 링을 비운 뒤 현재 간격의 멈춤/속도 하락/세션 종료를 확인하고
+// 가장 가까운 판정 시각에 유휴 타이머를 한 번만 예약 (키 입력이 이어지는 동안에는 깨우지 않음)
+void KeyboardNativeBinding::DeliverRhythmEvents(napi_env env, napi_value js_callback, KeyboardSubscription* sub) {
+    StopIdleTimer(sub);
+    
+    // 한 번의 깨우기에서 최대 링 크기만큼 처리 (메인 스레드 독점 방지)
+    QueuedEvent entry;
+    size_t delivered = 0;
+    bool ok = true;
+    while (ok && delivered < KEY_EVENT_RING_CAPACITY && CaptureDispatcher::PopEvent(sub, &entry)) {
+        delivered++;
+        AccountDequeued(sub, entry);
+        
+        if (entry.session.type == SESSION_RECORD_END) {
+            ok = ReportRhythmSessionEnd(env, js_callback, sub, entry.session);
+        } else if (entry.rhythm.type != RHYTHM_EVENT_NONE) {
+            ok = ReportRhythmEvent(env, js_callback, sub, entry.rhythm);
+        }
+    }
+    
+    // 남은 항목이 있으면 다음 깨우기에서 처리 (유휴 확인도 그때 수행)
+    if (CaptureDispatcher::PendingCount(sub) > 0) {
+        WakeJS(sub);
+        return;
+    }
+    
+    const uint64_t now = EventClock::NowNs();
+    RhythmEvent events[RHYTHM_MAX_EVENTS];
+    uint64_t deadline = 0;
+    const size_t count = sub->rhythmDetector.CheckIdle(now, events, &deadline);
+    for (size_t i = 0; ok && i < count; i++) {
+        ok = ReportRhythmEvent(env, js_callback, sub, events[i]);
+    }
+    
+    SessionRecord ended;
+    uint64_t sessionDeadline = 0;
+    if (sub->sessionizer.CheckIdle(now, &ended, &sessionDeadline)) {
+        if (ok) {
+            ReportRhythmSessionEnd(env, js_callback, sub, ended);
+        }
+    } else if (sessionDeadline > 0 && (deadline == 0 || sessionDeadline < deadline)) {
+        deadline = sessionDeadline;
+    }
+    
+    if (deadline > 0 && sub->attached) {
+        ArmIdleTimer(sub, deadline > now ? (deadline - now + 999999) / 1000000 : 0);
+    }
+}
+
+// 리듬 이벤트 하나 전달 - 키 입력과 유휴 타이머가 함께 보고한 간격 이벤트는 한 번만
+bool KeyboardNativeBinding::ReportRhythmEvent(napi_env env, napi_value js_callback, KeyboardSubscription* sub,
+                                              const RhythmEvent& event) {
+    if (event.type == RHYTHM_EVENT_PAUSE) {
+        if (event.gapKey <= sub->lastReportedPause) {
+            return true;
+        }
+        sub->lastReportedPause = event.gapKey;
+    } else if (event.type == RHYTHM_EVENT_RATE_LOW) {
+        if (event.gapKey <= sub->lastReportedRateLow) {
+            return true;
+        }
+        sub->lastReportedRateLow = event.gapKey;
+    }
+    
+    napi_value obj = CreateRhythmEventObject(env, kRhythmEventNames[event.type], event.timestamp, event.value);
+    napi_value global;
+    napi_get_global(env, &global);
+    
+    napi_value result;
+    return napi_call_function(env, global, js_callback, 1, &obj, &result) == napi_ok;
+}
+
+// 세션 종료 전달 - { type: 'session-end', timestamp, value: 세션 키 수, sessionId }
+bool KeyboardNativeBinding::ReportRhythmSessionEnd(napi_env env, napi_value js_callback, KeyboardSubscription* sub,
+                                                   const SessionRecord& record) {
+    // 유휴 타이머가 이미 보고한 세션은 건너뜀
+    if (record.sessionSeq <= sub->lastReportedSessionEnd) {
+        return true;
+    }
+    sub->lastReportedSessionEnd = record.sessionSeq;
+    
+    napi_value obj = CreateRhythmEventObject(env, "session-end", record.timestamp, record.keyCount);
+    
+    napi_set_named_property(env, obj, "sessionId", CreateSessionId(env, record.sessionStart, record.sessionSeq));
+    
+    napi_value global;
+    napi_get_global(env, &global);
+    
+    napi_value result;
+    return napi_call_function(env, global, js_callback, 1, &obj, &result) == napi_ok;
+}
+
+// 유휴 타이머 예약
+void KeyboardNativeBinding::ArmIdleTimer(KeyboardSubscription* sub, uint64_t delayMs) {
+    if (!sub->idleTimerInitialized || sub->idleTimerArmed) {
+        return;
+    }
+    sub->idleTimerArmed = true;
+    uv_timer_start(&sub->idleTimer, OnIdleTimer, delayMs, 0);
+}
+
+// 유휴 타이머 취소
+void KeyboardNativeBinding::StopIdleTimer(KeyboardSubscription* sub) {
+    if (!sub->idleTimerInitialized || !sub->idleTimerArmed) {
+        return;
+    }
+    sub->idleTimerArmed = false;
+    uv_timer_stop(&sub->idleTimer);
+}
+
+// 유휴 판정 시각 도달 - 콜백 스코프 밖이므로 Thread-safe 함수로 확인 요청
+void KeyboardNativeBinding::OnIdleTimer(uv_timer_t* handle) {
+    KeyboardSubscription* sub = static_cast<KeyboardSubscription*>(handle->data);
+    sub->idleTimerArmed = false;
+    WakeJS(sub);
+}
+
+// KeyEvent 객체 생성
+napi_value KeyboardNativeBinding::CreateKeyEventObject(napi_env env, const KeyEvent& event, const KeyTransitionInfo& keyState) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    // timestamp (types.ts 정의에 맞춰 number로 전달)
+    napi_value timestamp;
+    napi_create_double(env, EventClock::ToWallMs(event.timestamp), &timestamp);
+    napi_set_named_property(env, obj, "timestamp", timestamp);
+    
+    // keyCode
+    napi_value keyCode;
+    napi_create_uint32(env, event.keyCode, &keyCode);
+    napi_set_named_property(env, obj, "keyCode", keyCode);
     
     // isKeyDown
     napi_value isKeyDown;
@@ -212,6 +3121,589 @@ napi_value KeyboardNativeBinding::CreateKeyEventObject(napi_env env, const KeyEv
     napi_get_boolean(env, event.isSpecialKey, &isSpecialKey);
     napi_set_named_property(env, obj, "isSpecialKey", isSpecialKey);
     
+    // appId (getAppTable의 names 색인, 0 = 알 수 없음)
+    napi_value appId;
+    napi_create_uint32(env, event.appId, &appId);
+    napi_set_named_property(env, obj, "appId", appId);
+    
+    // isRepeat (필터가 반복을 전달하도록 설정한 경우에만 true가 옴)
+    napi_value isRepeat;
+    napi_get_boolean(env, keyState.transition == KEY_TRANSITION_REPEAT, &isRepeat);
+    napi_set_named_property(env, obj, "isRepeat", isRepeat);
+    
+    // modifiers (KEY_MODIFIER_* - 이 이벤트 직후 눌려 있는 수정자)
+    napi_value modifiers;
+    napi_create_uint32(env, keyState.modifiers, &modifiers);
+    napi_set_named_property(env, obj, "modifiers", modifiers);
+    
+    // 반복/뗌: 누른 시간과 반복 수 ("N ms 동안 누름" - 반복을 걸러도 뗌에 요약이 남음)
+    if (keyState.transition != KEY_TRANSITION_PRESS && keyState.heldNs > 0) {
+        napi_value heldMs, repeatCount;
+        napi_create_double(env, static_cast<double>(keyState.heldNs) / 1e6, &heldMs);
+        napi_create_uint32(env, keyState.repeatCount, &repeatCount);
+        napi_set_named_property(env, obj, "heldMs", heldMs);
+        napi_set_named_property(env, obj, "repeatCount", repeatCount);
+    }
+    
+    return obj;
+}
+
+// TypingMetadata 객체 생성 (KeyboardService.ts의 TypingMetadata와 동일한 형태)
+napi_value KeyboardNativeBinding::CreateTypingMetadataObject(napi_env env, const SessionRecord& record) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    // timestamp
+    napi_value timestamp;
+    napi_create_double(env, EventClock::ToWallMs(record.timestamp), &timestamp);
+    napi_set_named_property(env, obj, "timestamp", timestamp);
+    
+    // keyCount
+    napi_value keyCount;
+    napi_create_uint32(env, record.keyCount, &keyCount);
+    napi_set_named_property(env, obj, "keyCount", keyCount);
+    
+    // interval
+    napi_value interval;
+    napi_create_double(env, static_cast<double>(record.interval) / 1e6, &interval);
+    napi_set_named_property(env, obj, "interval", interval);
+    
+    // isActive (세션 종료 레코드는 false)
+    napi_value isActive;
+    napi_get_boolean(env, record.type == SESSION_RECORD_TYPING, &isActive);
+    napi_set_named_property(env, obj, "isActive", isActive);
+    
+    // sessionId (세션 시작 시각 + 일련번호)
+    napi_set_named_property(env, obj, "sessionId", CreateSessionId(env, record.sessionStart, record.sessionSeq));
+    
+    // appId (세션 종료 레코드는 0)
+    napi_value appId;
+    napi_create_uint32(env, record.appId, &appId);
+    napi_set_named_property(env, obj, "appId", appId);
+    
+    return obj;
+}
+
+// 과부하 정책 설정 객체 생성 - { policy, blockTimeoutMs, maxQueueDepth }
+napi_value KeyboardNativeBinding::CreateOverloadPolicyObject(napi_env env, KeyboardSubscription* sub) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value policy;
+    napi_create_string_utf8(env, kOverloadPolicyNames[sub->overloadPolicy.load(std::memory_order_relaxed)],
+                            NAPI_AUTO_LENGTH, &policy);
+    napi_set_named_property(env, obj, "policy", policy);
+    
+    napi_value blockTimeoutMs;
+    napi_create_uint32(env, sub->blockTimeoutMs.load(std::memory_order_relaxed), &blockTimeoutMs);
+    napi_set_named_property(env, obj, "blockTimeoutMs", blockTimeoutMs);
+    
+    napi_value maxQueueDepth;
+    napi_create_uint32(env, static_cast<uint32_t>(sub->eventRing.GetLimit()), &maxQueueDepth);
+    napi_set_named_property(env, obj, "maxQueueDepth", maxQueueDepth);
+    
+    return obj;
+}
+
+// 리듬 설정 객체 생성 - { burstGapMs, burstMinKeys, pauseMs, rateHighKps, rateLowKps, rateWindowMs, streakMs }
+napi_value KeyboardNativeBinding::CreateRhythmConfigObject(napi_env env, const RhythmConfig& config) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value value;
+    napi_create_uint32(env, config.burstGapMs, &value);
+    napi_set_named_property(env, obj, "burstGapMs", value);
+    napi_create_uint32(env, config.burstMinKeys, &value);
+    napi_set_named_property(env, obj, "burstMinKeys", value);
+    napi_create_uint32(env, config.pauseMs, &value);
+    napi_set_named_property(env, obj, "pauseMs", value);
+    napi_create_double(env, config.rateHighKps, &value);
+    napi_set_named_property(env, obj, "rateHighKps", value);
+    napi_create_double(env, config.rateLowKps, &value);
+    napi_set_named_property(env, obj, "rateLowKps", value);
+    napi_create_uint32(env, config.rateWindowMs, &value);
+    napi_set_named_property(env, obj, "rateWindowMs", value);
+    napi_create_uint32(env, config.streakMs, &value);
+    napi_set_named_property(env, obj, "streakMs", value);
+    
+    return obj;
+}
+
+// 리듬 이벤트 객체 생성 - { type, timestamp (epoch ms), value }
+napi_value KeyboardNativeBinding::CreateRhythmEventObject(napi_env env, const char* type, uint64_t timestamp, double value) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value property;
+    napi_create_string_utf8(env, type, NAPI_AUTO_LENGTH, &property);
+    napi_set_named_property(env, obj, "type", property);
+    napi_create_double(env, EventClock::ToWallMs(timestamp), &property);
+    napi_set_named_property(env, obj, "timestamp", property);
+    napi_create_double(env, value, &property);
+    napi_set_named_property(env, obj, "value", property);
+    
+    return obj;
+}
+
+// 이벤트 필터 설정 객체 생성 - { keyUp, special, repeats, customMask: number[] }
+napi_value KeyboardNativeBinding::CreateEventFilterObject(napi_env env, const EventFilterConfig& config) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value keyUp;
+    napi_get_boolean(env, config.keyUp, &keyUp);
+    napi_set_named_property(env, obj, "keyUp", keyUp);
+    
+    napi_value special;
+    napi_get_boolean(env, config.special, &special);
+    napi_set_named_property(env, obj, "special", special);
+    
+    napi_value repeats;
+    napi_get_boolean(env, config.repeats, &repeats);
+    napi_set_named_property(env, obj, "repeats", repeats);
+    
+    napi_value customMask;
+    napi_create_array(env, &customMask);
+    uint32_t index = 0;
+    for (uint32_t keyCode = 0; keyCode < KeyCodeSet::kMaxKeyCodes; keyCode++) {
+        if (config.customMask.Test(keyCode)) {
+            napi_value element;
+            napi_create_uint32(env, keyCode, &element);
+            napi_set_element(env, customMask, index++, element);
+        }
+    }
+    napi_set_named_property(env, obj, "customMask", customMask);
+    
+    return obj;
+}
+
+// 간격 통계 객체 생성 (통계는 ns로 누적, JS에는 ms로 전달)
+napi_value KeyboardNativeBinding::CreateIntervalStatsObject(napi_env env, const IntervalStats& stats) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    const double nsPerMs = 1e6;
+    const double variance = stats.GetVariance() / (nsPerMs * nsPerMs);
+    struct {
+        const char* name;
+        double value;
+    } fields[] = {
+        { "count", static_cast<double>(stats.GetCount()) },
+        { "mean", stats.GetMean() / nsPerMs },
+        { "variance", variance },
+        { "stddev", sqrt(variance) },
+        { "min", static_cast<double>(stats.GetMin()) / nsPerMs },
+        { "max", static_cast<double>(stats.GetMax()) / nsPerMs },
+        { "p50", static_cast<double>(stats.GetPercentile(0.50)) / nsPerMs },
+        { "p90", static_cast<double>(stats.GetPercentile(0.90)) / nsPerMs },
+        { "p99", static_cast<double>(stats.GetPercentile(0.99)) / nsPerMs },
+    };
+    
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        napi_value value;
+        napi_create_double(env, fields[i].value, &value);
+        napi_set_named_property(env, obj, fields[i].name, value);
+    }
+    
+    return obj;
+}
+
+// 저널 레코드 객체 생성 (배열 구조체 형태)
+// { count, timestamps: Float64Array, sessionStarts: Float64Array,
+//   sessionSeqs: Uint32Array, keyCounts: Uint32Array, intervals: Float64Array (ms) }
+napi_value KeyboardNativeBinding::CreateJournalRecordsObject(napi_env env, const std::vector<JournalRecord>& records) {
+    const size_t count = records.size();
+    
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value countValue;
+    napi_create_uint32(env, static_cast<uint32_t>(count), &countValue);
+    napi_set_named_property(env, obj, "count", countValue);
+    
+    void* timestampsData = nullptr;
+    void* sessionStartsData = nullptr;
+    void* sessionSeqsData = nullptr;
+    void* keyCountsData = nullptr;
+    void* intervalsData = nullptr;
+    napi_value buffers[5];
+    napi_value arrays[5];
+    napi_create_arraybuffer(env, count * sizeof(double), &timestampsData, &buffers[0]);
+    napi_create_arraybuffer(env, count * sizeof(double), &sessionStartsData, &buffers[1]);
+    napi_create_arraybuffer(env, count * sizeof(uint32_t), &sessionSeqsData, &buffers[2]);
+    napi_create_arraybuffer(env, count * sizeof(uint32_t), &keyCountsData, &buffers[3]);
+    napi_create_arraybuffer(env, count * sizeof(double), &intervalsData, &buffers[4]);
+    napi_create_typedarray(env, napi_float64_array, count, buffers[0], 0, &arrays[0]);
+    napi_create_typedarray(env, napi_float64_array, count, buffers[1], 0, &arrays[1]);
+    napi_create_typedarray(env, napi_uint32_array, count, buffers[2], 0, &arrays[2]);
+    napi_create_typedarray(env, napi_uint32_array, count, buffers[3], 0, &arrays[3]);
+    napi_create_typedarray(env, napi_float64_array, count, buffers[4], 0, &arrays[4]);
+    
+    double* timestamps = static_cast<double*>(timestampsData);
+    double* sessionStarts = static_cast<double*>(sessionStartsData);
+    uint32_t* sessionSeqs = static_cast<uint32_t*>(sessionSeqsData);
+    uint32_t* keyCounts = static_cast<uint32_t*>(keyCountsData);
+    double* intervals = static_cast<double*>(intervalsData);
+    for (size_t i = 0; i < count; i++) {
+        timestamps[i] = static_cast<double>(records[i].timestamp);
+        sessionStarts[i] = static_cast<double>(records[i].sessionStart);
+        sessionSeqs[i] = records[i].sessionSeq;
+        keyCounts[i] = records[i].keyCount;
+        intervals[i] = static_cast<double>(records[i].interval) / 1000.0;
+    }
+    
+    napi_set_named_property(env, obj, "timestamps", arrays[0]);
+    napi_set_named_property(env, obj, "sessionStarts", arrays[1]);
+    napi_set_named_property(env, obj, "sessionSeqs", arrays[2]);
+    napi_set_named_property(env, obj, "keyCounts", arrays[3]);
+    napi_set_named_property(env, obj, "intervals", arrays[4]);
+    
+    return obj;
+}
+
+// 배열 구조체 형태의 저널 레코드 객체 읽기 (CreateJournalRecordsObject의 역, 형식이 다르면 예외 후 false)
+bool KeyboardNativeBinding::ReadJournalRecordsObject(napi_env env, napi_value obj, std::vector<JournalRecord>* records) {
+    static const char* const names[5] = { "timestamps", "sessionStarts", "sessionSeqs", "keyCounts", "intervals" };
+    static const napi_typedarray_type types[5] = {
+        napi_float64_array, napi_float64_array, napi_uint32_array, napi_uint32_array, napi_float64_array
+    };
+    
+    uint32_t count = 0;
+    napi_value countValue;
+    if (napi_get_named_property(env, obj, "count", &countValue) != napi_ok ||
+        napi_get_value_uint32(env, countValue, &count) != napi_ok) {
+        napi_throw_type_error(env, nullptr, "Expected records.count");
+        return false;
+    }
+    
+    void* columns[5];
+    for (int i = 0; i < 5; i++) {
+        napi_value array;
+        bool isTypedArray = false;
+        napi_typedarray_type type;
+        size_t length = 0;
+        if (napi_get_named_property(env, obj, names[i], &array) != napi_ok ||
+            napi_is_typedarray(env, array, &isTypedArray) != napi_ok || !isTypedArray ||
+            napi_get_typedarray_info(env, array, &type, &length, &columns[i], nullptr, nullptr) != napi_ok ||
+            type != types[i] || length < count) {
+            std::string message = std::string("records.") + names[i] +
+                (types[i] == napi_float64_array ? " must be a Float64Array" : " must be a Uint32Array") +
+                " of at least count elements";
+            napi_throw_type_error(env, nullptr, message.c_str());
+            return false;
+        }
+    }
+    
+    const double* timestamps = static_cast<const double*>(columns[0]);
+    const double* sessionStarts = static_cast<const double*>(columns[1]);
+    const uint32_t* sessionSeqs = static_cast<const uint32_t*>(columns[2]);
+    const uint32_t* keyCounts = static_cast<const uint32_t*>(columns[3]);
+    const double* intervals = static_cast<const double*>(columns[4]);
+    
+    records->resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        JournalRecord& record = (*records)[i];
+        record.timestamp = timestamps[i] > 0 ? static_cast<uint64_t>(timestamps[i]) : 0;
+        record.sessionStart = sessionStarts[i] > 0 ? static_cast<uint64_t>(sessionStarts[i]) : 0;
+        record.sessionSeq = sessionSeqs[i];
+        record.keyCount = keyCounts[i];
+        
+        // ms → us (JournalRecord와 같이 약 71분에서 포화)
+        const double intervalUs = intervals[i] * 1000.0 + 0.5;
+        record.interval = intervalUs <= 0 ? 0 : (intervalUs >= 4294967295.0 ? UINT32_MAX : static_cast<uint32_t>(intervalUs));
+        record.checksum = 0;
+    }
+    return true;
+}
+
+// 분석 결과 객체 생성
+// { kernel, events, count, sum, mean, variance, stdDev, min, max, percentiles: number[],
+//   bursts: { runs, keys, longest }, pauses: { count, totalMs },
+//   histogram?: { origin, width, counts: Float64Array, sums: Float64Array }, elapsedMs }
+napi_value KeyboardNativeBinding::CreateAnalyticsObject(napi_env env, const AnalyticsWork& work) {
+    napi_value obj;
+    napi_value value;
+    napi_create_object(env, &obj);
+    
+    napi_create_string_utf8(env, AnalyticsKernels::Name(AnalyticsKernels::Resolve(work.kernel)), NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, obj, "kernel", value);
+    napi_create_double(env, static_cast<double>(work.events), &value);
+    napi_set_named_property(env, obj, "events", value);
+    napi_create_double(env, static_cast<double>(work.moments.count), &value);
+    napi_set_named_property(env, obj, "count", value);
+    napi_create_double(env, work.moments.sum, &value);
+    napi_set_named_property(env, obj, "sum", value);
+    napi_create_double(env, work.moments.mean, &value);
+    napi_set_named_property(env, obj, "mean", value);
+    napi_create_double(env, work.moments.variance, &value);
+    napi_set_named_property(env, obj, "variance", value);
+    napi_create_double(env, sqrt(work.moments.variance), &value);
+    napi_set_named_property(env, obj, "stdDev", value);
+    napi_create_double(env, work.moments.min, &value);
+    napi_set_named_property(env, obj, "min", value);
+    napi_create_double(env, work.moments.max, &value);
+    napi_set_named_property(env, obj, "max", value);
+    
+    napi_value percentiles;
+    napi_create_array_with_length(env, work.percentileValues.size(), &percentiles);
+    for (size_t i = 0; i < work.percentileValues.size(); i++) {
+        napi_create_double(env, work.percentileValues[i], &value);
+        napi_set_element(env, percentiles, static_cast<uint32_t>(i), value);
+    }
+    napi_set_named_property(env, obj, "percentiles", percentiles);
+    
+    napi_value bursts;
+    napi_create_object(env, &bursts);
+    napi_create_double(env, static_cast<double>(work.segments.burstRuns), &value);
+    napi_set_named_property(env, bursts, "runs", value);
+    napi_create_double(env, static_cast<double>(work.segments.burstKeys), &value);
+    napi_set_named_property(env, bursts, "keys", value);
+    napi_create_double(env, static_cast<double>(work.segments.longestBurst), &value);
+    napi_set_named_property(env, bursts, "longest", value);
+    napi_set_named_property(env, obj, "bursts", bursts);
+    
+    napi_value pauses;
+    napi_create_object(env, &pauses);
+    napi_create_double(env, static_cast<double>(work.segments.pauseCount), &value);
+    napi_set_named_property(env, pauses, "count", value);
+    napi_create_double(env, work.segments.pauseTotal, &value);
+    napi_set_named_property(env, pauses, "totalMs", value);
+    napi_set_named_property(env, obj, "pauses", pauses);
+    
+    if (work.histogram) {
+        napi_value histogram;
+        napi_create_object(env, &histogram);
+        napi_create_double(env, work.histogramOrigin, &value);
+        napi_set_named_property(env, histogram, "origin", value);
+        napi_create_double(env, work.histogramWidth, &value);
+        napi_set_named_property(env, histogram, "width", value);
+        
+        const std::vector<double>* columns[2] = { &work.histogramCounts, &work.histogramSums };
+        const char* names[2] = { "counts", "sums" };
+        for (int i = 0; i < 2; i++) {
+            void* data = nullptr;
+            napi_value buffer;
+            napi_value array;
+            napi_create_arraybuffer(env, columns[i]->size() * sizeof(double), &data, &buffer);
+            if (!columns[i]->empty()) {
+                memcpy(data, columns[i]->data(), columns[i]->size() * sizeof(double));
+            }
+            napi_create_typedarray(env, napi_float64_array, columns[i]->size(), buffer, 0, &array);
+            napi_set_named_property(env, histogram, names[i], array);
+        }
+        napi_set_named_property(env, obj, "histogram", histogram);
+    }
+    
+    napi_create_double(env, static_cast<double>(work.elapsedNs) / 1e6, &value);
+    napi_set_named_property(env, obj, "elapsedMs", value);
+    
+    return obj;
+}
+
+// 통계 증분 행 배열 생성
+// [{ date: 'YYYY-MM-DD', hour (일별 행은 -1), keys, sessions, activeMs, intervalCount, intervalSum, intervalSumSq }]
+napi_value KeyboardNativeBinding::CreateRollupArray(napi_env env, const std::vector<RollupBucket>& buckets) {
+    napi_value array;
+    napi_create_array_with_length(env, buckets.size(), &array);
+    
+    for (size_t i = 0; i < buckets.size(); i++) {
+        const RollupBucket& bucket = buckets[i];
+        napi_value row;
+        napi_create_object(env, &row);
+        
+        char date[16];
+        snprintf(date, sizeof(date), "%04u-%02u-%02u",
+                 bucket.date / 10000, (bucket.date / 100) % 100, bucket.date % 100);
+        napi_value value;
+        napi_create_string_utf8(env, date, NAPI_AUTO_LENGTH, &value);
+        napi_set_named_property(env, row, "date", value);
+        
+        struct {
+            const char* name;
+            double value;
+        } fields[] = {
+            { "hour", static_cast<double>(bucket.hour) },
+            { "keys", static_cast<double>(bucket.delta.keys) },
+            { "sessions", static_cast<double>(bucket.delta.sessions) },
+            { "activeMs", bucket.delta.activeNs / 1e6 },
+            { "intervalCount", static_cast<double>(bucket.delta.intervalCount) },
+            { "intervalSum", bucket.delta.intervalSum },
+            { "intervalSumSq", bucket.delta.intervalSumSq },
+        };
+        for (size_t j = 0; j < sizeof(fields) / sizeof(fields[0]); j++) {
+            napi_create_double(env, fields[j].value, &value);
+            napi_set_named_property(env, row, fields[j].name, value);
+        }
+        
+        napi_set_element(env, array, static_cast<uint32_t>(i), row);
+    }
+    
+    return array;
+}
+
+// 누적 통계 객체 생성
+// { date: 'YYYY-MM-DD' (기록이 없으면 ''), keys, sessions, activeMs, intervalCount, intervalSum, intervalSumSq,
+//   hourKeys: number[24], streakDays, bestStreakDays,
+//   session: { sessionId, startTime, keyCount, lastKeyTime } | null }
+napi_value KeyboardNativeBinding::CreateRunningStatsObject(napi_env env, const RollupRunning& running) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    char date[16] = "";
+    if (running.date != 0) {
+        snprintf(date, sizeof(date), "%04u-%02u-%02u",
+                 running.date / 10000, (running.date / 100) % 100, running.date % 100);
+    }
+    napi_value value;
+    napi_create_string_utf8(env, date, NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, obj, "date", value);
+    
+    struct {
+        const char* name;
+        double value;
+    } fields[] = {
+        { "keys", static_cast<double>(running.today.keys) },
+        { "sessions", static_cast<double>(running.today.sessions) },
+        { "activeMs", running.today.activeNs / 1e6 },
+        { "intervalCount", static_cast<double>(running.today.intervalCount) },
+        { "intervalSum", running.today.intervalSum },
+        { "intervalSumSq", running.today.intervalSumSq },
+        { "streakDays", static_cast<double>(running.streakDays) },
+        { "bestStreakDays", static_cast<double>(running.bestStreakDays) },
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        napi_create_double(env, fields[i].value, &value);
+        napi_set_named_property(env, obj, fields[i].name, value);
+    }
+    
+    napi_value hourKeys;
+    napi_create_array_with_length(env, 24, &hourKeys);
+    for (uint32_t hour = 0; hour < 24; hour++) {
+        napi_create_double(env, static_cast<double>(running.hourKeys[hour]), &value);
+        napi_set_element(env, hourKeys, hour, value);
+    }
+    napi_set_named_property(env, obj, "hourKeys", hourKeys);
+    
+    // 마지막 세션 (세션 ID는 타이핑 메타데이터와 같은 형식)
+    napi_value session;
+    if (running.sessionSeq == 0) {
+        napi_get_null(env, &session);
+    } else {
+        napi_create_object(env, &session);
+        
+        napi_set_named_property(env, session, "sessionId",
+                                CreateSessionId(env, running.sessionStart, running.sessionSeq));
+        napi_create_double(env, static_cast<double>(running.sessionStart), &value);
+        napi_set_named_property(env, session, "startTime", value);
+        napi_create_uint32(env, running.sessionKeys, &value);
+        napi_set_named_property(env, session, "keyCount", value);
+        napi_create_double(env, running.lastKeyMs, &value);
+        napi_set_named_property(env, session, "lastKeyTime", value);
+    }
+    napi_set_named_property(env, obj, "session", session);
+    
+    return obj;
+}
+
+// 누적 통계 객체 읽기 (CreateRunningStatsObject 형태 - 세션 정보는 읽지 않음)
+bool KeyboardNativeBinding::ReadRunningStatsObject(napi_env env, napi_value obj, RollupRunning* running) {
+    memset(running, 0, sizeof(*running));
+    
+    napi_valuetype valuetype;
+    if (napi_typeof(env, obj, &valuetype) != napi_ok || valuetype != napi_object) {
+        return false;
+    }
+    
+    napi_value value;
+    char date[16];
+    size_t dateLength = 0;
+    unsigned year = 0, month = 0, day = 0;
+    if (napi_get_named_property(env, obj, "date", &value) != napi_ok ||
+        napi_get_value_string_utf8(env, value, date, sizeof(date), &dateLength) != napi_ok ||
+        sscanf(date, "%4u-%2u-%2u", &year, &month, &day) != 3) {
+        return false;
+    }
+    running->date = year * 10000 + month * 100 + day;
+    
+    const char* names[] = {
+        "keys", "sessions", "activeMs", "intervalCount", "intervalSum", "intervalSumSq", "streakDays", "bestStreakDays"
+    };
+    double values[sizeof(names) / sizeof(names[0])];
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (napi_get_named_property(env, obj, names[i], &value) != napi_ok ||
+            napi_get_value_double(env, value, &values[i]) != napi_ok || !(values[i] >= 0)) {
+            return false;
+        }
+    }
+    running->today.keys = static_cast<uint64_t>(values[0]);
+    running->today.sessions = static_cast<uint64_t>(values[1]);
+    running->today.activeNs = static_cast<uint64_t>(values[2] * 1e6);
+    running->today.intervalCount = static_cast<uint64_t>(values[3]);
+    running->today.intervalSum = values[4];
+    running->today.intervalSumSq = values[5];
+    running->streakDays = static_cast<uint32_t>(values[6]);
+    running->bestStreakDays = static_cast<uint32_t>(values[7]);
+    
+    napi_value hourKeys;
+    bool isArray = false;
+    uint32_t length = 0;
+    if (napi_get_named_property(env, obj, "hourKeys", &hourKeys) != napi_ok ||
+        napi_is_array(env, hourKeys, &isArray) != napi_ok || !isArray ||
+        napi_get_array_length(env, hourKeys, &length) != napi_ok || length != 24) {
+        return false;
+    }
+    for (uint32_t hour = 0; hour < 24; hour++) {
+        double keys = 0;
+        if (napi_get_element(env, hourKeys, hour, &value) != napi_ok ||
+            napi_get_value_double(env, value, &keys) != napi_ok || !(keys >= 0)) {
+            return false;
+        }
+        running->hourKeys[hour] = static_cast<uint64_t>(keys);
+    }
+    
+    return true;
+}
+
+// 지연 시간 히스토그램 요약 객체 생성 (ns)
+napi_value KeyboardNativeBinding::CreateLatencyObject(napi_env env, const LatencyHistogram& histogram) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    struct {
+        const char* name;
+        double value;
+    } fields[] = {
+        { "count", static_cast<double>(histogram.GetCount()) },
+        { "mean", histogram.GetMean() },
+        { "max", static_cast<double>(histogram.GetMax()) },
+        { "p50", static_cast<double>(histogram.GetPercentile(0.50)) },
+        { "p90", static_cast<double>(histogram.GetPercentile(0.90)) },
+        { "p99", static_cast<double>(histogram.GetPercentile(0.99)) },
+        { "p999", static_cast<double>(histogram.GetPercentile(0.999)) },
+    };
+    
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        napi_value value;
+        napi_create_double(env, fields[i].value, &value);
+        napi_set_named_property(env, obj, fields[i].name, value);
+    }
+    
+    return obj;
+}
+
+// 추적 결과 객체 생성 - { path, events, dropped }
+napi_value KeyboardNativeBinding::CreateTraceSummaryObject(napi_env env, const TraceSummary& summary) {
+    napi_value obj;
+    napi_create_object(env, &obj);
+    
+    napi_value value;
+    napi_create_string_utf8(env, summary.path.c_str(), summary.path.size(), &value);
+    napi_set_named_property(env, obj, "path", value);
+    napi_create_double(env, static_cast<double>(summary.events), &value);
+    napi_set_named_property(env, obj, "events", value);
+    napi_create_double(env, static_cast<double>(summary.dropped), &value);
+    napi_set_named_property(env, obj, "dropped", value);
+    
     return obj;
 }
 
@@ -2,8 +2,171 @@
 #define KEYBOARD_NATIVE_H
 
 #include <node_api.h>
+#include <uv.h>
 #include "../common/keyboard-base.h"
+#include "../common/sessionizer.h"
+#include "../common/interval-stats.h"
+#include "../common/event-journal.h"
+#include "../common/stats-rollup.h"
+#include "../common/stats-snapshot.h"
+#include "../common/time-bucket-index.h"
+#include "../common/event-archive.h"
+#include "../common/analytics-kernels.h"
+#include "../common/live-state.h"
+#include "../common/rhythm-detector.h"
+#include "../common/pipeline-metrics.h"
+#include "../common/event-clock.h"
+#include "../common/event-filter.h"
+#include "../common/key-state.h"
+#include "../common/app-registry.h"
+#include "../common/trace-recorder.h"
+#include "../common/capture-dispatch.h"
 #include <memory>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// 배치 전달 시 flags 배열의 비트 정의
+// (COALESCED 항목은 keyCodes 자리에 합쳐진 이벤트 수, timestamps 자리에 마지막 이벤트 시각을 담음)
+#define KEY_EVENT_FLAG_KEY_DOWN  0x01
+#define KEY_EVENT_FLAG_SPECIAL   0x02
+#define KEY_EVENT_FLAG_COALESCED 0x04
+#define KEY_EVENT_FLAG_REPEAT    0x08
+#define KEY_EVENT_FLAG_MODIFIER_SHIFT 4   // 상위 4비트 = 수정자 (KEY_MODIFIER_* << 4)
+
+// 배치 전달 기본값
+#define DEFAULT_BATCH_MAX_SIZE 256
+#define DEFAULT_BATCH_MAX_LATENCY_MS 16
+
+// 배치 전달 설정
+struct BatchConfig {
+    size_t maxBatchSize;     // 이 개수가 모이면 즉시 전달
+    uint32_t maxLatencyMs;   // 첫 이벤트 이후 이 시간이 지나면 전달 (0이면 즉시)
+};
+
+// 기본 구독 ID (startListening 계열 API와 구독 ID를 생략한 설정 API가 사용)
+#define KEYBOARD_PRIMARY_SUBSCRIPTION_ID 0
+
+struct KeyboardAddonInstance;
+
+// 구독 - JS 콜백 하나와 그 콜백 전용 링/필터/세션/배치/과부하 상태
+// 하나의 OS 후킹이 연결된 모든 구독에 이벤트를 나눠 주며, 구독은 자신을 만든 Node 환경의 JS 스레드에서만 전달함
+// (후킹 쪽 상태는 CaptureSubscription - capture-dispatch.h, 여기에 덧붙인 필드는 JS 스레드 전용)
+struct KeyboardSubscription : CaptureSubscription {
+    uint32_t id;
+    KeyboardAddonInstance* instance;   // 소속 환경 (환경 종료 시 nullptr)
+    
+    // 전달 경로 (리스닝을 시작할 때마다 Thread-safe 함수를 새로 만들고 세대를 올림)
+    napi_threadsafe_function callback;
+    uintptr_t generation;
+    bool attached;                     // OS 후킹에 연결됨
+    bool closing;                      // 해제 예정 (남은 핸들이 모두 닫히면 삭제)
+    uint32_t openHandles;              // 닫히지 않은 Thread-safe 함수/타이머 수
+    
+    // 세션 유휴 타이머 (세션 단계와 리듬 단계가 공유)
+    uint32_t lastReportedSessionEnd;
+    uv_timer_t idleTimer;
+    bool idleTimerInitialized;
+    bool idleTimerArmed;
+    
+    // 키 입력과 유휴 타이머가 같은 간격을 보고할 수 있어 간격 직전 키 번호로 중복을 거름
+    uint64_t lastReportedPause;
+    uint64_t lastReportedRateLow;
+    
+    // 현재 세션의 키 입력 간격 통계 (링을 비우며 갱신)
+    IntervalStats sessionStats;
+    
+    // 배치 전달 상태 (깨우기 임계값은 CaptureSubscription::batchWakeThreshold)
+    BatchConfig batchConfig;
+    napi_ref batchTimestampsRef;
+    napi_ref batchKeyCodesRef;
+    napi_ref batchFlagsRef;
+    napi_ref batchAppIdsRef;
+    size_t batchBufferSize;
+    uv_timer_t flushTimer;
+    bool flushTimerInitialized;
+    bool flushTimerArmed;
+    bool flushDue;
+    
+    uint64_t wakeNs;   // 현재 CallJS 시작 시각 (EventClock)
+    
+    KeyboardSubscription(uint32_t subscriptionId, KeyboardAddonInstance* owner);
+    
+    KeyboardSubscription(const KeyboardSubscription&) = delete;
+    KeyboardSubscription& operator=(const KeyboardSubscription&) = delete;
+};
+
+// Thread-safe 함수 context - 어느 구독의 몇 번째 리스닝인지
+// (중지 직후 다시 시작한 경우 이전 함수의 마지막 호출을 가려냄)
+struct DeliveryToken {
+    KeyboardSubscription* subscription;
+    uintptr_t generation;
+};
+
+// Node 환경(메인 스레드, worker_threads)별 상태 - napi_set_instance_data로 연결
+struct KeyboardAddonInstance {
+    napi_env env;
+    KeyboardSubscription* primary;
+    std::vector<KeyboardSubscription*> subscriptions;   // 기본 구독과 subscribe로 만든 구독
+    uint32_t nextSubscriptionId;
+    
+    // 타이핑 이벤트 저널 (이 환경의 구독들이 링을 비우며 기록)
+    EventJournal journal;
+    
+    // 일별/시간별 통계 증분 (기본 구독의 레코드 링을 비우며 갱신, takeRollups로 꺼냄)
+    StatsRollup rollup;
+    
+    // 누적 통계 스냅샷 경로 (loadStatsSnapshot으로 지정, saveStatsSnapshot이 저장)
+    std::string statsSnapshotPath;
+    
+    // 분 단위 시간 버킷 색인 (기본 구독의 레코드 링을 비우며 갱신, 지난 기록은 JS가 DB에서 한 번 채움)
+    TimeBucketIndex timeIndex;
+    
+    // 앱별 누적 (앱 ID로 색인, 기본 구독의 레코드 링을 비우며 갱신 - 세션은 첫 키를 받은 앱에 셈)
+    std::vector<TimeBucketValue> appStats;
+    
+    // 지난 타이핑 이벤트의 압축 열 블록 아카이브 (openArchive로 열고 JS 보관기가 추가)
+    EventArchive archive;
+};
+
+// 분석 작업 (napi_async_work) - 입력은 JS 스레드에서 복사하거나 아카이브 사본을 만들고,
+// 아카이브 읽기와 커널 계산은 작업 스레드에서 수행한 뒤 Promise로 결과 전달
+struct AnalyticsWork {
+    napi_async_work work;
+    napi_deferred deferred;
+    
+    // 입력 (아카이브 레코드가 앞, 전달된 배열이 뒤)
+    std::vector<double> timestamps;    // epoch ms (히스토그램에만 사용)
+    std::vector<double> intervals;     // ms
+    EventArchiveReader archive;
+    bool useArchive;
+    uint64_t archiveStart;
+    uint64_t archiveEnd;
+    
+    // 옵션
+    AnalyticsKernel kernel;
+    std::vector<double> percentiles;
+    double burstMs;
+    double pauseMs;
+    bool histogram;
+    double histogramOrigin;
+    double histogramWidth;
+    uint32_t histogramBuckets;
+    
+    // 결과
+    bool failed;
+    std::string error;
+    uint64_t events;
+    AnalyticsMoments moments;
+    AnalyticsSegments segments;
+    std::vector<double> percentileValues;
+    std::vector<double> histogramCounts;
+    std::vector<double> histogramSums;
+    uint64_t elapsedNs;
+};
 
 // Node.js 바인딩 클래스
 class KeyboardNativeBinding {
@@ -11,24 +174,153 @@ public:
     static napi_value Init(napi_env env, napi_value exports);
 
 private:
-    // 정적 멤버
+    // 프로세스 공유 상태 - OS 후킹은 하나이며 연결된 구독들에 나눠 전달
+    // (리스너 교체/시작/중지와 구독 연결은 s_listenerMutex로 직렬화, 후킹 스레드는 잠금 없이 슬롯만 읽음)
     static std::unique_ptr<KeyboardListenerBase> s_listener;
-    static napi_threadsafe_function s_callback;
-    static napi_env s_env;
+    static std::mutex s_listenerMutex;
+    static CaptureDispatcher s_dispatcher;         // 후킹 쪽 파이프라인 (구독 슬롯, 키 상태, 실시간 상태)
+    static size_t s_attachedCount;
     
     // Node.js API 함수들
     static napi_value StartListening(napi_env env, napi_callback_info info);
+    static napi_value StartListeningBatched(napi_env env, napi_callback_info info);
+    static napi_value StartTypingSessions(napi_env env, napi_callback_info info);
+    static napi_value SetIdleTimeout(napi_env env, napi_callback_info info);
+    static napi_value SetEventFilter(napi_env env, napi_callback_info info);
+    static napi_value SetOverloadPolicy(napi_env env, napi_callback_info info);
+    static napi_value SetRhythmOptions(napi_env env, napi_callback_info info);
+    static napi_value Subscribe(napi_env env, napi_callback_info info);
+    static napi_value Unsubscribe(napi_env env, napi_callback_info info);
+    static napi_value GetSessionStats(napi_env env, napi_callback_info info);
+    static napi_value ResetSessionStats(napi_env env, napi_callback_info info);
     static napi_value StopListening(napi_env env, napi_callback_info info);
     static napi_value CheckPermissions(napi_env env, napi_callback_info info);
     static napi_value IsListening(napi_env env, napi_callback_info info);
+    static napi_value SetListenerBackend(napi_env env, napi_callback_info info);
+    static napi_value GetMetrics(napi_env env, napi_callback_info info);
+    static napi_value ResetMetrics(napi_env env, napi_callback_info info);
+    static napi_value GetClockAnchor(napi_env env, napi_callback_info info);
+    static napi_value OpenJournal(napi_env env, napi_callback_info info);
+    static napi_value CloseJournal(napi_env env, napi_callback_info info);
+    static napi_value JournalRange(napi_env env, napi_callback_info info);
+    static napi_value JournalSealedSegments(napi_env env, napi_callback_info info);
+    static napi_value JournalReadSegment(napi_env env, napi_callback_info info);
+    static napi_value JournalReleaseSegment(napi_env env, napi_callback_info info);
+    static napi_value TakeRollups(napi_env env, napi_callback_info info);
+    static napi_value LoadStatsSnapshot(napi_env env, napi_callback_info info);
+    static napi_value SaveStatsSnapshot(napi_env env, napi_callback_info info);
+    static napi_value GetRunningStats(napi_env env, napi_callback_info info);
+    static napi_value ReconcileStats(napi_env env, napi_callback_info info);
+    static napi_value TimeIndexAdd(napi_env env, napi_callback_info info);
+    static napi_value TimeIndexQuery(napi_env env, napi_callback_info info);
+    static napi_value TimeIndexInfo(napi_env env, napi_callback_info info);
+    static napi_value GetAppTable(napi_env env, napi_callback_info info);
+    static napi_value GetAppStats(napi_env env, napi_callback_info info);
+    static napi_value OpenArchive(napi_env env, napi_callback_info info);
+    static napi_value CloseArchive(napi_env env, napi_callback_info info);
+    static napi_value ArchiveAppend(napi_env env, napi_callback_info info);
+    static napi_value ArchiveScan(napi_env env, napi_callback_info info);
+    static napi_value ArchiveInfo(napi_env env, napi_callback_info info);
+    static napi_value Analyze(napi_env env, napi_callback_info info);
+    static napi_value GetAnalyticsKernel(napi_env env, napi_callback_info info);
+    static napi_value ReadSnapshot(napi_env env, napi_callback_info info);
+    static napi_value SetLiveStateOptions(napi_env env, napi_callback_info info);
+    static napi_value GetKeyState(napi_env env, napi_callback_info info);
+
+    // 지연 추적 (Chrome trace-event 파일)
+    static napi_value StartTrace(napi_env env, napi_callback_info info);
+    static napi_value StopTrace(napi_env env, napi_callback_info info);
+    static napi_value FlushTrace(napi_env env, napi_callback_info info);
+    static napi_value RecordTraceSpan(napi_env env, napi_callback_info info);
+    
+    // 환경/구독 관리
+    static void FinalizeInstance(napi_env env, void* data, void* hint);
+    static KeyboardAddonInstance* GetInstance(napi_env env);
+    static KeyboardSubscription* ResolveSubscription(napi_env env, napi_value* args, size_t argc, size_t index);
+    static napi_value StartSubscription(napi_env env, KeyboardSubscription* sub, DeliveryMode mode,
+                                        napi_value callback, napi_value options);
+    static bool StopSubscription(KeyboardSubscription* sub);
+    static void CloseSubscription(napi_env env, KeyboardSubscription* sub);
+    static void ReleaseSubscriptionHandle(KeyboardSubscription* sub);
+    static void DeleteSubscription(KeyboardSubscription* sub);
+    static void OnTimerClosed(uv_handle_t* handle);
+    static void FinalizeDelivery(napi_env env, void* data, void* hint);
+    
+    // OS 후킹 연결 (JS 스레드, s_listenerMutex 사용)
+    static bool AttachSubscription(napi_env env, KeyboardSubscription* sub);
+    static bool DetachSubscription(KeyboardSubscription* sub);
+    
+    // 설정 옵션 적용 (지정하지 않은 항목은 현재 값 유지)
+    static bool ApplyEventFilterOptions(napi_env env, KeyboardSubscription* sub, napi_value options);
+    static bool ApplyOverloadOptions(napi_env env, KeyboardSubscription* sub, napi_value options);
+    static bool ApplyIdleTimeoutOption(napi_env env, KeyboardSubscription* sub, napi_value options);
+    static bool ApplyRhythmOptions(napi_env env, KeyboardSubscription* sub, napi_value options);
     
-    // 콜백 처리
-    static void KeyEventCallback(const KeyEvent& event);
+    // 콜백 처리 (리스너 백엔드는 s_dispatcher를 싱크로 묶어 직접 호출, 후킹 쪽 단계는 CaptureDispatcher)
+    friend struct KeyboardSubscription;   // 생성 시 WakeJS를 깨우기 함수로 등록
     static void CallJS(napi_env env, napi_value js_callback, void* context, void* data);
+    static void WakeJS(CaptureSubscription* sub);
+    static void AccountDequeued(KeyboardSubscription* sub, const QueuedEvent& entry);
+    static void AccountSessionRecord(KeyboardSubscription* sub, const SessionRecord& record);
+    static void DrainSessionRecords(KeyboardSubscription* sub);
+    static bool InitTimer(napi_env env, KeyboardSubscription* sub, uv_timer_t* timer, bool* initialized);
+    
+    // 배치 전달
+    static bool ParseBatchConfig(napi_env env, napi_value options, BatchConfig* config);
+    static bool EnsureBatchBuffers(napi_env env, KeyboardSubscription* sub, size_t size);
+    static void DeliverBatches(napi_env env, napi_value js_callback, KeyboardSubscription* sub);
+    static bool CallBatchJS(napi_env env, napi_value js_callback, KeyboardSubscription* sub, size_t count);
+    static void ArmFlushTimer(KeyboardSubscription* sub);
+    static void StopFlushTimer(KeyboardSubscription* sub);
+    static void OnFlushTimer(uv_timer_t* handle);
+    
+    // 세션 레코드 전달
+    static void DeliverSessionRecords(napi_env env, napi_value js_callback, KeyboardSubscription* sub);
+    static bool CallSessionJS(napi_env env, napi_value js_callback, const SessionRecord& record, uint32_t coalescedCount,
+                              uint64_t traceId);
+    
+    // 리듬 전달 (후킹 스레드에서 의미 이벤트만 링에 넣고, JS 스레드에서 중복을 거른 뒤 전달)
+    static void DeliverRhythmEvents(napi_env env, napi_value js_callback, KeyboardSubscription* sub);
+    static bool ReportRhythmEvent(napi_env env, napi_value js_callback, KeyboardSubscription* sub, const RhythmEvent& event);
+    static bool ReportRhythmSessionEnd(napi_env env, napi_value js_callback, KeyboardSubscription* sub,
+                                       const SessionRecord& record);
+    static void ArmIdleTimer(KeyboardSubscription* sub, uint64_t delayMs);
+    static void StopIdleTimer(KeyboardSubscription* sub);
+    static void OnIdleTimer(uv_timer_t* handle);
+    
+    // 분석 작업 (작업 스레드에서 계산, JS 스레드에서 결과 생성)
+    static bool ParseAnalyticsInput(napi_env env, napi_value input, AnalyticsWork* work);
+    static bool ParseAnalyticsOptions(napi_env env, napi_value options, AnalyticsWork* work);
+    static void ExecuteAnalytics(napi_env env, void* data);
+    static void CompleteAnalytics(napi_env env, napi_status status, void* data);
+    static napi_value CreateAnalyticsObject(napi_env env, const AnalyticsWork& work);
+    
+    // 리스너 백엔드 생성 (이름과 옵션으로 선택, 지원하지 않으면 nullptr)
+    // sink: 백엔드가 키 이벤트를 넘길 곳 (s_dispatcher, 녹화 모드면 KeyboardListenerRecorder::GetSink())
+    // backpressure: 이벤트를 버리지 않고 링 자리를 기다려야 하는 소스 (최대 속도 재생)
+    template <typename Sink>
+    static KeyboardListenerBase* CreateListenerBackend(napi_env env, const char* name, napi_value options, Sink& sink,
+                                                       bool* backpressure);
+    static bool ReadNumberOption(napi_env env, napi_value options, const char* name, double* value);
+    static bool ReadStringOption(napi_env env, napi_value options, const char* name, std::string* value);
+    static bool ReadKeyCodeSetOption(napi_env env, napi_value options, const char* name, KeyCodeSet* value);
     
     // 유틸리티 함수
-    static napi_value CreateKeyEventObject(napi_env env, const KeyEvent& event);
+    static napi_value CreateKeyEventObject(napi_env env, const KeyEvent& event, const KeyTransitionInfo& keyState);
+    static napi_value CreateEventFilterObject(napi_env env, const EventFilterConfig& config);
+    static napi_value CreateOverloadPolicyObject(napi_env env, KeyboardSubscription* sub);
+    static napi_value CreateRhythmConfigObject(napi_env env, const RhythmConfig& config);
+    static napi_value CreateRhythmEventObject(napi_env env, const char* type, uint64_t timestamp, double value);
+    static napi_value CreateTypingMetadataObject(napi_env env, const SessionRecord& record);
+    static napi_value CreateIntervalStatsObject(napi_env env, const IntervalStats& stats);
+    static napi_value CreateLatencyObject(napi_env env, const LatencyHistogram& histogram);
+    static napi_value CreateTraceSummaryObject(napi_env env, const TraceSummary& summary);
     static napi_value CreatePermissionObject(napi_env env, const PermissionInfo& info);
+    static napi_value CreateJournalRecordsObject(napi_env env, const std::vector<JournalRecord>& records);
+    static bool ReadJournalRecordsObject(napi_env env, napi_value obj, std::vector<JournalRecord>* records);
+    static napi_value CreateRollupArray(napi_env env, const std::vector<RollupBucket>& buckets);
+    static napi_value CreateRunningStatsObject(napi_env env, const RollupRunning& running);
+    static bool ReadRunningStatsObject(napi_env env, napi_value obj, RollupRunning* running);
 };
 
 // Node.js 모듈 초기화 매크로
@@ -0,0 +1,47 @@
+// AVX2 커널 - 이 파일만 -mavx2 (/arch:AVX2)로 컴파일 (binding.gyp의 analytics_avx2 타깃)
+// AnalyticsKernels가 실행 시 CPU를 확인한 뒤에만 호출함
+
+#include "analytics-kernels-impl.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+    typedef __m256d V;
+    static const size_t W = 4;
+
+    static V Load(const double* p) { return _mm256_loadu_pd(p); }
+    static void Store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V Set1(double value) { return _mm256_set1_pd(value); }
+    static V Zero() { return _mm256_setzero_pd(); }
+    static V Add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V Sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V Mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V Div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V Min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V Max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V Lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static V Gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static V And(V a, V b) { return _mm256_and_pd(a, b); }
+    static unsigned Bits(V mask) { return static_cast<unsigned>(_mm256_movemask_pd(mask)); }
+};
+
+} // namespace
+
+void AnalyticsAvx2::Moments(const double* values, size_t count, AnalyticsMoments* out) {
+    MomentsKernel<Avx2Ops>(values, count, out);
+}
+
+void AnalyticsAvx2::Segments(const double* intervals, size_t count, double burstMs, double pauseMs,
+                             AnalyticsSegments* out) {
+    SegmentsKernel<Avx2Ops>(intervals, count, burstMs, pauseMs, out);
+}
+
+void AnalyticsAvx2::Histogram(const double* timestamps, const double* values, size_t count,
+                              double origin, double width, uint32_t buckets, double* counts, double* sums) {
+    HistogramKernel<Avx2Ops>(timestamps, values, count, origin, width, buckets, counts, sums);
+}
+
+double AnalyticsAvx2::Min(const double* values, size_t count) {
+    return MinKernel<Avx2Ops>(values, count);
+}
@@ -0,0 +1,297 @@
+#ifndef ANALYTICS_KERNELS_IMPL_H
+#define ANALYTICS_KERNELS_IMPL_H
+
+// analytics-kernels.cc와 analytics-kernels-avx2.cc가 공유하는 커널 본체
+// 벡터 연산 묶음(Ops)을 받아 인스턴스화하며, 번역 단위마다 다른 명령어 집합으로 컴파일되므로
+// 링커가 AVX2로 컴파일된 사본을 다른 번역 단위에 섞지 않도록 모두 익명 네임스페이스에 둠
+//
+// Ops 요구 사항: V, W(레인 수), Load, Store, Set1, Zero, Add, Sub, Mul, Div, Min, Max,
+//               Lt, Gt (레인별 전체 비트 마스크), And, Bits (레인 i → 비트 i)
+
+#include "analytics-kernels.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// AVX2 번역 단위의 진입점 (analytics-kernels-avx2.cc - ANALYTICS_HAVE_AVX2로 빌드할 때만 링크됨)
+struct AnalyticsAvx2 {
+    static void Moments(const double* values, size_t count, AnalyticsMoments* out);
+    static void Segments(const double* intervals, size_t count, double burstMs, double pauseMs, AnalyticsSegments* out);
+    static void Histogram(const double* timestamps, const double* values, size_t count,
+                          double origin, double width, uint32_t buckets, double* counts, double* sums);
+    static double Min(const double* values, size_t count);
+};
+
+namespace {
+
+struct AnalyticsBits {
+    static unsigned Popcount(uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_IX86)
+        return static_cast<unsigned>(__popcnt(static_cast<uint32_t>(value)) + __popcnt(static_cast<uint32_t>(value >> 32)));
+#elif defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(value));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(value));
+#endif
+    }
+
+    // value != 0
+    static unsigned TrailingZeros(uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_IX86)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<uint32_t>(value))) {
+            return static_cast<unsigned>(index);
+        }
+        _BitScanForward(&index, static_cast<uint32_t>(value >> 32));
+        return static_cast<unsigned>(index) + 32;
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+    }
+};
+
+// 합/제곱합은 첫 값과의 차이로 누적 (큰 값끼리 빼면서 생기는 자릿수 손실 방지)
+struct MomentsAccumulator {
+    double sum;
+    double sumSq;
+    double min;
+    double max;
+
+    void AddRange(const double* values, size_t begin, size_t end, double shift) {
+        for (size_t i = begin; i < end; i++) {
+            const double delta = values[i] - shift;
+            sum += delta;
+            sumSq += delta * delta;
+            if (values[i] < min) min = values[i];
+            if (values[i] > max) max = values[i];
+        }
+    }
+
+    void Finish(size_t count, double shift, AnalyticsMoments* out) const {
+        const double n = static_cast<double>(count);
+        out->count = count;
+        out->sum = sum + shift * n;
+        out->mean = shift + sum / n;
+        out->variance = count > 1 ? std::max(0.0, (sumSq - sum * sum / n) / (n - 1)) : 0.0;
+        out->min = min;
+        out->max = max;
+    }
+};
+
+// 몰아치기 구간 상태 - 스칼라는 값 하나씩, 벡터는 64개 단위 비트 마스크로 갱신
+struct SegmentState {
+    uint64_t run;
+    uint64_t longest;
+    uint64_t runs;
+    uint64_t keys;
+    uint64_t pauses;
+    double pauseTotal;
+
+    void Step(double value, double burstMs, double pauseMs) {
+        if (value > 0 && value < burstMs) {
+            if (run == 0) runs++;
+            run++;
+            keys++;
+        } else {
+            if (run > longest) longest = run;
+            run = 0;
+        }
+        if (value > pauseMs) {
+            pauses++;
+            pauseTotal += value;
+        }
+    }
+
+    // 연속된 64개 값의 마스크 (합계는 호출자가 벡터로 누적)
+    void Apply(uint64_t burstBits, uint64_t pauseBits) {
+        keys += AnalyticsBits::Popcount(burstBits);
+        pauses += AnalyticsBits::Popcount(pauseBits);
+        runs += AnalyticsBits::Popcount(burstBits & ~((burstBits << 1) | (run > 0 ? 1u : 0u)));
+
+        if (burstBits == ~0ull) {
+            run += 64;
+            return;
+        }
+
+        // 구간 길이 - 1 비트 묶음과 0 비트 묶음을 번갈아 건너뜀 (끝에서 이어지는 구간은 다음 묶음으로)
+        uint64_t mask = burstBits;
+        unsigned remaining = 64;
+        while (remaining > 0) {
+            if (mask & 1) {
+                const unsigned ones = AnalyticsBits::TrailingZeros(~mask);
+                run += ones;
+                remaining -= ones;
+                mask >>= ones;
+            } else {
+                if (run > longest) longest = run;
+                run = 0;
+                if (mask == 0) break;
+                const unsigned zeros = AnalyticsBits::TrailingZeros(mask);
+                remaining -= zeros;
+                mask >>= zeros;
+            }
+        }
+    }
+
+    void Finish(AnalyticsSegments* out) const {
+        out->burstRuns = runs;
+        out->burstKeys = keys;
+        out->longestBurst = std::max(longest, run);
+        out->pauseCount = pauses;
+        out->pauseTotal = pauseTotal;
+    }
+};
+
+struct HistogramTarget {
+    const double* values;
+    double buckets;
+    double* counts;
+    double* sums;
+
+    // 구간 번호가 [0, buckets)이면 반영 (음수/NaN/범위 초과는 무시)
+    void Add(double position, size_t index) const {
+        if (position >= 0 && position < buckets) {
+            const size_t bucket = static_cast<size_t>(position);
+            counts[bucket] += 1;
+            if (sums) sums[bucket] += values[index];
+        }
+    }
+};
+
+template <typename Ops>
+void MomentsKernel(const double* values, size_t count, AnalyticsMoments* out) {
+    typedef typename Ops::V V;
+    const size_t W = Ops::W;
+
+    const double shift = values[0];
+    const V shiftV = Ops::Set1(shift);
+    V sum0 = Ops::Zero(), sum1 = Ops::Zero();
+    V sq0 = Ops::Zero(), sq1 = Ops::Zero();
+    V min = Ops::Set1(shift), max = Ops::Set1(shift);
+
+    // 2배 펼침 - 덧셈 지연을 두 누산기로 가림
+    size_t i = 0;
+    for (; i + 2 * W <= count; i += 2 * W) {
+        const V a = Ops::Load(values + i);
+        const V b = Ops::Load(values + i + W);
+        const V da = Ops::Sub(a, shiftV);
+        const V db = Ops::Sub(b, shiftV);
+        sum0 = Ops::Add(sum0, da);
+        sum1 = Ops::Add(sum1, db);
+        sq0 = Ops::Add(sq0, Ops::Mul(da, da));
+        sq1 = Ops::Add(sq1, Ops::Mul(db, db));
+        min = Ops::Min(min, Ops::Min(a, b));
+        max = Ops::Max(max, Ops::Max(a, b));
+    }
+
+    double sums[W], squares[W], mins[W], maxs[W];
+    Ops::Store(sums, Ops::Add(sum0, sum1));
+    Ops::Store(squares, Ops::Add(sq0, sq1));
+    Ops::Store(mins, min);
+    Ops::Store(maxs, max);
+
+    MomentsAccumulator acc = { 0, 0, shift, shift };
+    for (size_t lane = 0; lane < W; lane++) {
+        acc.sum += sums[lane];
+        acc.sumSq += squares[lane];
+        acc.min = std::min(acc.min, mins[lane]);
+        acc.max = std::max(acc.max, maxs[lane]);
+    }
+    acc.AddRange(values, i, count, shift);
+    acc.Finish(count, shift, out);
+}
+
+template <typename Ops>
+void SegmentsKernel(const double* intervals, size_t count, double burstMs, double pauseMs, AnalyticsSegments* out) {
+    typedef typename Ops::V V;
+    const size_t W = Ops::W;
+
+    const V zero = Ops::Zero();
+    const V burst = Ops::Set1(burstMs);
+    const V pause = Ops::Set1(pauseMs);
+    V pauseSum = Ops::Zero();
+    SegmentState state = { 0, 0, 0, 0, 0, 0 };
+
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        uint64_t burstBits = 0;
+        uint64_t pauseBits = 0;
+        for (size_t j = 0; j < 64; j += W) {
+            const V x = Ops::Load(intervals + i + j);
+            const V isBurst = Ops::And(Ops::Gt(x, zero), Ops::Lt(x, burst));
+            const V isPause = Ops::Gt(x, pause);
+            burstBits |= static_cast<uint64_t>(Ops::Bits(isBurst)) << j;
+            pauseBits |= static_cast<uint64_t>(Ops::Bits(isPause)) << j;
+            pauseSum = Ops::Add(pauseSum, Ops::And(isPause, x));
+        }
+        state.Apply(burstBits, pauseBits);
+    }
+
+    double lanes[W];
+    Ops::Store(lanes, pauseSum);
+    for (size_t lane = 0; lane < W; lane++) {
+        state.pauseTotal += lanes[lane];
+    }
+    for (; i < count; i++) {
+        state.Step(intervals[i], burstMs, pauseMs);
+    }
+    state.Finish(out);
+}
+
+template <typename Ops>
+void HistogramKernel(const double* timestamps, const double* values, size_t count,
+                     double origin, double width, uint32_t buckets, double* counts, double* sums) {
+    typedef typename Ops::V V;
+    const size_t W = Ops::W;
+
+    const HistogramTarget target = { values, static_cast<double>(buckets), counts, sums };
+    const V originV = Ops::Set1(origin);
+    const V widthV = Ops::Set1(width);
+
+    // 구간 번호 계산만 벡터로, 누적은 레인별로 (같은 구간에 몰리는 경우가 대부분이라 흩뿌리기 이득 없음)
+    size_t i = 0;
+    double positions[W];
+    for (; i + W <= count; i += W) {
+        Ops::Store(positions, Ops::Div(Ops::Sub(Ops::Load(timestamps + i), originV), widthV));
+        for (size_t lane = 0; lane < W; lane++) {
+            target.Add(positions[lane], i + lane);
+        }
+    }
+    for (; i < count; i++) {
+        target.Add((timestamps[i] - origin) / width, i);
+    }
+}
+
+template <typename Ops>
+double MinKernel(const double* values, size_t count) {
+    typedef typename Ops::V V;
+    const size_t W = Ops::W;
+
+    double result = values[0];
+    size_t i = 0;
+    if (count >= W) {
+        V min = Ops::Load(values);
+        for (i = W; i + W <= count; i += W) {
+            min = Ops::Min(min, Ops::Load(values + i));
+        }
+        double lanes[W];
+        Ops::Store(lanes, min);
+        for (size_t lane = 0; lane < W; lane++) {
+            result = std::min(result, lanes[lane]);
+        }
+    }
+    for (; i < count; i++) {
+        result = std::min(result, values[i]);
+    }
+    return result;
+}
+
+} // namespace
+
+#endif // ANALYTICS_KERNELS_IMPL_H
@@ -0,0 +1,292 @@
+#include "analytics-kernels-impl.h"
+#include <string.h>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANALYTICS_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define ANALYTICS_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(ANALYTICS_HAVE_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+#ifdef ANALYTICS_HAVE_SSE2
+struct Sse2Ops {
+    typedef __m128d V;
+    static const size_t W = 2;
+
+    static V Load(const double* p) { return _mm_loadu_pd(p); }
+    static void Store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V Set1(double value) { return _mm_set1_pd(value); }
+    static V Zero() { return _mm_setzero_pd(); }
+    static V Add(V a, V b) { return _mm_add_pd(a, b); }
+    static V Sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V Mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V Div(V a, V b) { return _mm_div_pd(a, b); }
+    static V Min(V a, V b) { return _mm_min_pd(a, b); }
+    static V Max(V a, V b) { return _mm_max_pd(a, b); }
+    static V Lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V Gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static V And(V a, V b) { return _mm_and_pd(a, b); }
+    static unsigned Bits(V mask) { return static_cast<unsigned>(_mm_movemask_pd(mask)); }
+};
+#endif
+
+#ifdef ANALYTICS_HAVE_NEON
+struct NeonOps {
+    typedef float64x2_t V;
+    static const size_t W = 2;
+
+    static V Load(const double* p) { return vld1q_f64(p); }
+    static void Store(double* p, V v) { vst1q_f64(p, v); }
+    static V Set1(double value) { return vdupq_n_f64(value); }
+    static V Zero() { return vdupq_n_f64(0.0); }
+    static V Add(V a, V b) { return vaddq_f64(a, b); }
+    static V Sub(V a, V b) { return vsubq_f64(a, b); }
+    static V Mul(V a, V b) { return vmulq_f64(a, b); }
+    static V Div(V a, V b) { return vdivq_f64(a, b); }
+    static V Min(V a, V b) { return vminq_f64(a, b); }
+    static V Max(V a, V b) { return vmaxq_f64(a, b); }
+    static V Lt(V a, V b) { return vreinterpretq_f64_u64(vcltq_f64(a, b)); }
+    static V Gt(V a, V b) { return vreinterpretq_f64_u64(vcgtq_f64(a, b)); }
+    static V And(V a, V b) {
+        return vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(a), vreinterpretq_u64_f64(b)));
+    }
+    static unsigned Bits(V mask) {
+        const uint64x2_t bits = vreinterpretq_u64_f64(mask);
+        return static_cast<unsigned>((vgetq_lane_u64(bits, 0) & 1) | ((vgetq_lane_u64(bits, 1) & 1) << 1));
+    }
+};
+#endif
+
+bool CpuSupportsAvx2() {
+#if defined(ANALYTICS_HAVE_AVX2) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(ANALYTICS_HAVE_AVX2)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+AnalyticsKernel AnalyticsKernels::Detect() {
+    static const AnalyticsKernel detected = []() {
+        if (CpuSupportsAvx2()) {
+            return ANALYTICS_KERNEL_AVX2;
+        }
+#if defined(ANALYTICS_HAVE_NEON)
+        return ANALYTICS_KERNEL_NEON;
+#elif defined(ANALYTICS_HAVE_SSE2)
+        return ANALYTICS_KERNEL_SSE2;
+#else
+        return ANALYTICS_KERNEL_SCALAR;
+#endif
+    }();
+    return detected;
+}
+
+AnalyticsKernel AnalyticsKernels::Resolve(AnalyticsKernel preferred) {
+    const AnalyticsKernel best = Detect();
+    if (preferred >= best) {
+        return best;
+    }
+
+    // SSE2와 NEON은 서로 다른 아키텍처 - 요청한 쪽이 없으면 스칼라
+#ifdef ANALYTICS_HAVE_SSE2
+    if (preferred == ANALYTICS_KERNEL_SSE2) return ANALYTICS_KERNEL_SSE2;
+#endif
+#ifdef ANALYTICS_HAVE_NEON
+    if (preferred == ANALYTICS_KERNEL_NEON) return ANALYTICS_KERNEL_NEON;
+#endif
+    return ANALYTICS_KERNEL_SCALAR;
+}
+
+const char* AnalyticsKernels::Name(AnalyticsKernel kernel) {
+    switch (kernel) {
+        case ANALYTICS_KERNEL_SSE2: return "sse2";
+        case ANALYTICS_KERNEL_NEON: return "neon";
+        case ANALYTICS_KERNEL_AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+bool AnalyticsKernels::Parse(const char* name, AnalyticsKernel* kernel) {
+    if (strcmp(name, "auto") == 0) {
+        *kernel = Detect();
+    } else if (strcmp(name, "scalar") == 0) {
+        *kernel = ANALYTICS_KERNEL_SCALAR;
+    } else if (strcmp(name, "sse2") == 0) {
+        *kernel = ANALYTICS_KERNEL_SSE2;
+    } else if (strcmp(name, "neon") == 0) {
+        *kernel = ANALYTICS_KERNEL_NEON;
+    } else if (strcmp(name, "avx2") == 0) {
+        *kernel = ANALYTICS_KERNEL_AVX2;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void AnalyticsKernels::Moments(AnalyticsKernel kernel, const double* values, size_t count, AnalyticsMoments* out) {
+    if (count == 0) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+
+    switch (Resolve(kernel)) {
+#ifdef ANALYTICS_HAVE_AVX2
+        case ANALYTICS_KERNEL_AVX2: AnalyticsAvx2::Moments(values, count, out); return;
+#endif
+#ifdef ANALYTICS_HAVE_SSE2
+        case ANALYTICS_KERNEL_SSE2: MomentsKernel<Sse2Ops>(values, count, out); return;
+#endif
+#ifdef ANALYTICS_HAVE_NEON
+        case ANALYTICS_KERNEL_NEON: MomentsKernel<NeonOps>(values, count, out); return;
+#endif
+        default: {
+            MomentsAccumulator acc = { 0, 0, values[0], values[0] };
+            acc.AddRange(values, 0, count, values[0]);
+            acc.Finish(count, values[0], out);
+            return;
+        }
+    }
+}
+
+void AnalyticsKernels::Segments(AnalyticsKernel kernel, const double* intervals, size_t count,
+                                double burstMs, double pauseMs, AnalyticsSegments* out) {
+    switch (Resolve(kernel)) {
+#ifdef ANALYTICS_HAVE_AVX2
+        case ANALYTICS_KERNEL_AVX2: AnalyticsAvx2::Segments(intervals, count, burstMs, pauseMs, out); return;
+#endif
+#ifdef ANALYTICS_HAVE_SSE2
+        case ANALYTICS_KERNEL_SSE2: SegmentsKernel<Sse2Ops>(intervals, count, burstMs, pauseMs, out); return;
+#endif
+#ifdef ANALYTICS_HAVE_NEON
+        case ANALYTICS_KERNEL_NEON: SegmentsKernel<NeonOps>(intervals, count, burstMs, pauseMs, out); return;
+#endif
+        default: {
+            SegmentState state = { 0, 0, 0, 0, 0, 0 };
+            for (size_t i = 0; i < count; i++) {
+                state.Step(intervals[i], burstMs, pauseMs);
+            }
+            state.Finish(out);
+            return;
+        }
+    }
+}
+
+void AnalyticsKernels::Histogram(AnalyticsKernel kernel, const double* timestamps, const double* values, size_t count,
+                                 double origin, double width, uint32_t buckets, double* counts, double* sums) {
+    if (!(width > 0) || buckets == 0) {
+        return;
+    }
+
+    switch (Resolve(kernel)) {
+#ifdef ANALYTICS_HAVE_AVX2
+        case ANALYTICS_KERNEL_AVX2:
+            AnalyticsAvx2::Histogram(timestamps, values, count, origin, width, buckets, counts, sums);
+            return;
+#endif
+#ifdef ANALYTICS_HAVE_SSE2
+        case ANALYTICS_KERNEL_SSE2:
+            HistogramKernel<Sse2Ops>(timestamps, values, count, origin, width, buckets, counts, sums);
+            return;
+#endif
+#ifdef ANALYTICS_HAVE_NEON
+        case ANALYTICS_KERNEL_NEON:
+            HistogramKernel<NeonOps>(timestamps, values, count, origin, width, buckets, counts, sums);
+            return;
+#endif
+        default: {
+            const HistogramTarget target = { values, static_cast<double>(buckets), counts, sums };
+            for (size_t i = 0; i < count; i++) {
+                target.Add((timestamps[i] - origin) / width, i);
+            }
+            return;
+        }
+    }
+}
+
+size_t AnalyticsKernels::CompactPositive(const double* values, size_t count, double* out) {
+    // 분기 없이 항상 쓰고 조건에 따라 위치만 전진
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        out[kept] = values[i];
+        kept += values[i] > 0 ? 1 : 0;
+    }
+    return kept;
+}
+
+void AnalyticsKernels::Percentiles(AnalyticsKernel kernel, double* values, size_t count,
+                                   const double* percentiles, size_t percentileCount, double* out) {
+    if (count == 0) {
+        for (size_t i = 0; i < percentileCount; i++) {
+            out[i] = 0;
+        }
+        return;
+    }
+
+    // 순위 오름차순으로 처리 - 앞에서 고정한 위치 앞쪽은 다시 나누지 않음
+    std::vector<size_t> order(percentileCount);
+    for (size_t i = 0; i < percentileCount; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [percentiles](size_t a, size_t b) {
+        return percentiles[a] < percentiles[b];
+    });
+
+    const AnalyticsKernel resolved = Resolve(kernel);
+    size_t low = 0;
+    for (size_t index : order) {
+        const double percentile = std::min(100.0, std::max(0.0, percentiles[index]));
+        const double rank = percentile / 100.0 * static_cast<double>(count - 1);
+        const size_t k = static_cast<size_t>(rank);
+
+        std::nth_element(values + low, values + k, values + count);
+        low = k;
+
+        // k번째 다음 값 = 오른쪽 구간의 최솟값
+        double value = values[k];
+        const double fraction = rank - static_cast<double>(k);
+        if (fraction > 0 && k + 1 < count) {
+            double next;
+            switch (resolved) {
+#ifdef ANALYTICS_HAVE_AVX2
+                case ANALYTICS_KERNEL_AVX2: next = AnalyticsAvx2::Min(values + k + 1, count - k - 1); break;
+#endif
+#ifdef ANALYTICS_HAVE_SSE2
+                case ANALYTICS_KERNEL_SSE2: next = MinKernel<Sse2Ops>(values + k + 1, count - k - 1); break;
+#endif
+#ifdef ANALYTICS_HAVE_NEON
+                case ANALYTICS_KERNEL_NEON: next = MinKernel<NeonOps>(values + k + 1, count - k - 1); break;
+#endif
+                default: next = *std::min_element(values + k + 1, values + count); break;
+            }
+            value += (next - value) * fraction;
+        }
+        out[index] = value;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef ANALYTICS_KERNELS_H
+#define ANALYTICS_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 분석 커널 구현 (숫자가 클수록 넓은 벡터 - 요청한 구현을 CPU가 지원하지 않으면 한 단계씩 낮춤)
+enum AnalyticsKernel {
+    ANALYTICS_KERNEL_SCALAR = 0,
+    ANALYTICS_KERNEL_SSE2 = 1,     // x86-64 기본
+    ANALYTICS_KERNEL_NEON = 2,     // AArch64 기본
+    ANALYTICS_KERNEL_AVX2 = 3      // 별도 번역 단위 (-mavx2), 실행 시 CPU 확인 후 사용
+};
+
+// 간격 통계 (표본 분산 - IntervalStats와 같은 기준)
+struct AnalyticsMoments {
+    uint64_t count;
+    double sum;
+    double mean;
+    double variance;
+    double min;
+    double max;
+};
+
+// 몰아치기/멈춤 구간
+// - 몰아치기: 0 < 간격 < burstMs 가 연속된 구간 (세션 첫 키의 0 간격은 구간을 끊음)
+// - 멈춤: 간격 > pauseMs
+struct AnalyticsSegments {
+    uint64_t burstRuns;
+    uint64_t burstKeys;
+    uint64_t longestBurst;
+    uint64_t pauseCount;
+    double pauseTotal;
+};
+
+// 간격/타임스탬프 배열 분석 커널 (SIMD + 스칼라 폴백)
+// 모든 함수는 상태가 없어 어느 스레드에서나 호출 가능
+class AnalyticsKernels {
+public:
+    // 이 CPU에서 쓸 수 있는 가장 넓은 구현
+    static AnalyticsKernel Detect();
+
+    // preferred 이하에서 쓸 수 있는 가장 넓은 구현
+    static AnalyticsKernel Resolve(AnalyticsKernel preferred);
+
+    static const char* Name(AnalyticsKernel kernel);
+    static bool Parse(const char* name, AnalyticsKernel* kernel);
+
+    // 합/평균/분산/최소/최대 (count가 0이면 모두 0)
+    static void Moments(AnalyticsKernel kernel, const double* values, size_t count, AnalyticsMoments* out);
+
+    static void Segments(AnalyticsKernel kernel, const double* intervals, size_t count,
+                         double burstMs, double pauseMs, AnalyticsSegments* out);
+
+    // [origin + i*width, origin + (i+1)*width) 구간별 개수와 values 합 (values가 null이면 개수만)
+    // 범위를 벗어난 값은 무시하며 counts/sums는 호출자가 0으로 초기화해 둠
+    static void Histogram(AnalyticsKernel kernel, const double* timestamps, const double* values, size_t count,
+                          double origin, double width, uint32_t buckets, double* counts, double* sums);
+
+    // 양수만 out에 모으고 개수 반환 (out은 count 이상 크기)
+    static size_t CompactPositive(const double* values, size_t count, double* out);
+
+    // 분위수 (0-100, 선형 보간) - values 순서를 바꿈
+    static void Percentiles(AnalyticsKernel kernel, double* values, size_t count,
+                            const double* percentiles, size_t percentileCount, double* out);
+};
+
+#endif // ANALYTICS_KERNELS_H
@@ -0,0 +1,36 @@
+#include "app-registry.h"
+
+AppRegistry& AppRegistry::Shared() {
+    static AppRegistry registry;
+    return registry;
+}
+
+AppRegistry::AppRegistry()
+    : m_active(APP_ID_UNKNOWN) {
+}
+
+uint16_t AppRegistry::Intern(const char* name, size_t length) {
+    if (!name || length == 0) {
+        return APP_ID_UNKNOWN;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string key(name, length);
+    auto found = m_ids.find(key);
+    if (found != m_ids.end()) {
+        return found->second;
+    }
+    if (m_names.size() >= APP_REGISTRY_MAX_APPS) {
+        return APP_ID_UNKNOWN;
+    }
+
+    m_names.push_back(key);
+    const uint16_t appId = static_cast<uint16_t>(m_names.size());
+    m_ids.emplace(std::move(key), appId);
+    return appId;
+}
+
+void AppRegistry::CopyNames(std::vector<std::string>* names) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    *names = m_names;
+}
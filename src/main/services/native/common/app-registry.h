@@ -0,0 +1,42 @@
+#ifndef APP_REGISTRY_H
+#define APP_REGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 앱 ID 0 = 알 수 없음 (포커스 추적을 지원하지 않는 백엔드, 창 클래스가 없는 창)
+#define APP_ID_UNKNOWN 0
+#define APP_REGISTRY_MAX_APPS 65535
+
+// 포커스된 앱 이름(Linux: WM_CLASS의 클래스 이름) ↔ 16비트 앱 ID 표
+// - 키 이벤트에는 ID만 싣고 이름은 JS가 표로 찾음 (이벤트마다 문자열을 옮기지 않음)
+// - 이름 등록은 포커스가 바뀔 때만 일어나므로 잠금을 쓰고, 한 번 받은 ID는 프로세스가 끝날 때까지 유지
+// - 현재 앱 ID는 원자 변수 하나라 어느 스레드에서나 대기 없이 읽음
+class AppRegistry {
+public:
+    static AppRegistry& Shared();
+
+    // 이름에 해당하는 ID (처음 보면 새로 부여, 빈 이름이거나 표가 가득 차면 APP_ID_UNKNOWN)
+    uint16_t Intern(const char* name, size_t length);
+
+    void SetActive(uint16_t appId) { m_active.store(appId, std::memory_order_relaxed); }
+    uint16_t GetActive() const { return m_active.load(std::memory_order_relaxed); }
+
+    // ID 순서의 이름 복사본 (names[id - 1])
+    void CopyNames(std::vector<std::string>* names) const;
+
+private:
+    AppRegistry();
+
+    mutable std::mutex m_mutex;
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, uint16_t> m_ids;
+    std::atomic<uint16_t> m_active;
+};
+
+#endif // APP_REGISTRY_H
@@ -0,0 +1,476 @@
+#include "capture-dispatch.h"
+#include "event-clock.h"
+#include "trace-recorder.h"
+
+#include <chrono>
+
+CaptureSubscription::CaptureSubscription(bool keepRecords, WakeFunction wakeFunction)
+    : jsThreadId(std::this_thread::get_id()),
+      wake(wakeFunction),
+      deliveryMode(DELIVERY_EVENTS),
+      recordRing(keepRecords ? new SessionRecordRing() : nullptr),
+      overloadPolicy(OVERLOAD_DROP_NEWEST),
+      blockTimeoutMs(DEFAULT_OVERLOAD_BLOCK_TIMEOUT_MS),
+      producerBlocked(false),
+      releaseProducer(false),
+      coalescedPending(false),
+      batchWakeThreshold(0) {
+    coalescedLock.clear();
+}
+
+CaptureDispatcher::CaptureDispatcher(const KeyModifierTable& modifierKeys)
+    : m_hookSequence(0),
+      m_sourceBackpressure(false),
+      m_quiescing(0),
+      m_keyState(modifierKeys) {
+    for (size_t i = 0; i < KEYBOARD_MAX_SUBSCRIPTIONS; i++) {
+        m_slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+// 키 이벤트 전달 (리스너 캡처 단계의 끝)
+// OS 후킹 스레드에서 호출되므로 구독마다 링에 복사만 하고 즉시 반환 (대기/할당 없음)
+void CaptureDispatcher::Deliver(const KeyEvent& event) {
+    const uint64_t hookStartNs = EventClock::NowNs();
+    
+    // 지연 추적 중이면 키 입력마다 추적 ID 발급 (꺼져 있으면 원자 변수 읽기 한 번)
+    TraceRecorder& recorder = TraceRecorder::Shared();
+    const uint64_t traceId = recorder.IsEnabled() ? recorder.NextTraceId() : 0;
+    
+    // 누름/반복/뗌 분류 (구독과 무관하게 한 번) - 자동 반복은 세션과 실시간 상태에 세지 않음
+    const KeyTransitionInfo keyState = m_keyState.Update(event);
+    
+    // 실시간 상태는 구독 필터와 무관하게 세션 기준(처음 누름, 비특수 키)으로 먼저 게시
+    if (keyState.transition == KEY_TRANSITION_PRESS && !event.isSpecialKey) {
+        m_liveState.OnKeyPress(event.timestamp);
+    }
+    
+    // 진입 표시 (홀수 = 실행 중) - 구독 해제는 슬롯을 비운 뒤 이 값이 바뀔 때까지 기다림
+    m_hookSequence.fetch_add(1, std::memory_order_seq_cst);
+    for (size_t i = 0; i < KEYBOARD_MAX_SUBSCRIPTIONS; i++) {
+        CaptureSubscription* sub = m_slots[i].load(std::memory_order_seq_cst);
+        if (sub) {
+            DispatchEvent(sub, event, keyState, hookStartNs, traceId);
+        }
+    }
+    m_hookSequence.fetch_add(1, std::memory_order_release);
+    
+    // OS 이벤트 시각 → 콜백 진입은 별도 트랙에, 콜백 구간은 이 스레드에 기록하고 흐름 시작
+    // (소스 시각이 콜백 진입보다 늦으면 - 합성/재생 소스 - OS 전달 구간은 없음)
+    if (traceId != 0) {
+        recorder.NameCurrentThread("keyboard hook");
+        if (event.timestamp <= hookStartNs) {
+            recorder.Record(TRACE_NAME_OS_DELIVERY, TRACE_NAME_OS_INPUT_TRACK, event.timestamp, hookStartNs, traceId,
+                            TRACE_FLOW_NONE);
+        }
+        recorder.Record(TRACE_NAME_HOOK, TRACE_NAME_NONE, hookStartNs, EventClock::NowNs(), traceId, TRACE_FLOW_START);
+    }
+}
+
+// 구독을 빈 슬롯에 게시 (다음 후킹 콜백부터 전달)
+bool CaptureDispatcher::Attach(CaptureSubscription* sub) {
+    for (size_t i = 0; i < KEYBOARD_MAX_SUBSCRIPTIONS; i++) {
+        if (!m_slots[i].load(std::memory_order_relaxed)) {
+            m_slots[i].store(sub, std::memory_order_seq_cst);
+            return true;
+        }
+    }
+    return false;
+}
+
+// 구독을 슬롯에서 내림 - 반환 후에는 후킹 스레드가 이 구독에 접근하지 않음
+// (링 자리를 기다리는 후킹 스레드가 있으면 호출 전에 ReleaseBlockedProducer로 풀어야 함)
+void CaptureDispatcher::Detach(CaptureSubscription* sub) {
+    for (size_t i = 0; i < KEYBOARD_MAX_SUBSCRIPTIONS; i++) {
+        if (m_slots[i].load(std::memory_order_relaxed) == sub) {
+            m_slots[i].store(nullptr, std::memory_order_seq_cst);
+        }
+    }
+    // 다른 구독의 링 자리를 기다리는 최대 속도 재생 생산자는 이 소비자가 비워 줄 수 없으므로 포기시킴
+    m_quiescing.fetch_add(1, std::memory_order_seq_cst);
+    WaitForHookQuiescence();
+    m_quiescing.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// 실행 중인 후킹 콜백이 끝날 때까지 대기 (슬롯을 비운 뒤 호출)
+// 슬롯 비우기와 진입 표시가 모두 seq_cst이므로, 진입 표시를 못 본 콜백은 비워진 슬롯을 봄
+void CaptureDispatcher::WaitForHookQuiescence() {
+    const uint64_t sequence = m_hookSequence.load(std::memory_order_seq_cst);
+    if ((sequence & 1) == 0) {
+        return;
+    }
+    while (m_hookSequence.load(std::memory_order_acquire) == sequence) {
+        std::this_thread::yield();
+    }
+}
+
+// 구독 하나에 이벤트 전달 - 필터, 세션 단계를 거쳐 구독의 링에 추가 (후킹 스레드)
+void CaptureDispatcher::DispatchEvent(CaptureSubscription* sub, const KeyEvent& event, const KeyTransitionInfo& keyState,
+                                      uint64_t hookStartNs, uint64_t traceId) {
+    sub->metrics.hookCalls.fetch_add(1, std::memory_order_relaxed);
+
+    // 필터 단계 - 걸러진 이벤트는 링과 소비자 스레드까지 가지 않음
+    if (!sub->eventFilter.Accept(event, keyState)) {
+        sub->metrics.filtered.fetch_add(1, std::memory_order_relaxed);
+        sub->metrics.hookDuration.Record(EventClock::NowNs() - hookStartNs);
+        return;
+    }
+
+    QueuedEvent entry;
+    entry.event = event;
+    entry.keyState = keyState;
+    entry.session.type = SESSION_RECORD_NONE;
+    entry.rhythm.type = RHYTHM_EVENT_NONE;
+    entry.enqueuedNs = hookStartNs;
+    entry.coalescedStartNs = 0;
+    entry.coalescedCount = 0;
+    entry.traceId = traceId;
+    bool shouldWake = false;
+
+    // 세션 단계 - 처음 누름이면서 특수 키가 아닌 입력만 세션에 포함 (자동 반복은 키 수에 세지 않음)
+    QueuedEvent endEntry;
+    bool sessionEnded = false;
+    if (keyState.transition == KEY_TRANSITION_PRESS && !event.isSpecialKey) {
+        sessionEnded = sub->sessionizer.OnKeyPress(event.timestamp, &entry.session, &endEntry.session);
+        entry.session.appId = event.appId;
+        if (sessionEnded) {
+            endEntry.event = event;
+            endEntry.keyState = keyState;
+            endEntry.rhythm.type = RHYTHM_EVENT_NONE;
+            endEntry.enqueuedNs = hookStartNs;
+            endEntry.coalescedStartNs = 0;
+            endEntry.coalescedCount = 0;
+            endEntry.traceId = 0;
+        }
+    }
+
+    // 저널/통계 레코드는 과부하 정책과 상관없이 키마다 남김 (이벤트 링에 넣기 전 - 깨우기는 이벤트 링 항목이 맡음)
+    if (sub->recordRing && entry.session.type == SESSION_RECORD_TYPING) {
+        PushSessionRecord(sub, entry.session);
+    }
+
+    if (sub->deliveryMode == DELIVERY_RHYTHM) {
+        // 리듬 전달 모드에서는 의미 이벤트와 세션 종료만 링에 넣음
+        PushRhythmEvents(sub, entry, sessionEnded ? &endEntry : nullptr, &shouldWake);
+    } else {
+        if (sessionEnded) {
+            PushEvent(sub, endEntry, &shouldWake);
+        }
+        
+        // 세션 전달 모드에서는 세션에 포함되지 않는 이벤트(키 뗌 등)를 링에 넣지 않음
+        if (sub->deliveryMode == DELIVERY_SESSIONS && entry.session.type == SESSION_RECORD_NONE) {
+            sub->metrics.filtered.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            PushEvent(sub, entry, &shouldWake);
+        }
+    }
+
+    if (shouldWake) {
+        sub->wake(sub);
+    }
+
+    sub->metrics.hookDuration.Record(EventClock::NowNs() - hookStartNs);
+}
+
+// 타이핑 레코드를 레코드 링에 추가 (후킹 스레드, 레코드 링을 둔 구독)
+// 이벤트 링 항목이 같은 깨우기에 함께 전달되므로 따로 깨우지 않음
+void CaptureDispatcher::PushSessionRecord(CaptureSubscription* sub, const SessionRecord& record) {
+    if (!sub->recordRing->TryPush(record, nullptr)) {
+        sub->metrics.recordsDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// 리듬 단계 - 키 입력을 의미 이벤트로 바꿔 링에 넣음 (후킹 스레드)
+// 지난 간격의 이벤트 → 세션 종료 → 이 키가 만든 이벤트 순서 (시각 순)
+void CaptureDispatcher::PushRhythmEvents(CaptureSubscription* sub, const QueuedEvent& entry,
+                                         const QueuedEvent* endEntry, bool* shouldWake) {
+    if (entry.session.type != SESSION_RECORD_TYPING) {
+        sub->metrics.filtered.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    RhythmEvent events[RHYTHM_MAX_EVENTS];
+    const size_t count = sub->rhythmDetector.OnKeyPress(entry.event.timestamp, entry.session.keyCount == 1, events);
+    if (count == 0 && !endEntry) {
+        sub->metrics.filtered.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    // 키 입력 자체는 전달하지 않으므로 세션 레코드는 비워 둠 (저널/통계에 다시 세지 않도록)
+    QueuedEvent rhythmEntry = entry;
+    rhythmEntry.session.type = SESSION_RECORD_NONE;
+    
+    size_t i = 0;
+    for (; i < count && (events[i].type == RHYTHM_EVENT_PAUSE || events[i].type == RHYTHM_EVENT_RATE_LOW); i++) {
+        rhythmEntry.rhythm = events[i];
+        PushEvent(sub, rhythmEntry, shouldWake);
+    }
+    if (endEntry) {
+        PushEvent(sub, *endEntry, shouldWake);
+    }
+    for (; i < count; i++) {
+        rhythmEntry.rhythm = events[i];
+        PushEvent(sub, rhythmEntry, shouldWake);
+    }
+}
+
+// 링에 항목 추가 - 소비자 스레드를 깨워야 하면 shouldWake를 설정
+// 링이 가득 차면 과부하 정책에 따라 버리거나, 밀어내거나, 기다리거나, 요약에 합침
+bool CaptureDispatcher::PushEvent(CaptureSubscription* sub, const QueuedEvent& entry, bool* shouldWake) {
+    // 요약이 남아 있으면 순서를 지키기 위해 먼저 링에 넣음 (자리가 없으면 이 항목도 요약에 합침)
+    if (sub->coalescedPending.load(std::memory_order_acquire) && !FlushCoalesced(sub, shouldWake)) {
+        FoldCoalesced(sub, entry);
+        return false;
+    }
+    
+    size_t depth = 0;
+    bool pushed = sub->eventRing.TryPush(entry, &depth);
+    if (!pushed && m_sourceBackpressure.load(std::memory_order_relaxed)) {
+        pushed = BlockingPush(sub, entry, &depth, true);
+    } else if (!pushed) {
+        switch (sub->overloadPolicy.load(std::memory_order_relaxed)) {
+            case OVERLOAD_DROP_OLDEST:
+                if (sub->eventRing.EvictOldest()) {
+                    sub->metrics.evicted.fetch_add(1, std::memory_order_relaxed);
+                }
+                pushed = sub->eventRing.TryPush(entry, &depth);
+                break;
+                
+            case OVERLOAD_BLOCK:
+                pushed = BlockingPush(sub, entry, &depth, false);
+                break;
+                
+            case OVERLOAD_COALESCE:
+                // 요약이 새로 생겼을 때만 깨움 (소비자가 밀려 있는 동안 키마다 깨우기를 요청하지 않음)
+                if (FoldCoalesced(sub, entry)) {
+                    *shouldWake = true;
+                }
+                return false;
+                
+            default:
+                break;
+        }
+    }
+    if (!pushed) {
+        sub->metrics.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false; // 링이 가득 참 - 소비자 스레드가 밀려 있으므로 이벤트 버림
+    }
+    sub->metrics.enqueued.fetch_add(1, std::memory_order_relaxed);
+    sub->metrics.ObserveQueueDepth(depth);
+
+    // 링이 비어 있다가 채워졌을 때만 소비자 스레드를 깨움
+    // 배치 모드에서는 배치 크기에 도달했을 때도 깨움 (시간 예산 전 조기 전달)
+    // 링이 최대 깊이에 도달했을 때도 깨움 (최대 깊이가 배치 크기보다 작은 경우)
+    if (depth == 1 || depth == sub->batchWakeThreshold.load(std::memory_order_relaxed) ||
+        depth == sub->eventRing.GetLimit()) {
+        *shouldWake = true;
+    }
+    return true;
+}
+
+// 대기 정책 - 링에 자리가 나거나 시간이 초과될 때까지 후킹 스레드에서 기다림
+// untilSpace(최대 속도 재생)면 시간 초과 없이 자리가 날 때까지 기다림 (리스닝 중지, 구독 떼어내기 때만 포기)
+bool CaptureDispatcher::BlockingPush(CaptureSubscription* sub, const QueuedEvent& entry, size_t* depth,
+                                     bool untilSpace) {
+    // 후킹이 소비자 스레드에서 실행되면 (macOS 이벤트 탭) 기다리는 동안 링이 비워지지 않으므로 바로 버림
+    if (std::this_thread::get_id() == sub->jsThreadId || sub->releaseProducer.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    
+    sub->metrics.blocked.fetch_add(1, std::memory_order_relaxed);
+    sub->wake(sub);
+    
+    bool pushed = false;
+    {
+        std::unique_lock<std::mutex> lock(sub->blockMutex);
+        sub->producerBlocked.store(true, std::memory_order_seq_cst);
+        // 자리를 기다리는 동안에도 구독 떼어내기를 알아채도록 시간 초과 단위로 다시 확인
+        for (;;) {
+            const auto deadline = std::chrono::steady_clock::now() +
+                                  std::chrono::milliseconds(sub->blockTimeoutMs.load(std::memory_order_relaxed));
+            sub->blockCondition.wait_until(lock, deadline, [&]() {
+                pushed = sub->eventRing.TryPush(entry, depth);
+                return pushed ||
+                       sub->releaseProducer.load(std::memory_order_relaxed) ||
+                       (!untilSpace && sub->overloadPolicy.load(std::memory_order_relaxed) != OVERLOAD_BLOCK);
+            });
+            if (pushed || !untilSpace || sub->releaseProducer.load(std::memory_order_relaxed) ||
+                m_quiescing.load(std::memory_order_seq_cst) > 0) {
+                break;
+            }
+        }
+        sub->producerBlocked.store(false, std::memory_order_relaxed);
+    }
+    
+    if (!pushed) {
+        sub->metrics.blockTimeouts.fetch_add(1, std::memory_order_relaxed);
+    }
+    return pushed;
+}
+
+// 요약 잠금 - 임계 구역이 수십 ns이므로 스핀 (후킹 스레드가 잠들지 않도록)
+void CaptureDispatcher::LockCoalescedRun(CaptureSubscription* sub) {
+    while (sub->coalescedLock.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void CaptureDispatcher::UnlockCoalescedRun(CaptureSubscription* sub) {
+    sub->coalescedLock.clear(std::memory_order_release);
+}
+
+// 링에 들어가지 못한 항목을 요약에 합침 (후킹 스레드) - 요약이 비어 있다가 새로 생겼으면 true
+// 세션 종료 항목은 키 이벤트가 아니므로 개수에 넣지 않고 따로 보관
+bool CaptureDispatcher::FoldCoalesced(CaptureSubscription* sub, const QueuedEvent& entry) {
+    const bool isSessionEnd = entry.session.type == SESSION_RECORD_END;
+    CoalescedRun& run = sub->coalescedRun;
+    bool endDropped = false;
+    
+    LockCoalescedRun(sub);
+    const bool started = !sub->coalescedPending.load(std::memory_order_relaxed);
+    if (started) {
+        run.count = 0;
+        run.lastSession.type = SESSION_RECORD_NONE;
+        run.sessionEndHead = 0;
+        run.sessionEndCount = 0;
+    }
+    if (isSessionEnd) {
+        // 세션 종료가 요약보다 먼저 전달되므로 끝난 세션의 타이핑 레코드는 요약에 남기지 않음
+        // (최종 키 수는 세션 종료 레코드에 있음)
+        if (run.lastSession.type == SESSION_RECORD_TYPING && run.lastSession.sessionSeq == entry.session.sessionSeq) {
+            run.lastSession.type = SESSION_RECORD_NONE;
+        }
+        if (run.sessionEndCount < COALESCED_MAX_SESSION_ENDS) {
+            run.sessionEnds[run.sessionEndCount] = entry.session;
+            run.sessionEndNs[run.sessionEndCount] = entry.event.timestamp;
+            run.sessionEndCount++;
+        } else {
+            endDropped = true;
+        }
+    } else {
+        if (run.count == 0) {
+            run.startNs = entry.event.timestamp;
+        }
+        run.count++;
+        run.endNs = entry.event.timestamp;
+        run.lastEvent = entry.event;
+        if (entry.session.type != SESSION_RECORD_NONE) {
+            run.lastSession = entry.session;
+        }
+    }
+    sub->coalescedPending.store(true, std::memory_order_release);
+    UnlockCoalescedRun(sub);
+    
+    if (endDropped) {
+        sub->metrics.dropped.fetch_add(1, std::memory_order_relaxed);
+    } else if (!isSessionEnd) {
+        sub->metrics.coalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    return started;
+}
+
+// 요약을 링에 옮김 (후킹 스레드) - 세션 종료부터 차례로, 링에 자리가 모자라 남으면 false
+bool CaptureDispatcher::FlushCoalesced(CaptureSubscription* sub, bool* shouldWake) {
+    LockCoalescedRun(sub);
+    bool flushed = true;
+    while (sub->coalescedPending.load(std::memory_order_relaxed)) {
+        QueuedEvent item;
+        MakeCoalescedEntry(sub, &item);
+        size_t depth = 0;
+        if (!sub->eventRing.TryPush(item, &depth)) {
+            flushed = false;
+            break;
+        }
+        AdvanceCoalesced(sub);
+        
+        sub->metrics.enqueued.fetch_add(1, std::memory_order_relaxed);
+        sub->metrics.ObserveQueueDepth(depth);
+        if (depth == 1) {
+            *shouldWake = true;
+        }
+    }
+    UnlockCoalescedRun(sub);
+    return flushed; // 비어 있었으면 소비자 스레드가 먼저 가져간 것
+}
+
+// 요약의 다음 링 항목 (잠금을 잡은 상태, 요약이 남아 있을 때 호출)
+// 남은 세션 종료가 있으면 세션 종료 항목, 없으면 키 이벤트 요약 항목
+// (둘 다 coalescedStartNs를 설정 - 세션 종료 항목은 coalescedCount가 0)
+void CaptureDispatcher::MakeCoalescedEntry(CaptureSubscription* sub, QueuedEvent* entry) {
+    const CoalescedRun& run = sub->coalescedRun;
+    entry->keyState = KeyTransitionInfo();
+    entry->rhythm.type = RHYTHM_EVENT_NONE;
+    entry->enqueuedNs = EventClock::NowNs();
+    entry->traceId = 0;
+    if (run.sessionEndHead < run.sessionEndCount) {
+        entry->session = run.sessionEnds[run.sessionEndHead];
+        entry->coalescedCount = 0;
+        entry->coalescedStartNs = run.sessionEndNs[run.sessionEndHead];
+        entry->event.timestamp = run.sessionEndNs[run.sessionEndHead];
+        entry->event.keyCode = 0;
+        entry->event.isKeyDown = true;
+        entry->event.isSpecialKey = false;
+        entry->event.appId = 0;
+    } else {
+        entry->session = run.lastSession;
+        entry->coalescedCount = static_cast<uint32_t>(run.count < UINT32_MAX ? run.count : UINT32_MAX);
+        entry->coalescedStartNs = run.startNs;
+        entry->event = run.lastEvent;
+    }
+}
+
+// MakeCoalescedEntry가 만든 항목을 전달한 것으로 표시 (잠금을 잡은 상태) - 모두 전달하면 요약을 비움
+void CaptureDispatcher::AdvanceCoalesced(CaptureSubscription* sub) {
+    CoalescedRun& run = sub->coalescedRun;
+    if (run.sessionEndHead < run.sessionEndCount) {
+        run.sessionEndHead++;
+    } else {
+        run.count = 0;
+    }
+    if (run.sessionEndHead == run.sessionEndCount && run.count == 0) {
+        sub->coalescedPending.store(false, std::memory_order_release);
+    }
+}
+
+// 링에서 항목 꺼내기 (소비자 스레드) - 링이 비면 남은 요약 항목을 꺼냄
+bool CaptureDispatcher::PopEvent(CaptureSubscription* sub, QueuedEvent* entry) {
+    if (sub->eventRing.TryPop(entry)) {
+        // 자리를 기다리는 후킹 스레드 깨우기
+        // (tail 저장과 producerBlocked 확인이 모두 seq_cst - 생산자의 플래그 설정 후 재확인과 짝을 이룸)
+        if (sub->producerBlocked.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(sub->blockMutex);
+            sub->blockCondition.notify_one();
+        }
+        return true;
+    }
+    return TakeCoalesced(sub, entry);
+}
+
+// 아직 전달하지 않은 항목 수 (링 + 요약 - 요약은 남은 항목 수와 상관없이 1로 셈, 꺼낸 뒤 다시 확인)
+size_t CaptureDispatcher::PendingCount(CaptureSubscription* sub) {
+    return sub->eventRing.Size() + (sub->coalescedPending.load(std::memory_order_acquire) ? 1 : 0);
+}
+
+// 링이 비었을 때 요약 항목을 하나씩 직접 꺼냄 (소비자 스레드)
+// 링에 새 항목이 들어와 있으면 순서를 지키기 위해 가져가지 않음
+bool CaptureDispatcher::TakeCoalesced(CaptureSubscription* sub, QueuedEvent* entry) {
+    if (!sub->coalescedPending.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    LockCoalescedRun(sub);
+    const bool take = sub->coalescedPending.load(std::memory_order_relaxed) && sub->eventRing.Size() == 0;
+    if (take) {
+        MakeCoalescedEntry(sub, entry);
+        AdvanceCoalesced(sub);
+    }
+    UnlockCoalescedRun(sub);
+    return take;
+}
+
+// 기다리는 후킹 스레드를 풀어줌 (리스닝 중지 시, 다음 시작 전까지 대기하지 않음)
+void CaptureDispatcher::ReleaseBlockedProducer(CaptureSubscription* sub) {
+    std::lock_guard<std::mutex> lock(sub->blockMutex);
+    sub->releaseProducer.store(true, std::memory_order_relaxed);
+    sub->blockCondition.notify_all();
+}
@@ -0,0 +1,202 @@
+#ifndef CAPTURE_DISPATCH_H
+#define CAPTURE_DISPATCH_H
+
+#include "keyboard-base.h"
+#include "keycode-set.h"
+#include "event-filter.h"
+#include "key-state.h"
+#include "live-state.h"
+#include "sessionizer.h"
+#include "rhythm-detector.h"
+#include "pipeline-metrics.h"
+#include "spsc-ring.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+// 후킹 스레드 → 소비자(JS) 스레드 이벤트 링 크기 (2의 거듭제곱)
+#define KEY_EVENT_RING_CAPACITY 4096
+
+// 링에 들어가는 항목 - 원본 키 이벤트와 세션 단계의 결과
+// (session.type이 SESSION_RECORD_END인 항목은 키 이벤트 없이 세션 종료만 나타냄,
+//  rhythm.type이 RHYTHM_EVENT_NONE이 아닌 항목은 리듬 전달 모드의 의미 이벤트)
+// coalescedCount가 0이 아니면 합치기 정책의 요약 항목 - coalescedStartNs ~ event.timestamp 사이에
+// 넘친 이벤트 coalescedCount개를 나타내며, session은 그중 마지막 세션 레코드
+struct QueuedEvent {
+    KeyEvent event;
+    KeyTransitionInfo keyState;   // 키 상태 단계의 분류 (누름/반복/뗌, 누른 시간, 수정자)
+    SessionRecord session;
+    RhythmEvent rhythm;
+    uint64_t enqueuedNs;        // 후킹 콜백 진입 시각 (지표용, EventClock)
+    uint64_t coalescedStartNs;  // 요약 항목: 첫 이벤트 시각 (EventClock)
+    uint32_t coalescedCount;    // 요약 항목: 합쳐진 이벤트 수 (일반 항목은 0)
+    uint64_t traceId;           // 지연 추적 ID (추적 중이 아니거나 세션 종료/요약 항목이면 0)
+};
+
+typedef SpscRing<QueuedEvent, KEY_EVENT_RING_CAPACITY> KeyEventRing;
+
+// 타이핑 레코드 링 크기 (2의 거듭제곱)
+// 이벤트 링과 달리 과부하 정책 전에 채우므로 이벤트 링이 넘쳐도 저널/통계는 키마다 정확함
+// (소비자가 깨어날 때마다 모두 비우므로 이벤트 링 몇 바퀴 분량이면 충분)
+#define SESSION_RECORD_RING_CAPACITY 65536
+
+typedef SpscRing<SessionRecord, SESSION_RECORD_RING_CAPACITY> SessionRecordRing;
+
+// JS로 전달하는 방식
+enum DeliveryMode {
+    DELIVERY_EVENTS,     // startListening: 이벤트당 객체 하나
+    DELIVERY_BATCHED,    // startListeningBatched: 타입 배열 배치
+    DELIVERY_SESSIONS,   // startTypingSessions: TypingMetadata 레코드
+    DELIVERY_RHYTHM      // subscribe('rhythm'): 몰아치기/멈춤/속도/연속 입력/세션 종료 이벤트만
+};
+
+// 링이 가득 찼을 때의 처리 방식 (setOverloadPolicy)
+enum OverloadPolicy {
+    OVERLOAD_DROP_NEWEST,   // 새 항목 버림 (기본)
+    OVERLOAD_DROP_OLDEST,   // 가장 오래된 항목을 밀어내고 새 항목 추가
+    OVERLOAD_BLOCK,         // 자리가 날 때까지 후킹 스레드 대기 (시간 초과 시 새 항목 버림)
+    OVERLOAD_COALESCE       // 넘친 항목을 "t0 ~ t1 사이 N개" 요약 항목 하나로 합침
+};
+
+// 대기 정책 기본값/상한 (OS 후킹 스레드를 오래 붙잡으면 OS가 후킹을 해제할 수 있음)
+#define DEFAULT_OVERLOAD_BLOCK_TIMEOUT_MS 5
+#define MAX_OVERLOAD_BLOCK_TIMEOUT_MS 1000
+
+// 요약 하나에 따로 보관하는 세션 종료 수 (넘친 세션 종료는 버림 - metrics.dropped)
+#define COALESCED_MAX_SESSION_ENDS 64
+
+// 합치기 정책에서 링에 들어가지 못한 항목의 요약 (후킹 스레드가 쌓고, 자리가 나면 링으로 옮김)
+// 세션 종료는 키 이벤트 요약의 세션 레코드로 덮어쓰면 그 세션의 종료가 사라지므로 따로 모아
+// 요약 항목보다 먼저 하나씩 전달 (세션 종료만 있으면 요약 항목 없이 세션 종료 항목만)
+struct CoalescedRun {
+    uint64_t count;          // 합쳐진 키 이벤트 수
+    uint64_t startNs;        // 첫 키 이벤트 시각 (EventClock)
+    uint64_t endNs;          // 마지막 키 이벤트 시각 (EventClock)
+    KeyEvent lastEvent;
+    SessionRecord lastSession;   // 합쳐진 키 이벤트의 마지막 세션 레코드
+    SessionRecord sessionEnds[COALESCED_MAX_SESSION_ENDS];
+    uint64_t sessionEndNs[COALESCED_MAX_SESSION_ENDS];   // 세션 종료를 알린 키 이벤트 시각
+    uint32_t sessionEndHead;     // 다음에 전달할 세션 종료
+    uint32_t sessionEndCount;
+};
+
+// 하나의 후킹에 동시에 연결할 수 있는 구독 수
+#define KEYBOARD_MAX_SUBSCRIPTIONS 16
+
+// 구독의 후킹 쪽 상태 - 후킹 스레드가 채우는 링과 필터/세션/리듬/과부하 정책
+// (소비자 스레드가 설정하고 후킹 스레드가 읽는 필드는 원자 변수, 바인딩은 이 구조체를 상속해 전달 상태를 덧붙임)
+struct CaptureSubscription {
+    // 소비자 스레드 깨우기 (후킹 스레드에서 호출 - 대기/할당 없이 반환해야 함)
+    typedef void (*WakeFunction)(CaptureSubscription* sub);
+
+    // keepRecords: 저널/통계용 타이핑 레코드 링을 둠 (한 후킹에 연결된 구독 중 하나만)
+    CaptureSubscription(bool keepRecords, WakeFunction wakeFunction);
+
+    CaptureSubscription(const CaptureSubscription&) = delete;
+    CaptureSubscription& operator=(const CaptureSubscription&) = delete;
+
+    std::thread::id jsThreadId;        // 소비자 스레드 (후킹이 같은 스레드에서 돌면 기다리지 않음)
+    WakeFunction wake;
+
+    KeyEventRing eventRing;
+    DeliveryMode deliveryMode;
+
+    // 저널/통계에 반영할 타이핑 레코드 (keepRecords일 때만, 아니면 nullptr - 후킹 스레드가 넣고 소비자가 비움)
+    std::unique_ptr<SessionRecordRing> recordRing;
+
+    // 링 과부하 정책 (소비자 스레드에서 설정, 후킹 스레드에서 읽음)
+    std::atomic<int> overloadPolicy;
+    std::atomic<uint32_t> blockTimeoutMs;
+
+    // 대기 정책 - 후킹 스레드가 기다리는 동안 소비자가 링을 비우면 깨움
+    std::mutex blockMutex;
+    std::condition_variable blockCondition;
+    std::atomic<bool> producerBlocked;
+    std::atomic<bool> releaseProducer;
+
+    // 합치기 정책 - 넘친 항목 요약 (후킹 스레드/소비자 스레드가 스핀 잠금으로 공유)
+    CoalescedRun coalescedRun;
+    std::atomic_flag coalescedLock;
+    std::atomic<bool> coalescedPending;
+
+    // 링에 넣기 전 필터 단계 (후킹 스레드에서 판별, 소비자 스레드에서 교체)
+    EventFilter eventFilter;
+
+    // 세션 단계 (후킹 스레드에서 갱신, 유휴 타이머에서 확인)
+    Sessionizer sessionizer;
+
+    // 리듬 단계 (후킹 스레드에서 갱신, 유휴 타이머에서 확인)
+    RhythmDetector rhythmDetector;
+
+    // 배치 전달에서 이 깊이가 되면 시간 예산 전에 깨움 (0이면 사용 안 함)
+    std::atomic<size_t> batchWakeThreshold;
+
+    // 캡처 경로 지표 (후킹 스레드/소비자 스레드에서 잠금 없이 갱신)
+    PipelineMetrics metrics;
+};
+
+// 후킹 쪽 파이프라인 - OS 후킹 하나에 연결된 구독들에 키 이벤트를 나눠 줌
+// Deliver(후킹 스레드): 키 상태 분류 → 실시간 상태 → 구독마다 필터 → 세션 → (레코드 링) → 리듬 → 링 → 과부하 정책
+// 애드온(바인딩)과 pipeline_bench가 같은 코드를 거치도록 N-API와 분리해 둠
+// - Attach/Detach는 소비자 스레드에서 호출하며 호출자가 직렬화 (후킹 스레드는 잠금 없이 슬롯만 읽음)
+// - PopEvent/PendingCount/ReleaseBlockedProducer는 구독의 소비자 스레드 전용
+class CaptureDispatcher {
+public:
+    explicit CaptureDispatcher(const KeyModifierTable& modifierKeys);
+
+    CaptureDispatcher(const CaptureDispatcher&) = delete;
+    CaptureDispatcher& operator=(const CaptureDispatcher&) = delete;
+
+    // 후킹 스레드: 키 이벤트 하나를 연결된 구독 모두에 전달 (대기/할당 없음 - 대기 정책 제외)
+    void Deliver(const KeyEvent& event);
+
+    // 빈 슬롯에 구독 게시 - 슬롯이 모두 찼으면 false
+    bool Attach(CaptureSubscription* sub);
+    // 슬롯을 비우고 실행 중인 후킹 콜백이 끝날 때까지 대기 - 반환 후 후킹 스레드는 이 구독에 접근하지 않음
+    void Detach(CaptureSubscription* sub);
+
+    // 소스가 최대 속도 재생 - 링이 차면 정책과 무관하게 자리를 기다림 (리스너 교체 시 설정)
+    void SetSourceBackpressure(bool enabled) { m_sourceBackpressure.store(enabled, std::memory_order_relaxed); }
+
+    LiveTypingState& GetLiveState() { return m_liveState; }
+    // 눌린 키 비트맵 (후킹 스레드가 갱신 - Reset은 후킹 스레드가 없을 때만)
+    KeyStateTracker& GetKeyState() { return m_keyState; }
+
+    // 소비자 스레드: 링에서 항목 꺼내기 (링이 비면 남은 요약 항목)
+    static bool PopEvent(CaptureSubscription* sub, QueuedEvent* entry);
+    // 아직 전달하지 않은 항목 수 (링 + 요약 항목)
+    static size_t PendingCount(CaptureSubscription* sub);
+    // 기다리는 후킹 스레드를 풀어줌 (리스닝 중지 시, 다음 시작 전에 releaseProducer를 다시 내림)
+    static void ReleaseBlockedProducer(CaptureSubscription* sub);
+
+private:
+    std::atomic<CaptureSubscription*> m_slots[KEYBOARD_MAX_SUBSCRIPTIONS];
+    std::atomic<uint64_t> m_hookSequence;      // 후킹 콜백 진입/종료마다 증가 (홀수면 실행 중)
+    std::atomic<bool> m_sourceBackpressure;
+    std::atomic<int> m_quiescing;              // 구독을 떼어내는 중 (후킹 종료를 기다리는 소비자가 링을 비우지 못함)
+    LiveTypingState m_liveState;               // 후킹 스레드가 게시하는 실시간 타이핑 상태
+    KeyStateTracker m_keyState;
+
+    void DispatchEvent(CaptureSubscription* sub, const KeyEvent& event, const KeyTransitionInfo& keyState,
+                       uint64_t hookStartNs, uint64_t traceId);
+    void PushRhythmEvents(CaptureSubscription* sub, const QueuedEvent& entry, const QueuedEvent* endEntry,
+                          bool* shouldWake);
+    bool PushEvent(CaptureSubscription* sub, const QueuedEvent& entry, bool* shouldWake);
+    bool BlockingPush(CaptureSubscription* sub, const QueuedEvent& entry, size_t* depth, bool untilSpace);
+    void WaitForHookQuiescence();
+
+    static void PushSessionRecord(CaptureSubscription* sub, const SessionRecord& record);
+    static void LockCoalescedRun(CaptureSubscription* sub);
+    static void UnlockCoalescedRun(CaptureSubscription* sub);
+    static bool FoldCoalesced(CaptureSubscription* sub, const QueuedEvent& entry);
+    static bool FlushCoalesced(CaptureSubscription* sub, bool* shouldWake);
+    static bool TakeCoalesced(CaptureSubscription* sub, QueuedEvent* entry);
+    static void MakeCoalescedEntry(CaptureSubscription* sub, QueuedEvent* entry);
+    static void AdvanceCoalesced(CaptureSubscription* sub);
+};
+
+#endif // CAPTURE_DISPATCH_H
@@ -0,0 +1,72 @@
+#ifndef CAPTURE_PIPELINE_H
+#define CAPTURE_PIPELINE_H
+
+#include <stdint.h>
+#include "keyboard-base.h"
+#include "keycode-set.h"
+#include "event-clock.h"
+
+// 단계 함수를 호출 지점에 강제로 인라인 (체인 전체가 후킹 함수 하나로 합쳐지도록)
+#if defined(_MSC_VER)
+#define CAPTURE_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define CAPTURE_INLINE inline __attribute__((always_inline))
+#else
+#define CAPTURE_INLINE inline
+#endif
+
+// 컴파일 시점에 합성하는 캡처 파이프라인 (헤더 전용)
+// - 단계는 상태 없는 정책 타입: template <typename Context> static bool Process(KeyEvent&, Context&)
+//   false를 반환하면 뒤 단계로 넘기지 않음 (Context는 리스너에 묶인 싱크 - 상태가 필요한 단계는 싱크에 둠)
+// - CaptureChain<A, B, C>::Run은 A → B → C를 재귀 인스턴스화로 펼쳐 호출 지점 하나에 인라인
+//   (가상 호출, std::function, 힙에 잡힌 클로저 없음 - 단계 조합마다 별도 후킹 함수가 생성됨)
+// - 백엔드는 싱크 타입을 템플릿 인자로 받아 자기 체인을 헤더에서 typedef로 고르고 OS 콜백에서 Run(event, m_sink)만 호출
+// - 구독별 단계(필터, 세션, 리듬, 링)는 JS가 실행 중에 바꾸므로 싱크 뒤 CaptureDispatcher(capture-dispatch.h)에 남음
+template <typename... Stages>
+struct CaptureChain;
+
+template <>
+struct CaptureChain<> {
+    template <typename Context>
+    static CAPTURE_INLINE void Run(KeyEvent&, Context&) {}
+};
+
+template <typename Stage, typename... Rest>
+struct CaptureChain<Stage, Rest...> {
+    template <typename Context>
+    static CAPTURE_INLINE void Run(KeyEvent& event, Context& context) {
+        if (Stage::Process(event, context)) {
+            CaptureChain<Rest...>::Run(event, context);
+        }
+    }
+};
+
+// 특수 키 표시 - 플랫폼 키 테이블(컴파일 시점 비트 집합)로 isSpecialKey 설정 (걸러내지는 않음)
+template <const KeyCodeSet& SpecialKeys>
+struct SpecialKeyStage {
+    template <typename Context>
+    static CAPTURE_INLINE bool Process(KeyEvent& event, Context&) {
+        event.isSpecialKey = SpecialKeys.Test(event.keyCode);
+        return true;
+    }
+};
+
+// 벽시계 소스 시각 변환 - timestamp에 epoch ns를 담아 온 소스(단조 시계를 못 쓰는 evdev 장치 등)용
+struct WallClockTimestampStage {
+    template <typename Context>
+    static CAPTURE_INLINE bool Process(KeyEvent& event, Context&) {
+        event.timestamp = EventClock::FromWallNs(static_cast<int64_t>(event.timestamp));
+        return true;
+    }
+};
+
+// 싱크 - 리스너에 묶인 싱크로 전달 (비가상 직접 호출 - 바인딩은 CaptureDispatcher, 녹화는 TraceRecordingSink)
+template <typename Sink>
+struct SinkStage {
+    static CAPTURE_INLINE bool Process(KeyEvent& event, Sink& sink) {
+        sink.Deliver(event);
+        return true;
+    }
+};
+
+#endif // CAPTURE_PIPELINE_H
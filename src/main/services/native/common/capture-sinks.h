@@ -0,0 +1,33 @@
+#ifndef CAPTURE_SINKS_H
+#define CAPTURE_SINKS_H
+
+#include "keyboard-base.h"
+#include "keyboard-trace.h"
+#include "capture-dispatch.h"
+
+// 리스너 백엔드가 이벤트를 넘기는 싱크 (capture-pipeline.h SinkStage의 Sink)
+// - CaptureDispatcher: 후킹 쪽 파이프라인 (바인딩 기본)
+// - TraceRecordingSink: 트레이스 파일에 기록한 뒤 CaptureDispatcher로 넘김 (setListenerBackend recordTo)
+
+// 녹화 싱크 - 캡처 스레드에서 기록 후 그대로 전달 (파일은 KeyboardListenerRecorder가 열고 닫음)
+class TraceRecordingSink {
+public:
+    TraceRecordingSink(KeyboardTraceWriter& writer, CaptureDispatcher& target)
+        : m_writer(writer), m_target(target) {}
+
+    void Deliver(const KeyEvent& event) {
+        m_writer.Write(event);
+        m_target.Deliver(event);
+    }
+
+private:
+    KeyboardTraceWriter& m_writer;
+    CaptureDispatcher& m_target;
+};
+
+// 백엔드 템플릿을 애드온이 쓰는 싱크마다 명시적으로 인스턴스화 (멤버 정의가 있는 .cc 끝에서 한 번)
+#define INSTANTIATE_CAPTURE_LISTENER(Listener) \
+    template class Listener<CaptureDispatcher>; \
+    template class Listener<TraceRecordingSink>
+
+#endif // CAPTURE_SINKS_H
@@ -0,0 +1,21 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// FNV-1a 32비트 시작값
+#define FNV1A_OFFSET_BASIS 2166136261u
+
+// FNV-1a 32비트 - 저널/아카이브/스냅샷 파일의 부분 기록·손상 감지용 (암호학적 용도 아님)
+// 여러 조각을 이어서 계산하려면 앞 조각의 결과를 hash로 넘김
+inline uint32_t Fnv1a(const void* data, size_t length, uint32_t hash = FNV1A_OFFSET_BASIS) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#endif // CHECKSUM_H
@@ -0,0 +1,549 @@
+#include "event-archive.h"
+#include "checksum.h"
+
+#include <iostream>
+#include <string.h>
+
+static const char kArchiveMagic[8] = { 'T', 'H', 'A', 'R', 'C', 'V', '\0', '\1' };
+static const uint32_t kBlockMagic = 0x42414854;   // "THAB" (리틀 엔디언)
+
+static uint32_t HeaderChecksum(const ArchiveBlockHeader& header) {
+    return Fnv1a(&header, offsetof(ArchiveBlockHeader, headerChecksum));
+}
+
+static int SeekFile(FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+static uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static void PutVarint(std::vector<uint8_t>* out, uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+// 범위를 벗어나거나 10바이트를 넘으면 false
+static bool GetVarint(const uint8_t** cursor, const uint8_t* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64 && *cursor < end; shift += 7) {
+        const uint8_t byte = *(*cursor)++;
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint8_t BitWidth(uint64_t value) {
+    uint8_t bits = 0;
+    while (value) {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+// LSB 우선 비트 패킹 (값마다 같은 너비, 0비트면 아무것도 쓰지 않음)
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>* out) : m_out(out), m_acc(0), m_bits(0) {}
+
+    void Put(uint64_t value, uint8_t width) {
+        if (width > 32) {
+            Put32(value & 0xFFFFFFFFu, 32);
+            Put32(value >> 32, width - 32);
+        } else {
+            Put32(value, width);
+        }
+    }
+
+    void Flush() {
+        if (m_bits > 0) {
+            m_out->push_back(static_cast<uint8_t>(m_acc));
+            m_acc = 0;
+            m_bits = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>* m_out;
+    uint64_t m_acc;
+    unsigned m_bits;
+
+    void Put32(uint64_t value, unsigned width) {
+        m_acc |= value << m_bits;
+        m_bits += width;
+        while (m_bits >= 8) {
+            m_out->push_back(static_cast<uint8_t>(m_acc));
+            m_acc >>= 8;
+            m_bits -= 8;
+        }
+    }
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, const uint8_t* end) : m_data(data), m_end(end), m_acc(0), m_bits(0) {}
+
+    uint64_t Get(uint8_t width) {
+        if (width > 32) {
+            const uint64_t low = Get32(32);
+            return low | (Get32(width - 32) << 32);
+        }
+        return Get32(width);
+    }
+
+private:
+    const uint8_t* m_data;
+    const uint8_t* m_end;
+    uint64_t m_acc;
+    unsigned m_bits;
+
+    // 끝을 넘으면 0으로 채움 (열 길이는 디코딩 전에 검증)
+    uint64_t Get32(unsigned width) {
+        while (m_bits < width) {
+            m_acc |= static_cast<uint64_t>(m_data < m_end ? *m_data++ : 0) << m_bits;
+            m_bits += 8;
+        }
+        const uint64_t value = width == 0 ? 0 : (m_acc & ((1ull << width) - 1));
+        m_acc >>= width;
+        m_bits -= width;
+        return value;
+    }
+};
+
+static size_t PackedBytes(uint64_t values, uint8_t width) {
+    return static_cast<size_t>((values * width + 7) / 8);
+}
+
+// cursor 위치부터 [start, end)와 겹치는 다음 블록 하나를 풀어 범위 안의 레코드를 out에 추가
+bool EventArchive::ScanBlocks(FILE* file, const std::vector<ArchiveBlockEntry>& blocks, std::vector<uint8_t>* buffer,
+                              uint64_t start, uint64_t end, size_t* cursor, std::vector<JournalRecord>* out) {
+    while (*cursor < blocks.size()) {
+        const ArchiveBlockEntry& entry = blocks[(*cursor)++];
+        if (entry.header.maxTimestamp < start || entry.header.minTimestamp >= end) {
+            continue;
+        }
+
+        const size_t payloadSize = static_cast<size_t>(entry.header.timestampBytes) + entry.header.sessionBytes +
+                                   entry.header.intervalBytes + entry.header.keyCountBytes;
+        buffer->resize(payloadSize);
+        if (SeekFile(file, entry.offset) != 0 ||
+            (payloadSize > 0 && fread(buffer->data(), payloadSize, 1, file) != 1)) {
+            return false;
+        }
+
+        // 블록 전체를 풀고 범위 밖 레코드만 걸러냄 (블록이 범위 안에 다 들어가면 그대로)
+        const size_t base = out->size();
+        if (!DecodeBlock(entry.header, buffer->data(), out)) {
+            out->resize(base);
+            std::cerr << "Corrupt event archive block at offset " << entry.offset << std::endl;
+            continue;
+        }
+        if (entry.header.minTimestamp < start || entry.header.maxTimestamp >= end) {
+            size_t write = base;
+            for (size_t read = base; read < out->size(); read++) {
+                const uint64_t timestamp = (*out)[read].timestamp;
+                if (timestamp >= start && timestamp < end) {
+                    (*out)[write++] = (*out)[read];
+                }
+            }
+            out->resize(write);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+EventArchive::EventArchive()
+    : m_file(nullptr),
+      m_endOffset(0),
+      m_recordCount(0),
+      m_minTimestamp(0),
+      m_maxTimestamp(0) {
+}
+
+EventArchive::~EventArchive() {
+    Close();
+}
+
+bool EventArchive::Open(const char* path) {
+    if (IsOpen()) {
+        return true;
+    }
+
+    m_path = path;
+    m_file = fopen(path, "r+b");
+    if (!m_file) {
+        m_file = fopen(path, "w+b");
+        if (!m_file) {
+            std::cerr << "Failed to open event archive: " << path << std::endl;
+            return false;
+        }
+
+        ArchiveFileHeader fileHeader;
+        memset(&fileHeader, 0, sizeof(fileHeader));
+        memcpy(fileHeader.magic, kArchiveMagic, sizeof(kArchiveMagic));
+        fileHeader.version = EVENT_ARCHIVE_VERSION;
+        if (fwrite(&fileHeader, sizeof(fileHeader), 1, m_file) != 1 || fflush(m_file) != 0) {
+            Close();
+            return false;
+        }
+    } else {
+        ArchiveFileHeader fileHeader;
+        if (fread(&fileHeader, sizeof(fileHeader), 1, m_file) != 1 ||
+            memcmp(fileHeader.magic, kArchiveMagic, sizeof(kArchiveMagic)) != 0 ||
+            fileHeader.version > EVENT_ARCHIVE_VERSION) {
+            std::cerr << "Invalid event archive: " << path << std::endl;
+            Close();
+            return false;
+        }
+    }
+
+    // 블록 헤더만 따라가며 인덱스 구성 - 헤더 체크섬이나 본문 길이가 맞지 않는 곳을 끝으로 봄
+    uint64_t offset = sizeof(ArchiveFileHeader);
+    ArchiveBlockHeader header;
+    while (SeekFile(m_file, offset) == 0 && fread(&header, sizeof(header), 1, m_file) == 1) {
+        if (header.magic != kBlockMagic || header.headerChecksum != HeaderChecksum(header)) {
+            break;
+        }
+
+        const uint64_t payloadSize = static_cast<uint64_t>(header.timestampBytes) + header.sessionBytes +
+                                     header.intervalBytes + header.keyCountBytes;
+        m_buffer.resize(static_cast<size_t>(payloadSize));
+        if (payloadSize > 0 && fread(m_buffer.data(), static_cast<size_t>(payloadSize), 1, m_file) != 1) {
+            break;
+        }
+        if (Fnv1a(m_buffer.data(), m_buffer.size()) != header.payloadChecksum) {
+            break;
+        }
+
+        AddToIndex(offset + sizeof(header), header);
+        offset += sizeof(header) + payloadSize;
+    }
+    m_endOffset = offset;
+
+    return true;
+}
+
+void EventArchive::Close() {
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    m_path.clear();
+    m_blocks.clear();
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_endOffset = 0;
+    m_recordCount = 0;
+    m_minTimestamp = 0;
+    m_maxTimestamp = 0;
+}
+
+int EventArchive::Append(const JournalRecord* records, size_t count) {
+    if (!IsOpen()) {
+        return -1;
+    }
+
+    int blocks = 0;
+    for (size_t offset = 0; offset < count; offset += EVENT_ARCHIVE_BLOCK_MAX_RECORDS) {
+        const size_t blockCount = count - offset < EVENT_ARCHIVE_BLOCK_MAX_RECORDS
+            ? count - offset
+            : EVENT_ARCHIVE_BLOCK_MAX_RECORDS;
+        if (!AppendBlock(records + offset, blockCount)) {
+            return -1;
+        }
+        blocks++;
+    }
+
+    return blocks;
+}
+
+bool EventArchive::Scan(uint64_t start, uint64_t end, size_t* cursor, std::vector<JournalRecord>* out) {
+    return IsOpen() && ScanBlocks(m_file, m_blocks, &m_buffer, start, end, cursor, out);
+}
+
+void EventArchive::Snapshot(EventArchiveReader* reader) const {
+    reader->Close();
+    reader->m_path = m_path;
+    reader->m_blocks = m_blocks;
+}
+
+bool EventArchive::AppendBlock(const JournalRecord* records, size_t count) {
+    ArchiveBlockHeader header;
+    EncodeBlock(records, count, &header, &m_buffer);
+
+    // 마지막 유효 블록 뒤에 기록 (이전에 중단된 부분 기록이 있으면 덮어씀)
+    if (SeekFile(m_file, m_endOffset) != 0 ||
+        fwrite(&header, sizeof(header), 1, m_file) != 1 ||
+        (!m_buffer.empty() && fwrite(m_buffer.data(), m_buffer.size(), 1, m_file) != 1) ||
+        fflush(m_file) != 0) {
+        std::cerr << "Failed to write event archive block" << std::endl;
+        return false;
+    }
+
+    AddToIndex(m_endOffset + sizeof(header), header);
+    m_endOffset += sizeof(header) + m_buffer.size();
+    return true;
+}
+
+void EventArchive::AddToIndex(uint64_t offset, const ArchiveBlockHeader& header) {
+    ArchiveBlockEntry entry;
+    entry.offset = offset;
+    entry.header = header;
+    m_blocks.push_back(entry);
+
+    if (m_recordCount == 0 || header.minTimestamp < m_minTimestamp) {
+        m_minTimestamp = header.minTimestamp;
+    }
+    if (m_recordCount == 0 || header.maxTimestamp > m_maxTimestamp) {
+        m_maxTimestamp = header.maxTimestamp;
+    }
+    m_recordCount += header.count;
+}
+
+void EventArchive::EncodeBlock(const JournalRecord* records, size_t count,
+                               ArchiveBlockHeader* header, std::vector<uint8_t>* payload) {
+    memset(header, 0, sizeof(*header));
+    header->magic = kBlockMagic;
+    header->count = static_cast<uint32_t>(count);
+    payload->clear();
+    if (count == 0) {
+        header->headerChecksum = HeaderChecksum(*header);
+        header->payloadChecksum = Fnv1a(nullptr, 0);
+        return;
+    }
+
+    // 인덱스 (최소/최대) 와 잔차 너비 계산
+    header->minTimestamp = records[0].timestamp;
+    header->maxTimestamp = records[0].timestamp;
+    header->minInterval = records[0].interval;
+    header->maxInterval = records[0].interval;
+    uint64_t maxIntervalResidual = 0;
+    uint64_t maxKeyCountResidual = 0;
+    for (size_t i = 0; i < count; i++) {
+        const JournalRecord& record = records[i];
+        if (record.timestamp < header->minTimestamp) header->minTimestamp = record.timestamp;
+        if (record.timestamp > header->maxTimestamp) header->maxTimestamp = record.timestamp;
+        if (record.interval < header->minInterval) header->minInterval = record.interval;
+        if (record.interval > header->maxInterval) header->maxInterval = record.interval;
+
+        const bool sameRun = i > 0 && record.sessionStart == records[i - 1].sessionStart &&
+                             record.sessionSeq == records[i - 1].sessionSeq;
+        if (!sameRun) {
+            header->sessionRuns++;
+        }
+
+        // 같은 세션 안에서는 간격 ≈ 타임스탬프 차이 (ms → us), 키 수 = 직전 + 1
+        const int64_t predicted = sameRun
+            ? (static_cast<int64_t>(record.timestamp) - static_cast<int64_t>(records[i - 1].timestamp)) * 1000
+            : 0;
+        const uint64_t intervalResidual = ZigZag(static_cast<int64_t>(record.interval) - predicted);
+        if (intervalResidual > maxIntervalResidual) maxIntervalResidual = intervalResidual;
+        if (sameRun) {
+            const uint64_t keyCountResidual = ZigZag(static_cast<int64_t>(record.keyCount) -
+                                                     static_cast<int64_t>(records[i - 1].keyCount) - 1);
+            if (keyCountResidual > maxKeyCountResidual) maxKeyCountResidual = keyCountResidual;
+        }
+    }
+    header->intervalBits = BitWidth(maxIntervalResidual);
+    header->keyCountBits = BitWidth(maxKeyCountResidual);
+
+    // 타임스탬프 - 첫 값, 첫 델타, 이후 델타의 델타
+    size_t mark = payload->size();
+    int64_t previousDelta = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i == 0) {
+            PutVarint(payload, records[0].timestamp);
+            continue;
+        }
+        const int64_t delta = static_cast<int64_t>(records[i].timestamp) - static_cast<int64_t>(records[i - 1].timestamp);
+        PutVarint(payload, ZigZag(i == 1 ? delta : delta - previousDelta));
+        previousDelta = delta;
+    }
+    header->timestampBytes = static_cast<uint32_t>(payload->size() - mark);
+
+    // 세션 구간 - 시작 시각 델타, 일련번호, 길이, 첫 키 수
+    mark = payload->size();
+    uint64_t previousStart = 0;
+    for (size_t i = 0; i < count;) {
+        size_t runEnd = i + 1;
+        while (runEnd < count && records[runEnd].sessionStart == records[i].sessionStart &&
+               records[runEnd].sessionSeq == records[i].sessionSeq) {
+            runEnd++;
+        }
+        PutVarint(payload, ZigZag(static_cast<int64_t>(records[i].sessionStart) - static_cast<int64_t>(previousStart)));
+        PutVarint(payload, records[i].sessionSeq);
+        PutVarint(payload, runEnd - i);
+        PutVarint(payload, records[i].keyCount);
+        previousStart = records[i].sessionStart;
+        i = runEnd;
+    }
+    header->sessionBytes = static_cast<uint32_t>(payload->size() - mark);
+
+    // 간격 잔차
+    mark = payload->size();
+    {
+        BitWriter writer(payload);
+        for (size_t i = 0; i < count; i++) {
+            const bool sameRun = i > 0 && records[i].sessionStart == records[i - 1].sessionStart &&
+                                 records[i].sessionSeq == records[i - 1].sessionSeq;
+            const int64_t predicted = sameRun
+                ? (static_cast<int64_t>(records[i].timestamp) - static_cast<int64_t>(records[i - 1].timestamp)) * 1000
+                : 0;
+            writer.Put(ZigZag(static_cast<int64_t>(records[i].interval) - predicted), header->intervalBits);
+        }
+        writer.Flush();
+    }
+    header->intervalBytes = static_cast<uint32_t>(payload->size() - mark);
+
+    // 키 수 잔차 (구간 첫 레코드 제외)
+    mark = payload->size();
+    {
+        BitWriter writer(payload);
+        for (size_t i = 1; i < count; i++) {
+            const bool sameRun = records[i].sessionStart == records[i - 1].sessionStart &&
+                                 records[i].sessionSeq == records[i - 1].sessionSeq;
+            if (sameRun) {
+                writer.Put(ZigZag(static_cast<int64_t>(records[i].keyCount) -
+                                  static_cast<int64_t>(records[i - 1].keyCount) - 1), header->keyCountBits);
+            }
+        }
+        writer.Flush();
+    }
+    header->keyCountBytes = static_cast<uint32_t>(payload->size() - mark);
+
+    header->payloadChecksum = Fnv1a(payload->data(), payload->size());
+    header->headerChecksum = HeaderChecksum(*header);
+}
+
+bool EventArchive::DecodeBlock(const ArchiveBlockHeader& header, const uint8_t* payload,
+                               std::vector<JournalRecord>* out) {
+    const size_t count = header.count;
+    const size_t base = out->size();
+    out->resize(base + count);
+    JournalRecord* records = out->data() + base;
+
+    const uint8_t* timestamps = payload;
+    const uint8_t* sessions = timestamps + header.timestampBytes;
+    const uint8_t* intervals = sessions + header.sessionBytes;
+    const uint8_t* keyCounts = intervals + header.intervalBytes;
+    const uint8_t* payloadEnd = keyCounts + header.keyCountBytes;
+
+    if (header.intervalBits > 64 || header.keyCountBits > 64 ||
+        header.intervalBytes < PackedBytes(count, header.intervalBits) ||
+        header.keyCountBytes < PackedBytes(count > header.sessionRuns ? count - header.sessionRuns : 0,
+                                           header.keyCountBits)) {
+        return false;
+    }
+
+    // 타임스탬프
+    const uint8_t* cursor = timestamps;
+    uint64_t value = 0;
+    int64_t delta = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!GetVarint(&cursor, sessions, &value)) {
+            return false;
+        }
+        if (i == 0) {
+            records[0].timestamp = value;
+            continue;
+        }
+        delta = i == 1 ? UnZigZag(value) : delta + UnZigZag(value);
+        records[i].timestamp = records[i - 1].timestamp + static_cast<uint64_t>(delta);
+    }
+
+    // 세션 구간 + 키 수 (구간 첫 레코드는 구간에 기록된 값, 이후는 직전 + 1 + 잔차)
+    cursor = sessions;
+    BitReader keyCountReader(keyCounts, payloadEnd);
+    uint64_t sessionStart = 0;
+    size_t index = 0;
+    for (uint32_t run = 0; run < header.sessionRuns; run++) {
+        uint64_t startDelta, sessionSeq, length, firstKeyCount;
+        if (!GetVarint(&cursor, intervals, &startDelta) ||
+            !GetVarint(&cursor, intervals, &sessionSeq) ||
+            !GetVarint(&cursor, intervals, &length) ||
+            !GetVarint(&cursor, intervals, &firstKeyCount) ||
+            length == 0 || length > count - index) {
+            return false;
+        }
+        sessionStart += static_cast<uint64_t>(UnZigZag(startDelta));
+        for (size_t i = index; i < index + length; i++) {
+            records[i].sessionStart = sessionStart;
+            records[i].sessionSeq = static_cast<uint32_t>(sessionSeq);
+            records[i].keyCount = i == index
+                ? static_cast<uint32_t>(firstKeyCount)
+                : static_cast<uint32_t>(records[i - 1].keyCount + 1 + UnZigZag(keyCountReader.Get(header.keyCountBits)));
+            records[i].checksum = 0;
+        }
+        index += length;
+    }
+    if (index != count) {
+        return false;
+    }
+
+    // 간격
+    BitReader intervalReader(intervals, keyCounts);
+    for (size_t i = 0; i < count; i++) {
+        const bool sameRun = i > 0 && records[i].sessionStart == records[i - 1].sessionStart &&
+                             records[i].sessionSeq == records[i - 1].sessionSeq;
+        const int64_t predicted = sameRun
+            ? (static_cast<int64_t>(records[i].timestamp) - static_cast<int64_t>(records[i - 1].timestamp)) * 1000
+            : 0;
+        records[i].interval = static_cast<uint32_t>(predicted + UnZigZag(intervalReader.Get(header.intervalBits)));
+    }
+
+    return true;
+}
+
+EventArchiveReader::EventArchiveReader()
+    : m_file(nullptr) {
+}
+
+EventArchiveReader::~EventArchiveReader() {
+    Close();
+}
+
+bool EventArchiveReader::Open() {
+    if (m_file) {
+        return true;
+    }
+    if (m_path.empty()) {
+        return false;
+    }
+
+    m_file = fopen(m_path.c_str(), "rb");
+    if (!m_file) {
+        std::cerr << "Failed to open event archive for reading: " << m_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void EventArchiveReader::Close() {
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool EventArchiveReader::Scan(uint64_t start, uint64_t end, size_t* cursor, std::vector<JournalRecord>* out) {
+    return m_file && EventArchive::ScanBlocks(m_file, m_blocks, &m_buffer, start, end, cursor, out);
+}
@@ -0,0 +1,139 @@
+#ifndef EVENT_ARCHIVE_H
+#define EVENT_ARCHIVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "event-journal.h"
+
+// 아카이브 파일 형식 버전
+#define EVENT_ARCHIVE_VERSION 1
+
+// 블록당 최대 레코드 수 (하루치가 이보다 많으면 여러 블록으로 나눔)
+#define EVENT_ARCHIVE_BLOCK_MAX_RECORDS 65536
+
+// 파일 헤더 (16바이트, 파일 시작 위치)
+struct ArchiveFileHeader {
+    char magic[8];            // "THARCV\0\1"
+    uint32_t version;
+    uint32_t reserved;
+};
+
+// 블록 헤더 (64바이트) - 뒤에 열 데이터가 timestamps, sessions, intervals, keyCounts 순서로 이어짐
+// 열기 시 헤더만 읽어 최소/최대 인덱스를 만들고, 범위 조회는 겹치는 블록의 본문만 읽음
+struct ArchiveBlockHeader {
+    uint32_t magic;           // "THAB"
+    uint32_t count;           // 레코드 수
+    uint64_t minTimestamp;    // epoch ms
+    uint64_t maxTimestamp;
+    uint32_t minInterval;     // us
+    uint32_t maxInterval;
+    uint32_t sessionRuns;     // 같은 세션이 이어지는 구간 수
+    uint32_t timestampBytes;  // 델타의 델타 (zigzag varint)
+    uint32_t sessionBytes;    // 세션 구간 (시작 시각 델타, 일련번호, 길이, 첫 키 수 - varint)
+    uint32_t intervalBytes;   // 타임스탬프 차이로 예측한 간격의 잔차 (zigzag, intervalBits 비트씩 패킹)
+    uint32_t keyCountBytes;   // 구간 내 키 수 증가분의 잔차 (zigzag, keyCountBits 비트씩 패킹)
+    uint8_t intervalBits;
+    uint8_t keyCountBits;
+    uint8_t reserved[2];
+    uint32_t payloadChecksum;
+    uint32_t headerChecksum;
+};
+
+// 블록 인덱스 항목 (블록 위치와 헤더)
+struct ArchiveBlockEntry {
+    uint64_t offset;          // 본문 시작 위치 (헤더 바로 뒤)
+    ArchiveBlockHeader header;
+};
+
+class EventArchiveReader;
+
+// 지난 타이핑 이벤트의 압축 열 블록 아카이브 (추가 전용 단일 파일)
+// - 타임스탬프: 델타의 델타 varint (일정한 리듬이면 1바이트 이하)
+// - 간격: 같은 세션 안에서는 타임스탬프 차이로 예측하고 잔차만 비트 패킹 (ms 정밀도 입력이면 0비트)
+// - 세션 ID: 구간 길이 부호화, 구간 안의 키 수는 1씩 증가한다고 보고 잔차만 비트 패킹
+// 쓰는 도중 프로세스가 죽으면 체크섬이 맞지 않는 마지막 블록만 무시되고 다음 추가 때 덮어씀
+// 스레드 안전하지 않음 - 한 스레드(JS 스레드)에서만 호출해야 함
+class EventArchive {
+public:
+    EventArchive();
+    ~EventArchive();
+
+    EventArchive(const EventArchive&) = delete;
+    EventArchive& operator=(const EventArchive&) = delete;
+
+    // 아카이브 파일 열기 (없으면 생성) - 블록 헤더를 읽어 인덱스 구성
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    // 레코드 추가 (interval은 us) - 최대 블록 크기로 나눠 기록하고 기록한 블록 수 반환 (실패 시 -1)
+    int Append(const JournalRecord* records, size_t count);
+
+    // cursor 위치부터 [start, end)와 겹치는 다음 블록 하나를 풀어 범위 안의 레코드를 out에 추가
+    // cursor는 다음에 볼 블록 위치로 갱신되며, 더 이상 겹치는 블록이 없으면 false
+    bool Scan(uint64_t start, uint64_t end, size_t* cursor, std::vector<JournalRecord>* out);
+
+    // 다른 스레드에서 읽기 위한 읽기 전용 사본 (지금까지의 블록 인덱스만 포함)
+    // 블록은 추가만 되므로 사본을 만든 뒤의 추가와 무관하게 읽을 수 있음
+    void Snapshot(EventArchiveReader* reader) const;
+
+    size_t GetBlockCount() const { return m_blocks.size(); }
+    uint64_t GetRecordCount() const { return m_recordCount; }
+    uint64_t GetByteSize() const { return m_endOffset; }
+    uint64_t GetMinTimestamp() const { return m_minTimestamp; }
+    uint64_t GetMaxTimestamp() const { return m_maxTimestamp; }
+
+private:
+    std::string m_path;
+    FILE* m_file;
+    uint64_t m_endOffset;     // 마지막 유효 블록의 끝 (다음 블록을 쓸 위치)
+    uint64_t m_recordCount;
+    uint64_t m_minTimestamp;
+    uint64_t m_maxTimestamp;
+    std::vector<ArchiveBlockEntry> m_blocks;
+    std::vector<uint8_t> m_buffer;
+
+    bool AppendBlock(const JournalRecord* records, size_t count);
+    void AddToIndex(uint64_t offset, const ArchiveBlockHeader& header);
+
+    static void EncodeBlock(const JournalRecord* records, size_t count,
+                            ArchiveBlockHeader* header, std::vector<uint8_t>* payload);
+    static bool DecodeBlock(const ArchiveBlockHeader& header, const uint8_t* payload,
+                            std::vector<JournalRecord>* out);
+    static bool ScanBlocks(FILE* file, const std::vector<ArchiveBlockEntry>& blocks, std::vector<uint8_t>* buffer,
+                           uint64_t start, uint64_t end, size_t* cursor, std::vector<JournalRecord>* out);
+
+    friend class EventArchiveReader;
+};
+
+// 아카이브 읽기 전용 사본 - 자체 파일 핸들로 읽으므로 작업 스레드에서 사용 가능
+// (한 사본은 한 스레드에서만 사용)
+class EventArchiveReader {
+public:
+    EventArchiveReader();
+    ~EventArchiveReader();
+
+    EventArchiveReader(const EventArchiveReader&) = delete;
+    EventArchiveReader& operator=(const EventArchiveReader&) = delete;
+
+    bool Open();
+    void Close();
+
+    // EventArchive::Scan과 같음
+    bool Scan(uint64_t start, uint64_t end, size_t* cursor, std::vector<JournalRecord>* out);
+
+    bool IsEmpty() const { return m_blocks.empty(); }
+
+private:
+    std::string m_path;
+    FILE* m_file;
+    std::vector<ArchiveBlockEntry> m_blocks;
+    std::vector<uint8_t> m_buffer;
+
+    friend class EventArchive;
+};
+
+#endif // EVENT_ARCHIVE_H
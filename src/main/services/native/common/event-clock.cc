@@ -0,0 +1,41 @@
+#include "event-clock.h"
+#include <chrono>
+
+std::atomic<int64_t> EventClock::s_wallOffsetNs(EventClock::MeasureWallOffsetNs(nullptr));
+
+uint64_t EventClock::NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 벽시계와 단조 시계를 연달아 읽어 차이 계산
+int64_t EventClock::MeasureWallOffsetNs(uint64_t* monotonicNs) {
+    const uint64_t monotonic = NowNs();
+    const int64_t wall = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    if (monotonicNs) {
+        *monotonicNs = monotonic;
+    }
+    return wall - static_cast<int64_t>(monotonic);
+}
+
+uint64_t EventClock::RefreshWallOffset() {
+    uint64_t monotonicNs = 0;
+    s_wallOffsetNs.store(MeasureWallOffsetNs(&monotonicNs), std::memory_order_relaxed);
+    return monotonicNs;
+}
+
+double EventClock::ToWallMs(uint64_t monotonicNs) {
+    const int64_t wallNs = static_cast<int64_t>(monotonicNs) + GetWallOffsetNs();
+    return static_cast<double>(wallNs) / 1e6;
+}
+
+uint64_t EventClock::ToWallMsFloor(uint64_t monotonicNs) {
+    const int64_t wallNs = static_cast<int64_t>(monotonicNs) + GetWallOffsetNs();
+    return wallNs > 0 ? static_cast<uint64_t>(wallNs / 1000000) : 0;
+}
+
+uint64_t EventClock::FromWallNs(int64_t wallNs) {
+    const int64_t monotonicNs = wallNs - GetWallOffsetNs();
+    return monotonicNs > 0 ? static_cast<uint64_t>(monotonicNs) : 0;
+}
@@ -0,0 +1,34 @@
+#ifndef EVENT_CLOCK_H
+#define EVENT_CLOCK_H
+
+#include <stdint.h>
+#include <atomic>
+
+// 이벤트 시계
+// - 모든 네이티브 타임스탬프는 단조 시계 나노초 (steady_clock - Linux: CLOCK_MONOTONIC,
+//   macOS: mach 시간)로 다루므로 NTP 보정으로 간격이 음수가 되지 않음
+// - JS로 넘길 때만 벽시계 기준점(벽시계 - 단조 시계 차이) 하나로 epoch 밀리초로 변환
+// - 기준점은 원자 변수 하나라 어느 스레드에서나 읽을 수 있고, JS 스레드가 깨어날 때 갱신
+//   (절전 등으로 두 시계가 벌어져도 다음 전달부터 반영)
+class EventClock {
+public:
+    // 단조 시계 현재 시각 (ns) - 이벤트 소스가 시각을 주지 않을 때만 사용
+    static uint64_t NowNs();
+
+    // 벽시계 기준점 갱신 후 읽은 단조 시계 시각 반환
+    static uint64_t RefreshWallOffset();
+    static int64_t GetWallOffsetNs() { return s_wallOffsetNs.load(std::memory_order_relaxed); }
+
+    // 단조 ns → epoch 밀리초 (소수점 이하는 마이크로초 이하 정밀도)
+    static double ToWallMs(uint64_t monotonicNs);
+    // 단조 ns → epoch 밀리초 (정수, 세션 ID/DB용)
+    static uint64_t ToWallMsFloor(uint64_t monotonicNs);
+    // epoch ns → 단조 ns (벽시계 시각만 주는 소스용)
+    static uint64_t FromWallNs(int64_t wallNs);
+
+private:
+    static std::atomic<int64_t> s_wallOffsetNs;
+    static int64_t MeasureWallOffsetNs(uint64_t* monotonicNs);
+};
+
+#endif // EVENT_CLOCK_H
@@ -0,0 +1,31 @@
+#include "event-filter.h"
+
+EventFilter::EventFilter() : m_active(nullptr) {
+    Configure(DefaultConfig());
+}
+
+// 기본값 - 특수 키와 자동 반복을 걸러냄
+EventFilterConfig EventFilter::DefaultConfig() {
+    EventFilterConfig config;
+    config.keyUp = true;
+    config.special = false;
+    config.repeats = false;
+    return config;
+}
+
+void EventFilter::Configure(const EventFilterConfig& config) {
+    std::unique_ptr<Tables> tables(new Tables());
+    tables->config = config;
+    tables->dropKeyUp = !config.keyUp;
+    tables->dropSpecial = !config.special;
+    tables->dropRepeats = !config.repeats;
+
+    m_active.store(tables.get(), std::memory_order_release);
+    m_tables.push_back(std::move(tables));
+}
+
+void EventFilter::Reclaim() {
+    if (m_tables.size() > 1) {
+        m_tables.erase(m_tables.begin(), m_tables.end() - 1);
+    }
+}
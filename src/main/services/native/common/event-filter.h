@@ -0,0 +1,65 @@
+#ifndef EVENT_FILTER_H
+#define EVENT_FILTER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "keyboard-base.h"
+#include "keycode-set.h"
+#include "key-state.h"
+
+// 이벤트 필터 설정 (true = 전달)
+struct EventFilterConfig {
+    bool keyUp;              // 키 뗌 이벤트 전달 (기본 true)
+    bool special;            // 특수 키 전달 (기본 false - 프라이버시 보호)
+    bool repeats;            // 자동 반복 누름 전달 (기본 false - 뗌 이벤트의 누른 시간/반복 수로 요약)
+    KeyCodeSet customMask;   // 추가로 걸러낼 키 코드
+};
+
+// 링에 넣기 전에 후킹 스레드에서 실행되는 필터 단계
+// - Accept: 후킹 스레드 전용 (원자 포인터 읽기 + 비트 검사, 대기/할당 없음)
+// - Configure: JS 스레드 전용 - 새 설정을 만들어 포인터를 원자적으로 교체
+//   (교체된 설정은 후킹 스레드가 아직 읽고 있을 수 있으므로 Reclaim 전까지 보관)
+class EventFilter {
+public:
+    EventFilter();
+
+    EventFilter(const EventFilter&) = delete;
+    EventFilter& operator=(const EventFilter&) = delete;
+
+    static EventFilterConfig DefaultConfig();
+
+    void Configure(const EventFilterConfig& config);
+    EventFilterConfig GetConfig() const { return m_active.load(std::memory_order_acquire)->config; }
+
+    bool Accept(const KeyEvent& event, const KeyTransitionInfo& keyState) const {
+        const Tables* tables = m_active.load(std::memory_order_acquire);
+        if (!event.isKeyDown && tables->dropKeyUp) {
+            return false;
+        }
+        if (keyState.transition == KEY_TRANSITION_REPEAT && tables->dropRepeats) {
+            return false;
+        }
+        if (event.isSpecialKey && tables->dropSpecial) {
+            return false;
+        }
+        return !tables->config.customMask.Test(event.keyCode);
+    }
+
+    // 교체된 설정 해제 - 후킹 스레드가 없을 때(리스너 중지 후)만 호출
+    void Reclaim();
+
+private:
+    struct Tables {
+        EventFilterConfig config;
+        bool dropKeyUp;
+        bool dropSpecial;
+        bool dropRepeats;
+    };
+
+    std::atomic<const Tables*> m_active;
+    std::vector<std::unique_ptr<Tables>> m_tables;   // 마지막 항목이 현재 설정
+};
+
+#endif // EVENT_FILTER_H
@@ -0,0 +1,341 @@
+#include "event-journal.h"
+#include "checksum.h"
+#include "event-clock.h"
+
+#include <atomic>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static const char kJournalMagic[8] = { 'T', 'H', 'J', 'R', 'N', 'L', '\0', '\1' };
+static const char kSegmentPrefix[] = "segment-";
+static const char kSegmentSuffix[] = ".thj";
+
+EventJournal::EventJournal()
+    : m_capacity(EVENT_JOURNAL_DEFAULT_CAPACITY),
+      m_nextSegmentId(1),
+      m_fd(-1),
+      m_map(nullptr),
+      m_mapSize(0),
+      m_activeId(0),
+      m_writeIndex(0) {
+}
+
+EventJournal::~EventJournal() {
+    Close();
+}
+
+#ifdef _WIN32
+
+// Windows는 아직 지원하지 않음 (메모리 매핑 구현 필요)
+bool EventJournal::Open(const char* directory, uint32_t segmentCapacity) { return false; }
+void EventJournal::Close() {}
+bool EventJournal::Append(const SessionRecord& record) { return false; }
+void EventJournal::ReadRange(uint64_t start, uint64_t end, std::vector<JournalRecord>* out) const {}
+bool EventJournal::ReadSegment(uint64_t segmentId, std::vector<JournalRecord>* out) const { return false; }
+void EventJournal::ListSealedSegments(std::vector<uint64_t>* out) const {}
+bool EventJournal::ReleaseSegment(uint64_t segmentId) { return false; }
+
+#else
+
+bool EventJournal::Open(const char* directory, uint32_t segmentCapacity) {
+    if (IsOpen()) {
+        Close();
+    }
+
+    m_directory = directory;
+    m_capacity = segmentCapacity > 0 ? segmentCapacity : EVENT_JOURNAL_DEFAULT_CAPACITY;
+
+    if (mkdir(directory, 0700) != 0 && errno != EEXIST) {
+        std::cerr << "Failed to create journal directory: " << directory << std::endl;
+        return false;
+    }
+
+    // 이전 실행에서 남은 세그먼트 다음 번호부터 시작
+    std::vector<uint64_t> ids;
+    ListSegmentIds(&ids);
+    m_nextSegmentId = ids.empty() ? 1 : ids.back() + 1;
+
+    return OpenNewSegment();
+}
+
+void EventJournal::Close() {
+    SealActiveSegment();
+}
+
+// 레코드 추가 - 필드를 먼저 쓰고 체크섬을 마지막에 기록
+bool EventJournal::Append(const SessionRecord& record) {
+    if (!m_map) {
+        return false;
+    }
+
+    if (m_writeIndex >= m_capacity) {
+        SealActiveSegment();
+        if (!OpenNewSegment()) {
+            return false;
+        }
+    }
+
+    JournalRecord* slot = reinterpret_cast<JournalRecord*>(m_map + sizeof(JournalSegmentHeader)) + m_writeIndex;
+
+    // 세션 레코드의 단조 시계 ns를 DB와 같은 epoch ms / 간격 us로 변환
+    const uint64_t intervalUs = record.interval / 1000;
+
+    JournalRecord entry;
+    entry.timestamp = EventClock::ToWallMsFloor(record.timestamp);
+    entry.sessionStart = record.sessionStart;
+    entry.sessionSeq = record.sessionSeq;
+    entry.keyCount = record.keyCount;
+    entry.interval = intervalUs > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(intervalUs);
+    entry.checksum = RecordChecksum(&entry, m_activeId, m_writeIndex);
+
+    memcpy(slot, &entry, offsetof(JournalRecord, checksum));
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->checksum = entry.checksum;
+
+    m_writeIndex++;
+    return true;
+}
+
+void EventJournal::ReadRange(uint64_t start, uint64_t end, std::vector<JournalRecord>* out) const {
+    std::vector<uint64_t> ids;
+    ListSegmentIds(&ids);
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (m_map && ids[i] == m_activeId) {
+            const JournalSegmentHeader* header = reinterpret_cast<const JournalSegmentHeader*>(m_map);
+            const JournalRecord* records = reinterpret_cast<const JournalRecord*>(m_map + sizeof(JournalSegmentHeader));
+            ScanRecords(header, records, m_writeIndex, out, start, end);
+            continue;
+        }
+
+        std::vector<JournalRecord> segment;
+        if (ReadSegmentFile(ids[i], &segment)) {
+            for (size_t j = 0; j < segment.size(); j++) {
+                if (segment[j].timestamp >= start && segment[j].timestamp < end) {
+                    out->push_back(segment[j]);
+                }
+            }
+        }
+    }
+}
+
+bool EventJournal::ReadSegment(uint64_t segmentId, std::vector<JournalRecord>* out) const {
+    if (m_map && segmentId == m_activeId) {
+        const JournalSegmentHeader* header = reinterpret_cast<const JournalSegmentHeader*>(m_map);
+        const JournalRecord* records = reinterpret_cast<const JournalRecord*>(m_map + sizeof(JournalSegmentHeader));
+        ScanRecords(header, records, m_writeIndex, out, 0, UINT64_MAX);
+        return true;
+    }
+    return ReadSegmentFile(segmentId, out);
+}
+
+void EventJournal::ListSealedSegments(std::vector<uint64_t>* out) const {
+    std::vector<uint64_t> ids;
+    ListSegmentIds(&ids);
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (!m_map || ids[i] != m_activeId) {
+            out->push_back(ids[i]);
+        }
+    }
+}
+
+bool EventJournal::ReleaseSegment(uint64_t segmentId) {
+    if (m_map && segmentId == m_activeId) {
+        return false; // 활성 세그먼트는 해제 불가
+    }
+    return unlink(SegmentPath(segmentId).c_str()) == 0;
+}
+
+// 새 세그먼트 파일 생성 및 매핑
+bool EventJournal::OpenNewSegment() {
+    const uint64_t segmentId = m_nextSegmentId++;
+    const std::string path = SegmentPath(segmentId);
+    const size_t mapSize = sizeof(JournalSegmentHeader) + static_cast<size_t>(m_capacity) * sizeof(JournalRecord);
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        std::cerr << "Failed to create journal segment: " << path << std::endl;
+        return false;
+    }
+
+    // 파일 크기를 미리 확보 (0으로 채워진 레코드는 체크섬 불일치로 무효 처리됨)
+    if (ftruncate(fd, static_cast<off_t>(mapSize)) != 0) {
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+
+    void* map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+
+    JournalSegmentHeader* header = static_cast<JournalSegmentHeader*>(map);
+    memset(header, 0, sizeof(JournalSegmentHeader));
+    memcpy(header->magic, kJournalMagic, sizeof(kJournalMagic));
+    header->version = EVENT_JOURNAL_VERSION;
+    header->recordSize = sizeof(JournalRecord);
+    header->segmentId = segmentId;
+    header->capacity = m_capacity;
+    header->createdAt = EventClock::ToWallMsFloor(EventClock::NowNs());
+    header->headerChecksum = HeaderChecksum(header);
+
+    m_fd = fd;
+    m_map = static_cast<uint8_t*>(map);
+    m_mapSize = mapSize;
+    m_activeId = segmentId;
+    m_writeIndex = 0;
+    return true;
+}
+
+// 활성 세그먼트 봉인 (레코드 수 기록 후 매핑 해제)
+void EventJournal::SealActiveSegment() {
+    if (!m_map) {
+        return;
+    }
+
+    JournalSegmentHeader* header = reinterpret_cast<JournalSegmentHeader*>(m_map);
+    header->sealedCount = m_writeIndex;
+    header->flags |= EVENT_JOURNAL_SEGMENT_SEALED;
+    header->headerChecksum = HeaderChecksum(header);
+
+    msync(m_map, m_mapSize, MS_ASYNC);
+    munmap(m_map, m_mapSize);
+    close(m_fd);
+
+    // 빈 세그먼트는 남길 필요 없음
+    if (m_writeIndex == 0) {
+        unlink(SegmentPath(m_activeId).c_str());
+    }
+
+    m_map = nullptr;
+    m_mapSize = 0;
+    m_fd = -1;
+    m_activeId = 0;
+    m_writeIndex = 0;
+}
+
+void EventJournal::ListSegmentIds(std::vector<uint64_t>* out) const {
+    DIR* dir = opendir(m_directory.c_str());
+    if (!dir) {
+        return;
+    }
+
+    const size_t prefixLength = sizeof(kSegmentPrefix) - 1;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, kSegmentPrefix, prefixLength) != 0 ||
+            !strstr(entry->d_name, kSegmentSuffix)) {
+            continue;
+        }
+        unsigned long long id = 0;
+        if (sscanf(entry->d_name + prefixLength, "%llu", &id) == 1 && id > 0) {
+            out->push_back(static_cast<uint64_t>(id));
+        }
+    }
+    closedir(dir);
+
+    // 삽입 정렬 (세그먼트 수는 적음)
+    for (size_t i = 1; i < out->size(); i++) {
+        uint64_t value = (*out)[i];
+        size_t j = i;
+        while (j > 0 && (*out)[j - 1] > value) {
+            (*out)[j] = (*out)[j - 1];
+            j--;
+        }
+        (*out)[j] = value;
+    }
+}
+
+std::string EventJournal::SegmentPath(uint64_t segmentId) const {
+    char name[64];
+    snprintf(name, sizeof(name), "%s%016llu%s", kSegmentPrefix,
+             static_cast<unsigned long long>(segmentId), kSegmentSuffix);
+    return m_directory + "/" + name;
+}
+
+// 봉인된(또는 비정상 종료로 남은) 세그먼트 파일 읽기
+bool EventJournal::ReadSegmentFile(uint64_t segmentId, std::vector<JournalRecord>* out) const {
+    const std::string path = SegmentPath(segmentId);
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(JournalSegmentHeader)) {
+        close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    const JournalSegmentHeader* header = static_cast<const JournalSegmentHeader*>(map);
+    bool valid = IsValidHeader(header) &&
+                 size >= sizeof(JournalSegmentHeader) + header->capacity * sizeof(JournalRecord);
+    if (valid) {
+        const JournalRecord* records = reinterpret_cast<const JournalRecord*>(
+            static_cast<const uint8_t*>(map) + sizeof(JournalSegmentHeader));
+        const uint64_t available = (header->flags & EVENT_JOURNAL_SEGMENT_SEALED)
+            ? header->sealedCount
+            : header->capacity;
+        ScanRecords(header, records, available, out, 0, UINT64_MAX);
+    }
+
+    munmap(map, size);
+    return valid;
+}
+
+#endif // _WIN32
+
+// 체크섬이 맞는 레코드까지 순서대로 읽음 (첫 무효 레코드 = 비정상 종료 시점의 기록 위치)
+void EventJournal::ScanRecords(const JournalSegmentHeader* header, const JournalRecord* records,
+                               uint64_t available, std::vector<JournalRecord>* out,
+                               uint64_t start, uint64_t end) {
+    for (uint64_t i = 0; i < available; i++) {
+        const JournalRecord& record = records[i];
+        if (record.checksum != RecordChecksum(&record, header->segmentId, i)) {
+            break;
+        }
+        if (record.timestamp >= start && record.timestamp < end) {
+            out->push_back(record);
+        }
+    }
+}
+
+bool EventJournal::IsValidHeader(const JournalSegmentHeader* header) {
+    return memcmp(header->magic, kJournalMagic, sizeof(kJournalMagic)) == 0 &&
+           header->version == EVENT_JOURNAL_VERSION &&
+           header->recordSize == sizeof(JournalRecord) &&
+           header->headerChecksum == HeaderChecksum(header);
+}
+
+uint32_t EventJournal::HeaderChecksum(const JournalSegmentHeader* header) {
+    return Fnv1a(header, offsetof(JournalSegmentHeader, headerChecksum));
+}
+
+// 레코드 체크섬 - 세그먼트 ID와 위치를 섞어 이전 내용이나 0으로 채워진 영역이 유효하게 보이지 않도록 함
+uint32_t EventJournal::RecordChecksum(const JournalRecord* record, uint64_t segmentId, uint64_t index) {
+    uint32_t hash = Fnv1a(&segmentId, sizeof(segmentId));
+    hash = Fnv1a(&index, sizeof(index), hash);
+    hash = Fnv1a(record, offsetof(JournalRecord, checksum), hash);
+    return hash == 0 ? 1 : hash;
+}
@@ -0,0 +1,100 @@
+#ifndef EVENT_JOURNAL_H
+#define EVENT_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "sessionizer.h"
+
+// 세그먼트 파일 형식 버전 (다른 버전의 세그먼트는 읽지 않음)
+#define EVENT_JOURNAL_VERSION 2
+
+// 세그먼트당 기본 레코드 수 (32바이트 × 65536 = 2MB)
+#define EVENT_JOURNAL_DEFAULT_CAPACITY 65536
+
+// 세그먼트 헤더 플래그
+#define EVENT_JOURNAL_SEGMENT_SEALED 0x01
+
+// 세그먼트 헤더 (64바이트, 파일 시작 위치)
+struct JournalSegmentHeader {
+    char magic[8];            // "THJRNL\0\1"
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t segmentId;
+    uint64_t capacity;        // 레코드 수
+    uint64_t createdAt;
+    uint64_t sealedCount;     // 봉인 시 기록된 레코드 수 (미봉인이면 체크섬으로 끝을 찾음)
+    uint32_t flags;
+    uint32_t headerChecksum;
+    uint8_t reserved[8];
+};
+
+// 고정 크기 타이핑 이벤트 레코드 (32바이트)
+// checksum은 마지막에 기록되므로 쓰는 도중 프로세스가 죽으면 해당 레코드만 무효가 됨
+struct JournalRecord {
+    uint64_t timestamp;       // epoch ms
+    uint64_t sessionStart;    // epoch ms
+    uint32_t sessionSeq;
+    uint32_t keyCount;
+    uint32_t interval;        // us (약 71분에서 포화)
+    uint32_t checksum;
+};
+
+// 메모리 매핑된 추가 전용 이벤트 저널
+// 키 입력마다 SQLite에 쓰는 대신 레코드를 세그먼트에 복사하고,
+// 봉인된 세그먼트는 JS 쪽 압축기가 한 트랜잭션으로 typing_events에 반영한 뒤 해제
+// 스레드 안전하지 않음 - 쓰기와 읽기 모두 한 스레드(JS 스레드)에서 호출해야 함
+class EventJournal {
+public:
+    EventJournal();
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    // 저널 디렉토리 열기 - 기존 세그먼트는 모두 봉인된 것으로 취급하고 새 세그먼트 시작
+    bool Open(const char* directory, uint32_t segmentCapacity);
+    // 활성 세그먼트 봉인 후 닫기
+    void Close();
+    bool IsOpen() const { return m_map != nullptr; }
+
+    // 레코드 추가 (memcpy 수준, 세그먼트가 가득 차면 봉인 후 교체)
+    bool Append(const SessionRecord& record);
+
+    // [start, end) 시각 범위의 레코드 조회 (봉인 + 활성 세그먼트)
+    void ReadRange(uint64_t start, uint64_t end, std::vector<JournalRecord>* out) const;
+    // 세그먼트 하나의 유효한 레코드 전체 조회
+    bool ReadSegment(uint64_t segmentId, std::vector<JournalRecord>* out) const;
+    // 압축 대기 중인 봉인 세그먼트 ID 목록 (오름차순)
+    void ListSealedSegments(std::vector<uint64_t>* out) const;
+    // 반영이 끝난 봉인 세그먼트 삭제
+    bool ReleaseSegment(uint64_t segmentId);
+
+private:
+    std::string m_directory;
+    uint32_t m_capacity;
+    uint64_t m_nextSegmentId;
+
+    // 활성 세그먼트
+    int m_fd;
+    uint8_t* m_map;
+    size_t m_mapSize;
+    uint64_t m_activeId;
+    uint64_t m_writeIndex;
+
+    bool OpenNewSegment();
+    void SealActiveSegment();
+    void ListSegmentIds(std::vector<uint64_t>* out) const;
+    std::string SegmentPath(uint64_t segmentId) const;
+    bool ReadSegmentFile(uint64_t segmentId, std::vector<JournalRecord>* out) const;
+
+    static void ScanRecords(const JournalSegmentHeader* header, const JournalRecord* records,
+                            uint64_t available, std::vector<JournalRecord>* out,
+                            uint64_t start, uint64_t end);
+    static bool IsValidHeader(const JournalSegmentHeader* header);
+    static uint32_t HeaderChecksum(const JournalSegmentHeader* header);
+    static uint32_t RecordChecksum(const JournalRecord* record, uint64_t segmentId, uint64_t index);
+};
+
+#endif // EVENT_JOURNAL_H
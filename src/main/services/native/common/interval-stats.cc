@@ -0,0 +1,152 @@
+#include "interval-stats.h"
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// 최상위 비트 위치 (value > 0)
+static inline uint32_t HighestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+IntervalStats::IntervalStats() {
+    Reset();
+}
+
+void IntervalStats::Reset() {
+    m_count = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_min = UINT64_MAX;
+    m_max = 0;
+    memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+// 값 추가 - O(1), 할당 없음
+void IntervalStats::Add(uint64_t value) {
+    m_count++;
+
+    // Welford 온라인 평균/분산
+    const double delta = static_cast<double>(value) - m_mean;
+    m_mean += delta / static_cast<double>(m_count);
+    m_m2 += delta * (static_cast<double>(value) - m_mean);
+
+    if (value < m_min) {
+        m_min = value;
+    }
+    if (value > m_max) {
+        m_max = value;
+    }
+
+    m_buckets[BucketIndex(value)]++;
+}
+
+// 다른 통계 병합 (Chan 병렬 분산 공식)
+void IntervalStats::Merge(const IntervalStats& other) {
+    if (other.m_count == 0) {
+        return;
+    }
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+
+    const double countA = static_cast<double>(m_count);
+    const double countB = static_cast<double>(other.m_count);
+    const double total = countA + countB;
+    const double delta = other.m_mean - m_mean;
+
+    m_mean += delta * countB / total;
+    m_m2 += other.m_m2 + delta * delta * countA * countB / total;
+    m_count += other.m_count;
+
+    if (other.m_min < m_min) {
+        m_min = other.m_min;
+    }
+    if (other.m_max > m_max) {
+        m_max = other.m_max;
+    }
+
+    for (uint32_t i = 0; i < INTERVAL_STATS_BUCKET_COUNT; i++) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+}
+
+// 표본 분산
+double IntervalStats::GetVariance() const {
+    return m_count > 1 ? m_m2 / static_cast<double>(m_count - 1) : 0.0;
+}
+
+uint64_t IntervalStats::GetPercentile(double quantile) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    if (quantile <= 0.0) {
+        return m_min;
+    }
+    if (quantile >= 1.0) {
+        return m_max;
+    }
+
+    // 순위 (1부터) - 누적 개수가 순위에 도달하는 버킷 탐색
+    uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(m_count) + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t cumulative = 0;
+    for (uint32_t i = 0; i < INTERVAL_STATS_BUCKET_COUNT; i++) {
+        cumulative += m_buckets[i];
+        if (cumulative >= rank) {
+            uint64_t value = BucketLowerBound(i) + BucketWidth(i) / 2;
+            if (value < m_min) {
+                value = m_min;
+            }
+            if (value > m_max) {
+                value = m_max;
+            }
+            return value;
+        }
+    }
+
+    return m_max;
+}
+
+// 값 → 버킷 인덱스
+// 하위 2 * SUB_BUCKET_COUNT 값은 선형, 그 위는 shift만큼 해상도를 낮춘 로그 구간
+// index = shift * SUB_BUCKET_COUNT + (value >> shift)
+uint32_t IntervalStats::BucketIndex(uint64_t value) {
+    const uint64_t maxValue = (1ull << INTERVAL_STATS_MAX_VALUE_BITS) - 1;
+    if (value > maxValue) {
+        value = maxValue;
+    }
+    if (value < 2 * INTERVAL_STATS_SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(value);
+    }
+
+    const uint32_t msb = HighestBit(value);
+    const uint32_t shift = msb - INTERVAL_STATS_SUB_BUCKET_BITS;
+    return shift * INTERVAL_STATS_SUB_BUCKET_COUNT + static_cast<uint32_t>(value >> shift);
+}
+
+uint64_t IntervalStats::BucketLowerBound(uint32_t index) {
+    if (index < 2 * INTERVAL_STATS_SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const uint32_t shift = index / INTERVAL_STATS_SUB_BUCKET_COUNT - 1;
+    return static_cast<uint64_t>(index - shift * INTERVAL_STATS_SUB_BUCKET_COUNT) << shift;
+}
+
+uint64_t IntervalStats::BucketWidth(uint32_t index) {
+    if (index < 2 * INTERVAL_STATS_SUB_BUCKET_COUNT) {
+        return 1;
+    }
+    return 1ull << (index / INTERVAL_STATS_SUB_BUCKET_COUNT - 1);
+}
@@ -0,0 +1,48 @@
+#ifndef INTERVAL_STATS_H
+#define INTERVAL_STATS_H
+
+#include <stdint.h>
+
+// HDR 스타일 로그 버킷 히스토그램 설정
+// - 2^INTERVAL_STATS_SUB_BUCKET_BITS 개의 하위 버킷으로 2의 거듭제곱 구간을 나눔 (상대 오차 약 3%)
+// - 0 ~ 2^INTERVAL_STATS_MAX_VALUE_BITS 범위를 고정 메모리로 표현 (초과 값은 최상위 버킷에 기록)
+#define INTERVAL_STATS_SUB_BUCKET_BITS 5
+#define INTERVAL_STATS_SUB_BUCKET_COUNT (1u << INTERVAL_STATS_SUB_BUCKET_BITS)
+#define INTERVAL_STATS_MAX_VALUE_BITS 40
+#define INTERVAL_STATS_BUCKET_COUNT \
+    ((INTERVAL_STATS_MAX_VALUE_BITS - INTERVAL_STATS_SUB_BUCKET_BITS + 1) * INTERVAL_STATS_SUB_BUCKET_COUNT)
+
+// 키 입력 간격 스트리밍 통계 (고정 메모리)
+// 개수/평균/분산(Welford), 최소/최대, 분위수(로그 버킷 히스토그램)를 유지하며 병합 가능
+// 스레드 안전하지 않음 - 한 스레드에서만 갱신하거나 외부에서 동기화해야 함
+class IntervalStats {
+public:
+    IntervalStats();
+
+    void Add(uint64_t value);
+    void Merge(const IntervalStats& other);
+    void Reset();
+
+    uint64_t GetCount() const { return m_count; }
+    double GetMean() const { return m_mean; }
+    double GetVariance() const;
+    uint64_t GetMin() const { return m_count > 0 ? m_min : 0; }
+    uint64_t GetMax() const { return m_max; }
+
+    // 분위수 (0.0 ~ 1.0) - 해당 버킷의 중간값을 최소/최대 범위로 제한하여 반환
+    uint64_t GetPercentile(double quantile) const;
+
+private:
+    uint64_t m_count;
+    double m_mean;
+    double m_m2;    // 평균과의 편차 제곱합
+    uint64_t m_min;
+    uint64_t m_max;
+    uint32_t m_buckets[INTERVAL_STATS_BUCKET_COUNT];
+
+    static uint32_t BucketIndex(uint64_t value);
+    static uint64_t BucketLowerBound(uint32_t index);
+    static uint64_t BucketWidth(uint32_t index);
+};
+
+#endif // INTERVAL_STATS_H
@@ -0,0 +1,90 @@
+#include "key-state.h"
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static inline uint32_t PopCount(uint64_t value) {
+#ifdef _MSC_VER
+    return static_cast<uint32_t>(__popcnt64(value));
+#else
+    return static_cast<uint32_t>(__builtin_popcountll(value));
+#endif
+}
+
+KeyStateTracker::KeyStateTracker(const KeyModifierTable& modifierKeys)
+    : m_modifierKeys(modifierKeys), m_modifiers(0) {
+    Reset();
+}
+
+KeyTransitionInfo KeyStateTracker::Update(const KeyEvent& event) {
+    KeyTransitionInfo info;
+    info.heldNs = 0;
+    info.repeatCount = 0;
+    info.transition = event.isKeyDown ? KEY_TRANSITION_PRESS : KEY_TRANSITION_RELEASE;
+
+    const uint32_t keyCode = event.keyCode;
+    if (keyCode >= KeyCodeSet::kMaxKeyCodes) {
+        info.modifiers = m_modifiers.load(std::memory_order_relaxed);
+        return info;
+    }
+
+    const bool wasDown = m_down.Test(keyCode);
+    // 소스 시각이 뒤로 간 경우 (장치 간 순서 뒤바뀜 등) 누른 시간은 0으로 취급
+    const uint64_t heldNs = (wasDown && event.timestamp > m_pressedAt[keyCode]) ? event.timestamp - m_pressedAt[keyCode] : 0;
+
+    if (event.isKeyDown) {
+        if (wasDown) {
+            info.transition = KEY_TRANSITION_REPEAT;
+            info.heldNs = heldNs;
+            info.repeatCount = ++m_repeats[keyCode];
+        } else {
+            m_down.Set(keyCode);
+            m_pressedAt[keyCode] = event.timestamp;
+            m_repeats[keyCode] = 0;
+        }
+    } else if (wasDown) {
+        info.heldNs = heldNs;
+        info.repeatCount = m_repeats[keyCode];
+        m_down.Clear(keyCode);
+    }
+
+    // 반복은 비트맵이 바뀌지 않으므로 게시하지 않음
+    if (info.transition != KEY_TRANSITION_REPEAT) {
+        m_published[keyCode >> 6].store(m_down.Word(keyCode >> 6), std::memory_order_relaxed);
+        m_modifiers.store(ComputeModifiers(), std::memory_order_relaxed);
+    }
+    info.modifiers = m_modifiers.load(std::memory_order_relaxed);
+    return info;
+}
+
+bool KeyStateTracker::IsDown(uint32_t keyCode) const {
+    return keyCode < KeyCodeSet::kMaxKeyCodes &&
+           ((m_published[keyCode >> 6].load(std::memory_order_relaxed) >> (keyCode & 63)) & 1) != 0;
+}
+
+uint32_t KeyStateTracker::DownCount() const {
+    uint32_t count = 0;
+    for (size_t i = 0; i < 4; i++) {
+        count += PopCount(m_published[i].load(std::memory_order_relaxed));
+    }
+    return count;
+}
+
+void KeyStateTracker::Reset() {
+    m_down = KeyCodeSet();
+    for (size_t i = 0; i < 4; i++) {
+        m_published[i].store(0, std::memory_order_relaxed);
+    }
+    m_modifiers.store(0, std::memory_order_relaxed);
+    memset(m_pressedAt, 0, sizeof(m_pressedAt));
+    memset(m_repeats, 0, sizeof(m_repeats));
+}
+
+uint8_t KeyStateTracker::ComputeModifiers() const {
+    return (m_down.Intersects(m_modifierKeys.shift) ? KEY_MODIFIER_SHIFT : 0) |
+           (m_down.Intersects(m_modifierKeys.control) ? KEY_MODIFIER_CONTROL : 0) |
+           (m_down.Intersects(m_modifierKeys.alt) ? KEY_MODIFIER_ALT : 0) |
+           (m_down.Intersects(m_modifierKeys.meta) ? KEY_MODIFIER_META : 0);
+}
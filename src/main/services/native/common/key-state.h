@@ -0,0 +1,61 @@
+#ifndef KEY_STATE_H
+#define KEY_STATE_H
+
+#include <stdint.h>
+#include <atomic>
+#include "keyboard-base.h"
+#include "keycode-set.h"
+
+// 키 이벤트의 상태 전이
+enum KeyTransition : uint8_t {
+    KEY_TRANSITION_PRESS = 0,     // 처음 누름
+    KEY_TRANSITION_REPEAT = 1,    // 누르고 있는 동안의 자동 반복 (뗌 없이 다시 들어온 누름)
+    KEY_TRANSITION_RELEASE = 2    // 뗌
+};
+
+// 이벤트 직후 눌려 있는 수정자 비트
+#define KEY_MODIFIER_SHIFT   0x01
+#define KEY_MODIFIER_CONTROL 0x02
+#define KEY_MODIFIER_ALT     0x04
+#define KEY_MODIFIER_META    0x08
+
+// 키 이벤트 하나의 분류 결과
+struct KeyTransitionInfo {
+    uint64_t heldNs;        // 반복/뗌: 처음 누른 뒤 지난 시간 (누름, 누름을 보지 못한 뗌은 0)
+    uint32_t repeatCount;   // 반복: 이번까지의 반복 수, 뗌: 누르고 있는 동안의 전체 반복 수
+    uint8_t transition;     // KeyTransition
+    uint8_t modifiers;      // KEY_MODIFIER_*
+};
+
+// 눌린 키 비트맵 (키 코드 0 ~ 255) - 이벤트를 누름/반복/뗌으로 분류하고 수정자 상태를 유지
+// - Update: 후킹 스레드 전용 (비트 검사/갱신 몇 번, 대기/할당 없음)
+// - IsDown/Modifiers/DownCount: 어느 스레드에서나 원자 변수로 읽음
+// - 범위 밖 키 코드(일부 evdev 키)는 상태 없이 누름/뗌으로만 분류
+// - 뗌을 놓치면 (리스너 중지 중 뗌, 포커스 잡기 등) 다음 누름까지 반복으로 보이므로 리스너를 시작할 때 Reset
+class KeyStateTracker {
+public:
+    explicit KeyStateTracker(const KeyModifierTable& modifierKeys);
+
+    KeyTransitionInfo Update(const KeyEvent& event);
+
+    bool IsDown(uint32_t keyCode) const;
+    uint8_t Modifiers() const { return m_modifiers.load(std::memory_order_relaxed); }
+    uint32_t DownCount() const;
+
+    // 모든 키를 뗀 상태로 (후킹 스레드가 없을 때만)
+    void Reset();
+
+private:
+    const KeyModifierTable m_modifierKeys;
+
+    KeyCodeSet m_down;                        // 후킹 스레드 사본
+    std::atomic<uint64_t> m_published[4];     // 다른 스레드가 읽는 비트맵
+    std::atomic<uint8_t> m_modifiers;
+
+    uint64_t m_pressedAt[KeyCodeSet::kMaxKeyCodes];   // 처음 누른 시각 (단조 시계 ns)
+    uint32_t m_repeats[KeyCodeSet::kMaxKeyCodes];
+
+    uint8_t ComputeModifiers() const;
+};
+
+#endif // KEY_STATE_H
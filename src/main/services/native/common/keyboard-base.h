@@ -2,14 +2,15 @@
 #define KEYBOARD_BASE_H
 
 #include <stdint.h>
-#include <functional>
+#include "event-clock.h"
 
 // 크로스 플랫폼 키 이벤트 구조체
 struct KeyEvent {
-    uint64_t timestamp;
+    uint64_t timestamp;     // 단조 시계 ns (가능하면 이벤트 소스의 시각, EventClock 참고)
     uint32_t keyCode;
     bool isKeyDown;
     bool isSpecialKey;
+    uint16_t appId;         // 키를 받은 앱 (AppRegistry ID, 포커스 추적을 지원하지 않으면 0) - 구조체 패딩 자리
 };
 
 // 권한 정보 구조체
@@ -19,30 +20,21 @@ struct PermissionInfo {
     const char* permissionMessage;
 };
 
-// 키보드 리스너 콜백 타입
-typedef std::function<void(const KeyEvent&)> KeyboardCallback;
-
-// 플랫폼별 구현을 위한 추상 인터페이스
+// 플랫폼별 구현을 위한 추상 인터페이스 (리스너 수명 관리용 - 이벤트마다 거치지 않음)
+// 키 이벤트는 각 백엔드가 생성 시 받은 싱크로 전달 (백엔드는 싱크 타입을 템플릿 인자로 받고,
+// 캡처 단계 끝의 SinkStage가 Sink::Deliver를 직접 호출 - capture-pipeline.h)
 class KeyboardListenerBase {
 public:
     virtual ~KeyboardListenerBase() = default;
     
     // 순수 가상 함수 - 각 플랫폼에서 구현
-    virtual bool StartListening(KeyboardCallback callback) = 0;
+    virtual bool StartListening() = 0;
     virtual bool StopListening() = 0;
     virtual PermissionInfo CheckPermissions() = 0;
     virtual bool IsListening() const = 0;
     
 protected:
-    KeyboardCallback m_callback;
     bool m_isListening = false;
-    
-    // 공통 유틸리티 함수
-    uint64_t GetCurrentTimestamp();
-    virtual bool IsSpecialKey(uint32_t keyCode);
 };
 
-// 플랫폼별 팩토리 함수
-KeyboardListenerBase* CreatePlatformListener();
-
 #endif // KEYBOARD_BASE_H
\ No newline at end of file
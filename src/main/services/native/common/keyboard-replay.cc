@@ -0,0 +1,390 @@
+#include "keyboard-replay.h"
+#include "app-registry.h"
+#include <iostream>
+#include <random>
+#include <math.h>
+#include <string>
+#include <vector>
+
+// 합성 스트림에 쓰는 X 키 코드 (문자 키만 - 특수 키 필터에 걸리지 않도록)
+static const uint32_t kSyntheticKeyCodes[] = {
+    24, 25, 26, 27, 28, 29, 30, 31, 32, 33,   // q w e r t y u i o p
+    38, 39, 40, 41, 42, 43, 44, 45, 46,       // a s d f g h j k l
+    52, 53, 54, 55, 56, 57, 58                // z x c v b n m
+};
+
+// 합성 타이핑 키 순서 생성기 - 같은 모델/시드면 같은 순서 (길이 측정과 실제 생성이 공유)
+class SyntheticKeyStream {
+public:
+    explicit SyntheticKeyStream(const SyntheticTypingModel& model)
+        : m_rng(model.seed),
+          m_intervalDist(log(model.intervalMedianMs > 0 ? model.intervalMedianMs : 1.0),
+                         model.intervalSigma > 0 ? model.intervalSigma : 1e-9),
+          m_pauseDist(model.pauseMeanMs > 0 ? 1.0 / model.pauseMeanMs : 1.0),
+          m_keyDist(0, sizeof(kSyntheticKeyCodes) / sizeof(kSyntheticKeyCodes[0]) - 1),
+          m_unitDist(0.0, 1.0),
+          // 버스트가 이번 키에서 끝날 확률 (평균 길이의 기하 분포)
+          m_burstEndProbability(model.burstMeanKeys > 0 ? 1.0 / model.burstMeanKeys : 0.0),
+          m_elapsedMs(0),
+          m_emitted(0) {}
+
+    // 다음 키 - 가상 시각을 옮기고, 버스트 사이 멈춤 뒤면 pausedBefore 설정
+    uint32_t Next(bool* pausedBefore) {
+        *pausedBefore = false;
+        if (m_emitted > 0) {
+            m_elapsedMs += m_intervalDist(m_rng);
+            if (m_burstEndProbability > 0 && m_unitDist(m_rng) < m_burstEndProbability) {
+                m_elapsedMs += m_pauseDist(m_rng);
+                *pausedBefore = true;
+            }
+        }
+        m_emitted++;
+        return kSyntheticKeyCodes[m_keyDist(m_rng)];
+    }
+
+    double GetElapsedMs() const { return m_elapsedMs; }
+
+private:
+    std::mt19937_64 m_rng;
+    std::lognormal_distribution<double> m_intervalDist;
+    std::exponential_distribution<double> m_pauseDist;
+    std::uniform_int_distribution<size_t> m_keyDist;
+    std::uniform_real_distribution<double> m_unitDist;
+    double m_burstEndProbability;
+    double m_elapsedMs;         // 가상 시간 (ms)
+    uint64_t m_emitted;
+};
+
+SyntheticTypingModel DefaultSyntheticTypingModel() {
+    SyntheticTypingModel model;
+    model.keyCount = 0;
+    model.seed = 1;
+    model.intervalMedianMs = SYNTHETIC_DEFAULT_INTERVAL_MEDIAN_MS;
+    model.intervalSigma = SYNTHETIC_DEFAULT_INTERVAL_SIGMA;
+    model.burstMeanKeys = SYNTHETIC_DEFAULT_BURST_MEAN_KEYS;
+    model.pauseMeanMs = SYNTHETIC_DEFAULT_PAUSE_MEAN_MS;
+    model.holdMs = SYNTHETIC_DEFAULT_HOLD_MS;
+    model.appCount = 0;
+    return model;
+}
+
+ReplayOptions DefaultReplayOptions() {
+    ReplayOptions options;
+    options.speed = 1.0;
+    options.rebaseTimestamps = true;
+    options.loop = false;
+    return options;
+}
+
+template <typename Sink>
+KeyboardListenerReplay<Sink>::KeyboardListenerReplay(Sink& sink, const std::string& tracePath, const ReplayOptions& options)
+    : m_sink(sink), m_isSynthetic(false), m_tracePath(tracePath), m_model(DefaultSyntheticTypingModel()), m_options(options),
+      m_spanNs(0), m_shouldStop(false) {
+}
+
+template <typename Sink>
+KeyboardListenerReplay<Sink>::KeyboardListenerReplay(Sink& sink, const SyntheticTypingModel& model, const ReplayOptions& options)
+    : m_sink(sink), m_isSynthetic(true), m_model(model), m_options(options), m_spanNs(0), m_shouldStop(false) {
+}
+
+template <typename Sink>
+KeyboardListenerReplay<Sink>::~KeyboardListenerReplay() {
+    StopListening();
+}
+
+template <typename Sink>
+bool KeyboardListenerReplay<Sink>::StartListening() {
+    if (m_isListening) {
+        return true; // 이미 실행 중
+    }
+
+    if (!m_isSynthetic && !m_reader.Open(m_tracePath.c_str())) {
+        std::cerr << "Failed to open keyboard trace: " << m_tracePath << std::endl;
+        return false;
+    }
+
+    // 가속 재생은 시간축을 스트림 길이만큼 앞당김 (녹화 시각을 유지하는 재생은 이미 과거 시각)
+    m_spanNs = 0;
+    if (IsAcceleratedReplay(m_options) && (m_isSynthetic || m_options.rebaseTimestamps)) {
+        m_spanNs = m_isSynthetic ? MeasureSyntheticSpan() : MeasureTraceSpan();
+        if (m_spanNs > EventClock::NowNs()) {
+            std::cerr << "Accelerated replay is longer than system uptime; use speed 1 or a shorter stream" << std::endl;
+            m_reader.Close();
+            return false;
+        }
+    }
+
+    m_shouldStop = false;
+    if (m_isSynthetic) {
+        m_replayThread = std::thread(&KeyboardListenerReplay::SyntheticThreadFunc, this);
+    } else {
+        m_replayThread = std::thread(&KeyboardListenerReplay::ReplayTraceThreadFunc, this);
+    }
+
+    m_isListening = true;
+    std::cout << (m_isSynthetic ? "Synthetic" : "Replay") << " keyboard listener started successfully" << std::endl;
+
+    return true;
+}
+
+template <typename Sink>
+bool KeyboardListenerReplay<Sink>::StopListening() {
+    if (!m_isListening) {
+        return true; // 이미 중지됨
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_shouldStop = true;
+    }
+    m_stopCondition.notify_all();
+    if (m_replayThread.joinable()) {
+        m_replayThread.join();
+    }
+
+    m_reader.Close();
+    m_isListening = false;
+
+    std::cout << (m_isSynthetic ? "Synthetic" : "Replay") << " keyboard listener stopped" << std::endl;
+    return true;
+}
+
+template <typename Sink>
+PermissionInfo KeyboardListenerReplay<Sink>::CheckPermissions() {
+    PermissionInfo info;
+    info.requiresElevation = false;
+
+    if (m_isSynthetic) {
+        info.hasPermission = true;
+        info.permissionMessage = "Synthetic typing source requires no permissions";
+        return info;
+    }
+
+    KeyboardTraceReader probe;
+    info.hasPermission = probe.Open(m_tracePath.c_str());
+    info.permissionMessage = info.hasPermission
+        ? "Keyboard trace file is readable"
+        : "Keyboard trace file is missing, unreadable or not a valid trace";
+    return info;
+}
+
+template <typename Sink>
+bool KeyboardListenerReplay<Sink>::IsListening() const {
+    return m_isListening;
+}
+
+// 가상 시간 elapsedMs가 재생 속도 기준으로 도달할 때까지 대기
+template <typename Sink>
+bool KeyboardListenerReplay<Sink>::WaitUntil(std::chrono::steady_clock::time_point start, double elapsedMs) {
+    if (m_options.speed <= 0) {
+        return !m_shouldStop.load(std::memory_order_relaxed);
+    }
+
+    const auto target = start + std::chrono::microseconds(static_cast<int64_t>(elapsedMs * 1000.0 / m_options.speed));
+    const auto now = std::chrono::steady_clock::now();
+    if (target - now < std::chrono::microseconds(static_cast<int64_t>(REPLAY_MIN_SLEEP_MS * 1000.0))) {
+        return !m_shouldStop.load(std::memory_order_relaxed);
+    }
+
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    m_stopCondition.wait_until(lock, target, [this] { return m_shouldStop.load(); });
+    return !m_shouldStop.load();
+}
+
+// 재생 시간축 기준
+// 가상 시각 e인 이벤트는 실제로 start + e / speed 이후에 전달되므로, 기준을 span * (1 - 1 / speed)만큼
+// 앞당기면 (최대 속도는 span) 어느 이벤트도 전달 시점보다 앞선 시각을 갖지 않음
+template <typename Sink>
+uint64_t KeyboardListenerReplay<Sink>::TimelineBase(uint64_t startNs, uint64_t spanNs) const {
+    if (spanNs == 0 || !IsAcceleratedReplay(m_options)) {
+        return startNs;
+    }
+    const double leadNs = m_options.speed > 0 ? static_cast<double>(spanNs) * (1.0 - 1.0 / m_options.speed)
+                                              : static_cast<double>(spanNs);
+    const uint64_t lead = static_cast<uint64_t>(leadNs);
+    return lead < startNs ? startNs - lead : 0;
+}
+
+template <typename Sink>
+uint64_t KeyboardListenerReplay<Sink>::MeasureTraceSpan() {
+    KeyEvent event;
+    uint64_t first = 0;
+    uint64_t last = 0;
+    bool haveFirst = false;
+    while (m_reader.Read(&event)) {
+        if (!haveFirst) {
+            first = event.timestamp;
+            haveFirst = true;
+        }
+        if (event.timestamp > last) {
+            last = event.timestamp;
+        }
+    }
+    m_reader.Rewind();
+    return haveFirst && last > first ? last - first : 0;
+}
+
+template <typename Sink>
+uint64_t KeyboardListenerReplay<Sink>::MeasureSyntheticSpan() const {
+    SyntheticKeyStream stream(m_model);
+    bool pausedBefore = false;
+    for (uint64_t i = 0; i < m_model.keyCount; i++) {
+        stream.Next(&pausedBefore);
+    }
+    const double holdMs = m_model.holdMs > 0 ? m_model.holdMs : 0;
+    return static_cast<uint64_t>((stream.GetElapsedMs() + holdMs) * 1e6);
+}
+
+// 트레이스 재생 스레드
+template <typename Sink>
+void KeyboardListenerReplay<Sink>::ReplayTraceThreadFunc() {
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t baseTimestamp = TimelineBase(EventClock::NowNs(), m_spanNs);
+    uint64_t firstTimestamp = 0;
+    bool haveFirst = false;
+    uint64_t loopOffset = 0;     // 반복 재생 시 누적 가상 시간 (ns)
+    uint64_t lastElapsed = 0;
+
+    KeyEvent event;
+    for (;;) {
+        if (!m_reader.Read(&event)) {
+            // 끝까지 재생 - 반복이면 마지막 이벤트 이후부터 이어서 재생
+            if (!m_options.loop || !haveFirst || !m_reader.Rewind()) {
+                break;
+            }
+            loopOffset = lastElapsed + 1000000;
+            haveFirst = false;
+            continue;
+        }
+
+        if (!haveFirst) {
+            firstTimestamp = event.timestamp;
+            haveFirst = true;
+        }
+
+        const uint64_t elapsed = loopOffset + (event.timestamp >= firstTimestamp ? event.timestamp - firstTimestamp : 0);
+        lastElapsed = elapsed;
+        if (!WaitUntil(start, static_cast<double>(elapsed) / 1e6)) {
+            return;
+        }
+
+        // 기준을 옮기지 않으면 녹화 당시 벽시계 시각이 유지되도록 현재 단조 시계로 변환
+        if (m_options.rebaseTimestamps) {
+            event.timestamp = baseTimestamp + elapsed;
+        } else {
+            event.timestamp = EventClock::FromWallNs(
+                static_cast<int64_t>(firstTimestamp + elapsed) + m_reader.GetWallOffsetNs());
+        }
+        CaptureStages::Run(event, m_sink);
+    }
+
+    std::cout << "Keyboard trace replay finished" << std::endl;
+}
+
+// 합성 타이핑 스트림 생성 스레드
+template <typename Sink>
+void KeyboardListenerReplay<Sink>::SyntheticThreadFunc() {
+    SyntheticKeyStream stream(m_model);
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t baseTimestamp = TimelineBase(EventClock::NowNs(), m_spanNs);
+    uint64_t emitted = 0;
+
+    // 합성 앱 (Linux 창 추적과 같은 표에 등록 - X 서버 없이 앱별 경로 구동)
+    std::vector<uint16_t> appIds;
+    for (uint32_t i = 0; i < m_model.appCount && i < APP_REGISTRY_MAX_APPS; i++) {
+        const std::string name = "synthetic-" + std::to_string(i + 1);
+        appIds.push_back(AppRegistry::Shared().Intern(name.data(), name.size()));
+    }
+    size_t appIndex = 0;
+
+    KeyEvent event;
+    event.isSpecialKey = false;
+    event.appId = appIds.empty() ? APP_ID_UNKNOWN : appIds[0];
+    AppRegistry::Shared().SetActive(event.appId);
+
+    while (m_model.keyCount == 0 || emitted < m_model.keyCount) {
+        bool pausedBefore = false;
+        const uint32_t keyCode = stream.Next(&pausedBefore);
+        const double elapsed = stream.GetElapsedMs();
+        // 멈춤 뒤에는 다음 앱으로 포커스 전환
+        if (pausedBefore && !appIds.empty()) {
+            appIndex = (appIndex + 1) % appIds.size();
+            event.appId = appIds[appIndex];
+            AppRegistry::Shared().SetActive(event.appId);
+        }
+
+        if (!WaitUntil(start, elapsed)) {
+            return;
+        }
+        event.timestamp = baseTimestamp + static_cast<uint64_t>(elapsed * 1e6);
+        event.keyCode = keyCode;
+        event.isKeyDown = true;
+        CaptureStages::Run(event, m_sink);
+
+        // 뗌 이벤트 (다음 누름과 순서가 바뀌지 않도록 누름과 함께 전달)
+        if (m_model.holdMs > 0) {
+            event.timestamp = baseTimestamp + static_cast<uint64_t>((elapsed + m_model.holdMs) * 1e6);
+            event.isKeyDown = false;
+            CaptureStages::Run(event, m_sink);
+        }
+
+        emitted++;
+    }
+
+    std::cout << "Synthetic typing stream finished: " << emitted << " keys" << std::endl;
+}
+
+INSTANTIATE_CAPTURE_LISTENER(KeyboardListenerReplay);
+
+KeyboardListenerRecorder::KeyboardListenerRecorder(const std::string& tracePath, CaptureDispatcher& target)
+    : m_tracePath(tracePath), m_sink(m_writer, target) {
+}
+
+KeyboardListenerRecorder::~KeyboardListenerRecorder() {
+    StopListening();
+}
+
+bool KeyboardListenerRecorder::StartListening() {
+    if (m_isListening) {
+        return true; // 이미 실행 중
+    }
+    if (!m_inner) {
+        return false;
+    }
+
+    if (!m_writer.Open(m_tracePath.c_str())) {
+        std::cerr << "Failed to create keyboard trace: " << m_tracePath << std::endl;
+        return false;
+    }
+
+    // 내부 리스너의 캡처 스레드에서 기록 후 그대로 전달 (m_sink)
+    if (!m_inner->StartListening()) {
+        m_writer.Close();
+        return false;
+    }
+
+    m_isListening = true;
+    return true;
+}
+
+bool KeyboardListenerRecorder::StopListening() {
+    if (!m_isListening) {
+        return true; // 이미 중지됨
+    }
+
+    // 캡처 스레드가 끝난 뒤 파일을 닫음
+    bool result = m_inner->StopListening();
+    m_writer.Close();
+    m_isListening = false;
+
+    std::cout << "Keyboard trace recorded: " << m_tracePath << std::endl;
+    return result;
+}
+
+PermissionInfo KeyboardListenerRecorder::CheckPermissions() {
+    return m_inner->CheckPermissions();
+}
+
+bool KeyboardListenerRecorder::IsListening() const {
+    return m_inner->IsListening();
+}
@@ -0,0 +1,127 @@
+#ifndef KEYBOARD_REPLAY_H
+#define KEYBOARD_REPLAY_H
+
+#include "keyboard-base.h"
+#include "keyboard-trace.h"
+#include "capture-pipeline.h"
+#include "capture-sinks.h"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <string>
+
+// 합성 타이핑 모델 기본값
+#define SYNTHETIC_DEFAULT_INTERVAL_MEDIAN_MS 150.0
+#define SYNTHETIC_DEFAULT_INTERVAL_SIGMA 0.5
+#define SYNTHETIC_DEFAULT_BURST_MEAN_KEYS 40.0
+#define SYNTHETIC_DEFAULT_PAUSE_MEAN_MS 3000.0
+#define SYNTHETIC_DEFAULT_HOLD_MS 80.0
+
+// 재생 속도가 이 시간(ms) 이상 앞서 있을 때만 대기 (그 이하는 바로 전달해 고속 재생 유지)
+#define REPLAY_MIN_SLEEP_MS 1.0
+
+// 합성 타이핑 모델
+// 키 입력 간격은 로그정규 분포, 버스트 길이는 기하 분포, 버스트 사이 멈춤은 지수 분포
+struct SyntheticTypingModel {
+    uint64_t keyCount;          // 생성할 키 입력 수 (0이면 중지할 때까지)
+    uint64_t seed;              // 같은 시드면 같은 스트림
+    double intervalMedianMs;    // 키 입력 간격 중앙값
+    double intervalSigma;       // 간격의 로그 표준편차
+    double burstMeanKeys;       // 버스트 평균 길이 (0이면 멈춤 없음)
+    double pauseMeanMs;         // 버스트 사이 멈춤 평균
+    double holdMs;              // 누름 → 뗌 간격 (0이면 뗌 이벤트 생략)
+    uint32_t appCount;          // 포커스 앱 수 (0이면 앱 정보 없음, N이면 "synthetic-1..N"을 멈춤마다 차례로 전환)
+};
+
+// 재생 옵션
+struct ReplayOptions {
+    double speed;               // 1 = 실시간, N = N배속, 0 = 최대 속도 (바인딩은 링 자리를 기다리며 전달 - 버리지 않음)
+    bool rebaseTimestamps;      // 첫 이벤트를 시작 시각으로 옮김 (간격은 유지)
+    bool loop;                  // 트레이스 끝에서 처음으로 돌아감
+};
+
+SyntheticTypingModel DefaultSyntheticTypingModel();
+ReplayOptions DefaultReplayOptions();
+// 실시간보다 빠른 재생 (최대 속도 또는 1배속 초과)
+inline bool IsAcceleratedReplay(const ReplayOptions& options) { return options.speed <= 0 || options.speed > 1; }
+
+// 트레이스 재생/합성 타이핑 리스너 (부하 테스트, 회귀 테스트용)
+// 실제 키보드 없이 네이티브 → JS → DB 경로 전체를 결정적으로 구동
+// - 타임스탬프는 재생 속도와 무관하게 트레이스/모델의 간격을 유지하므로
+//   배속 재생에서도 세션 구분 결과가 같음
+// - 가속 재생(최대 속도, 1배속 초과)은 시각이 현재보다 앞서 저널/통계에 미래 시각이 남지 않도록
+//   스트림 길이만큼 시간축을 과거로 옮김 (그래서 끝이 있는 스트림만 가능 - 반복 재생, keyCount 0 불가,
+//   단조 시계 기준점(부팅) 이전으로는 옮길 수 없어 스트림이 가동 시간보다 길면 시작하지 않음)
+// - 재생이 끝나도 StopListening 전까지는 리스닝 상태로 남음
+// - 키 이벤트는 재생 스레드에서 Sink::Deliver로 넘김 (인스턴스화는 keyboard-replay.cc)
+template <typename Sink>
+class KeyboardListenerReplay : public KeyboardListenerBase {
+public:
+    // 트레이스 파일 재생
+    KeyboardListenerReplay(Sink& sink, const std::string& tracePath, const ReplayOptions& options);
+    // 합성 스트림 생성
+    KeyboardListenerReplay(Sink& sink, const SyntheticTypingModel& model, const ReplayOptions& options);
+    virtual ~KeyboardListenerReplay();
+
+    // KeyboardListenerBase 인터페이스 구현
+    bool StartListening() override;
+    bool StopListening() override;
+    PermissionInfo CheckPermissions() override;
+    bool IsListening() const override;
+
+private:
+    // 캡처 단계 - 트레이스/모델이 이미 특수 키 여부와 단조 시계 시각을 담고 있으므로 싱크만
+    typedef CaptureChain<SinkStage<Sink>> CaptureStages;
+
+    Sink& m_sink;
+    bool m_isSynthetic;
+    std::string m_tracePath;
+    SyntheticTypingModel m_model;
+    ReplayOptions m_options;
+    KeyboardTraceReader m_reader;
+    uint64_t m_spanNs;          // 가속 재생 시 시간축을 앞당길 길이 (StartListening에서 측정)
+
+    std::thread m_replayThread;
+    std::atomic<bool> m_shouldStop;
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+
+    void ReplayTraceThreadFunc();
+    void SyntheticThreadFunc();
+    // 재생 시간축 기준 (가속 재생이면 spanNs만큼 앞당겨 마지막 이벤트도 전달 시점 이전이 되도록)
+    uint64_t TimelineBase(uint64_t startNs, uint64_t spanNs) const;
+    // 트레이스 첫 이벤트 ~ 마지막 이벤트 (ns, 읽은 뒤 처음으로 되감음)
+    uint64_t MeasureTraceSpan();
+    // 합성 스트림의 가상 시간 길이 (ns, 같은 시드로 미리 생성)
+    uint64_t MeasureSyntheticSpan() const;
+    // elapsedMs(가상 시간)에 맞춰 대기 - 중지 요청 시 false
+    bool WaitUntil(std::chrono::steady_clock::time_point start, double elapsedMs);
+};
+
+// 다른 리스너의 출력을 트레이스 파일로 녹화하며 그대로 전달하는 리스너
+// 녹화할 백엔드는 GetSink()에 묶어 만든 뒤 SetInner로 넘김 (백엔드 → TraceRecordingSink → target)
+class KeyboardListenerRecorder : public KeyboardListenerBase {
+public:
+    KeyboardListenerRecorder(const std::string& tracePath, CaptureDispatcher& target);
+    virtual ~KeyboardListenerRecorder();
+
+    TraceRecordingSink& GetSink() { return m_sink; }
+    // 녹화할 백엔드 (소유권 이전, 시작 전에 한 번)
+    void SetInner(KeyboardListenerBase* inner) { m_inner.reset(inner); }
+
+    bool StartListening() override;
+    bool StopListening() override;
+    PermissionInfo CheckPermissions() override;
+    bool IsListening() const override;
+
+private:
+    std::unique_ptr<KeyboardListenerBase> m_inner;
+    std::string m_tracePath;
+    KeyboardTraceWriter m_writer;
+    TraceRecordingSink m_sink;
+};
+
+#endif // KEYBOARD_REPLAY_H
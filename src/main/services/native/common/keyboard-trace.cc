@@ -0,0 +1,126 @@
+#include "keyboard-trace.h"
+#include "app-registry.h"
+#include <stddef.h>
+#include <string.h>
+
+static const char kTraceMagic[8] = { 'T', 'H', 'T', 'R', 'A', 'C', 'E', '\0' };
+
+// 트레이스 쓰기 버퍼 크기 (키 입력 수천 개 단위로 write 호출)
+#define KEYBOARD_TRACE_WRITE_BUFFER (64 * 1024)
+
+KeyboardTraceWriter::KeyboardTraceWriter() : m_file(nullptr) {
+}
+
+KeyboardTraceWriter::~KeyboardTraceWriter() {
+    Close();
+}
+
+bool KeyboardTraceWriter::Open(const char* path) {
+    Close();
+
+    m_file = fopen(path, "wb");
+    if (!m_file) {
+        return false;
+    }
+    setvbuf(m_file, nullptr, _IOFBF, KEYBOARD_TRACE_WRITE_BUFFER);
+
+    KeyboardTraceHeader header;
+    memcpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+    header.version = KEYBOARD_TRACE_VERSION;
+    header.recordSize = sizeof(KeyboardTraceRecord);
+    header.wallOffsetNs = EventClock::GetWallOffsetNs();
+    if (fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void KeyboardTraceWriter::Close() {
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool KeyboardTraceWriter::Write(const KeyEvent& event) {
+    if (!m_file) {
+        return false;
+    }
+
+    KeyboardTraceRecord record;
+    record.timestamp = event.timestamp;
+    record.keyCode = event.keyCode;
+    record.flags = (event.isKeyDown ? KEYBOARD_TRACE_FLAG_KEY_DOWN : 0) |
+                   (event.isSpecialKey ? KEYBOARD_TRACE_FLAG_SPECIAL : 0);
+    memset(record.reserved, 0, sizeof(record.reserved));
+    return fwrite(&record, sizeof(record), 1, m_file) == 1;
+}
+
+KeyboardTraceReader::KeyboardTraceReader()
+    : m_file(nullptr),
+      m_version(0),
+      m_dataOffset(0),
+      m_wallOffsetNs(0) {
+}
+
+KeyboardTraceReader::~KeyboardTraceReader() {
+    Close();
+}
+
+bool KeyboardTraceReader::Open(const char* path) {
+    Close();
+
+    m_file = fopen(path, "rb");
+    if (!m_file) {
+        return false;
+    }
+
+    // 버전 1 헤더에는 wallOffsetNs가 없으므로 공통 부분을 먼저 읽음
+    const size_t commonSize = offsetof(KeyboardTraceHeader, wallOffsetNs);
+    KeyboardTraceHeader header;
+    if (fread(&header, commonSize, 1, m_file) != 1 ||
+        memcmp(header.magic, kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+        header.version < 1 || header.version > KEYBOARD_TRACE_VERSION ||
+        header.recordSize != sizeof(KeyboardTraceRecord)) {
+        Close();
+        return false;
+    }
+
+    header.wallOffsetNs = 0;
+    if (header.version >= 2 &&
+        fread(&header.wallOffsetNs, sizeof(header.wallOffsetNs), 1, m_file) != 1) {
+        Close();
+        return false;
+    }
+
+    m_version = header.version;
+    m_dataOffset = ftell(m_file);
+    m_wallOffsetNs = header.wallOffsetNs;
+    return true;
+}
+
+void KeyboardTraceReader::Close() {
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool KeyboardTraceReader::Rewind() {
+    return m_file && fseek(m_file, m_dataOffset, SEEK_SET) == 0;
+}
+
+bool KeyboardTraceReader::Read(KeyEvent* event) {
+    KeyboardTraceRecord record;
+    if (!m_file || fread(&record, sizeof(record), 1, m_file) != 1) {
+        return false;
+    }
+
+    event->timestamp = m_version >= 2 ? record.timestamp : record.timestamp * 1000000ull;
+    event->keyCode = record.keyCode;
+    event->isKeyDown = (record.flags & KEYBOARD_TRACE_FLAG_KEY_DOWN) != 0;
+    event->isSpecialKey = (record.flags & KEYBOARD_TRACE_FLAG_SPECIAL) != 0;
+    event->appId = APP_ID_UNKNOWN;   // 트레이스에는 앱 정보를 기록하지 않음
+    return true;
+}
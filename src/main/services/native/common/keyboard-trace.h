@@ -0,0 +1,78 @@
+#ifndef KEYBOARD_TRACE_H
+#define KEYBOARD_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "keyboard-base.h"
+
+// 키 이벤트 트레이스 파일 형식 버전
+// - 1: 16바이트 헤더, 타임스탬프 epoch ms
+// - 2: 24바이트 헤더 (wallOffsetNs 추가), 타임스탬프 단조 시계 ns
+#define KEYBOARD_TRACE_VERSION 2
+
+// 트레이스 레코드 플래그 (배치 전달 flags와 같은 비트)
+#define KEYBOARD_TRACE_FLAG_KEY_DOWN 0x01
+#define KEYBOARD_TRACE_FLAG_SPECIAL  0x02
+
+// 트레이스 파일 헤더 (24바이트, 버전 1 파일에는 wallOffsetNs가 없음)
+struct KeyboardTraceHeader {
+    char magic[8];        // "THTRACE\0"
+    uint32_t version;
+    uint32_t recordSize;
+    int64_t wallOffsetNs; // 녹화 시작 시 벽시계 - 단조 시계 차이 (타임스탬프 + 이 값 = epoch ns)
+};
+
+// 트레이스 레코드 (16바이트, 리틀 엔디언 그대로 기록)
+struct KeyboardTraceRecord {
+    uint64_t timestamp;   // 녹화한 프로세스의 단조 시계 ns
+    uint32_t keyCode;
+    uint8_t flags;
+    uint8_t reserved[3];
+};
+
+// 트레이스 파일 쓰기 (버퍼링된 stdio - 녹화 모드에서 캡처 스레드가 호출)
+class KeyboardTraceWriter {
+public:
+    KeyboardTraceWriter();
+    ~KeyboardTraceWriter();
+
+    KeyboardTraceWriter(const KeyboardTraceWriter&) = delete;
+    KeyboardTraceWriter& operator=(const KeyboardTraceWriter&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+    bool Write(const KeyEvent& event);
+
+private:
+    FILE* m_file;
+};
+
+// 트레이스 파일 읽기
+class KeyboardTraceReader {
+public:
+    KeyboardTraceReader();
+    ~KeyboardTraceReader();
+
+    KeyboardTraceReader(const KeyboardTraceReader&) = delete;
+    KeyboardTraceReader& operator=(const KeyboardTraceReader&) = delete;
+
+    // 헤더 검증까지 수행
+    bool Open(const char* path);
+    void Close();
+    // 처음 레코드로 되감기
+    bool Rewind();
+    // 다음 레코드 (파일 끝이나 잘린 레코드면 false)
+    // 타임스탬프는 트레이스의 단조 시계 ns (버전 1 파일은 epoch ns, 기준점 0)
+    bool Read(KeyEvent* event);
+    // 트레이스 타임스탬프 → epoch ns 변환 기준점
+    int64_t GetWallOffsetNs() const { return m_wallOffsetNs; }
+
+private:
+    FILE* m_file;
+    uint32_t m_version;
+    long m_dataOffset;
+    int64_t m_wallOffsetNs;
+};
+
+#endif // KEYBOARD_TRACE_H
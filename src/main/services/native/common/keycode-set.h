@@ -0,0 +1,143 @@
+#ifndef KEYCODE_SET_H
+#define KEYCODE_SET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 키 코드 집합 (0 ~ 255, 256비트)
+// constexpr로 만들 수 있어 플랫폼별 키 테이블은 컴파일 시점에 비트 집합으로 생성되고,
+// 후킹 스레드의 판별은 분기 없는 비트 검사 한 번으로 끝남
+class KeyCodeSet {
+public:
+    static const uint32_t kMaxKeyCodes = 256;
+
+    constexpr KeyCodeSet() : m_words{ 0, 0, 0, 0 } {}
+
+    template <size_t N>
+    constexpr explicit KeyCodeSet(const uint8_t (&keyCodes)[N]) : m_words{ 0, 0, 0, 0 } {
+        for (size_t i = 0; i < N; i++) {
+            m_words[keyCodes[i] >> 6] |= 1ull << (keyCodes[i] & 63);
+        }
+    }
+
+    // 범위 밖 키 코드는 포함되지 않은 것으로 취급
+    constexpr bool Test(uint32_t keyCode) const {
+        return keyCode < kMaxKeyCodes && ((m_words[keyCode >> 6] >> (keyCode & 63)) & 1) != 0;
+    }
+
+    void Set(uint32_t keyCode) {
+        if (keyCode < kMaxKeyCodes) {
+            m_words[keyCode >> 6] |= 1ull << (keyCode & 63);
+        }
+    }
+
+    void Clear(uint32_t keyCode) {
+        if (keyCode < kMaxKeyCodes) {
+            m_words[keyCode >> 6] &= ~(1ull << (keyCode & 63));
+        }
+    }
+
+    // 64비트 단어 하나 (index: 0 ~ 3)
+    constexpr uint64_t Word(size_t index) const {
+        return m_words[index];
+    }
+
+    constexpr bool Intersects(const KeyCodeSet& other) const {
+        return ((m_words[0] & other.m_words[0]) | (m_words[1] & other.m_words[1]) |
+                (m_words[2] & other.m_words[2]) | (m_words[3] & other.m_words[3])) != 0;
+    }
+
+    constexpr bool IsEmpty() const {
+        return (m_words[0] | m_words[1] | m_words[2] | m_words[3]) == 0;
+    }
+
+    constexpr KeyCodeSet operator|(const KeyCodeSet& other) const {
+        return KeyCodeSet(m_words[0] | other.m_words[0], m_words[1] | other.m_words[1],
+                          m_words[2] | other.m_words[2], m_words[3] | other.m_words[3]);
+    }
+
+private:
+    uint64_t m_words[4];
+
+    constexpr KeyCodeSet(uint64_t w0, uint64_t w1, uint64_t w2, uint64_t w3) : m_words{ w0, w1, w2, w3 } {}
+};
+
+// 플랫폼별 특수 키 테이블 (수정자, 기능 키, Escape/Tab/Return/BackSpace)
+// 특수 키는 리스너가 isSpecialKey로 표시하고, 전달 여부는 바인딩의 이벤트 필터가 결정
+
+// X 키 코드 (= evdev 키 코드 + 8) - XRecord/evdev 리스너 공용
+static constexpr uint8_t kXSpecialKeyCodes[] = {
+    37, 105,            // Left/Right Control
+    50, 62,             // Left/Right Shift
+    64, 108,            // Left Alt, Right Alt (AltGr)
+    133, 134,           // Left/Right Super
+    66, 135,            // Caps Lock, Menu (Compose)
+    67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 95, 96,   // F1 ~ F12
+    9, 23, 36, 22       // Escape, Tab, Return, BackSpace
+};
+static constexpr KeyCodeSet kXSpecialKeys(kXSpecialKeyCodes);
+
+// macOS 가상 키 코드
+static constexpr uint8_t kMacSpecialKeyCodes[] = {
+    54, 55,             // Right/Left Command
+    56, 60,             // Left/Right Shift
+    58, 61,             // Left/Right Option
+    59, 62,             // Left/Right Control
+    57, 63,             // Caps Lock, Function
+    122, 120, 99, 118, 96, 97, 98, 100, 101, 109, 103, 111,   // F1 ~ F12
+    53, 48, 36, 51      // Escape, Tab, Return, Delete
+};
+static constexpr KeyCodeSet kMacSpecialKeys(kMacSpecialKeyCodes);
+
+// Windows 가상 키 코드 (VK_*)
+static constexpr uint8_t kWindowsSpecialKeyCodes[] = {
+    0x10, 0x11, 0x12,   // VK_SHIFT, VK_CONTROL, VK_MENU
+    0xA0, 0xA1,         // VK_LSHIFT, VK_RSHIFT
+    0xA2, 0xA3,         // VK_LCONTROL, VK_RCONTROL
+    0xA4, 0xA5,         // VK_LMENU, VK_RMENU
+    0x5B, 0x5C, 0x5D,   // VK_LWIN, VK_RWIN, VK_APPS
+    0x14,               // VK_CAPITAL
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B,   // VK_F1 ~ VK_F12
+    0x1B, 0x09, 0x0D, 0x08   // VK_ESCAPE, VK_TAB, VK_RETURN, VK_BACK
+};
+static constexpr KeyCodeSet kWindowsSpecialKeys(kWindowsSpecialKeyCodes);
+
+// 플랫폼별 수정자 키 테이블 (키 상태 추적이 눌린 키 비트맵에서 수정자 상태를 계산)
+struct KeyModifierTable {
+    KeyCodeSet shift;
+    KeyCodeSet control;
+    KeyCodeSet alt;
+    KeyCodeSet meta;      // Super / Command / Windows
+};
+
+static constexpr uint8_t kXShiftKeyCodes[] = { 50, 62 };
+static constexpr uint8_t kXControlKeyCodes[] = { 37, 105 };
+static constexpr uint8_t kXAltKeyCodes[] = { 64, 108 };
+static constexpr uint8_t kXMetaKeyCodes[] = { 133, 134 };
+static constexpr KeyModifierTable kXModifierKeys = {
+    KeyCodeSet(kXShiftKeyCodes), KeyCodeSet(kXControlKeyCodes), KeyCodeSet(kXAltKeyCodes), KeyCodeSet(kXMetaKeyCodes)
+};
+
+static constexpr uint8_t kMacShiftKeyCodes[] = { 56, 60 };
+static constexpr uint8_t kMacControlKeyCodes[] = { 59, 62 };
+static constexpr uint8_t kMacAltKeyCodes[] = { 58, 61 };
+static constexpr uint8_t kMacMetaKeyCodes[] = { 54, 55 };
+static constexpr KeyModifierTable kMacModifierKeys = {
+    KeyCodeSet(kMacShiftKeyCodes), KeyCodeSet(kMacControlKeyCodes), KeyCodeSet(kMacAltKeyCodes), KeyCodeSet(kMacMetaKeyCodes)
+};
+
+static constexpr uint8_t kWindowsShiftKeyCodes[] = { 0x10, 0xA0, 0xA1 };
+static constexpr uint8_t kWindowsControlKeyCodes[] = { 0x11, 0xA2, 0xA3 };
+static constexpr uint8_t kWindowsAltKeyCodes[] = { 0x12, 0xA4, 0xA5 };
+static constexpr uint8_t kWindowsMetaKeyCodes[] = { 0x5B, 0x5C };
+static constexpr KeyModifierTable kWindowsModifierKeys = {
+    KeyCodeSet(kWindowsShiftKeyCodes), KeyCodeSet(kWindowsControlKeyCodes), KeyCodeSet(kWindowsAltKeyCodes),
+    KeyCodeSet(kWindowsMetaKeyCodes)
+};
+
+static_assert(kXSpecialKeys.Test(37) && !kXSpecialKeys.Test(38), "X special key table");
+static_assert(kMacSpecialKeys.Test(55) && !kMacSpecialKeys.Test(0), "macOS special key table");
+static_assert(kWindowsSpecialKeys.Test(0x1B) && !kWindowsSpecialKeys.Test('A'), "Windows special key table");
+static_assert(kXModifierKeys.shift.Test(50) && !kXModifierKeys.shift.Intersects(kXModifierKeys.control), "X modifier table");
+
+#endif // KEYCODE_SET_H
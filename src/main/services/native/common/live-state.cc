@@ -0,0 +1,94 @@
+#include "live-state.h"
+#include "event-clock.h"
+#include <math.h>
+#include <thread>
+
+LiveTypingState::LiveTypingState()
+    : m_sequence(0),
+      m_lastKeyNs(0),
+      m_lastIntervalNs(0),
+      m_combo(0),
+      m_totalKeys(0),
+      m_rate(0),
+      m_activeMs(DEFAULT_LIVE_STATE_ACTIVE_MS),
+      m_comboGapMs(DEFAULT_LIVE_STATE_COMBO_GAP_MS),
+      m_rateWindowMs(DEFAULT_LIVE_STATE_RATE_WINDOW_MS) {
+}
+
+void LiveTypingState::Configure(uint32_t activeMs, uint32_t comboGapMs, uint32_t rateWindowMs) {
+    if (activeMs > 0) m_activeMs.store(activeMs, std::memory_order_relaxed);
+    if (comboGapMs > 0) m_comboGapMs.store(comboGapMs, std::memory_order_relaxed);
+    if (rateWindowMs > 0) m_rateWindowMs.store(rateWindowMs, std::memory_order_relaxed);
+}
+
+void LiveTypingState::OnKeyPress(uint64_t timestamp) {
+    // 쓰는 쪽은 하나뿐이라 이전 값은 relaxed로 읽어도 자기 쓰기가 보임
+    const uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+    const uint64_t totalKeys = m_totalKeys.load(std::memory_order_relaxed);
+    const uint64_t lastKeyNs = m_lastKeyNs.load(std::memory_order_relaxed);
+    const double windowSec = m_rateWindowMs.load(std::memory_order_relaxed) / 1000.0;
+    const uint64_t comboGapNs = static_cast<uint64_t>(m_comboGapMs.load(std::memory_order_relaxed)) * 1000000ULL;
+
+    // 소스 시각이 되돌아간 경우 (장치 전환 등) 간격 0으로 취급
+    const uint64_t intervalNs = totalKeys > 0 && timestamp > lastKeyNs ? timestamp - lastKeyNs : 0;
+    const bool continues = totalKeys > 0 && intervalNs <= comboGapNs;
+
+    // 지수 가중 키 수 - 키마다 1/window를 더하고 경과 시간만큼 감쇠 (일정한 속도 r에서 평균 r)
+    double rate = m_rate.load(std::memory_order_relaxed);
+    rate = rate * exp(-(intervalNs / 1e9) / windowSec) + 1.0 / windowSec;
+
+    // 홀수로 바꾼 뒤 필드 갱신 - 필드는 release로 써서 새 값을 본 읽기가 앞선 홀수 표시도 보게 함
+    // (독립 펜스 대신 원자 변수의 순서만 써서 TSAN이 검사할 수 있도록)
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+
+    m_lastKeyNs.store(totalKeys > 0 && timestamp < lastKeyNs ? lastKeyNs : timestamp, std::memory_order_release);
+    m_lastIntervalNs.store(continues ? intervalNs : 0, std::memory_order_release);
+    m_combo.store(continues ? m_combo.load(std::memory_order_relaxed) + 1 : 1, std::memory_order_release);
+    m_totalKeys.store(totalKeys + 1, std::memory_order_release);
+    m_rate.store(rate, std::memory_order_release);
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void LiveTypingState::Read(uint64_t now, double* out) const {
+    uint64_t sequence;
+    uint64_t lastKeyNs;
+    uint64_t lastIntervalNs;
+    uint64_t combo;
+    uint64_t totalKeys;
+    double rate;
+
+    // 쓰기 구간은 필드 다섯 개 저장뿐 - 겹치면 바로 다시 읽고, 쓰는 스레드가 선점된 경우에만 양보
+    for (unsigned attempt = 0;; attempt++) {
+        sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) == 0) {
+            // acquire 읽기 - 뒤의 순서 번호 읽기가 필드 읽기보다 앞당겨지지 않음
+            lastKeyNs = m_lastKeyNs.load(std::memory_order_acquire);
+            lastIntervalNs = m_lastIntervalNs.load(std::memory_order_acquire);
+            combo = m_combo.load(std::memory_order_acquire);
+            totalKeys = m_totalKeys.load(std::memory_order_acquire);
+            rate = m_rate.load(std::memory_order_acquire);
+
+            if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+                break;
+            }
+        }
+        if (attempt >= 64) {
+            std::this_thread::yield();
+        }
+    }
+
+    const double ageMs = totalKeys > 0 && now > lastKeyNs ? (now - lastKeyNs) / 1e6 : 0.0;
+    const bool active = totalKeys > 0 && ageMs < m_activeMs.load(std::memory_order_relaxed);
+    const bool comboAlive = totalKeys > 0 && ageMs <= m_comboGapMs.load(std::memory_order_relaxed);
+    const double windowMs = m_rateWindowMs.load(std::memory_order_relaxed);
+
+    out[LIVE_STATE_SEQUENCE] = static_cast<double>(sequence / 2);
+    out[LIVE_STATE_ACTIVE] = active ? 1.0 : 0.0;
+    out[LIVE_STATE_RATE] = totalKeys > 0 ? rate * exp(-ageMs / windowMs) : 0.0;
+    out[LIVE_STATE_COMBO] = comboAlive ? static_cast<double>(combo) : 0.0;
+    out[LIVE_STATE_LAST_KEY_AGE_MS] = totalKeys > 0 ? ageMs : -1.0;
+    out[LIVE_STATE_LAST_INTERVAL_MS] = lastIntervalNs / 1e6;
+    out[LIVE_STATE_TOTAL_KEYS] = static_cast<double>(totalKeys);
+    out[LIVE_STATE_LAST_KEY_WALL_MS] = totalKeys > 0 ? EventClock::ToWallMs(lastKeyNs) : 0.0;
+}
@@ -0,0 +1,64 @@
+#ifndef LIVE_STATE_H
+#define LIVE_STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// 실시간 상태 기본값 (밀리초)
+#define DEFAULT_LIVE_STATE_ACTIVE_MS 2000       // 마지막 키 후 이 시간 동안 입력 중으로 판정
+#define DEFAULT_LIVE_STATE_COMBO_GAP_MS 1000    // 콤보가 이어지는 최대 키 간격
+#define DEFAULT_LIVE_STATE_RATE_WINDOW_MS 1000  // 입력 속도 지수 가중 평균의 시간 상수
+
+// readSnapshot 버퍼 배치 (Float64Array 인덱스 - types.ts의 LiveStateField와 같은 순서)
+enum LiveStateField {
+    LIVE_STATE_SEQUENCE = 0,          // 게시 횟수 (키 입력마다 1 증가 - 바뀌었는지 비교용)
+    LIVE_STATE_ACTIVE = 1,            // 1 = 입력 중, 0 = 유휴
+    LIVE_STATE_RATE = 2,              // 초당 키 수 (읽는 시점까지 감쇠 반영)
+    LIVE_STATE_COMBO = 3,             // 현재 콤보 길이 (간격이 끊기면 0)
+    LIVE_STATE_LAST_KEY_AGE_MS = 4,   // 마지막 키 이후 경과 시간 (키 입력이 없었으면 -1)
+    LIVE_STATE_LAST_INTERVAL_MS = 5,  // 마지막 두 키 사이 간격 (콤보 첫 키는 0)
+    LIVE_STATE_TOTAL_KEYS = 6,        // 프로세스 누적 키 수
+    LIVE_STATE_LAST_KEY_WALL_MS = 7,  // 마지막 키 시각 (epoch ms, 없으면 0)
+    LIVE_STATE_FIELD_COUNT = 8
+};
+
+// 화면 갱신 주기로 읽는 실시간 타이핑 상태 (시퀀스 잠금)
+// - 쓰기: 후킹 스레드 하나 (OnKeyPress - 대기/할당 없음)
+// - 읽기: 어느 스레드에서나 (Read - 쓰기와 겹치면 다시 읽음, 할당 없음)
+// - 키를 누를 때마다 JS를 깨우지 않으므로 읽는 비용은 입력 속도와 무관
+// - 경과 시간/활성 여부/속도 감쇠는 읽는 시점에 계산 (유휴 중에는 쓰기가 없음)
+class LiveTypingState {
+public:
+    LiveTypingState();
+
+    LiveTypingState(const LiveTypingState&) = delete;
+    LiveTypingState& operator=(const LiveTypingState&) = delete;
+
+    // 판정 기준 설정 (어느 스레드에서나 - 0은 현재 값 유지)
+    void Configure(uint32_t activeMs, uint32_t comboGapMs, uint32_t rateWindowMs);
+    uint32_t GetActiveMs() const { return m_activeMs.load(std::memory_order_relaxed); }
+    uint32_t GetComboGapMs() const { return m_comboGapMs.load(std::memory_order_relaxed); }
+    uint32_t GetRateWindowMs() const { return m_rateWindowMs.load(std::memory_order_relaxed); }
+
+    // 세션에 포함되는 키 입력 반영 (후킹 스레드 전용)
+    void OnKeyPress(uint64_t timestamp);
+
+    // now(단조 시계 ns) 시점의 상태를 out[0, LIVE_STATE_FIELD_COUNT)에 채움
+    void Read(uint64_t now, double* out) const;
+
+private:
+    // 짝수 = 안정, 홀수 = 쓰는 중 (필드는 release 쓰기/acquire 읽기 원자 변수 - 펜스 없이 순서 보장)
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<uint64_t> m_lastKeyNs;
+    std::atomic<uint64_t> m_lastIntervalNs;
+    std::atomic<uint64_t> m_combo;
+    std::atomic<uint64_t> m_totalKeys;
+    std::atomic<double> m_rate;     // 마지막 키 시점의 초당 키 수
+
+    std::atomic<uint32_t> m_activeMs;
+    std::atomic<uint32_t> m_comboGapMs;
+    std::atomic<uint32_t> m_rateWindowMs;
+};
+
+#endif // LIVE_STATE_H
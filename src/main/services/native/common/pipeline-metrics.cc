@@ -0,0 +1,139 @@
+#include "pipeline-metrics.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// 최상위 비트 위치 (value > 0)
+static inline uint32_t HighestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+LatencyHistogram::LatencyHistogram() {
+    Reset();
+}
+
+void LatencyHistogram::Reset() {
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKET_COUNT; i++) {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::Record(uint64_t valueNs) {
+    m_buckets[BucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(valueNs, std::memory_order_relaxed);
+    if (valueNs > m_max.load(std::memory_order_relaxed)) {
+        m_max.store(valueNs, std::memory_order_relaxed);
+    }
+    m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKET_COUNT; i++) {
+        m_buckets[i].fetch_add(other.m_buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    m_sum.fetch_add(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    const uint64_t otherMax = other.GetMax();
+    if (otherMax > m_max.load(std::memory_order_relaxed)) {
+        m_max.store(otherMax, std::memory_order_relaxed);
+    }
+    m_count.fetch_add(other.GetCount(), std::memory_order_relaxed);
+}
+
+double LatencyHistogram::GetMean() const {
+    const uint64_t count = GetCount();
+    return count > 0 ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / count : 0.0;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double quantile) const {
+    // 버킷 합계 기준 (count와 버킷이 조회 중 어긋나도 범위를 벗어나지 않도록)
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKET_COUNT; i++) {
+        total += m_buckets[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    if (quantile < 0.0) {
+        quantile = 0.0;
+    } else if (quantile > 1.0) {
+        quantile = 1.0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total));
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LATENCY_HISTOGRAM_BUCKET_COUNT; i++) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            const uint64_t value = BucketLowerBound(i) + BucketWidth(i) / 2;
+            const uint64_t max = GetMax();
+            return value < max ? value : max;
+        }
+    }
+    return GetMax();
+}
+
+// 버킷 번호 - IntervalStats와 같은 방식 (하위 구간은 선형, 이후 2의 거듭제곱마다 하위 버킷)
+uint32_t LatencyHistogram::BucketIndex(uint64_t value) {
+    const uint64_t maxValue = (1ull << LATENCY_HISTOGRAM_MAX_VALUE_BITS) - 1;
+    if (value > maxValue) {
+        value = maxValue;
+    }
+    if (value < 2 * LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(value);
+    }
+
+    const uint32_t msb = HighestBit(value);
+    const uint32_t shift = msb - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    return shift * LATENCY_HISTOGRAM_SUB_BUCKET_COUNT + static_cast<uint32_t>(value >> shift);
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(uint32_t index) {
+    if (index < 2 * LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const uint32_t shift = index / LATENCY_HISTOGRAM_SUB_BUCKET_COUNT - 1;
+    return static_cast<uint64_t>(index - shift * LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) << shift;
+}
+
+uint64_t LatencyHistogram::BucketWidth(uint32_t index) {
+    if (index < 2 * LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        return 1;
+    }
+    return 1ull << (index / LATENCY_HISTOGRAM_SUB_BUCKET_COUNT - 1);
+}
+
+PipelineMetrics::PipelineMetrics() {
+    Reset();
+}
+
+void PipelineMetrics::Reset() {
+    hookCalls.store(0, std::memory_order_relaxed);
+    filtered.store(0, std::memory_order_relaxed);
+    enqueued.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+    evicted.store(0, std::memory_order_relaxed);
+    coalesced.store(0, std::memory_order_relaxed);
+    blocked.store(0, std::memory_order_relaxed);
+    blockTimeouts.store(0, std::memory_order_relaxed);
+    maxQueueDepth.store(0, std::memory_order_relaxed);
+    recordsDropped.store(0, std::memory_order_relaxed);
+    delivered.store(0, std::memory_order_relaxed);
+    wakeups.store(0, std::memory_order_relaxed);
+    hookDuration.Reset();
+    deliveryLatency.Reset();
+}
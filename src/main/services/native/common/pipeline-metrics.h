@@ -0,0 +1,83 @@
+#ifndef PIPELINE_METRICS_H
+#define PIPELINE_METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// 지연 시간 히스토그램 설정 (나노초 단위 로그 버킷)
+// - 2의 거듭제곱 구간을 2^LATENCY_HISTOGRAM_SUB_BUCKET_BITS 개로 나눔 (상대 오차 약 6%)
+// - 2^LATENCY_HISTOGRAM_MAX_VALUE_BITS ns (약 18분) 초과 값은 최상위 버킷에 기록
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 4
+#define LATENCY_HISTOGRAM_SUB_BUCKET_COUNT (1u << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define LATENCY_HISTOGRAM_MAX_VALUE_BITS 40
+#define LATENCY_HISTOGRAM_BUCKET_COUNT \
+    ((LATENCY_HISTOGRAM_MAX_VALUE_BITS - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1) * LATENCY_HISTOGRAM_SUB_BUCKET_COUNT)
+
+// 잠금 없는 지연 시간 히스토그램 (고정 메모리)
+// 기록은 한 스레드(후킹 스레드 또는 JS 스레드)에서, 조회/초기화는 다른 스레드에서 해도 됨
+// 조회 중 기록된 값은 일부만 반영될 수 있음 (근사 스냅샷)
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // 값 기록 (ns) - O(1), 할당/잠금 없음
+    void Record(uint64_t valueNs);
+    void Reset();
+    // 다른 히스토그램의 기록을 더함 (여러 생산자의 지표 합산용 - other는 기록이 끝난 상태여야 정확함)
+    void Merge(const LatencyHistogram& other);
+
+    uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t GetMax() const { return m_max.load(std::memory_order_relaxed); }
+    double GetMean() const;
+    // 분위수 (0.0 ~ 1.0) - 해당 버킷의 중간값
+    uint64_t GetPercentile(double quantile) const;
+
+private:
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+    std::atomic<uint32_t> m_buckets[LATENCY_HISTOGRAM_BUCKET_COUNT];
+
+    static uint32_t BucketIndex(uint64_t value);
+    static uint64_t BucketLowerBound(uint32_t index);
+    static uint64_t BucketWidth(uint32_t index);
+};
+
+// 캡처 경로 지표 (후킹 스레드 → 링 → JS 스레드)
+// 카운터는 모두 relaxed 원자 연산 - 서로 다른 카운터 사이의 순간 일관성은 보장하지 않음
+struct PipelineMetrics {
+    // 후킹 스레드에서 갱신
+    std::atomic<uint64_t> hookCalls;        // 바인딩 콜백에 도달한 이벤트
+    std::atomic<uint64_t> filtered;         // 필터 단계에서 걸러진 이벤트 (링에 넣지 않음)
+    std::atomic<uint64_t> enqueued;         // 링에 들어간 항목 (세션 종료 항목 포함)
+    std::atomic<uint64_t> dropped;          // 링이 가득 차 버린 항목 (새 항목 버림, 대기 시간 초과)
+    std::atomic<uint64_t> evicted;          // 새 항목에 밀려 버려진 오래된 항목
+    std::atomic<uint64_t> coalesced;        // 요약 항목으로 합쳐진 키 이벤트
+    std::atomic<uint64_t> blocked;          // 링이 가득 차 후킹 스레드가 기다린 횟수
+    std::atomic<uint64_t> blockTimeouts;    // 그중 시간 초과로 버린 횟수
+    std::atomic<uint64_t> maxQueueDepth;    // 링 최대 깊이
+    std::atomic<uint64_t> recordsDropped;   // 레코드 링이 가득 차 저널/통계에 넣지 못한 타이핑 레코드 (기본 구독)
+    LatencyHistogram hookDuration;          // 바인딩 콜백 실행 시간
+
+    // JS 스레드에서 갱신
+    std::atomic<uint64_t> delivered;        // 링에서 꺼내 JS로 전달한 키 이벤트
+    std::atomic<uint64_t> wakeups;          // CallJS 호출 횟수
+    LatencyHistogram deliveryLatency;       // 링에 넣은 시점 → CallJS 시작
+
+    PipelineMetrics();
+
+    void Reset();
+
+    // 링 깊이 갱신 (생산자 전용)
+    void ObserveQueueDepth(uint64_t depth) {
+        if (depth > maxQueueDepth.load(std::memory_order_relaxed)) {
+            maxQueueDepth.store(depth, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif // PIPELINE_METRICS_H
@@ -0,0 +1,183 @@
+#include "rhythm-detector.h"
+#include <math.h>
+#include <thread>
+
+static const uint64_t kNsPerMs = 1000000ull;
+
+RhythmDetector::RhythmDetector()
+    : m_burstGapMs(DEFAULT_RHYTHM_BURST_GAP_MS),
+      m_burstMinKeys(DEFAULT_RHYTHM_BURST_MIN_KEYS),
+      m_pauseMs(DEFAULT_RHYTHM_PAUSE_MS),
+      m_rateHighKps(DEFAULT_RHYTHM_RATE_HIGH_KPS),
+      m_rateLowKps(DEFAULT_RHYTHM_RATE_LOW_KPS),
+      m_rateWindowMs(DEFAULT_RHYTHM_RATE_WINDOW_MS),
+      m_streakMs(DEFAULT_RHYTHM_STREAK_MS),
+      m_sequence(0),
+      m_keys(0),
+      m_lastKeyNs(0),
+      m_rate(0),
+      m_rateHigh(false),
+      m_burstRun(0),
+      m_streakStartNs(0),
+      m_streaks(0) {
+}
+
+void RhythmDetector::Configure(const RhythmConfig& config) {
+    m_burstGapMs.store(config.burstGapMs, std::memory_order_relaxed);
+    m_burstMinKeys.store(config.burstMinKeys, std::memory_order_relaxed);
+    m_pauseMs.store(config.pauseMs, std::memory_order_relaxed);
+    m_rateHighKps.store(config.rateHighKps, std::memory_order_relaxed);
+    m_rateLowKps.store(config.rateLowKps, std::memory_order_relaxed);
+    m_rateWindowMs.store(config.rateWindowMs, std::memory_order_relaxed);
+    m_streakMs.store(config.streakMs, std::memory_order_relaxed);
+}
+
+RhythmConfig RhythmDetector::GetConfig() const {
+    RhythmConfig config;
+    config.burstGapMs = m_burstGapMs.load(std::memory_order_relaxed);
+    config.burstMinKeys = m_burstMinKeys.load(std::memory_order_relaxed);
+    config.pauseMs = m_pauseMs.load(std::memory_order_relaxed);
+    config.rateHighKps = m_rateHighKps.load(std::memory_order_relaxed);
+    config.rateLowKps = m_rateLowKps.load(std::memory_order_relaxed);
+    config.rateWindowMs = m_rateWindowMs.load(std::memory_order_relaxed);
+    config.streakMs = m_streakMs.load(std::memory_order_relaxed);
+    return config;
+}
+
+// 속도가 하한에 닿는 시각 - rate * exp(-t / window) = low
+static uint64_t RateLowAt(uint64_t lastKeyNs, double rate, double low, double windowMs) {
+    if (!(rate > low) || !(low > 0)) {
+        return lastKeyNs;
+    }
+    return lastKeyNs + static_cast<uint64_t>(windowMs * log(rate / low) * kNsPerMs);
+}
+
+static void SetEvent(RhythmEvent* event, uint8_t type, uint64_t timestamp, uint64_t gapKey, double value) {
+    event->timestamp = timestamp;
+    event->gapKey = gapKey;
+    event->value = value;
+    event->type = type;
+}
+
+// 키 입력 처리 (후킹 스레드)
+size_t RhythmDetector::OnKeyPress(uint64_t timestamp, bool sessionStarted, RhythmEvent* out) {
+    const RhythmConfig config = GetConfig();
+    const double windowMs = config.rateWindowMs;
+    const uint64_t keys = m_keys.load(std::memory_order_relaxed);
+    const uint64_t lastKeyNs = m_lastKeyNs.load(std::memory_order_relaxed);
+    const double lastRate = m_rate.load(std::memory_order_relaxed);
+    double rate = lastRate;
+    bool rateHigh = m_rateHigh.load(std::memory_order_relaxed);
+    size_t count = 0;
+
+    // 소스 시각이 뒤로 간 경우 간격은 0으로 취급
+    const uint64_t gap = keys > 0 && timestamp > lastKeyNs ? timestamp - lastKeyNs : 0;
+
+    // 지난 간격 - 유휴 타이머가 아직 보고하지 않았을 수 있는 멈춤/속도 하락
+    if (keys > 0) {
+        if (gap >= config.pauseMs * kNsPerMs) {
+            SetEvent(&out[count++], RHYTHM_EVENT_PAUSE, lastKeyNs + config.pauseMs * kNsPerMs, keys,
+                     gap / static_cast<double>(kNsPerMs));
+        }
+        rate *= exp(-(gap / static_cast<double>(kNsPerMs)) / windowMs);
+        if (rateHigh && rate < config.rateLowKps) {
+            SetEvent(&out[count++], RHYTHM_EVENT_RATE_LOW, RateLowAt(lastKeyNs, lastRate, config.rateLowKps, windowMs),
+                     keys, config.rateLowKps);
+            rateHigh = false;
+        }
+    }
+
+    // 이 키 - 키마다 1/window를 더하는 지수 가중 속도 (일정한 속도 r에서 평균 r)
+    const uint64_t key = keys + 1;
+    rate += 1000.0 / windowMs;
+
+    if (keys > 0 && !sessionStarted && gap < config.burstGapMs * kNsPerMs) {
+        m_burstRun++;
+    } else {
+        m_burstRun = 1;
+    }
+    if (m_burstRun == config.burstMinKeys) {
+        SetEvent(&out[count++], RHYTHM_EVENT_BURST, timestamp, key, static_cast<double>(m_burstRun));
+    }
+
+    if (!rateHigh && rate >= config.rateHighKps) {
+        SetEvent(&out[count++], RHYTHM_EVENT_RATE_HIGH, timestamp, key, rate);
+        rateHigh = true;
+    }
+
+    if (keys == 0 || sessionStarted) {
+        m_streakStartNs = timestamp;
+        m_streaks = 0;
+    } else if (config.streakMs > 0 && timestamp > m_streakStartNs) {
+        const uint64_t streaks = (timestamp - m_streakStartNs) / (config.streakMs * kNsPerMs);
+        if (streaks > m_streaks) {
+            m_streaks = streaks;
+            SetEvent(&out[count++], RHYTHM_EVENT_STREAK, timestamp, key,
+                     static_cast<double>(streaks) * config.streakMs);
+        }
+    }
+
+    // 유휴 확인과 공유하는 상태 게시 (홀수 표시 → 필드 → 짝수, 필드의 release 쓰기가 홀수 표시를 함께 게시)
+    const uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    m_keys.store(key, std::memory_order_release);
+    m_lastKeyNs.store(timestamp > lastKeyNs || keys == 0 ? timestamp : lastKeyNs, std::memory_order_release);
+    m_rate.store(rate, std::memory_order_release);
+    m_rateHigh.store(rateHigh, std::memory_order_release);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+
+    return count;
+}
+
+// 현재 간격 확인 (타이머 스레드)
+size_t RhythmDetector::CheckIdle(uint64_t now, RhythmEvent* out, uint64_t* deadline) const {
+    uint64_t sequence;
+    uint64_t keys;
+    uint64_t lastKeyNs;
+    double rate;
+    bool rateHigh;
+
+    // 쓰는 도중이면 다시 읽음 (쓰기 구간이 짧아 대부분 한 번에 끝남)
+    for (unsigned attempt = 0;; attempt++) {
+        sequence = m_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) == 0) {
+            keys = m_keys.load(std::memory_order_acquire);
+            lastKeyNs = m_lastKeyNs.load(std::memory_order_acquire);
+            rate = m_rate.load(std::memory_order_acquire);
+            rateHigh = m_rateHigh.load(std::memory_order_acquire);
+
+            if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+                break;
+            }
+        }
+        if (attempt >= 64) {
+            std::this_thread::yield();
+        }
+    }
+
+    *deadline = 0;
+    if (keys == 0) {
+        return 0;
+    }
+
+    const RhythmConfig config = GetConfig();
+    size_t count = 0;
+
+    const uint64_t pauseAt = lastKeyNs + config.pauseMs * kNsPerMs;
+    if (now >= pauseAt) {
+        SetEvent(&out[count++], RHYTHM_EVENT_PAUSE, pauseAt, keys, (now - lastKeyNs) / static_cast<double>(kNsPerMs));
+    } else {
+        *deadline = pauseAt;
+    }
+
+    if (rateHigh) {
+        const uint64_t lowAt = RateLowAt(lastKeyNs, rate, config.rateLowKps, config.rateWindowMs);
+        if (now >= lowAt) {
+            SetEvent(&out[count++], RHYTHM_EVENT_RATE_LOW, lowAt, keys, config.rateLowKps);
+        } else if (*deadline == 0 || lowAt < *deadline) {
+            *deadline = lowAt;
+        }
+    }
+
+    return count;
+}
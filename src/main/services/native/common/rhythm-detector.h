@@ -0,0 +1,90 @@
+#ifndef RHYTHM_DETECTOR_H
+#define RHYTHM_DETECTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// 리듬 판정 기본값
+#define DEFAULT_RHYTHM_BURST_GAP_MS 150     // 몰아치기 안에서 허용하는 키 간격
+#define DEFAULT_RHYTHM_BURST_MIN_KEYS 8     // 몰아치기로 판정할 연속 키 수
+#define DEFAULT_RHYTHM_PAUSE_MS 1000        // 멈춤 판정 간격
+#define DEFAULT_RHYTHM_RATE_HIGH_KPS 5.0    // 빠른 입력 진입 (초당 키 수, 약 60타)
+#define DEFAULT_RHYTHM_RATE_LOW_KPS 3.0     // 빠른 입력 해제 (진입보다 낮게 - 경계에서 깜빡이지 않도록)
+#define DEFAULT_RHYTHM_RATE_WINDOW_MS 2000  // 속도 지수 가중 평균의 시간 상수
+#define DEFAULT_RHYTHM_STREAK_MS 60000      // 연속 입력 단위 (세션이 이 길이의 배수를 넘을 때마다)
+
+// 한 번의 키 입력/유휴 확인이 만들 수 있는 최대 이벤트 수
+#define RHYTHM_MAX_EVENTS 5
+
+// 리듬 이벤트 종류 (세션 종료는 세션 단계가 따로 전달)
+enum RhythmEventType : uint8_t {
+    RHYTHM_EVENT_NONE = 0,
+    RHYTHM_EVENT_BURST = 1,       // 몰아치기 시작 - value: 연속 키 수
+    RHYTHM_EVENT_PAUSE = 2,       // 멈춤 - value: 지금까지 멈춘 시간 (ms)
+    RHYTHM_EVENT_RATE_HIGH = 3,   // 속도가 상한을 넘음 - value: 초당 키 수
+    RHYTHM_EVENT_RATE_LOW = 4,    // 속도가 하한 아래로 내려감 - value: 초당 키 수
+    RHYTHM_EVENT_STREAK = 5       // 연속 입력 - value: 세션 지속 시간 (ms, streakMs의 배수)
+};
+
+struct RhythmEvent {
+    uint64_t timestamp;   // 조건이 성립한 시각 (단조 시계 ns)
+    uint64_t gapKey;      // 멈춤/속도 하락: 그 간격 직전 키 번호 (중복 제거용), 나머지: 이벤트를 만든 키 번호
+    double value;
+    uint8_t type;         // RhythmEventType
+};
+
+struct RhythmConfig {
+    uint32_t burstGapMs;
+    uint32_t burstMinKeys;
+    uint32_t pauseMs;
+    double rateHighKps;
+    double rateLowKps;
+    uint32_t rateWindowMs;
+    uint32_t streakMs;
+};
+
+// 키 입력 흐름을 의미 이벤트로 바꾸는 상태 기계
+// - OnKeyPress: 후킹 스레드 전용 (유일한 쓰기 주체, 대기/할당 없음)
+//   키가 다시 들어왔을 때 지난 간격의 멈춤/속도 하락도 함께 보고 (타이머보다 키가 먼저 온 경우)
+// - CheckIdle: 다른 스레드(유휴 타이머)에서 읽기 전용으로 호출 - 간격 중에 성립한 멈춤/속도 하락
+//   두 경로가 같은 간격을 보고할 수 있으므로 전달하는 쪽이 gapKey로 중복을 거름 (세션 종료와 같은 방식)
+class RhythmDetector {
+public:
+    RhythmDetector();
+
+    // 판정 기준 (어느 스레드에서나 - 항목별로 원자적, 설정 중인 키는 새 값과 옛 값이 섞일 수 있음)
+    void Configure(const RhythmConfig& config);
+    RhythmConfig GetConfig() const;
+
+    // 세션에 포함되는 키 입력 처리 - sessionStarted면 연속 입력 시작 시각을 새로 잡음
+    // 지난 간격의 이벤트(멈춤, 속도 하락)가 앞, 이 키가 만든 이벤트가 뒤 → out에 채운 개수 반환
+    size_t OnKeyPress(uint64_t timestamp, bool sessionStarted, RhythmEvent* out);
+
+    // now 시점까지 현재 간격에서 성립한 이벤트를 out에 채움 (개수 반환)
+    // 아직 성립하지 않은 판정이 있으면 deadline에 가장 가까운 판정 시각 (없으면 0)
+    size_t CheckIdle(uint64_t now, RhythmEvent* out, uint64_t* deadline) const;
+
+private:
+    std::atomic<uint32_t> m_burstGapMs;
+    std::atomic<uint32_t> m_burstMinKeys;
+    std::atomic<uint32_t> m_pauseMs;
+    std::atomic<double> m_rateHighKps;
+    std::atomic<double> m_rateLowKps;
+    std::atomic<uint32_t> m_rateWindowMs;
+    std::atomic<uint32_t> m_streakMs;
+
+    // CheckIdle과 공유하는 상태 - 시퀀스 잠금 (짝수 = 안정, 홀수 = 쓰는 중)
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<uint64_t> m_keys;
+    std::atomic<uint64_t> m_lastKeyNs;
+    std::atomic<double> m_rate;        // 마지막 키 시점의 초당 키 수
+    std::atomic<bool> m_rateHigh;
+
+    // 후킹 스레드 전용
+    uint64_t m_burstRun;
+    uint64_t m_streakStartNs;
+    uint64_t m_streaks;
+};
+
+#endif // RHYTHM_DETECTOR_H
@@ -0,0 +1,117 @@
+#include "sessionizer.h"
+#include "event-clock.h"
+
+static const uint64_t kNsPerMs = 1000000ull;
+
+Sessionizer::Sessionizer()
+    : m_idleTimeoutMs(DEFAULT_SESSION_IDLE_TIMEOUT_MS),
+      m_sequence(0),
+      m_sessionSeq(0),
+      m_sessionStart(0),
+      m_lastKeyTime(0),
+      m_keyCount(0) {
+}
+
+void Sessionizer::SetIdleTimeout(uint32_t timeoutMs) {
+    m_idleTimeoutMs.store(timeoutMs, std::memory_order_relaxed);
+}
+
+uint32_t Sessionizer::GetIdleTimeout() const {
+    return m_idleTimeoutMs.load(std::memory_order_relaxed);
+}
+
+// 키 입력 처리 (후킹 스레드)
+bool Sessionizer::OnKeyPress(uint64_t timestamp, SessionRecord* record, SessionRecord* ended) {
+    const uint32_t timeoutMs = m_idleTimeoutMs.load(std::memory_order_relaxed);
+    uint32_t sessionSeq = m_sessionSeq.load(std::memory_order_relaxed);
+    uint64_t sessionStart = m_sessionStart.load(std::memory_order_relaxed);
+    const uint64_t lastKeyTime = m_lastKeyTime.load(std::memory_order_relaxed);
+    uint32_t keyCount = m_keyCount.load(std::memory_order_relaxed);
+
+    // 소스 시각이 뒤로 간 경우 (장치 간 순서 뒤바뀜 등) 간격은 0으로 취급
+    const uint64_t gap = (sessionSeq != 0 && timestamp > lastKeyTime) ? timestamp - lastKeyTime : 0;
+    bool sessionEnded = false;
+
+    if (sessionSeq == 0 || gap >= timeoutMs * kNsPerMs) {
+        // 이전 세션 종료 (유휴 타이머보다 키 입력이 먼저 도착한 경우)
+        if (sessionSeq != 0) {
+            FillEndRecord(sessionSeq, sessionStart, lastKeyTime, keyCount, timeoutMs, ended);
+            sessionEnded = true;
+        }
+
+        // 새 세션 시작
+        // 세션 ID가 세션 동안 바뀌지 않도록 시작 시각은 여기서 한 번만 벽시계로 변환
+        sessionSeq++;
+        sessionStart = EventClock::ToWallMsFloor(timestamp);
+        keyCount = 0;
+    }
+    keyCount++;
+
+    // 홀수로 올린 뒤 필드를 쓰고 짝수로 마침 (필드의 release 쓰기가 앞선 홀수 쓰기를 함께 게시)
+    const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    m_sessionSeq.store(sessionSeq, std::memory_order_release);
+    m_sessionStart.store(sessionStart, std::memory_order_release);
+    m_keyCount.store(keyCount, std::memory_order_release);
+    m_lastKeyTime.store(timestamp, std::memory_order_release);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+
+    record->timestamp = timestamp;
+    record->sessionStart = sessionStart;
+    record->sessionSeq = sessionSeq;
+    record->keyCount = keyCount;
+    record->interval = keyCount > 1 ? gap : 0;
+    record->type = SESSION_RECORD_TYPING;
+    record->appId = 0;
+
+    return sessionEnded;
+}
+
+// 유휴 상태 확인 (타이머 스레드)
+bool Sessionizer::CheckIdle(uint64_t now, SessionRecord* ended, uint64_t* deadline) const {
+    const uint32_t timeoutMs = m_idleTimeoutMs.load(std::memory_order_relaxed);
+    uint32_t sessionSeq;
+    uint64_t sessionStart;
+    uint64_t lastKeyTime;
+    uint32_t keyCount;
+
+    // 쓰는 중(홀수)이었거나 읽는 도중 키 입력이 반영되면 다시 읽음
+    // (필드를 acquire로 읽으므로 더 새 값을 봤다면 뒤의 순서 번호 읽기가 그 쓰기의 홀수 이후를 봄)
+    uint32_t sequence;
+    do {
+        sequence = m_sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+        sessionSeq = m_sessionSeq.load(std::memory_order_acquire);
+        sessionStart = m_sessionStart.load(std::memory_order_acquire);
+        lastKeyTime = m_lastKeyTime.load(std::memory_order_acquire);
+        keyCount = m_keyCount.load(std::memory_order_acquire);
+    } while ((sequence & 1) || sequence != m_sequence.load(std::memory_order_relaxed));
+
+    if (sessionSeq == 0) {
+        *deadline = 0;
+        return false;
+    }
+
+    const uint64_t idleAt = lastKeyTime + timeoutMs * kNsPerMs;
+    if (now >= idleAt) {
+        FillEndRecord(sessionSeq, sessionStart, lastKeyTime, keyCount, timeoutMs, ended);
+        return true;
+    }
+
+    *deadline = idleAt;
+    return false;
+}
+
+// 세션 종료 레코드 작성 (종료 시각 = 마지막 키 + 타임아웃, 기존 JS 타이머와 동일한 의미)
+void Sessionizer::FillEndRecord(uint32_t sessionSeq, uint64_t sessionStart, uint64_t lastKeyTime,
+                                uint32_t keyCount, uint32_t timeoutMs, SessionRecord* ended) const {
+    ended->timestamp = lastKeyTime + timeoutMs * kNsPerMs;
+    ended->sessionStart = sessionStart;
+    ended->sessionSeq = sessionSeq;
+    ended->keyCount = keyCount;
+    ended->interval = 0;
+    ended->type = SESSION_RECORD_END;
+    ended->appId = 0;
+}
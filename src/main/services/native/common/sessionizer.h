@@ -0,0 +1,65 @@
+#ifndef SESSIONIZER_H
+#define SESSIONIZER_H
+
+#include <stdint.h>
+#include <atomic>
+
+// 기본 세션 유휴 타임아웃 (밀리초) - 마지막 키 입력 후 이 시간이 지나면 세션 종료
+#define DEFAULT_SESSION_IDLE_TIMEOUT_MS 2000
+
+// 세션 레코드 종류
+enum SessionRecordType : uint8_t {
+    SESSION_RECORD_NONE = 0,     // 세션에 포함되지 않는 이벤트 (키 업, 특수 키)
+    SESSION_RECORD_TYPING = 1,   // 세션 내 키 입력
+    SESSION_RECORD_END = 2       // 세션 종료
+};
+
+// TypingMetadata에 대응하는 세션 레코드
+struct SessionRecord {
+    uint64_t timestamp;      // 키 입력 시각 또는 세션 종료 시각 (단조 시계 ns)
+    uint64_t sessionStart;   // 세션 시작 시각 (epoch ms, 세션 ID 생성용 - 세션 시작 시 한 번 변환)
+    uint64_t interval;       // 직전 키와의 간격 (ns, 세션 첫 키는 0)
+    uint32_t sessionSeq;     // 프로세스 내 세션 일련번호 (1부터)
+    uint32_t keyCount;       // 세션 내 누적 키 수
+    uint8_t type;            // SessionRecordType
+    uint16_t appId;          // 키를 받은 앱 (KeyEvent.appId, 세션 단계는 0으로 채우고 호출자가 설정)
+};
+
+// 키 입력을 세션 단위로 묶는 단계
+// - 시각은 모두 단조 시계 ns (타임아웃만 ms로 설정)
+// - OnKeyPress: 후킹 스레드 전용 (유일한 쓰기 주체, 대기/할당 없음)
+// - CheckIdle: 다른 스레드(유휴 타이머)에서 읽기 전용으로 호출
+class Sessionizer {
+public:
+    Sessionizer();
+
+    // 유휴 타임아웃 설정 (어느 스레드에서나 호출 가능)
+    void SetIdleTimeout(uint32_t timeoutMs);
+    uint32_t GetIdleTimeout() const;
+
+    // 세션에 포함되는 키 입력 처리 (키 다운, 비특수 키)
+    // 이전 세션이 유휴 타임아웃으로 끝났으면 ended에 종료 레코드를 채우고 true 반환
+    bool OnKeyPress(uint64_t timestamp, SessionRecord* record, SessionRecord* ended);
+
+    // 현재 세션이 now 시점에 유휴 상태인지 확인
+    // 유휴 상태면 ended에 종료 레코드를 채우고 true 반환
+    // 아직 진행 중이면 deadline에 유휴로 판정될 시각을 채움 (열린 세션이 없으면 0)
+    bool CheckIdle(uint64_t now, SessionRecord* ended, uint64_t* deadline) const;
+
+private:
+    std::atomic<uint32_t> m_idleTimeoutMs;
+
+    // 세션 상태 쓰기 순서 번호 - 쓰는 동안 홀수, 끝나면 짝수 (읽는 쪽은 홀수이거나 앞뒤가 다르면 다시 읽음)
+    // 필드는 release로 쓰고 acquire로 읽어 독립 펜스 없이 순서를 보장 (TSAN이 검사할 수 있도록)
+    std::atomic<uint32_t> m_sequence;
+
+    std::atomic<uint32_t> m_sessionSeq;
+    std::atomic<uint64_t> m_sessionStart;   // epoch ms
+    std::atomic<uint64_t> m_lastKeyTime;    // 단조 시계 ns
+    std::atomic<uint32_t> m_keyCount;
+
+    void FillEndRecord(uint32_t sessionSeq, uint64_t sessionStart, uint64_t lastKeyTime,
+                       uint32_t keyCount, uint32_t timeoutMs, SessionRecord* ended) const;
+};
+
+#endif // SESSIONIZER_H
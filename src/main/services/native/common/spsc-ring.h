@@ -0,0 +1,163 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+// 캐시 라인 크기 (false sharing 방지용 패딩)
+#define SPSC_CACHE_LINE_SIZE 64
+
+// 단일 생산자/단일 소비자 링 버퍼
+// - 생산자: OS 후킹 스레드 (TryPush/EvictOldest만 호출, 대기/할당 없음)
+// - 소비자: Node.js 메인 스레드 (TryPop만 호출)
+// 저장 공간은 모두 미리 할당되며, Capacity는 2의 거듭제곱이어야 함
+// 실제로 쌓을 수 있는 항목 수는 SetLimit으로 Capacity 이하로 줄일 수 있음
+// 슬롯은 원자 워드 배열로 복사 - 밀어내기(EvictOldest) 뒤에는 생산자가 소비자가 복사 중인 슬롯을
+// 다시 쓸 수 있으므로 (소비자는 tail CAS가 실패하면 복사본을 버림, 복사 자체는 데이터 경쟁이 아님)
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing items are copied word by word");
+
+public:
+    SpscRing() : m_head(0), m_cachedTail(0), m_limit(Capacity), m_tail(0), m_cachedHead(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // 생산자 전용: 항목 추가 (wait-free)
+    // 링이 가득 차면 false 반환 (항목은 버려짐)
+    // depth에는 추가 직후 소비자가 아직 가져가지 않은 항목 수를 기록
+    // (1이면 소비자가 모든 항목을 가져간 상태에서 이 항목이 들어간 것 - 깨우기 필요)
+    bool TryPush(const T& item, size_t* depth) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t limit = m_limit.load(std::memory_order_relaxed);
+
+        if (head - m_cachedTail >= limit) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail >= limit) {
+                return false;
+            }
+        }
+
+        StoreSlot(m_buffer[head & (Capacity - 1)], item);
+
+        // 게시 후 소비자 위치를 다시 읽음 (seq_cst: 소비자의 비어있음 확인과 짝을 이룸)
+        // 둘 중 적어도 한쪽은 상대의 갱신을 보게 되므로 깨우기 신호가 유실되지 않음
+        m_head.store(head + 1, std::memory_order_seq_cst);
+        const size_t tail = m_tail.load(std::memory_order_seq_cst);
+        m_cachedTail = tail;
+
+        if (depth) {
+            *depth = head + 1 - tail;
+        }
+        return true;
+    }
+
+    // 생산자 전용: 가장 오래된 항목 버리기 (오래된 항목 밀어내기 정책)
+    // 실제로 버렸으면 true, 비어 있거나 소비자가 먼저 가져갔으면 false
+    // (어느 쪽이든 호출 후 TryPush할 자리는 생김)
+    bool EvictOldest() {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        if (tail == m_head.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const bool evicted = m_tail.compare_exchange_strong(tail, tail + 1,
+                                                            std::memory_order_seq_cst,
+                                                            std::memory_order_acquire);
+        m_cachedTail = evicted ? tail + 1 : tail;
+        return evicted;
+    }
+
+    // 소비자 전용: 항목 꺼내기 (lock-free)
+    // 비어 있으면 false 반환
+    bool TryPop(T* out) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        for (;;) {
+            // 생산자가 밀어낸 뒤에는 tail이 캐시된 head를 앞지를 수 있으므로 부호 있는 차이로 비교
+            if (static_cast<ptrdiff_t>(m_cachedHead - tail) <= 0) {
+                m_cachedHead = m_head.load(std::memory_order_seq_cst);
+                if (tail == m_cachedHead) {
+                    return false;
+                }
+            }
+
+            LoadSlot(m_buffer[tail & (Capacity - 1)], out);
+
+            // 복사하는 동안 생산자가 이 항목을 밀어냈으면 (EvictOldest) tail이 이미 넘어가 있음
+            // 그 경우 복사본은 덮어써졌을 수 있으므로 버리고 새 tail에서 다시 시도
+            if (m_tail.compare_exchange_strong(tail, tail + 1,
+                                               std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+                return true;
+            }
+            m_cachedHead = m_head.load(std::memory_order_seq_cst);
+        }
+    }
+
+    // 현재 대기 중인 항목 수 (근사값, 어느 스레드에서나 호출 가능)
+    size_t Size() const {
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        return head - tail;
+    }
+
+    static constexpr size_t GetCapacity() { return Capacity; }
+
+    // 최대 대기 항목 수 (1 ~ Capacity로 제한, 어느 스레드에서나 호출 가능)
+    // 현재 깊이보다 작게 줄이면 소비자가 그 아래로 비울 때까지 TryPush가 실패함
+    void SetLimit(size_t limit) {
+        if (limit < 1) {
+            limit = 1;
+        } else if (limit > Capacity) {
+            limit = Capacity;
+        }
+        m_limit.store(limit, std::memory_order_relaxed);
+    }
+
+    size_t GetLimit() const { return m_limit.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kSlotWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> words[kSlotWords];
+    };
+
+    // 워드 단위 relaxed 복사 (순서는 m_head/m_tail의 게시/CAS가 보장)
+    static void StoreSlot(Slot& slot, const T& item) {
+        uint64_t words[kSlotWords] = {};
+        memcpy(words, &item, sizeof(T));
+        for (size_t i = 0; i < kSlotWords; i++) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    static void LoadSlot(const Slot& slot, T* out) {
+        uint64_t words[kSlotWords];
+        for (size_t i = 0; i < kSlotWords; i++) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        memcpy(static_cast<void*>(out), words, sizeof(T));
+    }
+
+    // 생산자 쪽 상태
+    alignas(SPSC_CACHE_LINE_SIZE) std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+    std::atomic<size_t> m_limit;
+
+    // 소비자 쪽 상태
+    alignas(SPSC_CACHE_LINE_SIZE) std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+
+    // 미리 할당된 슬롯
+    alignas(SPSC_CACHE_LINE_SIZE) Slot m_buffer[Capacity];
+};
+
+#endif // SPSC_RING_H
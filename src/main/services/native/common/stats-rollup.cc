@@ -0,0 +1,185 @@
+#include "stats-rollup.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+
+#define STATS_ROLLUP_HOUR_MS 3600000.0
+
+StatsRollup::StatsRollup()
+    : m_hourStartMs(0),
+      m_hourEndMs(0),
+      m_cachedDate(0),
+      m_cachedHour(0),
+      m_cachedDay(0) {
+    memset(&m_running, 0, sizeof(m_running));
+    memset(&m_taken, 0, sizeof(m_taken));
+}
+
+void StatsRollup::Add(const SessionRecord& record, double wallMs) {
+    if (record.type != SESSION_RECORD_TYPING) {
+        return;
+    }
+
+    // 같은 시간 구간이면 로컬 시각 변환 없이 버킷 위치 재사용
+    if (!(wallMs >= m_hourStartMs && wallMs < m_hourEndMs)) {
+        Locate(wallMs);
+    }
+
+    DayRollup& day = m_days[m_cachedDay];
+    AddTo(&day.total, record);
+    AddTo(&day.hours[m_cachedHour], record);
+    day.hourMask |= 1u << m_cachedHour;
+
+    AddRunning(record, wallMs);
+}
+
+void StatsRollup::Take(std::vector<RollupBucket>* daily, std::vector<RollupBucket>* hourly) {
+    std::sort(m_days.begin(), m_days.end(), [](const DayRollup& a, const DayRollup& b) {
+        return a.date < b.date;
+    });
+
+    for (const DayRollup& day : m_days) {
+        RollupBucket bucket;
+        bucket.date = day.date;
+        bucket.hour = STATS_ROLLUP_DAILY_HOUR;
+        bucket.delta = day.total;
+        daily->push_back(bucket);
+
+        for (int32_t hour = 0; hour < 24; hour++) {
+            if (day.hourMask & (1u << hour)) {
+                bucket.hour = hour;
+                bucket.delta = day.hours[hour];
+                hourly->push_back(bucket);
+            }
+        }
+    }
+
+    m_days.clear();
+    m_hourStartMs = 0;
+    m_hourEndMs = 0;
+    m_taken = m_running;
+}
+
+bool StatsRollup::SeedRunning(const RollupRunning& running) {
+    if (m_running.date != 0) {
+        return false;
+    }
+    m_running = running;
+    m_taken = running;
+    return true;
+}
+
+bool StatsRollup::Reconcile(const RollupRunning& stored) {
+    if (stored.date == 0 || stored.date != m_running.date || stored.date != m_taken.date) {
+        return false;
+    }
+
+    // Take 이후 더해진 값 (같은 날짜 안에서는 누적이 줄지 않음)
+    RollupDelta& today = m_running.today;
+    const RollupDelta& taken = m_taken.today;
+    today.keys = stored.today.keys + (today.keys - taken.keys);
+    today.sessions = stored.today.sessions + (today.sessions - taken.sessions);
+    today.activeNs = stored.today.activeNs + (today.activeNs - taken.activeNs);
+    today.intervalCount = stored.today.intervalCount + (today.intervalCount - taken.intervalCount);
+    today.intervalSum = stored.today.intervalSum + (today.intervalSum - taken.intervalSum);
+    today.intervalSumSq = stored.today.intervalSumSq + (today.intervalSumSq - taken.intervalSumSq);
+    for (int hour = 0; hour < 24; hour++) {
+        m_running.hourKeys[hour] = stored.hourKeys[hour] + (m_running.hourKeys[hour] - m_taken.hourKeys[hour]);
+    }
+
+    m_running.streakDays = stored.streakDays;
+    m_running.bestStreakDays = std::max(stored.bestStreakDays, stored.streakDays);
+
+    // 같은 보정을 다시 받아도 결과가 같도록 기준을 DB 값으로 옮김
+    m_taken.today = stored.today;
+    memcpy(m_taken.hourKeys, stored.hourKeys, sizeof(m_taken.hourKeys));
+    return true;
+}
+
+// 다음 로컬 날짜 (YYYYMMDD)
+static uint32_t NextDate(uint32_t date) {
+    struct tm local;
+    memset(&local, 0, sizeof(local));
+    local.tm_year = static_cast<int>(date / 10000) - 1900;
+    local.tm_mon = static_cast<int>((date / 100) % 100) - 1;
+    local.tm_mday = static_cast<int>(date % 100) + 1;
+    local.tm_hour = 12;   // 일광 절약 시간 전환과 무관하도록 정오 기준
+    local.tm_isdst = -1;
+    mktime(&local);
+    return static_cast<uint32_t>((local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday);
+}
+
+// 누적 통계 갱신 (Locate로 찾은 날짜/시간 사용)
+void StatsRollup::AddRunning(const SessionRecord& record, double wallMs) {
+    if (m_cachedDate != m_running.date) {
+        // 시계가 뒤로 간 경우 지난 날짜의 레코드는 증분에만 반영
+        if (m_cachedDate < m_running.date) {
+            return;
+        }
+
+        m_running.streakDays = m_running.date != 0 && NextDate(m_running.date) == m_cachedDate
+            ? m_running.streakDays + 1
+            : 1;
+        m_running.bestStreakDays = std::max(m_running.bestStreakDays, m_running.streakDays);
+        m_running.date = m_cachedDate;
+        memset(&m_running.today, 0, sizeof(m_running.today));
+        memset(m_running.hourKeys, 0, sizeof(m_running.hourKeys));
+    }
+
+    AddTo(&m_running.today, record);
+    m_running.hourKeys[m_cachedHour]++;
+    m_running.sessionSeq = record.sessionSeq;
+    m_running.sessionKeys = record.keyCount;
+    m_running.sessionStart = record.sessionStart;
+    m_running.lastKeyMs = wallMs;
+}
+
+// wallMs가 속한 로컬 날짜/시간 버킷을 찾고 (없으면 추가) 시간 구간을 기억
+void StatsRollup::Locate(double wallMs) {
+    const double secondMs = floor(wallMs / 1000.0) * 1000.0;
+    const time_t seconds = static_cast<time_t>(secondMs / 1000.0);
+
+    struct tm local;
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+
+    m_cachedDate = static_cast<uint32_t>((local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday);
+    m_cachedHour = local.tm_hour;
+
+    // 시간 경계는 로컬 시각의 정각 (30분 단위 시간대도 정각 기준으로 나뉨)
+    m_hourStartMs = secondMs - (local.tm_min * 60 + local.tm_sec) * 1000.0;
+    m_hourEndMs = m_hourStartMs + STATS_ROLLUP_HOUR_MS;
+
+    for (size_t i = m_days.size(); i > 0; i--) {
+        if (m_days[i - 1].date == m_cachedDate) {
+            m_cachedDay = i - 1;
+            return;
+        }
+    }
+
+    DayRollup day;
+    memset(&day, 0, sizeof(day));
+    day.date = m_cachedDate;
+    m_days.push_back(day);
+    m_cachedDay = m_days.size() - 1;
+}
+
+void StatsRollup::AddTo(RollupDelta* delta, const SessionRecord& record) {
+    delta->keys++;
+
+    // 세션 첫 키는 간격이 없음
+    if (record.keyCount <= 1) {
+        delta->sessions++;
+        return;
+    }
+
+    const double intervalMs = record.interval / 1e6;
+    delta->activeNs += record.interval;
+    delta->intervalCount++;
+    delta->intervalSum += intervalMs;
+    delta->intervalSumSq += intervalMs * intervalMs;
+}
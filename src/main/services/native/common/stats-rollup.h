@@ -0,0 +1,95 @@
+#ifndef STATS_ROLLUP_H
+#define STATS_ROLLUP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "sessionizer.h"
+
+// 일별 통계 행 대신 쓰는 시간 구분값
+#define STATS_ROLLUP_DAILY_HOUR -1
+
+// 집계 증분 (마지막 Take 이후 더해진 값 - DB에는 더하기 upsert로 반영)
+struct RollupDelta {
+    uint64_t keys;            // 세션에 포함된 키 입력 수
+    uint64_t sessions;        // 시작된 세션 수 (세션 첫 키가 속한 날/시간에 집계)
+    uint64_t activeNs;        // 활동 시간 - 세션 내 키 간격의 합 (키가 속한 날/시간에 집계)
+    uint64_t intervalCount;   // 간격 적률 (ms 단위 합/제곱합 - 병합 가능한 형태)
+    double intervalSum;
+    double intervalSumSq;
+};
+
+// 날짜/시간 단위 집계 행
+struct RollupBucket {
+    uint32_t date;            // 로컬 날짜 YYYYMMDD
+    int32_t hour;             // 로컬 시간 0-23, 일별 행이면 STATS_ROLLUP_DAILY_HOUR
+    RollupDelta delta;
+};
+
+// 가장 최근 입력 날짜의 누적 통계 (Take로 비우지 않음 - 빠른 시작 스냅샷에 그대로 저장)
+// 파일에 그대로 쓰는 고정 배치 구조체이므로 필드를 바꾸면 스냅샷 버전도 올려야 함
+struct RollupRunning {
+    uint32_t date;            // 로컬 날짜 YYYYMMDD (0 = 기록 없음)
+    uint32_t streakDays;      // date까지 하루도 빠짐없이 입력한 날 수
+    uint32_t bestStreakDays;  // 가장 긴 연속 입력 일수
+    uint32_t sessionSeq;      // 마지막 세션 (세션 ID = session_<sessionStart>_<sessionSeq>)
+    uint32_t sessionKeys;
+    uint32_t reserved;
+    uint64_t sessionStart;    // epoch ms
+    double lastKeyMs;         // 마지막 키 입력 시각 (epoch ms)
+    RollupDelta today;        // date의 누적
+    uint64_t hourKeys[24];    // date의 시간별 키 입력 수 (가장 활발한 시간 계산용)
+};
+
+// 일별/시간별 타이핑 통계 증분 집계
+// 타이핑 레코드마다 해당 날짜와 시간 버킷에 O(1)로 더하고, Take로 증분을 꺼내 비움
+// (현재 시간 구간을 기억해 두므로 시간이 바뀔 때만 로컬 시각 변환을 수행)
+// 증분과 별도로 가장 최근 날짜의 누적과 연속 입력 일수를 유지 (GetRunning)
+// 스레드 안전하지 않음 - 한 스레드(JS 스레드)에서만 호출해야 함
+class StatsRollup {
+public:
+    StatsRollup();
+
+    // 타이핑 레코드 반영 (wallMs: 레코드 시각을 epoch ms로 변환한 값)
+    void Add(const SessionRecord& record, double wallMs);
+
+    // 마지막 Take 이후 갱신된 일별/시간별 증분을 꺼내고 비움 (날짜, 시간 오름차순)
+    void Take(std::vector<RollupBucket>* daily, std::vector<RollupBucket>* hourly);
+
+    bool IsEmpty() const { return m_days.empty(); }
+
+    // 누적 통계 (스냅샷 저장/조회용)
+    const RollupRunning& GetRunning() const { return m_running; }
+    // 스냅샷에서 읽은 누적으로 시작 (이미 더해진 레코드가 없을 때만 - 있으면 false)
+    bool SeedRunning(const RollupRunning& running);
+    // DB에 반영된 누적으로 보정 - stored는 마지막 Take까지의 레코드가 반영된 DB 값
+    // 오늘 누적은 stored + (Take 이후 더해진 값)으로 바꾸고 연속 입력 일수는 stored 값 사용
+    // stored의 날짜가 마지막 Take 시점과 현재 날짜 모두와 같을 때만 반영 (아니면 false)
+    bool Reconcile(const RollupRunning& stored);
+
+private:
+    struct DayRollup {
+        uint32_t date;
+        uint32_t hourMask;    // 갱신된 시간 비트
+        RollupDelta total;
+        RollupDelta hours[24];
+    };
+
+    std::vector<DayRollup> m_days;
+
+    RollupRunning m_running;
+    RollupRunning m_taken;    // 마지막 Take 시점의 누적
+
+    // 현재 시간 구간 [m_hourStartMs, m_hourEndMs)과 해당 버킷 위치
+    double m_hourStartMs;
+    double m_hourEndMs;
+    uint32_t m_cachedDate;
+    int32_t m_cachedHour;
+    size_t m_cachedDay;
+
+    void Locate(double wallMs);
+    void AddRunning(const SessionRecord& record, double wallMs);
+    static void AddTo(RollupDelta* delta, const SessionRecord& record);
+};
+
+#endif // STATS_ROLLUP_H
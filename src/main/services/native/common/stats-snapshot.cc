@@ -0,0 +1,140 @@
+#include "stats-snapshot.h"
+#include "checksum.h"
+
+#include <iostream>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static const char kSnapshotMagic[8] = { 'T', 'H', 'S', 'N', 'A', 'P', '\0', '\1' };
+
+static uint32_t SnapshotChecksum(const StatsSnapshotFile* file) {
+    return Fnv1a(file, offsetof(StatsSnapshotFile, checksum));
+}
+
+static bool Validate(const StatsSnapshotFile* file) {
+    return memcmp(file->magic, kSnapshotMagic, sizeof(kSnapshotMagic)) == 0 &&
+           file->version == STATS_SNAPSHOT_VERSION &&
+           file->size == sizeof(StatsSnapshotFile) &&
+           file->checksum == SnapshotChecksum(file);
+}
+
+bool StatsSnapshot::Save(const char* path, const RollupRunning& running, uint64_t savedAt) {
+    // 패딩까지 0으로 채워야 체크섬이 내용에만 의존함
+    StatsSnapshotFile file;
+    memset(&file, 0, sizeof(file));
+    memcpy(file.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    file.version = STATS_SNAPSHOT_VERSION;
+    file.size = sizeof(StatsSnapshotFile);
+    file.savedAt = savedAt;
+    file.running = running;
+    file.checksum = SnapshotChecksum(&file);
+
+    const std::string tempPath = std::string(path) + ".tmp";
+
+#ifdef _WIN32
+    FILE* out = fopen(tempPath.c_str(), "wb");
+    if (!out) {
+        std::cerr << "Failed to create stats snapshot: " << tempPath << std::endl;
+        return false;
+    }
+    const bool written = fwrite(&file, sizeof(file), 1, out) == 1;
+    if (fclose(out) != 0 || !written) {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    // Windows의 rename은 기존 파일을 덮어쓰지 않음 (교체 사이에 종료되면 다음 시작은 DB에서 시작)
+    remove(path);
+    if (rename(tempPath.c_str(), path) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+#else
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        std::cerr << "Failed to create stats snapshot: " << tempPath << std::endl;
+        return false;
+    }
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&file);
+    size_t offset = 0;
+    while (offset < sizeof(file)) {
+        const ssize_t result = write(fd, bytes + offset, sizeof(file) - offset);
+        if (result <= 0) {
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
+        }
+        offset += static_cast<size_t>(result);
+    }
+
+    // 이름을 바꾸기 전에 내용을 디스크에 내림 (교체 후 전원이 꺼져도 빈 파일이 남지 않도록)
+    if (fsync(fd) != 0) {
+        close(fd);
+        unlink(tempPath.c_str());
+        return false;
+    }
+    close(fd);
+
+    if (rename(tempPath.c_str(), path) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool StatsSnapshot::Load(const char* path, RollupRunning* running, uint64_t* savedAt) {
+#ifdef _WIN32
+    // Windows는 메모리 매핑 대신 한 번에 읽음 (파일이 수백 바이트)
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        return false;
+    }
+    StatsSnapshotFile file;
+    const bool complete = fread(&file, sizeof(file), 1, in) == 1 && fgetc(in) == EOF;
+    fclose(in);
+    if (!complete || !Validate(&file)) {
+        return false;
+    }
+    *running = file.running;
+    *savedAt = file.savedAt;
+    return true;
+#else
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(sizeof(StatsSnapshotFile))) {
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(nullptr, sizeof(StatsSnapshotFile), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    const StatsSnapshotFile* file = static_cast<const StatsSnapshotFile*>(map);
+    const bool valid = Validate(file);
+    if (valid) {
+        *running = file->running;
+        *savedAt = file->savedAt;
+    }
+    munmap(map, sizeof(StatsSnapshotFile));
+    return valid;
+#endif
+}
@@ -0,0 +1,33 @@
+#ifndef STATS_SNAPSHOT_H
+#define STATS_SNAPSHOT_H
+
+#include <stdint.h>
+#include "stats-rollup.h"
+
+// 스냅샷 파일 형식 버전 (RollupRunning 배치가 바뀌면 올림 - 다른 버전은 읽지 않고 DB에서 다시 시작)
+#define STATS_SNAPSHOT_VERSION 1
+
+// 통계 스냅샷 파일 (고정 크기 - 통째로 쓰고 통째로 읽음)
+struct StatsSnapshotFile {
+    char magic[8];            // "THSNAP\0\1"
+    uint32_t version;
+    uint32_t size;            // sizeof(StatsSnapshotFile)
+    uint64_t savedAt;         // epoch ms
+    RollupRunning running;
+    uint32_t reserved;
+    uint32_t checksum;        // 앞부분 전체의 FNV-1a
+};
+
+// 빠른 시작용 누적 통계 스냅샷
+// 시작할 때 DB를 열고 집계하기 전에 마지막 누적 통계를 바로 보여 주기 위한 작은 파일
+// 저장은 임시 파일에 쓴 뒤 이름을 바꿔 교체하므로 저장 도중 종료되어도 이전 스냅샷이 남음
+class StatsSnapshot {
+public:
+    // 스냅샷 저장 (path.tmp에 쓰고 path로 교체)
+    static bool Save(const char* path, const RollupRunning& running, uint64_t savedAt);
+
+    // 스냅샷 읽기 (메모리 매핑 후 검증) - 파일이 없거나 크기/매직/버전/체크섬이 맞지 않으면 false
+    static bool Load(const char* path, RollupRunning* running, uint64_t* savedAt);
+};
+
+#endif // STATS_SNAPSHOT_H
@@ -0,0 +1,181 @@
+#include "time-bucket-index.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#define TIME_INDEX_MINUTE_MS 60000.0
+#define TIME_INDEX_DAY_MINUTES 1440
+#define TIME_INDEX_INITIAL_DAYS 64
+
+// Fenwick 트리 - index 위치에 더함 (0부터)
+static void FenwickAdd(TimeBucketValue* tree, size_t size, size_t index, const TimeBucketValue& value) {
+    for (size_t i = index + 1; i <= size; i += i & (~i + 1)) {
+        tree[i - 1].Add(value);
+    }
+}
+
+// Fenwick 트리 - 앞 count개의 합
+static TimeBucketValue FenwickPrefix(const TimeBucketValue* tree, size_t count) {
+    TimeBucketValue sum = {};
+    for (size_t i = count; i > 0; i -= i & (~i + 1)) {
+        sum.Add(tree[i - 1]);
+    }
+    return sum;
+}
+
+static TimeBucketValue HourValue(const TimeBucketValue* hours, size_t hour) {
+    TimeBucketValue value = FenwickPrefix(hours, hour + 1);
+    value.Subtract(FenwickPrefix(hours, hour));
+    return value;
+}
+
+static int64_t ToMinute(double wallMs) {
+    return wallMs > 0 ? static_cast<int64_t>(floor(wallMs / TIME_INDEX_MINUTE_MS)) : 0;
+}
+
+TimeBucketIndex::TimeBucketIndex()
+    : m_firstDay(0),
+      m_allocatedDays(0),
+      m_minuteHours(0) {
+}
+
+void TimeBucketIndex::Add(double wallMs, const TimeBucketValue& value) {
+    if (value.IsEmpty()) {
+        return;
+    }
+
+    const int64_t minute = ToMinute(wallMs);
+    const int64_t day = minute / TIME_INDEX_DAY_MINUTES;
+    Reserve(day);
+
+    const size_t index = static_cast<size_t>(day - m_firstDay);
+    std::unique_ptr<DayBuckets>& bucket = m_days[index];
+    if (!bucket) {
+        bucket.reset(new DayBuckets());
+        m_allocatedDays++;
+    }
+
+    const size_t hour = static_cast<size_t>((minute % TIME_INDEX_DAY_MINUTES) / 60);
+    const uint8_t minuteOfHour = static_cast<uint8_t>(minute % 60);
+
+    if (!bucket->minutes[hour]) {
+        const TimeBucketValue hourValue = HourValue(bucket->hours, hour);
+        if (hourValue.IsEmpty()) {
+            bucket->anchor[hour] = minuteOfHour;
+        } else if (bucket->anchor[hour] != minuteOfHour) {
+            // 같은 시간의 다른 분 - 분 트리를 만들고 몰아 둔 값을 anchor 분으로 옮김
+            bucket->minutes[hour].reset(new MinuteTree());
+            FenwickAdd(bucket->minutes[hour]->tree, 60, bucket->anchor[hour], hourValue);
+            m_minuteHours++;
+        }
+    }
+    if (bucket->minutes[hour]) {
+        FenwickAdd(bucket->minutes[hour]->tree, 60, minuteOfHour, value);
+    }
+
+    FenwickAdd(bucket->hours, 24, hour, value);
+    FenwickAdd(m_dayTree.data(), m_dayTree.size(), index, value);
+}
+
+TimeBucketValue TimeBucketIndex::Query(double startMs, double endMs) const {
+    const int64_t start = ToMinute(startMs);
+    const int64_t end = ToMinute(endMs);
+    if (end <= start) {
+        return TimeBucketValue();
+    }
+
+    TimeBucketValue sum = Prefix(end);
+    sum.Subtract(Prefix(start));
+    return sum;
+}
+
+void TimeBucketIndex::Clear() {
+    m_firstDay = 0;
+    m_days.clear();
+    m_dayTree.clear();
+    m_allocatedDays = 0;
+    m_minuteHours = 0;
+}
+
+size_t TimeBucketIndex::MemoryBytes() const {
+    return m_days.capacity() * sizeof(m_days[0]) +
+           m_dayTree.capacity() * sizeof(TimeBucketValue) +
+           m_allocatedDays * sizeof(DayBuckets) +
+           m_minuteHours * sizeof(MinuteTree);
+}
+
+// minute 이전(미포함) 모든 버킷의 합 - 날짜 트리 + 그날의 시간 트리 + 그 시간의 분 트리
+TimeBucketValue TimeBucketIndex::Prefix(int64_t minute) const {
+    TimeBucketValue sum = {};
+    const int64_t day = minute / TIME_INDEX_DAY_MINUTES;
+    if (m_days.empty() || day < m_firstDay) {
+        return sum;
+    }
+
+    const size_t index = static_cast<size_t>(day - m_firstDay);
+    if (index >= m_days.size()) {
+        return FenwickPrefix(m_dayTree.data(), m_dayTree.size());
+    }
+
+    sum = FenwickPrefix(m_dayTree.data(), index);
+    const DayBuckets* bucket = m_days[index].get();
+    if (!bucket) {
+        return sum;
+    }
+
+    const size_t hour = static_cast<size_t>((minute % TIME_INDEX_DAY_MINUTES) / 60);
+    const size_t minuteOfHour = static_cast<size_t>(minute % 60);
+    sum.Add(FenwickPrefix(bucket->hours, hour));
+
+    if (bucket->minutes[hour]) {
+        sum.Add(FenwickPrefix(bucket->minutes[hour]->tree, minuteOfHour));
+    } else if (minuteOfHour > bucket->anchor[hour]) {
+        sum.Add(HourValue(bucket->hours, hour));
+    }
+    return sum;
+}
+
+// day가 날짜 범위에 들도록 앞뒤로 늘림 (늘어난 만큼 이상 여유를 둬서 재구성 횟수를 로그로 제한)
+void TimeBucketIndex::Reserve(int64_t day) {
+    if (m_days.empty()) {
+        // 첫 기록이 지난 기록의 시작이면 대부분 앞으로 자라므로 뒤쪽에 여유를 둠
+        m_firstDay = day;
+        m_days.resize(TIME_INDEX_INITIAL_DAYS);
+        m_dayTree.assign(TIME_INDEX_INITIAL_DAYS, TimeBucketValue());
+        return;
+    }
+
+    const int64_t size = static_cast<int64_t>(m_days.size());
+    if (day >= m_firstDay && day < m_firstDay + size) {
+        return;
+    }
+
+    if (day >= m_firstDay + size) {
+        m_days.resize(static_cast<size_t>(std::max(size * 2, day - m_firstDay + 1)));
+    } else {
+        const int64_t newFirst = std::max<int64_t>(0, std::min(day, m_firstDay - size));
+        const size_t shift = static_cast<size_t>(m_firstDay - newFirst);
+        std::vector<std::unique_ptr<DayBuckets>> days(m_days.size() + shift);
+        std::move(m_days.begin(), m_days.end(), days.begin() + shift);
+        m_days.swap(days);
+        m_firstDay = newFirst;
+    }
+    RebuildDayTree();
+}
+
+// 날짜별 합(시간 트리 전체 합)에서 날짜 트리를 O(n)으로 다시 구성
+void TimeBucketIndex::RebuildDayTree() {
+    const size_t size = m_days.size();
+    m_dayTree.assign(size, TimeBucketValue());
+    for (size_t i = 0; i < size; i++) {
+        if (m_days[i]) {
+            m_dayTree[i] = FenwickPrefix(m_days[i]->hours, 24);
+        }
+    }
+    for (size_t i = 1; i <= size; i++) {
+        const size_t parent = i + (i & (~i + 1));
+        if (parent <= size) {
+            m_dayTree[parent - 1].Add(m_dayTree[i - 1]);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef TIME_BUCKET_INDEX_H
+#define TIME_BUCKET_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+
+// 버킷 값 (Fenwick 트리 노드도 같은 형태 - 구간 합)
+struct TimeBucketValue {
+    uint64_t keys;            // 키 입력 수
+    uint64_t activeUs;        // 활동 시간 (us - 정수로 더해 누적 오차 없음)
+    uint64_t sessions;        // 시작된 세션 수
+
+    void Add(const TimeBucketValue& other) {
+        keys += other.keys;
+        activeUs += other.activeUs;
+        sessions += other.sessions;
+    }
+    void Subtract(const TimeBucketValue& other) {
+        keys -= other.keys;
+        activeUs -= other.activeUs;
+        sessions -= other.sessions;
+    }
+    bool IsEmpty() const { return keys == 0 && activeUs == 0 && sessions == 0; }
+};
+
+// 분 단위 시간 버킷 색인 - 임의의 [start, end) 구간 합을 O(log n)으로 조회 (n = 기록이 있는 기간의 날짜 수)
+// 3단계 Fenwick 트리: 날짜(UTC 일, 전체 기간) → 날짜별 시간(24) → 시간별 분(60)
+// - 구간은 분 단위로 내림 (시간대 오프셋은 15분 단위이므로 로컬 날짜/시간 경계는 정확)
+// - 분 트리는 한 시간에 서로 다른 분의 값이 들어올 때만 할당하고, 그 전까지는 시간 값을 한 분에 몰아 둠
+//   (DB에서 읽은 시간 단위 기록은 로컬 시간의 시작 분에 놓이므로 지난 기록은 메모리를 거의 쓰지 않음)
+// - 날짜 범위는 앞뒤로 자라며 자랄 때만 O(n)으로 다시 구성 (두 배씩 늘려 추가당 평균 O(log n))
+// 스레드 안전하지 않음 - 한 스레드(JS 스레드)에서만 호출해야 함
+class TimeBucketIndex {
+public:
+    TimeBucketIndex();
+
+    // wallMs(epoch ms)가 속한 분 버킷에 더함
+    void Add(double wallMs, const TimeBucketValue& value);
+    // [startMs, endMs) 구간 합 (분 단위로 내림)
+    TimeBucketValue Query(double startMs, double endMs) const;
+    void Clear();
+
+    size_t DayCount() const { return m_days.size(); }        // 날짜 트리 크기
+    size_t MinuteHourCount() const { return m_minuteHours; } // 분 트리가 할당된 시간 수
+    size_t MemoryBytes() const;
+
+private:
+    struct MinuteTree {
+        TimeBucketValue tree[60];
+    };
+
+    struct DayBuckets {
+        TimeBucketValue hours[24];                   // 시간 Fenwick 트리
+        std::unique_ptr<MinuteTree> minutes[24];     // 분 Fenwick 트리 (없으면 시간 값 전체가 anchor 분에 있음)
+        uint8_t anchor[24];
+    };
+
+    int64_t m_firstDay;                              // m_days[0]의 날짜 (epoch 이후 UTC 일 수)
+    std::vector<std::unique_ptr<DayBuckets>> m_days; // 기록이 없는 날은 nullptr
+    std::vector<TimeBucketValue> m_dayTree;          // 날짜 Fenwick 트리 (m_days와 같은 크기)
+    size_t m_allocatedDays;
+    size_t m_minuteHours;
+
+    TimeBucketValue Prefix(int64_t minute) const;
+    void Reserve(int64_t day);
+    void RebuildDayTree();
+};
+
+#endif // TIME_BUCKET_INDEX_H
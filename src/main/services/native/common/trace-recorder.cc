@@ -0,0 +1,299 @@
+#include "trace-recorder.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// 가상 트랙(트랙 이름 ID)을 스레드 번호와 겹치지 않게 쓰는 tid
+#define TRACE_TRACK_TID_BASE 0x10000
+
+static const char* const kBuiltinNames[TRACE_NAME_BUILTIN_COUNT] = {
+    "", "os-delivery", "hook", "ring-wait", "js-dispatch", "OS input"
+};
+
+// 스레드가 끝날 때 버퍼를 돌려주기 위한 thread_local 핸들
+struct TraceThreadHandle {
+    TraceRecorder::ThreadBuffer* buffer;
+    const char* name;   // 마지막으로 NameCurrentThread에 넘긴 이름 (같은 포인터면 잠그지 않음)
+
+    TraceThreadHandle() : buffer(nullptr), name(nullptr) {}
+    ~TraceThreadHandle() {
+        if (buffer) {
+            TraceRecorder::Shared().ReleaseBuffer(buffer);
+        }
+    }
+};
+
+static thread_local TraceThreadHandle t_handle;
+
+// JSON 문자열 출력 (JS에서 받은 이름의 따옴표/제어 문자 처리)
+static void WriteJsonString(FILE* file, const std::string& value) {
+    fputc('"', file);
+    for (unsigned char c : value) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+TraceRecorder& TraceRecorder::Shared() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : m_enabled(false), m_nextTraceId(0), m_file(nullptr), m_firstEvent(true), m_events(0),
+      m_droppedBase(0), m_pid(0) {
+    for (size_t i = 0; i < TRACE_NAME_BUILTIN_COUNT; i++) {
+        m_names.push_back(kBuiltinNames[i]);
+        if (i != TRACE_NAME_NONE) {
+            m_nameIds.emplace(kBuiltinNames[i], static_cast<uint16_t>(i));
+        }
+    }
+}
+
+bool TraceRecorder::Start(const char* path, std::string* error) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file) {
+        *error = "trace already started: " + m_path;
+        return false;
+    }
+
+    m_file = fopen(path, "wb");
+    if (!m_file) {
+        *error = std::string("cannot open trace file: ") + path;
+        return false;
+    }
+
+    // 이전 기록 이후 남은 구간은 버림 (파일 앞부분에 엉뚱한 시각의 구간이 섞이지 않도록)
+    for (auto& buffer : m_buffers) {
+        DrainLocked(buffer.get(), false);
+        buffer->nameWritten = false;
+    }
+    m_trackNamed.assign(m_names.size(), false);
+
+    m_path = path;
+    m_firstEvent = true;
+    m_events = 0;
+    m_droppedBase = TotalDropped();
+    m_pid = static_cast<int>(getpid());
+
+    // JSON 배열 형식 - 닫는 괄호가 없어도 (비정상 종료) 도구가 읽을 수 있음
+    fputs("[\n", m_file);
+    fflush(m_file);
+
+    m_enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool TraceRecorder::Stop(TraceSummary* summary) {
+    m_enabled.store(false, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file) {
+        return false;
+    }
+
+    for (auto& buffer : m_buffers) {
+        DrainLocked(buffer.get(), true);
+    }
+    fputs("\n]\n", m_file);
+    fclose(m_file);
+    m_file = nullptr;
+
+    if (summary) {
+        summary->path = m_path;
+        summary->events = m_events;
+        summary->dropped = TotalDropped() - m_droppedBase;
+    }
+    return true;
+}
+
+void TraceRecorder::Flush(TraceSummary* summary) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file) {
+        return;
+    }
+
+    for (auto& buffer : m_buffers) {
+        DrainLocked(buffer.get(), true);
+    }
+    fflush(m_file);
+
+    if (summary) {
+        summary->path = m_path;
+        summary->events = m_events;
+        summary->dropped = TotalDropped() - m_droppedBase;
+    }
+}
+
+uint16_t TraceRecorder::Intern(const char* name, size_t length) {
+    if (!name || length == 0) {
+        return TRACE_NAME_NONE;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string key(name, length);
+    auto found = m_nameIds.find(key);
+    if (found != m_nameIds.end()) {
+        return found->second;
+    }
+    if (m_names.size() >= TRACE_MAX_NAMES) {
+        return TRACE_NAME_NONE;
+    }
+
+    m_names.push_back(key);
+    m_trackNamed.resize(m_names.size(), false);
+    const uint16_t id = static_cast<uint16_t>(m_names.size() - 1);
+    m_nameIds.emplace(std::move(key), id);
+    return id;
+}
+
+void TraceRecorder::Record(uint16_t name, uint16_t track, uint64_t startNs, uint64_t endNs, uint64_t traceId,
+                           uint8_t flow) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    ThreadBuffer* buffer = t_handle.buffer;
+    if (!buffer) {
+        buffer = AcquireBuffer();
+        t_handle.buffer = buffer;
+    }
+
+    const size_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) >= TRACE_BUFFER_CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TraceSpan& span = buffer->spans[head & (TRACE_BUFFER_CAPACITY - 1)];
+    span.startNs = startNs;
+    span.endNs = endNs > startNs ? endNs : startNs;
+    span.traceId = traceId;
+    span.name = name;
+    span.track = track;
+    span.flow = flow;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void TraceRecorder::NameCurrentThread(const char* name) {
+    if (t_handle.name == name) {
+        return;
+    }
+
+    if (!t_handle.buffer) {
+        t_handle.buffer = AcquireBuffer();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    t_handle.buffer->name = name;
+    t_handle.buffer->nameWritten = false;
+    t_handle.name = name;
+}
+
+// 현재 스레드용 버퍼 - 비어 있는 반납 버퍼를 재사용하고 없으면 새로 만듦
+TraceRecorder::ThreadBuffer* TraceRecorder::AcquireBuffer() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) {
+        if (!buffer->owned.load(std::memory_order_acquire) &&
+            buffer->head.load(std::memory_order_relaxed) == buffer->tail.load(std::memory_order_relaxed)) {
+            buffer->owned.store(true, std::memory_order_relaxed);
+            return buffer.get();
+        }
+    }
+
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+    buffer->owned.store(true, std::memory_order_relaxed);
+    buffer->tid = static_cast<uint32_t>(m_buffers.size() + 1);
+    buffer->name = "thread " + std::to_string(buffer->tid);
+    m_buffers.push_back(std::move(buffer));
+    return m_buffers.back().get();
+}
+
+void TraceRecorder::ReleaseBuffer(ThreadBuffer* buffer) {
+    buffer->owned.store(false, std::memory_order_release);
+}
+
+uint64_t TraceRecorder::TotalDropped() const {
+    uint64_t total = 0;
+    for (const auto& buffer : m_buffers) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// 버퍼의 구간을 모두 꺼냄 (write가 false면 버리기만 함) - 잠금 안에서 호출
+void TraceRecorder::DrainLocked(ThreadBuffer* buffer, bool write) {
+    const size_t tail = buffer->tail.load(std::memory_order_relaxed);
+    const size_t head = buffer->head.load(std::memory_order_acquire);
+    if (write) {
+        for (size_t i = tail; i != head; i++) {
+            WriteSpanLocked(*buffer, buffer->spans[i & (TRACE_BUFFER_CAPACITY - 1)]);
+        }
+    }
+    buffer->tail.store(head, std::memory_order_release);
+}
+
+void TraceRecorder::WriteSpanLocked(ThreadBuffer& buffer, const TraceSpan& span) {
+    static const char kFlowPhases[] = { 0, 's', 't', 'f' };
+
+    uint32_t tid = buffer.tid;
+    if (span.track != TRACE_NAME_NONE && span.track < m_names.size()) {
+        tid = TRACE_TRACK_TID_BASE + span.track;
+        if (!m_trackNamed[span.track]) {
+            m_trackNamed[span.track] = true;
+            WriteThreadNameLocked(tid, m_names[span.track]);
+        }
+    } else if (!buffer.nameWritten) {
+        buffer.nameWritten = true;
+        WriteThreadNameLocked(tid, buffer.name);
+    }
+
+    const std::string& name = span.name < m_names.size() ? m_names[span.name] : m_names[TRACE_NAME_NONE];
+    const double tsUs = static_cast<double>(span.startNs) / 1e3;
+    const double durUs = static_cast<double>(span.endNs - span.startNs) / 1e3;
+
+    WriteSeparatorLocked();
+    fputs("{\"name\":", m_file);
+    WriteJsonString(m_file, name);
+    fprintf(m_file, ",\"cat\":\"typing\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u",
+            tsUs, durUs, m_pid, tid);
+    if (span.traceId != 0) {
+        fprintf(m_file, ",\"args\":{\"traceId\":%llu}", static_cast<unsigned long long>(span.traceId));
+    }
+    fputc('}', m_file);
+    m_events++;
+
+    // 흐름 이벤트는 같은 스레드/시각의 구간에 붙음 ("bp":"e" - 감싸는 구간에 연결)
+    if (span.traceId != 0 && span.flow != TRACE_FLOW_NONE && span.flow < sizeof(kFlowPhases)) {
+        WriteSeparatorLocked();
+        fprintf(m_file,
+                "{\"name\":\"keystroke\",\"cat\":\"typing\",\"ph\":\"%c\",\"id\":%llu,\"ts\":%.3f,"
+                "\"pid\":%d,\"tid\":%u,\"bp\":\"e\"}",
+                kFlowPhases[span.flow], static_cast<unsigned long long>(span.traceId), tsUs, m_pid, tid);
+    }
+}
+
+void TraceRecorder::WriteThreadNameLocked(uint32_t tid, const std::string& name) {
+    WriteSeparatorLocked();
+    fprintf(m_file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":", m_pid, tid);
+    WriteJsonString(m_file, name);
+    fputs("}}", m_file);
+}
+
+void TraceRecorder::WriteSeparatorLocked() {
+    if (!m_firstEvent) {
+        fputs(",\n", m_file);
+    }
+    m_firstEvent = false;
+}
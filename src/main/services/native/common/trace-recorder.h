@@ -0,0 +1,128 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 스레드별 구간 버퍼 크기 (2의 거듭제곱) - 플러시 주기 사이에 이보다 많이 쌓이면 새 구간을 버림
+#define TRACE_BUFFER_CAPACITY 8192
+#define TRACE_MAX_NAMES 4096
+
+// 미리 등록된 구간/트랙 이름 (네이티브 경로는 문자열 없이 ID만 기록)
+enum TraceName : uint16_t {
+    TRACE_NAME_NONE = 0,            // 트랙 0 = 기록한 스레드
+    TRACE_NAME_OS_DELIVERY = 1,     // 키 입력 → 후킹 콜백 진입 (OS 이벤트 소스 시각 기준)
+    TRACE_NAME_HOOK = 2,            // 후킹 콜백 (필터, 세션 단계, 링에 넣기)
+    TRACE_NAME_RING_WAIT = 3,       // 링에 넣음 → JS 스레드가 꺼냄
+    TRACE_NAME_JS_DISPATCH = 4,     // 네이티브 → JS 콜백 호출
+    TRACE_NAME_OS_INPUT_TRACK = 5,  // os-delivery 구간을 그리는 트랙
+    TRACE_NAME_BUILTIN_COUNT = 6
+};
+
+// 흐름 연결 (한 키 입력의 구간들을 화살표로 잇는 Chrome 흐름 이벤트)
+enum TraceFlow : uint8_t {
+    TRACE_FLOW_NONE = 0,
+    TRACE_FLOW_START = 1,   // 흐름 시작 ("s")
+    TRACE_FLOW_STEP = 2,    // 중간 단계 ("t")
+    TRACE_FLOW_END = 3      // 흐름 끝 ("f")
+};
+
+// 구간 하나 (고정 크기, 할당 없음)
+struct TraceSpan {
+    uint64_t startNs;       // EventClock 단조 시계
+    uint64_t endNs;
+    uint64_t traceId;       // 0 = 키 입력과 연결되지 않은 구간
+    uint16_t name;          // TraceName 또는 Intern 결과
+    uint16_t track;         // 0 = 기록한 스레드, 그 외 = 이름 ID로 된 가상 트랙
+    uint8_t flow;           // TraceFlow
+};
+
+// 플러시/중지 결과
+struct TraceSummary {
+    std::string path;
+    uint64_t events;        // 파일에 쓴 구간 수
+    uint64_t dropped;       // 스레드 버퍼가 가득 차 버린 구간 수
+};
+
+// 키 입력 지연 추적 (Chrome trace-event JSON 배열 형식 - chrome://tracing, Perfetto에서 열림)
+// - 꺼져 있으면 후킹 경로 비용은 relaxed 원자 변수 읽기 한 번 (IsEnabled)
+// - 스레드마다 단일 생산자/단일 소비자 버퍼 하나 (처음 기록할 때 등록) - 기록은 대기/할당 없음
+// - 소비자는 Flush를 부르는 스레드 하나 (JS 스레드 - 주기적으로 플러시해 버퍼가 넘치지 않게 함)
+// - 시각은 단조 시계 µs (ts) - JS 쪽 구간은 epoch 밀리초를 EventClock으로 바꿔 같은 축에 놓음
+// - 스레드가 끝나면 버퍼는 남은 구간을 플러시한 뒤 다음에 등록하는 스레드가 재사용
+class TraceRecorder {
+public:
+    static TraceRecorder& Shared();
+
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // 파일을 새로 만들고 기록 시작 (이미 기록 중이면 false, 이전 기록에서 남은 구간은 버림)
+    bool Start(const char* path, std::string* error);
+    // 남은 구간을 쓰고 JSON 배열을 닫음 (기록 중이 아니었으면 false)
+    bool Stop(TraceSummary* summary);
+    // 쌓인 구간을 파일에 씀 (기록 중이 아니면 아무것도 하지 않음)
+    void Flush(TraceSummary* summary);
+
+    // 키 입력 추적 ID 발급 (1부터)
+    uint64_t NextTraceId() { return m_nextTraceId.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    // 이름 ID (처음 보면 새로 부여 - 잠금, JS 구간용 / 표가 가득 차면 TRACE_NAME_NONE)
+    uint16_t Intern(const char* name, size_t length);
+
+    // 현재 스레드 버퍼에 구간 기록 (가득 차면 버리고 dropped 증가)
+    void Record(uint16_t name, uint16_t track, uint64_t startNs, uint64_t endNs, uint64_t traceId,
+                uint8_t flow);
+    // 현재 스레드의 트랙 이름 (등록 전이면 등록 - 처음 한 번만 잠금)
+    void NameCurrentThread(const char* name);
+
+private:
+    struct ThreadBuffer {
+        std::atomic<size_t> head;       // 생산자 (소유 스레드)
+        std::atomic<size_t> tail;       // 소비자 (Flush)
+        std::atomic<uint64_t> dropped;
+        std::atomic<bool> owned;        // 스레드가 살아 있음 (false면 비운 뒤 재사용 가능)
+        uint32_t tid;                   // 파일에 쓰는 스레드 번호 (버퍼 색인 + 1)
+        std::string name;               // 등록/NameCurrentThread 때만 바뀜 (잠금 안에서)
+        bool nameWritten;               // 이번 파일에 스레드 이름 메타데이터를 썼는지
+        TraceSpan spans[TRACE_BUFFER_CAPACITY];
+
+        ThreadBuffer() : head(0), tail(0), dropped(0), owned(false), tid(0), nameWritten(false) {}
+    };
+
+    friend struct TraceThreadHandle;
+
+    TraceRecorder();
+
+    std::atomic<bool> m_enabled;
+    std::atomic<uint64_t> m_nextTraceId;
+
+    std::mutex m_mutex;                                 // 버퍼 목록, 이름 표, 파일
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::vector<std::string> m_names;                   // 이름 ID → 이름
+    std::unordered_map<std::string, uint16_t> m_nameIds;
+    std::vector<bool> m_trackNamed;                     // 가상 트랙 이름 메타데이터를 썼는지
+
+    FILE* m_file;
+    std::string m_path;
+    bool m_firstEvent;
+    uint64_t m_events;
+    uint64_t m_droppedBase;                             // 시작 시점의 버퍼별 dropped 합
+    int m_pid;
+
+    ThreadBuffer* AcquireBuffer();
+    void ReleaseBuffer(ThreadBuffer* buffer);
+    uint64_t TotalDropped() const;
+    void DrainLocked(ThreadBuffer* buffer, bool write);
+    void WriteSpanLocked(ThreadBuffer& buffer, const TraceSpan& span);
+    void WriteThreadNameLocked(uint32_t tid, const std::string& name);
+    void WriteSeparatorLocked();
+};
+
+#endif // TRACE_RECORDER_H
@@ -1,14 +1,99 @@
 // 네이티브 키보드 리스너 TypeScript 진입점
 
 import * as path from 'path';
-import { NativeKeyEvent, PlatformPermissions } from './types';
+import {
+  NativeKeyEvent,
+  NativeKeyEventBatchCallback,
+  BatchOptions,
+  NativeTypingRecord,
+  TypingSessionOptions,
+  EventFilterOptions,
+  EventFilterConfig,
+  OverloadOptions,
+  OverloadConfig,
+  SubscriptionMode,
+  SubscriptionCallback,
+  SubscriptionOptions,
+  IntervalStatsSnapshot,
+  ListenerBackend,
+  ListenerBackendOptions,
+  JournalOptions,
+  JournalRecords,
+  RollupSet,
+  RunningStats,
+  TimeBuckets,
+  TimeRangeSums,
+  TimeIndexInfo,
+  AppTable,
+  AppStats,
+  ArchiveInfo,
+  ArchiveScanResult,
+  AnalyticsInput,
+  AnalyticsOptions,
+  AnalyticsResult,
+  AnalyticsKernelName,
+  LiveStateOptions,
+  LiveStateConfig,
+  KeyState,
+  TraceSummary,
+  TraceSpanOptions,
+  RhythmOptions,
+  RhythmConfig,
+  PipelineMetrics,
+  ClockAnchor,
+  PlatformPermissions
+} from './types';
 
 // 네이티브 모듈 인터페이스 정의
 interface NativeModule {
   startListening(callback: (event: NativeKeyEvent) => void): boolean;
+  startListeningBatched(callback: NativeKeyEventBatchCallback, options?: BatchOptions): boolean;
+  startTypingSessions(callback: (record: NativeTypingRecord) => void, options?: TypingSessionOptions): boolean;
+  subscribe(mode: SubscriptionMode, callback: SubscriptionCallback, options?: SubscriptionOptions): number;
+  unsubscribe(subscriptionId: number): boolean;
+  setIdleTimeout(timeoutMs: number, subscriptionId?: number): void;
+  setEventFilter(options: EventFilterOptions, subscriptionId?: number): EventFilterConfig;
+  setOverloadPolicy(options: OverloadOptions, subscriptionId?: number): OverloadConfig;
+  getSessionStats(subscriptionId?: number): IntervalStatsSnapshot;
+  resetSessionStats(subscriptionId?: number): void;
   stopListening(): boolean;
   checkPermissions(): PlatformPermissions;
   isListening(): boolean;
+  setListenerBackend(backend: ListenerBackend, options?: ListenerBackendOptions): boolean;
+  getMetrics(subscriptionId?: number): PipelineMetrics;
+  resetMetrics(subscriptionId?: number): void;
+  getClockAnchor(): ClockAnchor;
+  openJournal(directory: string, options?: JournalOptions): boolean;
+  closeJournal(): void;
+  journalRange(start: number, end: number): JournalRecords;
+  journalSealedSegments(): number[];
+  journalReadSegment(segmentId: number): JournalRecords | null;
+  journalReleaseSegment(segmentId: number): boolean;
+  takeRollups(): RollupSet;
+  loadStatsSnapshot(path: string): RunningStats | null;
+  saveStatsSnapshot(): boolean;
+  getRunningStats(): RunningStats;
+  reconcileStats(stored: RunningStats): boolean;
+  timeIndexAdd(buckets: TimeBuckets): number;
+  timeIndexQuery(bounds: number[] | Float64Array): TimeRangeSums;
+  timeIndexInfo(): TimeIndexInfo;
+  getAppTable(): AppTable;
+  getAppStats(reset?: boolean): AppStats[];
+  openArchive(path: string): boolean;
+  closeArchive(): void;
+  archiveAppend(records: JournalRecords): number;
+  archiveScan(start: number, end: number, cursor?: number): ArchiveScanResult;
+  archiveInfo(): ArchiveInfo;
+  analyze(input: AnalyticsInput, options?: AnalyticsOptions): Promise<AnalyticsResult>;
+  getAnalyticsKernel(): AnalyticsKernelName;
+  readSnapshot(buffer: Float64Array): boolean;
+  setLiveStateOptions(options: LiveStateOptions): LiveStateConfig;
+  getKeyState(): KeyState;
+  setRhythmOptions(options: RhythmOptions, subscriptionId?: number): RhythmConfig;
+  startTrace(path: string): boolean;
+  stopTrace(): TraceSummary | null;
+  flushTrace(): TraceSummary | null;
+  traceSpan(traceId: number, name: string, startMs: number, endMs: number, options?: TraceSpanOptions): void;
 }
 
 // 네이티브 모듈을 지연 로드하기 위한 변수
@@ -57,7 +142,11 @@ function loadNativeModule(): NativeModule {
 }
 
 export class NativeKeyboardListener {
-  private callback: ((event: NativeKeyEvent) => void) | null = null;
+  private callback:
+    | ((event: NativeKeyEvent) => void)
+    | NativeKeyEventBatchCallback
+    | ((record: NativeTypingRecord) => void)
+    | null = null;
 
   /**
    * 키보드 리스닝 시작
@@ -73,7 +162,7 @@ export class NativeKeyboardListener {
       const module = loadNativeModule();
       return module.startListening((event: NativeKeyEvent) => {
         if (this.callback) {
-          this.callback(event);
+          (this.callback as (event: NativeKeyEvent) => void)(event);
         }
       });
     } catch (error) {
@@ -82,6 +171,117 @@ export class NativeKeyboardListener {
     }
   }
 
+  /**
+   * 배치 키보드 리스닝 시작
+   * 이벤트를 개수/시간 예산 단위로 모아 타입 배열(struct-of-arrays)로 전달
+   */
+  public startListeningBatched(callback: NativeKeyEventBatchCallback, options?: BatchOptions): boolean {
+    if (this.callback) {
+      throw new Error('Keyboard listener is already running');
+    }
+
+    this.callback = callback;
+
+    try {
+      const module = loadNativeModule();
+      return module.startListeningBatched(
+        (timestamps: Float64Array, keyCodes: Uint32Array, flags: Uint8Array, count: number, appIds: Uint16Array) => {
+          if (this.callback) {
+            (this.callback as NativeKeyEventBatchCallback)(timestamps, keyCodes, flags, count, appIds);
+          }
+        },
+        options
+      );
+    } catch (error) {
+      this.callback = null;
+      throw error;
+    }
+  }
+
+  /**
+   * 타이핑 세션 추적 시작
+   * 세션 ID/키 수/간격 계산과 유휴 타임아웃 감지를 네이티브에서 수행하고 레코드만 전달
+   */
+  public startTypingSessions(callback: (record: NativeTypingRecord) => void, options?: TypingSessionOptions): boolean {
+    if (this.callback) {
+      throw new Error('Keyboard listener is already running');
+    }
+
+    this.callback = callback;
+
+    try {
+      const module = loadNativeModule();
+      return module.startTypingSessions((record: NativeTypingRecord) => {
+        if (this.callback) {
+          (this.callback as (record: NativeTypingRecord) => void)(record);
+        }
+      }, options);
+    } catch (error) {
+      this.callback = null;
+      throw error;
+    }
+  }
+
+  /**
+   * 추가 구독 생성 (반환값은 구독 ID)
+   * 같은 OS 후킹을 공유하며 필터/배치/세션/과부하 상태는 구독마다 따로 가짐 - worker_threads에서도 사용 가능
+   */
+  public subscribe(mode: SubscriptionMode, callback: SubscriptionCallback, options?: SubscriptionOptions): number {
+    const module = loadNativeModule();
+    return module.subscribe(mode, callback, options);
+  }
+
+  /**
+   * 추가 구독 해제
+   */
+  public unsubscribe(subscriptionId: number): boolean {
+    const module = loadNativeModule();
+    return module.unsubscribe(subscriptionId);
+  }
+
+  /**
+   * 세션 유휴 타임아웃 변경 (구독 ID를 생략하면 기본 리스너)
+   */
+  public setIdleTimeout(timeoutMs: number, subscriptionId?: number): void {
+    const module = loadNativeModule();
+    module.setIdleTimeout(timeoutMs, subscriptionId);
+  }
+
+  /**
+   * 네이티브 이벤트 필터 설정 (리스닝 중에도 변경 가능)
+   * 걸러진 이벤트는 JS 스레드로 넘어오지 않음 - 키 뗌을 끄면 스레드 간 전달량이 약 절반으로 줄어듦
+   */
+  public setEventFilter(options: EventFilterOptions, subscriptionId?: number): EventFilterConfig {
+    const module = loadNativeModule();
+    return module.setEventFilter(options, subscriptionId);
+  }
+
+  /**
+   * 이벤트 링 과부하 정책 설정 (리스닝 중에도 변경 가능)
+   * 링 메모리는 고정이며, 넘친 이벤트는 정책에 따라 처리되고 getMetrics에 집계됨
+   */
+  public setOverloadPolicy(options: OverloadOptions, subscriptionId?: number): OverloadConfig {
+    const module = loadNativeModule();
+    return module.setOverloadPolicy(options, subscriptionId);
+  }
+
+  /**
+   * 현재 세션의 키 입력 간격 통계 조회
+   * 세션 종료 레코드를 받은 콜백 안에서 호출하면 종료된 세션의 통계를 반환
+   */
+  public getSessionStats(subscriptionId?: number): IntervalStatsSnapshot {
+    const module = loadNativeModule();
+    return module.getSessionStats(subscriptionId);
+  }
+
+  /**
+   * 세션 간격 통계 초기화
+   */
+  public resetSessionStats(subscriptionId?: number): void {
+    const module = loadNativeModule();
+    module.resetSessionStats(subscriptionId);
+  }
+
   /**
    * 키보드 리스닝 중지
    */
@@ -118,6 +318,312 @@ export class NativeKeyboardListener {
     }
   }
 
+  /**
+   * 리스너 백엔드 선택 (어느 구독도 리스닝 중이 아닐 때만 가능)
+   */
+  public setListenerBackend(backend: ListenerBackend, options?: ListenerBackendOptions): boolean {
+    if (this.callback) {
+      throw new Error('Cannot change backend while keyboard listener is running');
+    }
+
+    const module = loadNativeModule();
+    return module.setListenerBackend(backend, options);
+  }
+
+  /**
+   * 캡처 경로 지표 조회 (이벤트 수, 버림 수, 링 깊이, 후킹/전달 지연 히스토그램)
+   */
+  public getMetrics(subscriptionId?: number): PipelineMetrics {
+    const module = loadNativeModule();
+    return module.getMetrics(subscriptionId);
+  }
+
+  /**
+   * 캡처 경로 지표 초기화
+   */
+  public resetMetrics(subscriptionId?: number): void {
+    const module = loadNativeModule();
+    module.resetMetrics(subscriptionId);
+  }
+
+  /**
+   * 시계 기준점 조회 (네이티브 단조 시계 ↔ epoch ms 변환용)
+   */
+  public getClockAnchor(): ClockAnchor {
+    const module = loadNativeModule();
+    return module.getClockAnchor();
+  }
+
+  /**
+   * 이벤트 저널 열기
+   * 열려 있는 동안 네이티브 세션 단계의 타이핑 레코드가 메모리 매핑 세그먼트에 기록됨
+   */
+  public openJournal(directory: string, options?: JournalOptions): boolean {
+    const module = loadNativeModule();
+    return module.openJournal(directory, options);
+  }
+
+  /**
+   * 이벤트 저널 닫기 (활성 세그먼트 봉인)
+   */
+  public closeJournal(): void {
+    const module = loadNativeModule();
+    module.closeJournal();
+  }
+
+  /**
+   * [start, end) 시각 범위의 저널 레코드 조회
+   */
+  public journalRange(start: number, end: number): JournalRecords {
+    const module = loadNativeModule();
+    return module.journalRange(start, end);
+  }
+
+  /**
+   * DB 반영 대기 중인 봉인 세그먼트 ID 목록
+   */
+  public journalSealedSegments(): number[] {
+    const module = loadNativeModule();
+    return module.journalSealedSegments();
+  }
+
+  /**
+   * 세그먼트 레코드 조회 (손상된 세그먼트는 null)
+   */
+  public journalReadSegment(segmentId: number): JournalRecords | null {
+    const module = loadNativeModule();
+    return module.journalReadSegment(segmentId);
+  }
+
+  /**
+   * DB 반영이 끝난 세그먼트 삭제
+   */
+  public journalReleaseSegment(segmentId: number): boolean {
+    const module = loadNativeModule();
+    return module.journalReleaseSegment(segmentId);
+  }
+
+  /**
+   * 일별/시간별 통계 증분 꺼내기 (마지막 호출 이후 더해진 값 - DB에는 더하기 upsert로 반영)
+   */
+  public takeRollups(): RollupSet {
+    const module = loadNativeModule();
+    return module.takeRollups();
+  }
+
+  /**
+   * 누적 통계 스냅샷 읽기 (유효하면 네이티브 누적을 스냅샷 값으로 시작, 없거나 손상되면 null)
+   */
+  public loadStatsSnapshot(path: string): RunningStats | null {
+    const module = loadNativeModule();
+    return module.loadStatsSnapshot(path);
+  }
+
+  /**
+   * 현재 누적 통계를 loadStatsSnapshot에서 지정한 파일에 저장
+   */
+  public saveStatsSnapshot(): boolean {
+    const module = loadNativeModule();
+    return module.saveStatsSnapshot();
+  }
+
+  /**
+   * 현재 누적 통계 (오늘 카운터, 연속 입력 일수, 마지막 세션)
+   */
+  public getRunningStats(): RunningStats {
+    const module = loadNativeModule();
+    return module.getRunningStats();
+  }
+
+  /**
+   * DB 값으로 누적 보정 (stored는 마지막 takeRollups까지 반영된 값 - 날짜가 맞지 않으면 false)
+   */
+  public reconcileStats(stored: RunningStats): boolean {
+    const module = loadNativeModule();
+    return module.reconcileStats(stored);
+  }
+
+  /**
+   * 시간 버킷 색인에 더하기 (지난 기록/네이티브 세션 단계를 거치지 않은 이벤트 - 더한 버킷 수 반환)
+   */
+  public timeIndexAdd(buckets: TimeBuckets): number {
+    const module = loadNativeModule();
+    return module.timeIndexAdd(buckets);
+  }
+
+  /**
+   * 시간 버킷 색인 구간 합 (연속한 [bounds[i], bounds[i + 1]) 구간마다 O(log n))
+   */
+  public timeIndexQuery(bounds: number[] | Float64Array): TimeRangeSums {
+    const module = loadNativeModule();
+    return module.timeIndexQuery(bounds);
+  }
+
+  /**
+   * 시간 버킷 색인 요약
+   */
+  public timeIndexInfo(): TimeIndexInfo {
+    const module = loadNativeModule();
+    return module.timeIndexInfo();
+  }
+
+  /**
+   * 앱 ID → 이름 표 (키 이벤트/타이핑 레코드의 appId로 이름 찾기)
+   */
+  public getAppTable(): AppTable {
+    const module = loadNativeModule();
+    return module.getAppTable();
+  }
+
+  /**
+   * 앱별 누적 키 입력/활동 시간/세션 (reset이면 읽은 뒤 비움)
+   */
+  public getAppStats(reset?: boolean): AppStats[] {
+    const module = loadNativeModule();
+    return module.getAppStats(reset);
+  }
+
+  /**
+   * 이벤트 아카이브 열기 (없으면 생성)
+   */
+  public openArchive(path: string): boolean {
+    const module = loadNativeModule();
+    return module.openArchive(path);
+  }
+
+  /**
+   * 이벤트 아카이브 닫기
+   */
+  public closeArchive(): void {
+    const module = loadNativeModule();
+    module.closeArchive();
+  }
+
+  /**
+   * 레코드를 압축 블록으로 추가하고 기록한 블록 수 반환
+   * 시각 순으로 정렬된 큰 묶음(하루치 등)으로 넘겨야 압축률이 좋음
+   */
+  public archiveAppend(records: JournalRecords): number {
+    const module = loadNativeModule();
+    return module.archiveAppend(records);
+  }
+
+  /**
+   * [start, end) 범위와 겹치는 다음 블록 하나 조회 (cursor로 이어서 읽음)
+   */
+  public archiveScan(start: number, end: number, cursor?: number): ArchiveScanResult {
+    const module = loadNativeModule();
+    return module.archiveScan(start, end, cursor);
+  }
+
+  /**
+   * [start, end) 범위의 보관된 레코드를 블록 단위로 순회
+   * 범위와 겹치지 않는 블록은 읽지 않으며, 한 번에 블록 하나 분량만 메모리에 올림
+   */
+  public *archiveRange(start: number, end: number): Generator<JournalRecords> {
+    const module = loadNativeModule();
+    let cursor = 0;
+    while (cursor >= 0) {
+      const result = module.archiveScan(start, end, cursor);
+      if (result.records.count > 0) {
+        yield result.records;
+      }
+      cursor = result.cursor;
+    }
+  }
+
+  /**
+   * 이벤트 아카이브 요약 (블록/레코드 수, 파일 크기, 시각 범위)
+   */
+  public archiveInfo(): ArchiveInfo {
+    const module = loadNativeModule();
+    return module.archiveInfo();
+  }
+
+  /**
+   * 간격 분석 (합/평균/분산, 분위수, 몰아치기/멈춤 구간, 시각 구간별 히스토그램)
+   * 아카이브 읽기와 계산은 작업 스레드에서 수행되며 결과는 Promise로 전달
+   */
+  public analyze(input: AnalyticsInput, options?: AnalyticsOptions): Promise<AnalyticsResult> {
+    const module = loadNativeModule();
+    return module.analyze(input, options);
+  }
+
+  /**
+   * 이 CPU에서 분석에 쓰는 커널 구현
+   */
+  public getAnalyticsKernel(): AnalyticsKernelName {
+    const module = loadNativeModule();
+    return module.getAnalyticsKernel();
+  }
+
+  /**
+   * 실시간 타이핑 상태를 호출자 버퍼에 채움 (LIVE_STATE_* 인덱스, 할당 없음) → 입력 중 여부
+   * 후킹 스레드가 키마다 게시한 상태를 읽기만 하므로 화면 갱신 주기로 불러도 비용이 일정함
+   */
+  public readSnapshot(buffer: Float64Array): boolean {
+    const module = loadNativeModule();
+    return module.readSnapshot(buffer);
+  }
+
+  /**
+   * 실시간 상태 판정 기준 변경 (입력 중 유지 시간, 콤보 간격, 속도 평균 시간 상수)
+   */
+  public setLiveStateOptions(options: LiveStateOptions): LiveStateConfig {
+    const module = loadNativeModule();
+    return module.setLiveStateOptions(options);
+  }
+
+  /**
+   * 현재 눌린 수정자와 키 수 (후킹 스레드가 게시한 비트맵을 읽기만 함)
+   */
+  public getKeyState(): KeyState {
+    const module = loadNativeModule();
+    return module.getKeyState();
+  }
+
+  /**
+   * 지연 추적 시작 - 키 입력마다 추적 ID를 붙이고 후킹 → 링 → JS 호출 구간을 path에 기록
+   * (Chrome trace-event JSON, 이미 추적 중이거나 파일을 만들 수 없으면 false)
+   */
+  public startTrace(path: string): boolean {
+    const module = loadNativeModule();
+    return module.startTrace(path);
+  }
+
+  /**
+   * 지연 추적 중지 (파일을 닫음) → 기록 요약, 추적 중이 아니었으면 null
+   */
+  public stopTrace(): TraceSummary | null {
+    const module = loadNativeModule();
+    return module.stopTrace();
+  }
+
+  /**
+   * 스레드별 버퍼에 쌓인 구간을 파일에 씀 - 추적 중에는 주기적으로 호출 (버퍼는 고정 크기)
+   */
+  public flushTrace(): TraceSummary | null {
+    const module = loadNativeModule();
+    return module.flushTrace();
+  }
+
+  /**
+   * JS 쪽 구간 기록 (epoch ms - performance.timeOrigin + performance.now() 권장, 추적 중이 아니면 무시)
+   * traceId가 0이 아니면 네이티브 구간과 같은 흐름으로 이어짐
+   */
+  public traceSpan(traceId: number, name: string, startMs: number, endMs: number, options?: TraceSpanOptions): void {
+    const module = loadNativeModule();
+    module.traceSpan(traceId, name, startMs, endMs, options);
+  }
+
+  /**
+   * 리듬 구독의 판정 기준 변경 (생략한 항목은 유지) → 적용된 전체 기준
+   */
+  public setRhythmOptions(options: RhythmOptions, subscriptionId?: number): RhythmConfig {
+    const module = loadNativeModule();
+    return module.setRhythmOptions(options, subscriptionId);
+  }
+
   /**
    * 리스닝 상태 확인
    */
@@ -0,0 +1,161 @@
+#include "active-window-linux.h"
+#include "../../common/app-registry.h"
+
+#ifdef __linux__
+
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#include <atomic>
+#include <iostream>
+#include <string.h>
+
+// 오류 핸들러는 프로세스 전역이라 추적 연결과 설치 전 핸들러를 정적으로 보관
+static std::atomic<Display*> s_trackerDisplay(nullptr);
+static int (*s_previousErrorHandler)(Display*, XErrorEvent*) = nullptr;
+
+ActiveWindowTrackerLinux::ActiveWindowTrackerLinux()
+    : m_display(nullptr), m_root(0), m_activeWindow(0), m_netActiveWindow(0), m_wmClass(0),
+      m_activeApp(APP_ID_UNKNOWN) {
+}
+
+ActiveWindowTrackerLinux::~ActiveWindowTrackerLinux() {
+    Close();
+}
+
+bool ActiveWindowTrackerLinux::Open() {
+    if (m_display) {
+        return true;
+    }
+
+    m_display = XOpenDisplay(nullptr);
+    if (!m_display) {
+        std::cerr << "Active window tracking unavailable: cannot open display" << std::endl;
+        return false;
+    }
+
+    s_trackerDisplay.store(m_display);
+    int (*previous)(Display*, XErrorEvent*) = XSetErrorHandler(ErrorHandler);
+    if (previous != ErrorHandler) {
+        s_previousErrorHandler = previous;
+    }
+
+    m_root = DefaultRootWindow(m_display);
+    m_netActiveWindow = XInternAtom(m_display, "_NET_ACTIVE_WINDOW", False);
+    m_wmClass = XInternAtom(m_display, "WM_CLASS", False);
+    XSelectInput(m_display, m_root, PropertyChangeMask);
+
+    UpdateActiveWindow();
+    XFlush(m_display);
+    return true;
+}
+
+void ActiveWindowTrackerLinux::Close() {
+    if (!m_display) {
+        return;
+    }
+
+    XCloseDisplay(m_display);
+    m_display = nullptr;
+    m_root = 0;
+    m_activeWindow = 0;
+    SetActiveApp(APP_ID_UNKNOWN);
+
+    // 그 사이 다른 코드가 핸들러를 바꾸지 않았을 때만 되돌림
+    s_trackerDisplay.store(nullptr);
+    int (*current)(Display*, XErrorEvent*) = XSetErrorHandler(s_previousErrorHandler);
+    if (current != ErrorHandler) {
+        XSetErrorHandler(current);
+    }
+}
+
+int ActiveWindowTrackerLinux::Fd() const {
+    return m_display ? ConnectionNumber(m_display) : -1;
+}
+
+void ActiveWindowTrackerLinux::ProcessEvents() {
+    if (!m_display) {
+        return;
+    }
+
+    while (XPending(m_display) > 0) {
+        XEvent event;
+        XNextEvent(m_display, &event);
+        if (event.type != PropertyNotify) {
+            continue;
+        }
+
+        const XPropertyEvent& property = event.xproperty;
+        if (property.window == m_root && property.atom == m_netActiveWindow) {
+            UpdateActiveWindow();
+        } else if (property.window == m_activeWindow && property.atom == m_wmClass) {
+            // 창을 띄운 뒤 클래스를 바꾸는 앱 (일부 Electron/Java 앱)
+            UpdateActiveApp();
+        }
+    }
+}
+
+// 루트 창의 _NET_ACTIVE_WINDOW를 읽어 활성 창 교체
+void ActiveWindowTrackerLinux::UpdateActiveWindow() {
+    Window active = 0;
+    Atom type = None;
+    int format = 0;
+    unsigned long count = 0;
+    unsigned long remaining = 0;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(m_display, m_root, m_netActiveWindow, 0, 1, False, XA_WINDOW,
+                           &type, &format, &count, &remaining, &data) == Success && data) {
+        if (type == XA_WINDOW && format == 32 && count == 1) {
+            // 32비트 형식 속성은 long 배열로 돌아옴
+            active = static_cast<Window>(*reinterpret_cast<unsigned long*>(data));
+        }
+        XFree(data);
+    }
+
+    if (active == m_activeWindow) {
+        return;
+    }
+
+    // 이전 창의 WM_CLASS 변경 구독 해제 (이미 사라졌으면 BadWindow - 무시)
+    if (m_activeWindow) {
+        XSelectInput(m_display, m_activeWindow, NoEventMask);
+    }
+    m_activeWindow = active;
+    if (m_activeWindow) {
+        XSelectInput(m_display, m_activeWindow, PropertyChangeMask);
+    }
+    UpdateActiveApp();
+}
+
+// 활성 창의 WM_CLASS 클래스 이름으로 앱 ID 갱신 (포커스가 바뀔 때만 호출)
+void ActiveWindowTrackerLinux::UpdateActiveApp() {
+    uint16_t appId = APP_ID_UNKNOWN;
+    XClassHint hint;
+    hint.res_name = nullptr;
+    hint.res_class = nullptr;
+    if (m_activeWindow && XGetClassHint(m_display, m_activeWindow, &hint)) {
+        if (hint.res_class) {
+            appId = AppRegistry::Shared().Intern(hint.res_class, strlen(hint.res_class));
+        }
+    }
+    if (hint.res_name) {
+        XFree(hint.res_name);
+    }
+    if (hint.res_class) {
+        XFree(hint.res_class);
+    }
+    SetActiveApp(appId);
+}
+
+void ActiveWindowTrackerLinux::SetActiveApp(uint16_t appId) {
+    m_activeApp = appId;
+    AppRegistry::Shared().SetActive(appId);
+}
+
+int ActiveWindowTrackerLinux::ErrorHandler(Display* display, XErrorEvent* error) {
+    if (display == s_trackerDisplay.load()) {
+        return 0;
+    }
+    return s_previousErrorHandler ? s_previousErrorHandler(display, error) : 0;
+}
+
+#endif // __linux__
@@ -0,0 +1,48 @@
+#ifndef ACTIVE_WINDOW_LINUX_H
+#define ACTIVE_WINDOW_LINUX_H
+
+#include <stdint.h>
+
+#ifdef __linux__
+#include <X11/Xlib.h>
+
+// 포커스된 앱 추적 (X11, EWMH 창 관리자)
+// - 루트 창의 _NET_ACTIVE_WINDOW와 활성 창의 WM_CLASS 변경(PropertyNotify)에만 반응해 앱 ID를 캐시
+//   키 이벤트마다 X 서버에 묻지 않으므로 이벤트당 비용은 멤버 하나를 읽는 것뿐
+// - 자체 연결을 쓰고 Open 이후에는 캡처 스레드만 사용 (Fd를 캡처 스레드의 poll()에 함께 등록)
+// - _NET_ACTIVE_WINDOW를 지원하지 않는 창 관리자에서는 앱 ID가 APP_ID_UNKNOWN으로 남음
+class ActiveWindowTrackerLinux {
+public:
+    ActiveWindowTrackerLinux();
+    ~ActiveWindowTrackerLinux();
+
+    // 연결을 열고 현재 활성 창을 읽음 (실패해도 키 캡처는 계속 - 앱 ID만 알 수 없음)
+    bool Open();
+    void Close();
+
+    // poll()에 등록할 연결 fd (열리지 않았으면 -1)
+    int Fd() const;
+    // 수신된 속성 변경 이벤트를 모두 처리 (블록하지 않음)
+    void ProcessEvents();
+
+    uint16_t ActiveApp() const { return m_activeApp; }
+
+private:
+    Display* m_display;
+    Window m_root;
+    Window m_activeWindow;
+    Atom m_netActiveWindow;
+    Atom m_wmClass;
+    uint16_t m_activeApp;
+
+    void UpdateActiveWindow();
+    void UpdateActiveApp();
+    void SetActiveApp(uint16_t appId);
+
+    // 추적 중 사라진 창에 대한 BadWindow 등은 무시 (다른 연결의 오류는 이전 핸들러로 전달)
+    static int ErrorHandler(Display* display, XErrorEvent* error);
+};
+
+#endif // __linux__
+
+#endif // ACTIVE_WINDOW_LINUX_H
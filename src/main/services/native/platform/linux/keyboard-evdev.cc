@@ -0,0 +1,465 @@
+#include "keyboard-evdev.h"
+#include "../../common/app-registry.h"
+#include "../../common/capture-sinks.h"
+
+#ifdef __linux__
+
+#include <iostream>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+
+// 자동 탐색 대상 디렉토리
+#define EVDEV_INPUT_DIR "/dev/input"
+
+// epoll 데이터 태그 (장치는 슬롯 번호 사용)
+#define EVDEV_TAG_WAKE    0xFFFFFFFFu
+#define EVDEV_TAG_INOTIFY 0xFFFFFFFEu
+
+// X 키 코드 = evdev 키 코드 + 8
+#define EVDEV_TO_X_KEYCODE(code) ((code) + 8)
+
+// 비트 배열 검사 (EVIOCGBIT 결과)
+#define EVDEV_TEST_BIT(bits, bit) (((bits)[(bit) / 8] >> ((bit) % 8)) & 1)
+
+// /dev/input 아래 장치 경로 (EVDEV_PATH_MAX에 들어가지 않는 이름이면 false - 잘린 경로는 쓰지 않음)
+static bool MakeDevicePath(char (&path)[EVDEV_PATH_MAX], const char* name) {
+    const int length = snprintf(path, sizeof(path), EVDEV_INPUT_DIR "/%s", name);
+    return length > 0 && static_cast<size_t>(length) < sizeof(path);
+}
+
+template <typename Sink>
+KeyboardListenerEvdev<Sink>::KeyboardListenerEvdev(Sink& sink)
+    : m_sink(sink), m_autoDiscover(true), m_epollFd(-1), m_inotifyFd(-1), m_wakeFd(-1), m_shouldStop(false) {
+    for (int i = 0; i < EVDEV_MAX_DEVICES; i++) {
+        m_devices[i].fd = -1;
+        m_devices[i].monotonicClock = false;
+        m_devices[i].path[0] = '\0';
+    }
+}
+
+template <typename Sink>
+KeyboardListenerEvdev<Sink>::KeyboardListenerEvdev(Sink& sink, const std::vector<std::string>& devicePaths)
+    : KeyboardListenerEvdev(sink) {
+    m_fixedPaths = devicePaths;
+    m_autoDiscover = false;
+}
+
+template <typename Sink>
+KeyboardListenerEvdev<Sink>::~KeyboardListenerEvdev() {
+    StopListening();
+}
+
+template <typename Sink>
+bool KeyboardListenerEvdev<Sink>::StartListening() {
+    if (m_isListening) {
+        return true; // 이미 실행 중
+    }
+    
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_epollFd < 0 || m_wakeFd < 0) {
+        std::cerr << "Failed to create epoll/eventfd" << std::endl;
+        CleanupEvdev();
+        return false;
+    }
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = EVDEV_TAG_WAKE;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev);
+    
+    // 장치 추가/권한 변경/제거 감시 (장치 노드는 생성 직후 권한이 바뀌므로 IN_ATTRIB도 감시)
+    if (m_autoDiscover) {
+        m_inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (m_inotifyFd >= 0 &&
+            inotify_add_watch(m_inotifyFd, EVDEV_INPUT_DIR, IN_CREATE | IN_ATTRIB | IN_DELETE) >= 0) {
+            ev.events = EPOLLIN;
+            ev.data.u32 = EVDEV_TAG_INOTIFY;
+            epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_inotifyFd, &ev);
+        } else {
+            std::cerr << "inotify on " EVDEV_INPUT_DIR " unavailable, hotplug disabled" << std::endl;
+        }
+    }
+    
+    m_shouldStop = false;
+    m_listenerThread = std::thread(&KeyboardListenerEvdev::ListenerThreadFunc, this);
+    
+    m_isListening = true;
+    std::cout << "evdev keyboard listener started successfully" << std::endl;
+    
+    return true;
+}
+
+template <typename Sink>
+bool KeyboardListenerEvdev<Sink>::StopListening() {
+    if (!m_isListening) {
+        return true; // 이미 중지됨
+    }
+    
+    // 캡처 스레드 깨우기 및 종료 대기
+    m_shouldStop = true;
+    uint64_t one = 1;
+    ssize_t written = write(m_wakeFd, &one, sizeof(one));
+    (void)written;
+    if (m_listenerThread.joinable()) {
+        m_listenerThread.join();
+    }
+    
+    CleanupEvdev();
+    
+    m_isListening = false;
+    
+    std::cout << "evdev keyboard listener stopped" << std::endl;
+    return true;
+}
+
+template <typename Sink>
+PermissionInfo KeyboardListenerEvdev<Sink>::CheckPermissions() {
+    PermissionInfo info;
+    info.hasPermission = CheckDevicePermissions();
+    info.requiresElevation = !info.hasPermission; // input 그룹 또는 root 필요
+    info.permissionMessage = GetPermissionInstructions();
+    
+    return info;
+}
+
+template <typename Sink>
+bool KeyboardListenerEvdev<Sink>::IsListening() const {
+    return m_isListening;
+}
+
+// 장치 목록 초기 탐색
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::ScanDevices() {
+    if (!m_autoDiscover) {
+        for (size_t i = 0; i < m_fixedPaths.size(); i++) {
+            OpenDevice(m_fixedPaths[i].c_str(), false);
+        }
+        return;
+    }
+    
+    DIR* dir = opendir(EVDEV_INPUT_DIR);
+    if (!dir) {
+        return;
+    }
+    
+    struct dirent* entry;
+    char path[EVDEV_PATH_MAX];
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, "event", 5) != 0) {
+            continue;
+        }
+        if (!MakeDevicePath(path, entry->d_name)) {
+            continue;
+        }
+        OpenDevice(path, true);
+    }
+    closedir(dir);
+}
+
+// 장치 열기 및 epoll 등록
+template <typename Sink>
+bool KeyboardListenerEvdev<Sink>::OpenDevice(const char* path, bool requireKeyboard) {
+    // 장치 표의 경로 칸에 들어가지 않으면 열지 않음 (잘린 경로로는 중복 확인/닫기가 맞지 않음)
+    if (strlen(path) >= EVDEV_PATH_MAX) {
+        std::cerr << "Input device path too long, ignoring " << path << std::endl;
+        return false;
+    }
+    
+    // 이미 열린 장치인지 확인하며 빈 슬롯 탐색
+    int freeSlot = -1;
+    for (int i = 0; i < EVDEV_MAX_DEVICES; i++) {
+        if (m_devices[i].fd >= 0) {
+            if (strcmp(m_devices[i].path, path) == 0) {
+                return true;
+            }
+        } else if (freeSlot < 0) {
+            freeSlot = i;
+        }
+    }
+    if (freeSlot < 0) {
+        std::cerr << "Too many input devices, ignoring " << path << std::endl;
+        return false;
+    }
+    
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false; // 권한 없음 또는 아직 준비되지 않은 장치
+    }
+    
+    if (requireKeyboard && !IsKeyboardDevice(fd)) {
+        close(fd);
+        return false;
+    }
+    
+    // 커널이 이벤트 시각을 단조 시계로 기록하도록 요청 (실패하면 벽시계 - FIFO/일반 파일 대체 장치)
+    int clockId = CLOCK_MONOTONIC;
+    const bool monotonicClock = ioctl(fd, EVIOCSCLOCKID, &clockId) == 0;
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = static_cast<uint32_t>(freeSlot);
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        // 일반 파일은 epoll로 감시할 수 없으므로 시작 시 한 번에 읽음 (테스트용 대체 장치)
+        if (errno == EPERM) {
+            DrainRegularFile(fd);
+        }
+        close(fd);
+        return false;
+    }
+    
+    m_devices[freeSlot].fd = fd;
+    m_devices[freeSlot].monotonicClock = monotonicClock;
+    memcpy(m_devices[freeSlot].path, path, strlen(path) + 1);   // 길이는 위에서 확인
+    return true;
+}
+
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::CloseDevice(int slot) {
+    if (m_devices[slot].fd < 0) {
+        return;
+    }
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, m_devices[slot].fd, nullptr);
+    close(m_devices[slot].fd);
+    m_devices[slot].fd = -1;
+    m_devices[slot].path[0] = '\0';
+}
+
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::CloseDeviceByPath(const char* path) {
+    for (int i = 0; i < EVDEV_MAX_DEVICES; i++) {
+        if (m_devices[i].fd >= 0 && strcmp(m_devices[i].path, path) == 0) {
+            CloseDevice(i);
+        }
+    }
+}
+
+// 키보드 장치 판별 - EV_KEY를 지원하고 일반 문자 키를 가진 장치
+template <typename Sink>
+bool KeyboardListenerEvdev<Sink>::IsKeyboardDevice(int fd) {
+    unsigned char evBits[(EV_MAX + 7) / 8];
+    unsigned char keyBits[(KEY_MAX + 7) / 8];
+    memset(evBits, 0, sizeof(evBits));
+    memset(keyBits, 0, sizeof(keyBits));
+    
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0 || !EVDEV_TEST_BIT(evBits, EV_KEY)) {
+        return false;
+    }
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) {
+        return false;
+    }
+    
+    // 마우스 버튼 등과 구분하기 위해 대표 문자 키 확인
+    return EVDEV_TEST_BIT(keyBits, KEY_A) && EVDEV_TEST_BIT(keyBits, KEY_Z) &&
+           EVDEV_TEST_BIT(keyBits, KEY_SPACE);
+}
+
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::CleanupEvdev() {
+    for (int i = 0; i < EVDEV_MAX_DEVICES; i++) {
+        CloseDevice(i);
+    }
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    if (m_epollFd >= 0) {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+}
+
+// 캡처 스레드 - epoll로 모든 장치를 기다리고 준비된 장치마다 한 번씩 묶어 읽음
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::ListenerThreadFunc() {
+    struct epoll_event ready[EVDEV_MAX_DEVICES + 2];
+    
+    // 장치 열기와 읽기는 모두 캡처 스레드에서 수행 (이벤트 생산자를 한 스레드로 유지)
+    ScanDevices();
+    
+    while (!m_shouldStop) {
+        int count = epoll_wait(m_epollFd, ready, EVDEV_MAX_DEVICES + 2, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "epoll_wait() failed" << std::endl;
+            break;
+        }
+        
+        for (int i = 0; i < count; i++) {
+            const uint32_t tag = ready[i].data.u32;
+            if (tag == EVDEV_TAG_WAKE) {
+                return; // StopListening 요청
+            }
+            if (tag == EVDEV_TAG_INOTIFY) {
+                HandleInotify();
+                continue;
+            }
+            if (tag < EVDEV_MAX_DEVICES) {
+                ReadDevice(static_cast<int>(tag));
+            }
+        }
+    }
+}
+
+// /dev/input 변경 처리 (핫플러그)
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::HandleInotify() {
+    alignas(struct inotify_event) char buffer[4096];
+    char path[EVDEV_PATH_MAX];
+    
+    ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+    if (length <= 0) {
+        return;
+    }
+    
+    for (char* ptr = buffer; ptr < buffer + length; ) {
+        const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+        ptr += sizeof(struct inotify_event) + event->len;
+        
+        if (event->len == 0 || strncmp(event->name, "event", 5) != 0) {
+            continue;
+        }
+        if (!MakeDevicePath(path, event->name)) {
+            continue;
+        }
+        
+        if (event->mask & IN_DELETE) {
+            CloseDeviceByPath(path);
+        } else {
+            OpenDevice(path, true); // IN_CREATE / IN_ATTRIB - 이미 열린 장치면 무시됨
+        }
+    }
+}
+
+// 장치에서 이벤트 묶음 읽기 (깨어날 때마다 read() 한 번)
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::ReadDevice(int slot) {
+    struct input_event events[EVDEV_READ_BATCH];
+    
+    ssize_t length = read(m_devices[slot].fd, events, sizeof(events));
+    if (length < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            return;
+        }
+        CloseDevice(slot); // ENODEV 등 - 장치 제거됨
+        return;
+    }
+    if (length == 0) {
+        CloseDevice(slot); // FIFO 대체 장치의 쓰기 쪽이 닫힘
+        return;
+    }
+    
+    const size_t count = static_cast<size_t>(length) / sizeof(struct input_event);
+    const bool monotonicClock = m_devices[slot].monotonicClock;
+    for (size_t i = 0; i < count; i++) {
+        HandleKeyEvent(events[i], monotonicClock);
+    }
+}
+
+// 일반 파일 대체 장치 - 전체 내용을 한 번에 처리
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::DrainRegularFile(int fd) {
+    struct input_event events[EVDEV_READ_BATCH];
+    ssize_t length;
+    
+    while ((length = read(fd, events, sizeof(events))) > 0) {
+        const size_t count = static_cast<size_t>(length) / sizeof(struct input_event);
+        for (size_t i = 0; i < count; i++) {
+            HandleKeyEvent(events[i], false);
+        }
+    }
+}
+
+// 키 이벤트 처리 (할당 없음)
+template <typename Sink>
+void KeyboardListenerEvdev<Sink>::HandleKeyEvent(const struct input_event& event, bool monotonicClock) {
+    if (event.type != EV_KEY) {
+        return;
+    }
+    
+    const uint32_t keyCode = EVDEV_TO_X_KEYCODE(event.code);
+    
+    // 키 이벤트 구조체 생성 - 커널이 기록한 시각 사용 (value: 0 = 뗌, 1 = 누름, 2 = 자동 반복)
+    KeyEvent keyEvent;
+    keyEvent.timestamp = static_cast<uint64_t>(event.input_event_sec) * 1000000000ull +
+                         static_cast<uint64_t>(event.input_event_usec) * 1000ull;
+    keyEvent.keyCode = keyCode;
+    keyEvent.isKeyDown = (event.value != 0);
+    keyEvent.isSpecialKey = false;                   // CaptureStages가 표시 (걸러내기는 바인딩의 이벤트 필터)
+    keyEvent.appId = APP_ID_UNKNOWN;                 // evdev는 창 시스템과 무관 (포커스 추적 없음)
+    
+    // 캡처 단계를 거쳐 싱크로 전달 (메타데이터만 전달)
+    if (monotonicClock) {
+        CaptureStages::Run(keyEvent, m_sink);
+    } else {
+        WallClockCaptureStages::Run(keyEvent, m_sink);
+    }
+}
+
+// 읽을 수 있는 키보드 장치가 하나라도 있는지 확인
+template <typename Sink>
+bool KeyboardListenerEvdev<Sink>::CheckDevicePermissions() {
+    if (!m_autoDiscover) {
+        for (size_t i = 0; i < m_fixedPaths.size(); i++) {
+            if (access(m_fixedPaths[i].c_str(), R_OK) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    DIR* dir = opendir(EVDEV_INPUT_DIR);
+    if (!dir) {
+        return false;
+    }
+    
+    bool found = false;
+    struct dirent* entry;
+    char path[EVDEV_PATH_MAX];
+    while (!found && (entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, "event", 5) != 0) {
+            continue;
+        }
+        if (!MakeDevicePath(path, entry->d_name)) {
+            continue;
+        }
+        int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd >= 0) {
+            found = IsKeyboardDevice(fd);
+            close(fd);
+        }
+    }
+    closedir(dir);
+    
+    return found;
+}
+
+// 권한 안내 메시지
+template <typename Sink>
+const char* KeyboardListenerEvdev<Sink>::GetPermissionInstructions() {
+    return "Reading keyboard devices requires access to /dev/input/event*:\n"
+           "1. Add this user to the 'input' group (sudo usermod -aG input $USER)\n"
+           "2. Log out and log back in\n"
+           "3. Restart the application";
+}
+
+INSTANTIATE_CAPTURE_LISTENER(KeyboardListenerEvdev);
+
+#endif // __linux__
@@ -0,0 +1,88 @@
+#ifndef KEYBOARD_EVDEV_H
+#define KEYBOARD_EVDEV_H
+
+#include "../../common/keyboard-base.h"
+#include "../../common/capture-pipeline.h"
+
+#ifdef __linux__
+#include <linux/input.h>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// 동시에 감시할 수 있는 최대 입력 장치 수
+#define EVDEV_MAX_DEVICES 32
+
+// 한 번의 read()로 가져오는 최대 input_event 수
+#define EVDEV_READ_BATCH 64
+
+// evdev 장치 경로 최대 길이
+#define EVDEV_PATH_MAX 256
+
+// /dev/input/event* 키보드 장치를 직접 읽는 리스너 (Wayland, 헤드리스 세션용)
+// - 모든 장치를 epoll 하나로 다중화하고, 깨어날 때마다 장치당 read() 한 번으로 이벤트를 묶어서 읽음
+// - 커널이 기록한 이벤트 시각을 그대로 사용
+// - 자동 탐색 모드에서는 inotify로 /dev/input 장치 추가/제거를 감지
+// - 키 코드는 XRecord 리스너와 같도록 X 키 코드(evdev 코드 + 8)로 보고
+// - 키 이벤트는 캡처 스레드에서 Sink::Deliver로 넘김 (인스턴스화는 keyboard-evdev.cc)
+template <typename Sink>
+class KeyboardListenerEvdev : public KeyboardListenerBase {
+public:
+    // /dev/input 자동 탐색 (핫플러그 지원)
+    explicit KeyboardListenerEvdev(Sink& sink);
+    // 지정한 경로만 사용 (테스트용 FIFO/파일 대체 가능, 핫플러그 없음)
+    KeyboardListenerEvdev(Sink& sink, const std::vector<std::string>& devicePaths);
+    virtual ~KeyboardListenerEvdev();
+    
+    // KeyboardListenerBase 인터페이스 구현
+    bool StartListening() override;
+    bool StopListening() override;
+    PermissionInfo CheckPermissions() override;
+    bool IsListening() const override;
+
+private:
+    // 캡처 단계 (X 키 코드 기준) - EVIOCSCLOCKID가 실패한 장치는 벽시계 시각을 단조 시계로 변환
+    typedef CaptureChain<SpecialKeyStage<kXSpecialKeys>, SinkStage<Sink>> CaptureStages;
+    typedef CaptureChain<WallClockTimestampStage, SpecialKeyStage<kXSpecialKeys>, SinkStage<Sink>> WallClockCaptureStages;
+    
+    struct Device {
+        int fd;
+        bool monotonicClock;   // EVIOCSCLOCKID 성공 - input_event 시각이 CLOCK_MONOTONIC
+        char path[EVDEV_PATH_MAX];
+    };
+    
+    Sink& m_sink;
+    std::vector<std::string> m_fixedPaths;
+    bool m_autoDiscover;
+    Device m_devices[EVDEV_MAX_DEVICES];
+    int m_epollFd;
+    int m_inotifyFd;
+    int m_wakeFd;
+    std::thread m_listenerThread;
+    std::atomic<bool> m_shouldStop;
+    
+    // 장치 관리
+    void ScanDevices();
+    bool OpenDevice(const char* path, bool requireKeyboard);
+    void CloseDevice(int slot);
+    void CloseDeviceByPath(const char* path);
+    static bool IsKeyboardDevice(int fd);
+    
+    // 이벤트 처리 (캡처 스레드)
+    void ListenerThreadFunc();
+    void HandleInotify();
+    void ReadDevice(int slot);
+    void DrainRegularFile(int fd);
+    void HandleKeyEvent(const struct input_event& event, bool monotonicClock);
+    
+    // 권한 관련
+    bool CheckDevicePermissions();
+    const char* GetPermissionInstructions();
+    
+    void CleanupEvdev();
+};
+
+#endif // __linux__
+
+#endif // KEYBOARD_EVDEV_H
@@ -0,0 +1,325 @@
+#include "keyboard-linux.h"
+#include "../../common/capture-sinks.h"
+
+#ifdef __linux__
+
+#include <iostream>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+// 서버 시각을 단조 시계에 다시 맞추는 기준 (절전 복귀, 서버 재시작 등으로 어긋난 경우)
+#define XRECORD_SERVER_TIME_MAX_SKEW_NS 1000000000ll
+
+template <typename Sink>
+KeyboardListenerLinux<Sink>::KeyboardListenerLinux(Sink& sink)
+    : m_sink(sink), m_display(nullptr), m_recordDisplay(nullptr), m_recordContext(0), m_shouldStop(false),
+      m_haveServerTime(false), m_lastServerTime(0), m_serverTimeHigh(0), m_serverTimeOffsetNs(0),
+      m_hasPendingRelease(false), m_pendingReleaseTime(0) {
+    m_wakePipe[0] = -1;
+    m_wakePipe[1] = -1;
+}
+
+template <typename Sink>
+KeyboardListenerLinux<Sink>::~KeyboardListenerLinux() {
+    StopListening();
+}
+
+template <typename Sink>
+bool KeyboardListenerLinux<Sink>::StartListening() {
+    if (m_isListening) {
+        return true; // 이미 실행 중
+    }
+    
+    // X11 연결 및 XRecord 컨텍스트 생성
+    if (!InitializeX11()) {
+        std::cerr << "Failed to initialize X11 record context" << std::endl;
+        CleanupX11();
+        return false;
+    }
+    
+    // 포커스 앱 추적 (실패해도 앱 ID 없이 캡처)
+    m_activeWindow.Open();
+    
+    m_shouldStop = false;
+    m_haveServerTime = false;
+    m_hasPendingRelease = false;
+    
+    // 전용 캡처 스레드 시작 (데이터 연결은 이 스레드만 사용)
+    m_listenerThread = std::thread(&KeyboardListenerLinux::ListenerThreadFunc, this);
+    
+    m_isListening = true;
+    std::cout << "Linux keyboard listener started successfully" << std::endl;
+    
+    return true;
+}
+
+template <typename Sink>
+bool KeyboardListenerLinux<Sink>::StopListening() {
+    if (!m_isListening) {
+        return true; // 이미 중지됨
+    }
+    
+    // 캡처 스레드 깨우기 및 종료 대기
+    // 스레드가 XRecordEnableContext 안에서 블록되지 않으므로 (비동기 활성화 + poll)
+    // 컨텍스트 비활성화 전에 안전하게 합류할 수 있음
+    m_shouldStop = true;
+    if (m_wakePipe[1] >= 0) {
+        char wake = 1;
+        ssize_t written = write(m_wakePipe[1], &wake, 1);
+        (void)written;
+    }
+    if (m_listenerThread.joinable()) {
+        m_listenerThread.join();
+    }
+    
+    CleanupX11();
+    
+    m_isListening = false;
+    
+    std::cout << "Linux keyboard listener stopped" << std::endl;
+    return true;
+}
+
+template <typename Sink>
+PermissionInfo KeyboardListenerLinux<Sink>::CheckPermissions() {
+    PermissionInfo info;
+    info.hasPermission = X11Permissions::Check();
+    info.requiresElevation = false; // XRecord는 같은 X 서버에 접속 가능한 사용자면 충분
+    info.permissionMessage = X11Permissions::GetInstructions();
+    
+    return info;
+}
+
+template <typename Sink>
+bool KeyboardListenerLinux<Sink>::IsListening() const {
+    return m_isListening;
+}
+
+// X11 연결 초기화
+// - m_display: 제어 연결 (컨텍스트 생성/비활성화, 호출 스레드에서 사용)
+// - m_recordDisplay: 데이터 연결 (캡처 스레드 전용)
+template <typename Sink>
+bool KeyboardListenerLinux<Sink>::InitializeX11() {
+    // 두 연결을 서로 다른 스레드에서 사용하므로 Xlib 스레드 지원 활성화
+    XInitThreads();
+    
+    m_display = XOpenDisplay(nullptr);
+    m_recordDisplay = XOpenDisplay(nullptr);
+    if (!m_display || !m_recordDisplay) {
+        std::cerr << "Failed to open X display" << std::endl;
+        return false;
+    }
+    
+    int major = 0, minor = 0;
+    if (!XRecordQueryVersion(m_display, &major, &minor)) {
+        std::cerr << "XRecord extension is not available" << std::endl;
+        return false;
+    }
+    
+    // 키보드 디바이스 이벤트만 기록
+    XRecordRange* range = XRecordAllocRange();
+    if (!range) {
+        return false;
+    }
+    range->device_events.first = KeyPress;
+    range->device_events.last = KeyRelease;
+    
+    XRecordClientSpec clients = XRecordAllClients;
+    m_recordContext = XRecordCreateContext(m_display, 0, &clients, 1, &range, 1);
+    XFree(range);
+    if (!m_recordContext) {
+        std::cerr << "Failed to create XRecord context" << std::endl;
+        return false;
+    }
+    
+    // 데이터 연결에서 컨텍스트를 활성화하기 전에 서버가 생성 요청을 처리했는지 보장
+    XSync(m_display, False);
+    
+    // 종료 신호용 파이프
+    if (pipe(m_wakePipe) != 0) {
+        m_wakePipe[0] = m_wakePipe[1] = -1;
+        return false;
+    }
+    fcntl(m_wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_wakePipe[1], F_SETFL, O_NONBLOCK);
+    fcntl(m_wakePipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(m_wakePipe[1], F_SETFD, FD_CLOEXEC);
+    
+    return true;
+}
+
+// X11 자원 정리 (캡처 스레드가 종료된 뒤 호출)
+template <typename Sink>
+void KeyboardListenerLinux<Sink>::CleanupX11() {
+    if (m_display && m_recordContext) {
+        XRecordDisableContext(m_display, m_recordContext);
+        XRecordFreeContext(m_display, m_recordContext);
+        XSync(m_display, False);
+    }
+    m_recordContext = 0;
+    
+    m_activeWindow.Close();
+    
+    if (m_recordDisplay) {
+        XCloseDisplay(m_recordDisplay);
+        m_recordDisplay = nullptr;
+    }
+    if (m_display) {
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        if (m_wakePipe[i] >= 0) {
+            close(m_wakePipe[i]);
+            m_wakePipe[i] = -1;
+        }
+    }
+}
+
+// 캡처 스레드 - 비동기로 활성화한 컨텍스트의 응답을 poll()로 기다리며 처리
+template <typename Sink>
+void KeyboardListenerLinux<Sink>::ListenerThreadFunc() {
+    if (!XRecordEnableContextAsync(m_recordDisplay, m_recordContext, EventCallback,
+                                   reinterpret_cast<XPointer>(this))) {
+        std::cerr << "Failed to enable XRecord context" << std::endl;
+        return;
+    }
+    
+    // [2] = 포커스 추적 연결 (열리지 않았으면 -1 - poll()이 무시)
+    struct pollfd fds[3];
+    fds[0].fd = ConnectionNumber(m_recordDisplay);
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakePipe[0];
+    fds[1].events = POLLIN;
+    fds[2].fd = m_activeWindow.Fd();
+    fds[2].events = POLLIN;
+    
+    while (!m_shouldStop) {
+        // 포커스 변경을 먼저 반영한 뒤 버퍼에 있는 키 응답을 모두 처리 (블록하지 않음)
+        m_activeWindow.ProcessEvents();
+        XRecordProcessReplies(m_recordDisplay);
+        FlushPendingRelease();
+        
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        fds[2].revents = 0;
+        if (poll(fds, 3, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "poll() failed on X connection" << std::endl;
+            break;
+        }
+        
+        if (fds[1].revents & POLLIN) {
+            break; // StopListening 요청
+        }
+        if (fds[0].revents & (POLLERR | POLLHUP)) {
+            std::cerr << "X connection closed" << std::endl;
+            break;
+        }
+        if (fds[2].revents & (POLLERR | POLLHUP)) {
+            fds[2].fd = -1;   // 포커스 추적만 중단 (키 캡처는 계속)
+        }
+    }
+}
+
+// 정적 콜백 함수 (XRecord 콜백, 캡처 스레드에서 호출)
+template <typename Sink>
+void KeyboardListenerLinux<Sink>::EventCallback(XPointer closure, XRecordInterceptData* data) {
+    KeyboardListenerLinux* listener = reinterpret_cast<KeyboardListenerLinux*>(closure);
+    if (listener && data->category == XRecordFromServer) {
+        listener->HandleKeyEvent(data);
+    }
+    XRecordFreeData(data);
+}
+
+// 키 이벤트 처리 (할당 없음)
+template <typename Sink>
+void KeyboardListenerLinux<Sink>::HandleKeyEvent(XRecordInterceptData* data) {
+    if (data->data_len < 1 || !data->data) {
+        return;
+    }
+    
+    // 와이어 포맷의 xEvent: [0] = 이벤트 타입, [1] = 키 코드, [4..7] = 서버 시각 (ms)
+    if (data->data_len * 4 < 8) {
+        return;
+    }
+    const int type = data->data[0] & 0x7F;
+    if (type != KeyPress && type != KeyRelease) {
+        return;
+    }
+    const uint32_t keyCode = data->data[1];
+    
+    uint32_t serverTime;
+    memcpy(&serverTime, data->data + 4, sizeof(serverTime));
+    
+    // 키 이벤트 구조체 생성 (키 내용은 포함하지 않음)
+    KeyEvent keyEvent;
+    keyEvent.timestamp = ServerTimeToNs(serverTime);
+    keyEvent.keyCode = keyCode;
+    keyEvent.isKeyDown = (type == KeyPress);
+    keyEvent.isSpecialKey = false;                   // 전달할 때 CaptureStages가 표시 (걸러내기는 바인딩의 이벤트 필터)
+    keyEvent.appId = m_activeWindow.ActiveApp();     // 속성 변경 때 캐시한 값 (X 서버 왕복 없음)
+    
+    if (m_hasPendingRelease) {
+        if (type == KeyPress && keyCode == m_pendingRelease.keyCode && serverTime == m_pendingReleaseTime) {
+            m_hasPendingRelease = false;   // 자동 반복 - 누름만 전달
+        } else {
+            FlushPendingRelease();
+        }
+    }
+    if (type == KeyRelease) {
+        m_pendingRelease = keyEvent;
+        m_pendingReleaseTime = serverTime;
+        m_hasPendingRelease = true;
+        return;
+    }
+    
+    // 캡처 단계를 거쳐 싱크로 전달 (메타데이터만 전달)
+    CaptureStages::Run(keyEvent, m_sink);
+}
+
+// 보류한 뗌 전달 (응답 묶음을 모두 처리한 뒤, 또는 다른 이벤트가 뒤따른 경우)
+template <typename Sink>
+void KeyboardListenerLinux<Sink>::FlushPendingRelease() {
+    if (!m_hasPendingRelease) {
+        return;
+    }
+    m_hasPendingRelease = false;
+    CaptureStages::Run(m_pendingRelease, m_sink);
+}
+
+// X 서버 이벤트 시각 → 단조 시계 ns
+// 서버 시각은 ms 해상도지만 이벤트가 발생한 시점의 값이라 전달 지연/스케줄링에 흔들리지 않음
+// 첫 이벤트에서 기준을 잡고, 변환 결과가 현재 시각보다 앞서면 (첫 이벤트보다 전달 지연이 작음)
+// 기준을 당기고, 크게 뒤처지면 (절전 복귀, 서버 재시작) 다시 맞춤
+template <typename Sink>
+uint64_t KeyboardListenerLinux<Sink>::ServerTimeToNs(uint32_t serverTime) {
+    const uint64_t nowNs = EventClock::NowNs();
+    
+    if (m_haveServerTime && serverTime < m_lastServerTime && m_lastServerTime - serverTime > 0x80000000u) {
+        m_serverTimeHigh += 1ull << 32;
+    }
+    m_lastServerTime = serverTime;
+    
+    const int64_t serverNs = static_cast<int64_t>((m_serverTimeHigh + serverTime) * 1000000ull);
+    int64_t eventNs = serverNs + m_serverTimeOffsetNs;
+    const int64_t skew = static_cast<int64_t>(nowNs) - eventNs;
+    
+    if (!m_haveServerTime || skew < 0 || skew > XRECORD_SERVER_TIME_MAX_SKEW_NS) {
+        m_serverTimeOffsetNs = static_cast<int64_t>(nowNs) - serverNs;
+        m_haveServerTime = true;
+        eventNs = static_cast<int64_t>(nowNs);
+    }
+    
+    return static_cast<uint64_t>(eventNs);
+}
+
+INSTANTIATE_CAPTURE_LISTENER(KeyboardListenerLinux);
+
+#endif // __linux__
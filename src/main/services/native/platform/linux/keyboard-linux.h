@@ -2,43 +2,68 @@
 #define KEYBOARD_LINUX_H
 
 #include "../../common/keyboard-base.h"
+#include "../../common/capture-pipeline.h"
+#include "active-window-linux.h"
 
 #ifdef __linux__
 #include <X11/Xlib.h>
 #include <X11/extensions/XInput2.h>
 #include <X11/extensions/record.h>
 #include <thread>
+#include <atomic>
 
+// X 서버 접속/XRecord 확장 확인 (싱크와 무관 - permissions-linux.cc)
+class X11Permissions {
+public:
+    static bool Check();
+    static const char* GetInstructions();
+};
+
+// XRecord 리스너 - 키 이벤트를 캡처 스레드에서 Sink::Deliver로 넘김 (인스턴스화는 keyboard-linux.cc)
+template <typename Sink>
 class KeyboardListenerLinux : public KeyboardListenerBase {
 public:
-    KeyboardListenerLinux();
+    explicit KeyboardListenerLinux(Sink& sink);
     virtual ~KeyboardListenerLinux();
     
     // KeyboardListenerBase 인터페이스 구현
-    bool StartListening(KeyboardCallback callback) override;
+    bool StartListening() override;
     bool StopListening() override;
     PermissionInfo CheckPermissions() override;
     bool IsListening() const override;
 
 private:
+    // 캡처 단계 (X 키 코드 = evdev 키 코드 + 8) - 시각은 HandleKeyEvent가 서버 시각에서 변환
+    typedef CaptureChain<SpecialKeyStage<kXSpecialKeys>, SinkStage<Sink>> CaptureStages;
+    
+    Sink& m_sink;
     Display* m_display;
     Display* m_recordDisplay;
     XRecordContext m_recordContext;
     std::thread m_listenerThread;
-    bool m_shouldStop;
+    std::atomic<bool> m_shouldStop;
+    int m_wakePipe[2];   // 리스너 스레드의 poll()을 깨우기 위한 self-pipe
+    ActiveWindowTrackerLinux m_activeWindow;   // 키 이벤트에 붙일 포커스 앱 (캡처 스레드에서 갱신)
+    
+    // X 서버 시각(32비트 ms) → 단조 시계 ns 변환 상태 (캡처 스레드 전용)
+    bool m_haveServerTime;
+    uint32_t m_lastServerTime;
+    uint64_t m_serverTimeHigh;      // 32비트 랩어라운드 누적 (49.7일마다)
+    int64_t m_serverTimeOffsetNs;   // 단조 시계 ns - 서버 시각 ns
+    
+    // XKB 자동 반복은 같은 서버 시각의 뗌 + 누름 쌍으로 오므로 뗌을 응답 묶음 하나를 처리하는 동안 보류
+    // (바로 뒤에 같은 키의 누름이 같은 시각으로 오면 뗌을 버려 키 상태 단계가 반복으로 분류하게 함, 캡처 스레드 전용)
+    bool m_hasPendingRelease;
+    uint32_t m_pendingReleaseTime;
+    KeyEvent m_pendingRelease;
     
     // X11 이벤트 처리
     static void EventCallback(XPointer closure, XRecordInterceptData* data);
     void HandleKeyEvent(XRecordInterceptData* data);
+    uint64_t ServerTimeToNs(uint32_t serverTime);
+    void FlushPendingRelease();
     void ListenerThreadFunc();
     
-    // Linux 특수 키 판별
-    bool IsSpecialKey(uint32_t keyCode) override;
-    
-    // 권한 관련
-    bool CheckX11Permissions();
-    const char* GetPermissionInstructions();
-    
     // X11 초기화
     bool InitializeX11();
     void CleanupX11();
@@ -0,0 +1,42 @@
+#include "keyboard-linux.h"
+
+#ifdef __linux__
+
+#include <stdlib.h>
+
+// X 서버 접속 및 XRecord 확장 사용 가능 여부 확인
+bool X11Permissions::Check() {
+    // 캡처 시 여러 스레드에서 Xlib을 사용하므로 첫 Xlib 호출 전에 스레드 지원 활성화
+    XInitThreads();
+    
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return false;
+    }
+    
+    int major = 0, minor = 0;
+    bool hasRecord = XRecordQueryVersion(display, &major, &minor);
+    XCloseDisplay(display);
+    
+    return hasRecord;
+}
+
+// 권한 안내 메시지
+const char* X11Permissions::GetInstructions() {
+    const char* display = getenv("DISPLAY");
+    if (!display || !*display) {
+        if (getenv("WAYLAND_DISPLAY")) {
+            return "X11 display is not available under this Wayland session.\n"
+                   "Run the application through XWayland (set DISPLAY) or use an X11 session.";
+        }
+        return "X11 display is not available.\n"
+               "Set the DISPLAY environment variable to a running X server (e.g. Xvfb :99).";
+    }
+    
+    return "Keyboard monitoring requires the X RECORD extension:\n"
+           "1. Make sure the X server loads the RECORD extension\n"
+           "2. Make sure this user can connect to the X display (xhost / XAUTHORITY)\n"
+           "3. Restart the application";
+}
+
+#endif // __linux__
@@ -1,35 +1,44 @@
 #include "keyboard-macos.h"
+#include "../../common/app-registry.h"
+#include "../../common/capture-sinks.h"
 
 #ifdef __APPLE__
 
 #include <iostream>
-#include <chrono>
 
-// 정적 멤버 초기화
-KeyboardListenerMacOS* KeyboardListenerMacOS::s_instance = nullptr;
+// 이벤트 시각을 단조 시계에 다시 맞추는 기준 (절전 복귀 등으로 두 시계가 어긋난 경우)
+#define EVENT_TAP_TIME_MAX_SKEW_NS 1000000000ll
 
-KeyboardListenerMacOS::KeyboardListenerMacOS() 
-    : m_eventTap(nullptr), m_runLoopSource(nullptr) {
+// 정적 멤버 초기화 (싱크 타입마다 하나)
+template <typename Sink>
+KeyboardListenerMacOS<Sink>* KeyboardListenerMacOS<Sink>::s_instance = nullptr;
+
+template <typename Sink>
+KeyboardListenerMacOS<Sink>::KeyboardListenerMacOS(Sink& sink)
+    : m_sink(sink), m_eventTap(nullptr), m_runLoopSource(nullptr), m_haveEventTime(false), m_eventTimeOffsetNs(0) {
     s_instance = this;
+    mach_timebase_info(&m_timebase);
 }
 
-KeyboardListenerMacOS::~KeyboardListenerMacOS() {
+template <typename Sink>
+KeyboardListenerMacOS<Sink>::~KeyboardListenerMacOS() {
     StopListening();
     s_instance = nullptr;
 }
 
-bool KeyboardListenerMacOS::StartListening(KeyboardCallback callback) {
+template <typename Sink>
+bool KeyboardListenerMacOS<Sink>::StartListening() {
     if (m_isListening) {
         return true; // 이미 실행 중
     }
     
     // 접근성 권한 확인
-    if (!CheckAccessibilityPermissions()) {
+    if (!AccessibilityPermissions::Check()) {
         std::cerr << "Accessibility permissions not granted" << std::endl;
         return false;
     }
     
-    m_callback = callback;
+    m_haveEventTime = false;
     
     // CGEventTap 생성 (키보드 이벤트 감지)
     m_eventTap = CGEventTapCreate(
@@ -68,7 +77,8 @@ bool KeyboardListenerMacOS::StartListening(KeyboardCallback callback) {
     return true;
 }
 
-bool KeyboardListenerMacOS::StopListening() {
+template <typename Sink>
+bool KeyboardListenerMacOS<Sink>::StopListening() {
     if (!m_isListening) {
         return true; // 이미 중지됨
     }
@@ -88,28 +98,30 @@ bool KeyboardListenerMacOS::StopListening() {
     }
     
     m_isListening = false;
-    m_callback = nullptr;
     
     std::cout << "macOS keyboard listener stopped" << std::endl;
     return true;
 }
 
-PermissionInfo KeyboardListenerMacOS::CheckPermissions() {
+template <typename Sink>
+PermissionInfo KeyboardListenerMacOS<Sink>::CheckPermissions() {
     PermissionInfo info;
-    info.hasPermission = CheckAccessibilityPermissions();
+    info.hasPermission = AccessibilityPermissions::Check();
     info.requiresElevation = false; // macOS는 관리자 권한이 아닌 접근성 권한 필요
-    info.permissionMessage = GetPermissionInstructions();
+    info.permissionMessage = AccessibilityPermissions::GetInstructions();
     
     return info;
 }
 
-bool KeyboardListenerMacOS::IsListening() const {
+template <typename Sink>
+bool KeyboardListenerMacOS<Sink>::IsListening() const {
     return m_isListening;
 }
 
 // 정적 콜백 함수 (C API 호환)
-CGEventRef KeyboardListenerMacOS::EventCallback(CGEventTapProxy proxy, CGEventType type, 
-                                               CGEventRef event, void* refcon) {
+template <typename Sink>
+CGEventRef KeyboardListenerMacOS<Sink>::EventCallback(CGEventTapProxy proxy, CGEventType type, 
+                                                     CGEventRef event, void* refcon) {
     KeyboardListenerMacOS* listener = static_cast<KeyboardListenerMacOS*>(refcon);
     if (listener) {
         return listener->HandleKeyEvent(type, event);
@@ -118,88 +130,45 @@ CGEventRef KeyboardListenerMacOS::EventCallback(CGEventTapProxy proxy, CGEventTy
 }
 
 // 키 이벤트 처리
-CGEventRef KeyboardListenerMacOS::HandleKeyEvent(CGEventType type, CGEventRef event) {
-    if (!m_callback) {
-        return event; // 콜백이 없으면 이벤트 통과
-    }
-    
+template <typename Sink>
+CGEventRef KeyboardListenerMacOS<Sink>::HandleKeyEvent(CGEventType type, CGEventRef event) {
     // 키 코드 추출
     CGKeyCode keyCode = (CGKeyCode)CGEventGetIntegerValueField(event, kCGKeyboardEventKeycode);
     
-    // 특수 키 필터링 (프라이버시 보호)
-    if (IsSpecialKey(keyCode)) {
-        return event; // 특수 키는 무시
-    }
-    
     // 키 이벤트 구조체 생성 (키 내용은 포함하지 않음)
     KeyEvent keyEvent;
-    keyEvent.timestamp = GetCurrentTimestamp();
+    keyEvent.timestamp = EventTimeToNs(CGEventGetTimestamp(event));
     keyEvent.keyCode = keyCode;
     keyEvent.isKeyDown = (type == kCGEventKeyDown);
-    keyEvent.isSpecialKey = false;
+    keyEvent.isSpecialKey = false;                   // CaptureStages가 표시 (걸러내기는 바인딩의 이벤트 필터)
+    keyEvent.appId = APP_ID_UNKNOWN;                 // 포커스 추적은 아직 Linux(X11)만 지원
     
-    // 콜백 호출 (메타데이터만 전달)
-    m_callback(keyEvent);
+    // 캡처 단계를 거쳐 싱크로 전달 (메타데이터만 전달)
+    CaptureStages::Run(keyEvent, m_sink);
     
     return event; // 이벤트를 다른 애플리케이션으로 전달
 }
 
-// macOS 특수 키 판별
-bool KeyboardListenerMacOS::IsSpecialKey(uint32_t keyCode) {
-    // macOS 키 코드 기준 특수 키들
-    switch (keyCode) {
-        // 수정자 키들
-        case 54: // Right Command
-        case 55: // Left Command  
-        case 56: // Left Shift
-        case 57: // Caps Lock
-        case 58: // Left Option
-        case 59: // Left Control
-        case 60: // Right Shift
-        case 61: // Right Option
-        case 62: // Right Control
-        case 63: // Function
-        
-        // 기능 키들
-        case 122: // F1
-        case 120: // F2
-        case 99:  // F3
-        case 118: // F4
-        case 96:  // F5
-        case 97:  // F6
-        case 98:  // F7
-        case 100: // F8
-        case 101: // F9
-        case 109: // F10
-        case 103: // F11
-        case 111: // F12
-        
-        // 기타 특수 키
-        case 53:  // Escape
-        case 48:  // Tab
-        case 36:  // Return
-        case 51:  // Delete
-            return true;
-            
-        default:
-            return false;
+// CGEventTimestamp → 단조 시계 ns
+// 이벤트 시각은 mach_absolute_time 단위이므로 timebase로 ns 변환 후 단조 시계 기준으로 옮김
+// (steady_clock 구현에 따라 절전 시간 포함 여부가 달라 기준은 관측값으로 맞춤)
+template <typename Sink>
+uint64_t KeyboardListenerMacOS<Sink>::EventTimeToNs(CGEventTimestamp eventTime) {
+    const uint64_t nowNs = EventClock::NowNs();
+    const int64_t eventNs = static_cast<int64_t>(
+        static_cast<__uint128_t>(eventTime) * m_timebase.numer / m_timebase.denom);
+    int64_t timestamp = eventNs + m_eventTimeOffsetNs;
+    const int64_t skew = static_cast<int64_t>(nowNs) - timestamp;
+    
+    if (!m_haveEventTime || skew < 0 || skew > EVENT_TAP_TIME_MAX_SKEW_NS) {
+        m_eventTimeOffsetNs = static_cast<int64_t>(nowNs) - eventNs;
+        m_haveEventTime = true;
+        timestamp = static_cast<int64_t>(nowNs);
     }
+    
+    return static_cast<uint64_t>(timestamp);
 }
 
-// 접근성 권한 확인
-bool KeyboardListenerMacOS::CheckAccessibilityPermissions() {
-    // macOS 10.9 이상에서 접근성 권한 확인
-    return AXIsProcessTrustedWithOptions(nullptr);
-}
-
-// 권한 안내 메시지
-const char* KeyboardListenerMacOS::GetPermissionInstructions() {
-    return "Please grant accessibility permissions:\n"
-           "1. Open System Preferences\n"
-           "2. Go to Security & Privacy → Privacy → Accessibility\n"
-           "3. Click the lock to make changes\n"
-           "4. Add this application to the list\n"
-           "5. Restart the application";
-}
+INSTANTIATE_CAPTURE_LISTENER(KeyboardListenerMacOS);
 
 #endif // __APPLE__
\ No newline at end of file
@@ -2,43 +2,57 @@
 #define KEYBOARD_MACOS_H
 
 #include "../../common/keyboard-base.h"
+#include "../../common/capture-pipeline.h"
 
 #ifdef __APPLE__
 #include <ApplicationServices/ApplicationServices.h>
 #include <Carbon/Carbon.h>
+#include <mach/mach_time.h>
 
+// 접근성 권한 확인/요청 (싱크와 무관 - permissions-macos.cc)
+class AccessibilityPermissions {
+public:
+    static bool Check();
+    static bool Request();                  // 사용자에게 다이얼로그 표시
+    static PermissionInfo GetDetailedInfo();
+    static void OpenPreferences();
+    static const char* GetInstructions();
+};
+
+// 이벤트 탭 리스너 - 키 이벤트를 탭 콜백에서 Sink::Deliver로 넘김 (인스턴스화는 keyboard-macos.cc)
+template <typename Sink>
 class KeyboardListenerMacOS : public KeyboardListenerBase {
 public:
-    KeyboardListenerMacOS();
+    explicit KeyboardListenerMacOS(Sink& sink);
     virtual ~KeyboardListenerMacOS();
     
     // KeyboardListenerBase 인터페이스 구현
-    bool StartListening(KeyboardCallback callback) override;
+    bool StartListening() override;
     bool StopListening() override;
     PermissionInfo CheckPermissions() override;
     bool IsListening() const override;
 
 private:
+    // 캡처 단계 (가상 키 코드 기준) - 시각은 HandleKeyEvent가 이벤트 시각에서 변환
+    typedef CaptureChain<SpecialKeyStage<kMacSpecialKeys>, SinkStage<Sink>> CaptureStages;
+    
+    Sink& m_sink;
     CFMachPortRef m_eventTap;
     CFRunLoopSourceRef m_runLoopSource;
     static KeyboardListenerMacOS* s_instance;
     
+    // CGEventTimestamp(mach 시간) → 단조 시계 ns 변환 상태 (이벤트 탭 스레드 전용)
+    mach_timebase_info_data_t m_timebase;
+    bool m_haveEventTime;
+    int64_t m_eventTimeOffsetNs;
+    
     // 정적 콜백 함수 (C API 호환)
     static CGEventRef EventCallback(CGEventTapProxy proxy, CGEventType type, 
                                    CGEventRef event, void* refcon);
     
     // 인스턴스 메서드
     CGEventRef HandleKeyEvent(CGEventType type, CGEventRef event);
-    
-    // macOS 특수 키 판별
-    bool IsSpecialKey(uint32_t keyCode) override;
-    
-    // 권한 관련
-    bool CheckAccessibilityPermissions();
-    bool RequestAccessibilityPermissions();
-    PermissionInfo GetDetailedPermissionInfo();
-    void OpenAccessibilityPreferences();
-    const char* GetPermissionInstructions();
+    uint64_t EventTimeToNs(CGEventTimestamp eventTime);
 };
 
 #endif // __APPLE__
@@ -5,8 +5,14 @@
 #include <iostream>
 #include <ApplicationServices/ApplicationServices.h>
 
+// 접근성 권한 확인
+bool AccessibilityPermissions::Check() {
+    // macOS 10.9 이상에서 접근성 권한 확인
+    return AXIsProcessTrustedWithOptions(nullptr);
+}
+
 // 접근성 권한 요청 (사용자에게 다이얼로그 표시)
-bool KeyboardListenerMacOS::RequestAccessibilityPermissions() {
+bool AccessibilityPermissions::Request() {
     // 권한 요청 옵션 설정
     CFStringRef keys[] = { kAXTrustedCheckOptionPrompt };
     CFBooleanRef values[] = { kCFBooleanTrue };
@@ -33,7 +39,7 @@ bool KeyboardListenerMacOS::RequestAccessibilityPermissions() {
 }
 
 // 상세한 권한 상태 확인
-PermissionInfo KeyboardListenerMacOS::GetDetailedPermissionInfo() {
+PermissionInfo AccessibilityPermissions::GetDetailedInfo() {
     PermissionInfo info;
     
     // 현재 권한 상태 확인
@@ -43,14 +49,14 @@ PermissionInfo KeyboardListenerMacOS::GetDetailedPermissionInfo() {
     if (info.hasPermission) {
         info.permissionMessage = "Accessibility permissions granted";
     } else {
-        info.permissionMessage = GetPermissionInstructions();
+        info.permissionMessage = GetInstructions();
     }
     
     return info;
 }
 
 // 시스템 환경설정 열기
-void KeyboardListenerMacOS::OpenAccessibilityPreferences() {
+void AccessibilityPermissions::OpenPreferences() {
     // 접근성 설정 패널 열기
     CFStringRef urlString = CFSTR("x-apple.systempreferences:com.apple.preference.security?Privacy_Accessibility");
     CFURLRef url = CFURLCreateWithString(kCFAllocatorDefault, urlString, nullptr);
@@ -64,4 +70,14 @@ void KeyboardListenerMacOS::OpenAccessibilityPreferences() {
     }
 }
 
+// 권한 안내 메시지
+const char* AccessibilityPermissions::GetInstructions() {
+    return "Please grant accessibility permissions:\n"
+           "1. Open System Preferences\n"
+           "2. Go to Security & Privacy → Privacy → Accessibility\n"
+           "3. Click the lock to make changes\n"
+           "4. Add this application to the list\n"
+           "5. Restart the application";
+}
+
 #endif // __APPLE__
\ No newline at end of file
@@ -2,22 +2,37 @@
 #define KEYBOARD_WINDOWS_H
 
 #include "../../common/keyboard-base.h"
+#include "../../common/capture-pipeline.h"
 
 #ifdef _WIN32
 #include <windows.h>
 
+// 관리자 권한 확인 (싱크와 무관 - permissions-windows.cc)
+class AdminPermissions {
+public:
+    static bool Check();
+    static bool IsRunningAsAdmin();
+    static const char* GetInstructions();
+};
+
+// 저수준 키보드 후킹 리스너 - 키 이벤트를 후킹 프로시저에서 Sink::Deliver로 넘김 (인스턴스화는 keyboard-windows.cc)
+template <typename Sink>
 class KeyboardListenerWindows : public KeyboardListenerBase {
 public:
-    KeyboardListenerWindows();
+    explicit KeyboardListenerWindows(Sink& sink);
     virtual ~KeyboardListenerWindows();
     
     // KeyboardListenerBase 인터페이스 구현
-    bool StartListening(KeyboardCallback callback) override;
+    bool StartListening() override;
     bool StopListening() override;
     PermissionInfo CheckPermissions() override;
     bool IsListening() const override;
 
 private:
+    // 캡처 단계 (가상 키 코드 기준) - HandleKeyEvent는 KeyEvent를 채운 뒤 CaptureStages::Run(event, m_sink)
+    typedef CaptureChain<SpecialKeyStage<kWindowsSpecialKeys>, SinkStage<Sink>> CaptureStages;
+    
+    Sink& m_sink;
     HHOOK m_keyboardHook;
     static KeyboardListenerWindows* s_instance;
     
@@ -26,14 +41,6 @@ private:
     
     // 인스턴스 메서드
     void HandleKeyEvent(WPARAM wParam, KBDLLHOOKSTRUCT* pKeyboard);
-    
-    // Windows 특수 키 판별
-    bool IsSpecialKey(uint32_t keyCode) override;
-    
-    // 권한 관련
-    bool CheckAdminPermissions();
-    bool IsRunningAsAdmin();
-    const char* GetPermissionInstructions();
 };
 
 #endif // _WIN32
@@ -1,19 +1,420 @@
 // 네이티브 키보드 리스너 타입 정의
 
 export interface NativeKeyEvent {
-  timestamp: number;
+  timestamp: number;  // epoch ms (소수점 이하 포함, 이벤트 소스 시각을 getClockAnchor 기준점으로 변환)
   keyCode: number;
   isKeyDown: boolean;
   isSpecialKey: boolean;
+  appId: number;      // 키를 받은 앱 (getAppTable().names 색인, 0 = 알 수 없음 - 포커스 추적은 Linux X11만)
+  isRepeat: boolean;  // 자동 반복 누름 (필터의 repeats가 true일 때만 전달됨)
+  modifiers: number;  // 이벤트 직후 눌려 있는 수정자 (KEY_MODIFIER_* 비트)
+
+  // 뗌/반복: 처음 누른 뒤 지난 시간과 자동 반복 수 (반복을 걸러도 뗌에 "N ms 동안 누름"으로 남음)
+  heldMs?: number;
+  repeatCount?: number;
+
+  // 과부하 정책이 coalesce일 때 넘친 이벤트의 요약 - 마지막 이벤트에 덧붙여 전달
+  coalescedCount?: number;  // coalescedStart ~ timestamp 사이에 합쳐진 이벤트 수
+  coalescedStart?: number;  // 첫 이벤트 시각 (epoch ms)
+
+  traceId?: number;         // 지연 추적 중일 때만 - 이 키 입력의 추적 ID (traceSpan에 넘겨 JS 구간을 이어 붙임)
+}
+
+// 배치 전달 시 flags 배열의 비트 정의 (keyboard-native.h와 동일)
+// COALESCED 항목은 keyCodes 자리에 합쳐진 이벤트 수, timestamps 자리에 마지막 이벤트 시각을 담음
+export const KEY_EVENT_FLAG_KEY_DOWN = 0x01;
+export const KEY_EVENT_FLAG_SPECIAL = 0x02;
+export const KEY_EVENT_FLAG_COALESCED = 0x04;
+export const KEY_EVENT_FLAG_REPEAT = 0x08;
+export const KEY_EVENT_FLAG_MODIFIER_SHIFT = 4;   // 상위 4비트 = 수정자 (flags >> 4 = KEY_MODIFIER_*)
+
+// 수정자 비트 (key-state.h와 동일)
+export const KEY_MODIFIER_SHIFT = 0x01;
+export const KEY_MODIFIER_CONTROL = 0x02;
+export const KEY_MODIFIER_ALT = 0x04;
+export const KEY_MODIFIER_META = 0x08;      // Super / Command / Windows
+
+// 배치 전달 옵션
+export interface BatchOptions {
+  maxBatchSize?: number;  // 이 개수가 모이면 즉시 전달 (기본 256)
+  maxLatencyMs?: number;  // 첫 이벤트 이후 이 시간이 지나면 전달 (기본 16, 0이면 즉시)
 }
 
+// 배치 콜백 - 배열은 호출 사이에 재사용되므로 count 이후 값은 무효이며, 보관하려면 복사해야 함
+export type NativeKeyEventBatchCallback = (
+  timestamps: Float64Array,
+  keyCodes: Uint32Array,
+  flags: Uint8Array,
+  count: number,
+  appIds: Uint16Array   // 이벤트별 앱 ID (NativeKeyEvent.appId와 같은 의미)
+) => void;
+
 export interface KeyboardMetadata {
   timestamp: number;
-  interval: number;
+  interval: number;   // ms (네이티브 세션 레코드는 단조 시계 기준, 소수점 이하 포함)
   keyCount: number;
   sessionId: string;
 }
 
+// 네이티브 세션 단계가 전달하는 레코드 (KeyboardService의 TypingMetadata와 동일한 형태)
+// isActive가 false면 유휴 타임아웃으로 세션이 종료되었음을 의미
+export interface NativeTypingRecord extends KeyboardMetadata {
+  isActive: boolean;
+  appId: number;            // 이 키를 받은 앱 (NativeKeyEvent.appId와 같은 의미, 세션 종료 레코드는 0)
+  coalescedCount?: number;  // coalesce 정책: 이 레코드 전에 합쳐진 키 입력 수 (keyCount는 항상 정확)
+  traceId?: number;         // 지연 추적 중일 때만 (NativeKeyEvent.traceId와 같은 의미)
+}
+
+// 이벤트 링 과부하 정책 (JS 스레드가 밀렸거나 디버거로 멈췄을 때)
+// - drop-newest: 새 이벤트 버림 (기본)
+// - drop-oldest: 가장 오래된 이벤트를 밀어내고 새 이벤트 보관
+// - block: 자리가 날 때까지 후킹 스레드가 blockTimeoutMs까지 기다린 뒤 버림
+// - coalesce: 넘친 이벤트를 "t0 ~ t1 사이 N개" 요약 하나로 합침 (개수는 정확)
+// 정책은 콜백 전달에만 적용되며, 기본 구독의 저널과 통계(롤업, 시간 색인, 앱별 통계)는 정책과 상관없이 키마다 셈
+export type OverloadPolicy = 'drop-newest' | 'drop-oldest' | 'block' | 'coalesce';
+
+export interface OverloadOptions {
+  policy?: OverloadPolicy;
+  blockTimeoutMs?: number;   // block 정책의 최대 대기 시간 (기본 5, 최대 1000)
+  maxQueueDepth?: number;    // 링에 쌓을 최대 항목 수 (1-4096, 기본 4096)
+}
+
+export type OverloadConfig = Required<OverloadOptions>;
+
+// 네이티브 이벤트 필터 (링에 넣기 전 후킹 스레드에서 적용, true = 전달)
+export interface EventFilterOptions {
+  keyUp?: boolean;        // 키 뗌 이벤트 전달 (기본 true)
+  special?: boolean;      // 특수 키(수정자, 기능 키 등) 전달 (기본 false)
+  repeats?: boolean;      // 자동 반복 누름 전달 (기본 false - 뗌 이벤트의 heldMs/repeatCount로 요약)
+  customMask?: number[];  // 추가로 걸러낼 플랫폼 키 코드 (0-255, 빈 배열이면 해제)
+}
+
+export type EventFilterConfig = Required<EventFilterOptions>;
+
+// 세션 추적 옵션
+export interface TypingSessionOptions {
+  idleTimeoutMs?: number;  // 마지막 키 입력 후 세션 종료까지의 시간 (기본 2000)
+}
+
+// 추가 구독 (subscribe) - 같은 OS 후킹을 공유하며 필터/배치/세션/과부하 상태는 구독마다 따로 가짐
+// worker_threads 안에서도 만들 수 있고, 콜백은 구독을 만든 스레드에서 호출됨
+// - events: startListening과 같은 이벤트 객체
+// - batched: startListeningBatched와 같은 타입 배열 배치
+// - sessions: startTypingSessions와 같은 타이핑 레코드
+// - rhythm: 몰아치기/멈춤/속도 변화/연속 입력/세션 종료 같은 의미 이벤트만 (키마다 호출되지 않음)
+export type SubscriptionMode = 'events' | 'batched' | 'sessions' | 'rhythm';
+
+// 리듬 이벤트 종류와 value의 의미
+// - burst: 몰아치기 시작 (연속 키 수)
+// - pause: 멈춤 (판정 시점까지 멈춘 시간 ms)
+// - rate-high / rate-low: 속도가 상한을 넘음 / 하한 아래로 내려감 (초당 키 수)
+// - streak: 세션이 streakMs의 배수를 넘음 (세션 지속 시간 ms)
+// - session-end: 세션 종료 (세션 키 수)
+export type RhythmEventType = 'burst' | 'pause' | 'rate-high' | 'rate-low' | 'streak' | 'session-end';
+
+export interface NativeRhythmEvent {
+  type: RhythmEventType;
+  timestamp: number;   // 조건이 성립한 시각 (epoch ms - 멈춤/속도 하락/세션 종료는 전달 시각보다 이를 수 있음)
+  value: number;
+  sessionId?: string;  // session-end에만
+}
+
+// 리듬 판정 기준 (구독마다 따로 가짐)
+export interface RhythmOptions {
+  burstGapMs?: number;    // 몰아치기 안에서 허용하는 키 간격 (기본 150)
+  burstMinKeys?: number;  // 몰아치기로 판정할 연속 키 수 (기본 8, 2 이상)
+  pauseMs?: number;       // 멈춤 판정 간격 (기본 1000)
+  rateHighKps?: number;   // 빠른 입력 진입 속도 (초당 키 수, 기본 5)
+  rateLowKps?: number;    // 빠른 입력 해제 속도 (기본 3, rateHighKps보다 낮아야 함)
+  rateWindowMs?: number;  // 속도 지수 가중 평균의 시간 상수 (기본 2000)
+  streakMs?: number;      // 연속 입력 보고 단위 (기본 60000)
+}
+
+export type RhythmConfig = Required<RhythmOptions>;
+
+export type SubscriptionCallback =
+  | ((event: NativeKeyEvent) => void)
+  | NativeKeyEventBatchCallback
+  | ((record: NativeTypingRecord) => void)
+  | ((event: NativeRhythmEvent) => void);
+
+export interface SubscriptionOptions extends BatchOptions, TypingSessionOptions, RhythmOptions {
+  filter?: EventFilterOptions;
+  overload?: OverloadOptions;
+}
+
+// 세션 키 입력 간격 통계 (네이티브 고정 메모리 히스토그램 기반, 단위: ms)
+export interface IntervalStatsSnapshot {
+  count: number;
+  mean: number;
+  variance: number;
+  stddev: number;
+  min: number;
+  max: number;
+  p50: number;
+  p90: number;
+  p99: number;
+}
+
+// 지연 시간 히스토그램 요약 (ns)
+export interface LatencySummary {
+  count: number;
+  mean: number;
+  max: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  p999: number;
+}
+
+// 캡처 경로 지표 (시작 또는 resetMetrics 이후 누적값)
+export interface PipelineMetrics {
+  eventsSeen: number;        // 후킹 단계에 도달한 이벤트 (걸러진 이벤트 포함)
+  eventsFiltered: number;    // 필터 단계에서 걸러진 이벤트 (세션 모드에서는 세션에 포함되지 않는 이벤트 포함)
+  eventsEnqueued: number;    // 링에 들어간 항목 (세션 종료 항목 포함)
+  eventsDelivered: number;   // 링에서 꺼내 JS 전달 단계로 넘어간 키 이벤트
+  eventsDropped: number;     // 링이 가득 차 버린 항목 (drop-newest, block 시간 초과)
+  eventsEvicted: number;     // 새 항목에 밀려 버려진 오래된 항목 (drop-oldest)
+  eventsCoalesced: number;   // 요약으로 합쳐진 키 이벤트 (coalesce)
+  producerBlocks: number;    // 후킹 스레드가 링 자리를 기다린 횟수 (block)
+  producerBlockTimeouts: number;  // 그중 시간 초과로 버린 횟수
+  queueDepth: number;        // 현재 링 깊이
+  maxQueueDepth: number;     // 링 최대 깊이
+  queueLimit: number;        // 설정된 최대 깊이 (setOverloadPolicy)
+  queueCapacity: number;
+  recordsDropped: number;    // 레코드 링이 가득 차 저널/통계에 넣지 못한 타이핑 레코드 (기본 구독, 보통 0)
+  wakeups: number;           // JS 스레드 깨우기 횟수
+  hookDurationNs: LatencySummary;     // 후킹 콜백 실행 시간
+  deliveryLatencyNs: LatencySummary;  // 후킹 → CallJS 지연
+}
+
+// 네이티브 리스너 백엔드
+// - default: 플랫폼 기본값 (Linux에서는 DISPLAY가 있으면 xrecord, 없으면 evdev)
+// - xrecord: X RECORD 확장 (Linux X11)
+// - evdev: /dev/input/event* 직접 읽기 (Linux Wayland/헤드리스)
+// - replay: 녹화된 트레이스 파일 재생 (부하/회귀 테스트)
+// - synthetic: 합성 타이핑 스트림 생성 (부하/회귀 테스트)
+export type ListenerBackend = 'default' | 'xrecord' | 'evdev' | 'replay' | 'synthetic';
+
+export interface ListenerBackendOptions {
+  devices?: string[];  // evdev: 읽을 장치 경로 (생략 시 /dev/input 자동 탐색 및 핫플러그)
+
+  // 모든 백엔드: 전달되는 이벤트를 이 경로에 트레이스 파일로 녹화
+  recordTo?: string;
+
+  // replay/synthetic 재생 옵션
+  trace?: string;              // replay: 트레이스 파일 경로 (필수)
+  // 1 = 실시간 (기본), N = N배속, 0 = 최대 속도
+  // 0이면 과부하 정책과 무관하게 링 자리를 기다리며 전달 (버리지 않음 - 같은 시드면 같은 결과)
+  // 가속 재생(0 또는 1 초과)은 시각이 현재를 앞서지 않도록 시간축을 과거로 옮기므로 끝이 있어야 함
+  // (loop, keyCount 0과 함께 쓰면 RangeError)
+  speed?: number;
+  loop?: boolean;              // replay: 끝에서 처음으로 돌아감
+  rebaseTimestamps?: boolean;  // 첫 이벤트를 시작 시각(가속 재생이면 그만큼 앞당긴 시각)으로 옮김 (기본 true, 간격은 유지)
+
+  // synthetic 모델 (간격: 로그정규, 버스트 길이: 기하, 버스트 사이 멈춤: 지수 분포)
+  keyCount?: number;           // 생성할 키 입력 수 (기본 0 = 중지할 때까지)
+  seed?: number;               // 같은 시드면 같은 스트림 (기본 1)
+  intervalMedianMs?: number;   // 키 입력 간격 중앙값 (기본 150)
+  intervalSigma?: number;      // 간격의 로그 표준편차 (기본 0.5)
+  burstMeanKeys?: number;      // 버스트 평균 길이 (기본 40, 0이면 멈춤 없음)
+  pauseMeanMs?: number;        // 버스트 사이 멈춤 평균 (기본 3000)
+  holdMs?: number;             // 누름 → 뗌 간격 (기본 80, 0이면 뗌 이벤트 생략)
+  appCount?: number;           // 포커스 앱 수 (기본 0, N이면 "synthetic-1..N"을 멈춤마다 차례로 전환)
+}
+
+// 이벤트 저널 옵션
+export interface JournalOptions {
+  segmentRecords?: number;  // 세그먼트당 레코드 수 (기본 65536, 32바이트/레코드)
+}
+
+// 저널 레코드 (배열 구조체 형태, 세션 ID는 session_<sessionStart>_<sessionSeq>)
+export interface JournalRecords {
+  count: number;
+  timestamps: Float64Array;
+  sessionStarts: Float64Array;
+  sessionSeqs: Uint32Array;
+  keyCounts: Uint32Array;
+  intervals: Float64Array;  // ms (us 정밀도)
+}
+
+// 일별/시간별 통계 증분 행 (마지막 takeRollups 이후 더해진 값, 날짜/시간은 로컬 시각 기준)
+export interface RollupRow {
+  date: string;           // YYYY-MM-DD
+  hour: number;           // 0-23 (일별 행은 -1)
+  keys: number;           // 세션에 포함된 키 입력 수
+  sessions: number;       // 시작된 세션 수
+  activeMs: number;       // 활동 시간 - 세션 내 키 입력 간격의 합
+  intervalCount: number;  // 간격 적률 (ms) - 평균 = sum / count, 분산 = sumSq / count - 평균²
+  intervalSum: number;
+  intervalSumSq: number;
+}
+
+export interface RollupSet {
+  daily: RollupRow[];
+  hourly: RollupRow[];
+}
+
+// 가장 최근 입력 날짜의 누적 통계 (빠른 시작 스냅샷에 저장되는 값)
+export interface RunningStats {
+  date: string;           // YYYY-MM-DD (기록이 없으면 '')
+  keys: number;
+  sessions: number;
+  activeMs: number;
+  intervalCount: number;
+  intervalSum: number;
+  intervalSumSq: number;
+  hourKeys: number[];     // 시간별 키 입력 수 (24개)
+  streakDays: number;     // date까지 연속으로 입력한 날 수
+  bestStreakDays: number;
+  session: RunningSession | null;   // 마지막 세션 (reconcileStats에는 필요 없음)
+  savedAt?: number;       // 스냅샷 저장 시각 (loadStatsSnapshot 결과에만)
+}
+
+export interface RunningSession {
+  sessionId: string;
+  startTime: number;      // epoch ms
+  keyCount: number;
+  lastKeyTime: number;    // epoch ms
+}
+
+// 시간 버킷 (timeIndexAdd 입력 - 열 배열, 시각은 epoch ms)
+export interface TimeBuckets {
+  count: number;
+  starts: Float64Array;
+  keys: Float64Array;
+  activeMs: Float64Array;
+  sessions: Float64Array;
+}
+
+// 시간 버킷 색인 구간 합 (timeIndexQuery 경계 사이 구간마다 한 값)
+export interface TimeRangeSums {
+  keys: Float64Array;
+  activeMs: Float64Array;
+  sessions: Float64Array;
+}
+
+export interface TimeIndexInfo {
+  days: number;           // 날짜 트리 크기
+  minuteHours: number;    // 분 단위 버킷이 할당된 시간 수
+  bytes: number;
+}
+
+// 앱 ID → 이름 표 (ID는 프로세스가 끝날 때까지 유지)
+export interface AppTable {
+  names: string[];        // names[appId], names[0] = '' (알 수 없음)
+  activeAppId: number;    // 현재 포커스된 앱
+}
+
+// 앱별 누적 (세션은 첫 키를 받은 앱에 셈)
+export interface AppStats {
+  appId: number;
+  keys: number;
+  activeMs: number;
+  sessions: number;
+}
+
+// 이벤트 아카이브 요약
+export interface ArchiveInfo {
+  open: boolean;
+  blocks: number;
+  records: number;
+  bytes: number;          // 파일 크기 (마지막 유효 블록까지)
+  minTimestamp: number;   // 보관된 레코드의 시각 범위 (비어 있으면 0)
+  maxTimestamp: number;
+}
+
+// 아카이브 범위 조회 결과 (블록 하나 분량)
+export interface ArchiveScanResult {
+  records: JournalRecords;
+  cursor: number;         // 다음 호출에 넘길 위치 (더 읽을 블록이 없으면 -1)
+}
+
+// 분석 커널 구현 ('auto'는 이 CPU에서 쓸 수 있는 가장 넓은 구현)
+export type AnalyticsKernelName = 'auto' | 'scalar' | 'sse2' | 'neon' | 'avx2';
+
+// 분석 입력 - 아카이브 범위의 레코드 뒤에 전달한 배열을 이어 붙여 한 흐름으로 분석
+export interface AnalyticsInput {
+  intervals?: Float64Array;     // ms (0은 세션 첫 키 - 통계/분위수에서 제외, 몰아치기 구간을 끊음)
+  timestamps?: Float64Array;    // epoch ms (intervals와 같은 길이, 히스토그램에 필요)
+  archive?: { start: number; end: number };   // [start, end) 범위의 보관된 이벤트
+}
+
+export interface AnalyticsOptions {
+  percentiles?: number[];       // 0-100 (기본 [50, 90, 99])
+  burstMs?: number;             // 몰아치기 간격 상한 (기본 100)
+  pauseMs?: number;             // 멈춤 간격 하한 (기본 2000)
+  histogram?: {                 // 시각 구간별 키 수/간격 합 - [origin + i*width, origin + (i+1)*width)
+    origin: number;
+    width: number;
+    buckets: number;
+  };
+  kernel?: AnalyticsKernelName;
+}
+
+export interface AnalyticsResult {
+  kernel: AnalyticsKernelName;
+  events: number;               // 분석한 전체 이벤트 수
+  count: number;                // 간격이 있는 이벤트 수 (아래 통계의 표본)
+  sum: number;
+  mean: number;
+  variance: number;             // 표본 분산
+  stdDev: number;
+  min: number;
+  max: number;
+  percentiles: number[];        // 요청한 순서
+  bursts: { runs: number; keys: number; longest: number };
+  pauses: { count: number; totalMs: number };
+  histogram?: { origin: number; width: number; counts: Float64Array; sums: Float64Array };
+  elapsedMs: number;            // 작업 스레드에서 걸린 시간
+}
+
+// readSnapshot 버퍼 배치 (Float64Array 인덱스 - live-state.h의 LiveStateField와 같은 순서)
+export const LIVE_STATE_SEQUENCE = 0;           // 게시 횟수 (키 입력마다 1 증가)
+export const LIVE_STATE_ACTIVE = 1;             // 1 = 입력 중, 0 = 유휴
+export const LIVE_STATE_RATE = 2;               // 초당 키 수 (읽는 시점까지 감쇠 반영)
+export const LIVE_STATE_COMBO = 3;              // 현재 콤보 길이 (간격이 끊기면 0)
+export const LIVE_STATE_LAST_KEY_AGE_MS = 4;    // 마지막 키 이후 경과 시간 (키 입력이 없었으면 -1)
+export const LIVE_STATE_LAST_INTERVAL_MS = 5;   // 마지막 두 키 사이 간격 (콤보 첫 키는 0)
+export const LIVE_STATE_TOTAL_KEYS = 6;         // 프로세스 누적 키 수
+export const LIVE_STATE_LAST_KEY_WALL_MS = 7;   // 마지막 키 시각 (epoch ms, 없으면 0)
+export const LIVE_STATE_FIELD_COUNT = 8;
+
+// 실시간 상태 판정 기준 (ms, 프로세스 공유)
+export interface LiveStateOptions {
+  activeMs?: number;      // 마지막 키 후 입력 중으로 보는 시간 (기본 2000)
+  comboGapMs?: number;    // 콤보가 이어지는 최대 키 간격 (기본 1000)
+  rateWindowMs?: number;  // 입력 속도 지수 가중 평균의 시간 상수 (기본 1000)
+}
+
+export type LiveStateConfig = Required<LiveStateOptions>;
+
+// 현재 키 상태 (프로세스 공유 - 어느 키가 눌렸는지는 노출하지 않음)
+export interface KeyState {
+  modifiers: number;      // KEY_MODIFIER_* 비트
+  keysDown: number;       // 눌려 있는 키 수
+}
+
+// 지연 추적 파일 (Chrome trace-event JSON - chrome://tracing, ui.perfetto.dev에서 열림)
+export interface TraceSummary {
+  path: string;
+  events: number;     // 지금까지 파일에 쓴 구간 수
+  dropped: number;    // 스레드별 버퍼가 가득 차 버린 구간 수 (flushTrace를 더 자주 부르면 줄어듦)
+}
+
+// traceSpan 옵션
+export interface TraceSpanOptions {
+  track?: string;     // 별도 트랙 이름 (예: 위젯 렌더러) - 생략하면 호출한 JS 스레드 트랙
+  end?: boolean;      // 이 키 입력 흐름의 마지막 구간
+}
+
+// 시계 기준점 - 같은 순간의 네이티브 단조 시계(ns)와 epoch ms
+// 네이티브 이벤트 시각은 단조 시계로 기록되고 JS로 넘길 때 이 기준점으로 변환됨
+export interface ClockAnchor {
+  monotonicNs: number;
+  wallMs: number;
+}
+
 export interface PlatformPermissions {
   hasPermission: boolean;
   requiresElevation: boolean;
@@ -22,9 +423,53 @@ export interface PlatformPermissions {
 
 export interface NativeKeyboardListener {
   startListening(callback: (event: NativeKeyEvent) => void): boolean;
+  startListeningBatched(callback: NativeKeyEventBatchCallback, options?: BatchOptions): boolean;
+  startTypingSessions(callback: (record: NativeTypingRecord) => void, options?: TypingSessionOptions): boolean;
+  subscribe(mode: SubscriptionMode, callback: SubscriptionCallback, options?: SubscriptionOptions): number;
+  unsubscribe(subscriptionId: number): boolean;
+  setIdleTimeout(timeoutMs: number, subscriptionId?: number): void;
+  setEventFilter(options: EventFilterOptions, subscriptionId?: number): EventFilterConfig;
+  setOverloadPolicy(options: OverloadOptions, subscriptionId?: number): OverloadConfig;
+  getSessionStats(subscriptionId?: number): IntervalStatsSnapshot;
+  resetSessionStats(subscriptionId?: number): void;
   stopListening(): boolean;
   checkPermissions(): PlatformPermissions;
   isListening(): boolean;
+  setListenerBackend(backend: ListenerBackend, options?: ListenerBackendOptions): boolean;
+  getMetrics(subscriptionId?: number): PipelineMetrics;
+  resetMetrics(subscriptionId?: number): void;
+  getClockAnchor(): ClockAnchor;
+  openJournal(directory: string, options?: JournalOptions): boolean;
+  closeJournal(): void;
+  journalRange(start: number, end: number): JournalRecords;
+  journalSealedSegments(): number[];
+  journalReadSegment(segmentId: number): JournalRecords | null;
+  journalReleaseSegment(segmentId: number): boolean;
+  takeRollups(): RollupSet;
+  loadStatsSnapshot(path: string): RunningStats | null;
+  saveStatsSnapshot(): boolean;
+  getRunningStats(): RunningStats;
+  reconcileStats(stored: RunningStats): boolean;
+  timeIndexAdd(buckets: TimeBuckets): number;
+  timeIndexQuery(bounds: number[] | Float64Array): TimeRangeSums;
+  timeIndexInfo(): TimeIndexInfo;
+  getAppTable(): AppTable;
+  getAppStats(reset?: boolean): AppStats[];
+  openArchive(path: string): boolean;
+  closeArchive(): void;
+  archiveAppend(records: JournalRecords): number;
+  archiveScan(start: number, end: number, cursor?: number): ArchiveScanResult;
+  archiveInfo(): ArchiveInfo;
+  analyze(input: AnalyticsInput, options?: AnalyticsOptions): Promise<AnalyticsResult>;
+  getAnalyticsKernel(): AnalyticsKernelName;
+  readSnapshot(buffer: Float64Array): boolean;
+  setLiveStateOptions(options: LiveStateOptions): LiveStateConfig;
+  getKeyState(): KeyState;
+  setRhythmOptions(options: RhythmOptions, subscriptionId?: number): RhythmConfig;
+  startTrace(path: string): boolean;
+  stopTrace(): TraceSummary | null;
+  flushTrace(): TraceSummary | null;
+  traceSpan(traceId: number, name: string, startMs: number, endMs: number, options?: TraceSpanOptions): void;
 }
 
 // 네이티브 모듈 타입은 index.ts에서 직접 처리
\ No newline at end of file
@@ -1,4 +1,4 @@
-import { TypingEvent } from '../shared/types';
+import { TypingEvent, TypingLiveState, TraceRenderReport } from '../shared/types';
 
 // ElectronAPI 타입 정의
 export interface ElectronAPI {
@@ -16,7 +16,9 @@ export interface ElectronAPI {
   // 타이핑 이벤트 리스너
   onTypingEvent: (callback: (event: TypingEvent) => void) => void;
   onTypingSessionEnd: (callback: (event: TypingEvent) => void) => void;
+  onTypingLiveState: (callback: (state: TypingLiveState) => void) => void;
   onPermissionRequired: (callback: (permissionInfo: any) => void) => void;
+  reportTraceRendered: (report: TraceRenderReport) => void;
 
   // 데이터베이스 관련 API
   database: {
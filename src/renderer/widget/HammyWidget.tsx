@@ -1,6 +1,9 @@
 import React, { useState, useEffect, useRef } from 'react';
 import HammyCharacter from './components/HammyCharacter';
-import { TypingEvent } from '../../shared/types';
+import { TypingEvent, TypingLiveState } from '../../shared/types';
+
+// 메인 프로세스와 같은 축의 epoch ms (소수점 이하 포함)
+const traceNow = () => performance.timeOrigin + performance.now();
 
 export type HammyState = 'idle' | 'typing' | 'excited' | 'sleeping';
 
@@ -21,6 +24,11 @@ const HammyWidget: React.FC = () => {
             window.electronAPI.onTypingSessionEnd(() => {
                 handleTypingEnd();
             });
+
+            // 네이티브 리스너 동작 중에는 키 이벤트 대신 실시간 상태만 전달됨
+            window.electronAPI.onTypingLiveState((state: TypingLiveState) => {
+                handleLiveState(state);
+            });
         }
 
         // 컴포넌트 언마운트 시 정리
@@ -31,7 +39,20 @@ const HammyWidget: React.FC = () => {
         };
     }, []);
 
+    // 지연 추적: 상태 변경이 반영된 프레임을 그린 뒤 메인 프로세스에 보고
+    // (requestAnimationFrame은 그리기 직전에 실행되므로 그 다음 작업에서 시각을 잼)
+    const reportRendered = (traceId: number | undefined, receivedAt: number) => {
+        if (!traceId) return;
+        requestAnimationFrame(() => {
+            setTimeout(() => {
+                window.electronAPI.reportTraceRendered({ traceId, receivedAt, renderedAt: traceNow() });
+            }, 0);
+        });
+    };
+
     const handleTypingEvent = (event: TypingEvent) => {
+        const receivedAt = event.traceId ? traceNow() : 0;
+
         // 타이핑 상태로 변경
         setHammyState('typing');
 
@@ -49,6 +70,29 @@ const HammyWidget: React.FC = () => {
         typingTimeoutRef.current = setTimeout(() => {
             setHammyState('idle');
         }, 2000);
+
+        reportRendered(event.traceId, receivedAt);
+    };
+
+    const handleLiveState = (state: TypingLiveState) => {
+        const receivedAt = state.traceId ? traceNow() : 0;
+
+        // 유휴 전환도 메인 프로세스가 판정해 보내므로 별도 타이머 없음
+        if (typingTimeoutRef.current) {
+            clearTimeout(typingTimeoutRef.current);
+            typingTimeoutRef.current = null;
+        }
+
+        if (!state.active) {
+            setHammyState('idle');
+        } else if (state.lastIntervalMs < 100 && state.combo > 5) {
+            // 키 이벤트 경로와 같은 기준 (빠른 연속 입력)
+            setHammyState('excited');
+        } else {
+            setHammyState('typing');
+        }
+
+        reportRendered(state.traceId, receivedAt);
     };
 
     const handleTypingEnd = () => {
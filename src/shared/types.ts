@@ -6,6 +6,31 @@ export interface TypingEvent {
   interval: number;
   isActive: boolean;
   sessionId: string;
+  traceId?: number;        // 지연 추적 중일 때만 (네이티브가 키 입력마다 붙인 추적 ID)
+}
+
+// 위젯 애니메이션용 실시간 타이핑 상태 (메인 프로세스가 화면 갱신 주기로 읽어 바뀔 때만 전달)
+export interface TypingLiveState {
+  active: boolean;
+  rate: number;            // 초당 키 수
+  combo: number;           // 현재 콤보 길이
+  lastKeyAgeMs: number;    // 마지막 키 이후 경과 시간 (키 입력이 없었으면 -1)
+  lastIntervalMs: number;  // 마지막 두 키 사이 간격
+  traceId?: number;        // 지연 추적 중일 때만 - 이 상태에 처음 반영된 추적 대상 키 입력
+}
+
+// 위젯이 추적 ID가 붙은 상태를 화면에 그린 뒤 보내는 보고 (epoch ms, performance.timeOrigin 기준)
+export interface TraceRenderReport {
+  traceId: number;
+  receivedAt: number;   // IPC 메시지를 받은 시각
+  renderedAt: number;   // 상태 변경이 반영된 프레임을 그린 뒤의 시각
+}
+
+// 햄찌 반응용 타이핑 리듬 이벤트 (네이티브 리듬 구독이 조건이 성립할 때만 전달)
+export interface HammyReaction {
+  type: 'burst' | 'pause' | 'rate-high' | 'rate-low' | 'streak' | 'session-end';
+  timestamp: number;
+  value: number;
 }
 
 export interface IPCMessage {
@@ -16,7 +41,9 @@ export interface IPCMessage {
 export enum IPCChannels {
   TYPING_EVENT = 'typing-event',
   TYPING_SESSION_END = 'typing-session-end',
+  TYPING_LIVE_STATE = 'typing-live-state',
   HAMMY_REACTION = 'hammy-reaction',
+  TRACE_RENDERED = 'trace-rendered',
   DASHBOARD_OPEN = 'dashboard-open',
   DASHBOARD_CLOSE = 'dashboard-close',
   STATISTICS_REQUEST = 'statistics-request',